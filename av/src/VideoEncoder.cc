@@ -64,6 +64,9 @@ class GZ_COMMON_AV_HIDDEN common::VideoEncoder::Implementation
   /// \brief libav input image data (aligned to 32 bytes)
   public: AVFrame *avInFrame = nullptr;
 
+  /// \brief libav packet reused for every encoded frame
+  public: AVPacket *avPacket = nullptr;
+
   /// \brief Pixel format of the input frame. So far it is hardcoded.
   public: AVPixelFormat inPixFormat = AV_PIX_FMT_RGB24;
 
@@ -567,6 +570,17 @@ bool VideoEncoder::Start(
     return false;
   }
 
+  // Allocated once and reused by every call to AddFrame
+  this->dataPtr->avPacket = av_packet_alloc();
+
+  if (!this->dataPtr->avPacket)
+  {
+    gzerr << "Could not allocate video packet. "
+          << "Video encoding is not started\n";
+    this->Reset();
+    return false;
+  }
+
   // we misuse sw_pix_fmt a bit, as docs say it is unused in encoders
   this->dataPtr->avOutFrame->format = this->dataPtr->codecCtx->sw_pix_fmt;
   this->dataPtr->avOutFrame->width = this->dataPtr->codecCtx->width;
@@ -757,10 +771,7 @@ bool VideoEncoder::AddFrame(const unsigned char *_frame,
   {
     frameToEncode->pts = this->dataPtr->frameCount++;
 
-    AVPacket* avPacket = av_packet_alloc();
-
-    avPacket->data = nullptr;
-    avPacket->size = 0;
+    AVPacket* avPacket = this->dataPtr->avPacket;
 
     ret = avcodec_send_frame(this->dataPtr->codecCtx,
                                  frameToEncode);
@@ -822,11 +833,9 @@ bool VideoEncoder::Stop()
     // enter drain state
     ret = avcodec_send_frame(this->dataPtr->codecCtx, nullptr);
 
-    if (ret >= 0)
+    if (ret >= 0 && this->dataPtr->avPacket)
     {
-      AVPacket *avPacket = av_packet_alloc();
-      avPacket->data = nullptr;
-      avPacket->size = 0;
+      AVPacket *avPacket = this->dataPtr->avPacket;
 
       // This loop will retrieve and write all remaining packets
       while (ret >= 0)
@@ -838,7 +847,7 @@ bool VideoEncoder::Stop()
         if (ret >= 0)
           ret = this->dataPtr->ProcessPacket(avPacket);
       }
-      av_packet_free(&avPacket);
+      av_packet_unref(avPacket);
     }
   }
 
@@ -857,6 +866,10 @@ bool VideoEncoder::Stop()
     av_frame_free(&this->dataPtr->avOutFrame);
   this->dataPtr->avOutFrame = nullptr;
 
+  if (this->dataPtr->avPacket)
+    av_packet_free(&this->dataPtr->avPacket);
+  this->dataPtr->avPacket = nullptr;
+
   if (this->dataPtr->swsCtx)
     sws_freeContext(this->dataPtr->swsCtx);
   this->dataPtr->swsCtx = nullptr;
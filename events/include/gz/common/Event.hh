@@ -18,12 +18,15 @@
 #define GZ_COMMON_EVENT_HH_
 
 #include <atomic>
+#include <cstddef>
+#include <deque>
 #include <functional>
 #include <list>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <utility>
+#include <vector>
 
 #include <gz/common/config.hh>
 #include <gz/common/events/Export.hh>
@@ -55,6 +58,26 @@ namespace gz
       /// \param[in] _sig True if the event has been signaled.
       public: void SetSignaled(bool _sig);
 
+      /// \brief Base class of state that derived events keep outside of
+      /// their objects, see SetExtra.
+      public: class GZ_COMMON_EVENTS_VISIBLE ExtraState
+      {
+        /// \brief Destructor.
+        public: virtual ~ExtraState();
+      };
+
+      /// \brief Get the extra state of this event.
+      /// \return The state, or nullptr if none was set.
+      protected: ExtraState *Extra() const;
+
+      /// \brief Set the extra state of this event, replacing the current
+      /// one. The state is destroyed along with the event. It is stored
+      /// outside of the object, so that derived events can add state
+      /// without changing their layout.
+      /// \param[in] _state The state.
+      /// \return Pointer to the state.
+      protected: ExtraState *SetExtra(std::unique_ptr<ExtraState> _state);
+
       /// \brief True if the event has been signaled.
       private: bool signaled;
     };
@@ -95,7 +118,112 @@ namespace gz
       public: template<typename T, typename N> friend class EventT;
     };
 
+    /// \brief Identifier of a connection made with EventT::ConnectToken.
+    /// Unlike a ConnectionPtr, a token is a plain value which does not
+    /// disconnect when it is destroyed: the subscriber calls
+    /// EventT::Disconnect with it, or lets the event go out of scope.
+    class ConnectionToken
+    {
+      /// \brief Constructor of an invalid token.
+      public: ConnectionToken() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _id Id of the connection.
+      public: explicit ConnectionToken(int _id)
+        : id(_id)
+      {
+      }
+
+      /// \brief Get the id of the connection.
+      /// \return The id, -1 for an invalid token.
+      public: int Id() const
+      {
+        return this->id;
+      }
+
+      /// \brief Check whether the token refers to a connection.
+      /// \return True if the token is valid.
+      public: bool Valid() const
+      {
+        return this->id >= 0;
+      }
+
+      /// \brief Id of the connection.
+      private: int id = -1;
+    };
+
+    /// \class ConnectionGroup Event.hh gz/common/Event.hh
+    /// \brief A set of connections, to one or more events, which are
+    /// disconnected together, e.g. all the subscriptions of an entity.
+    ///
+    /// The callbacks of a group are stored in one block per event, which
+    /// grows in chunks. Disconnecting a group takes a constant time per
+    /// event, whatever the number of callbacks, and frees each block in
+    /// one go the next time the event is signaled.
+    ///
+    /// ~~~
+    /// gz::common::ConnectionGroup group;
+    /// for (auto &entity : entities)
+    ///   updateEvent.Connect(group, [&entity]() { entity.Update(); });
+    /// group.Disconnect();
+    /// ~~~
+    class GZ_COMMON_EVENTS_VISIBLE ConnectionGroup
+    {
+      /// \brief Constructor.
+      public: ConnectionGroup();
+
+      /// \brief Destructor, disconnects all the connections.
+      public: ~ConnectionGroup();
+
+      /// \brief Not copyable.
+      public: ConnectionGroup(const ConnectionGroup &) = delete;
+
+      /// \brief Not copyable.
+      public: ConnectionGroup &operator=(const ConnectionGroup &) = delete;
+
+      /// \brief Disconnect all the connections of the group. The group can
+      /// be connected again afterwards.
+      public: void Disconnect();
+
+      /// \brief Check whether the group has no connections.
+      /// \return True if no event has connections of the group.
+      public: bool Empty() const;
+
+      /// \brief Record a block of connections of an event.
+      /// \param[in] _event The event.
+      /// \param[in] _id Id of the block in the event.
+      private: void Add(Event *_event, int _id);
+
+      /// \brief Forget a block of an event, after it was disconnected or
+      /// the event was destroyed.
+      /// \param[in] _event The event.
+      /// \param[in] _id Id of the block in the event.
+      private: void Remove(Event *_event, int _id);
+
+#ifdef _WIN32
+// Disable warning C4251
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Blocks of connections, as event and block id.
+      private: std::vector<std::pair<Event *, int>> blocks;
+
+      /// \brief Protects the blocks.
+      private: mutable std::mutex mutex;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+      /// \brief Friend class.
+      public: template<typename T, typename N> friend class EventT;
+    };
+
     /// \brief A class for event processing.
+    ///
+    /// Subscribers are called by decreasing priority, and in the order they
+    /// were connected within a priority. The default priority is 0. The
+    /// callbacks of a group are the exception, see Connect(ConnectionGroup &,
+    /// const CallbackT &, int).
     /// \tparam T function event callback function signature
     /// \tparam N optional additional type to disambiguate events with same
     ///   function signature
@@ -114,16 +242,49 @@ namespace gz
 
       /// \brief Connect a callback to this event.
       /// \param[in] _subscriber Pointer to a callback function.
+      /// \param[in] _priority Subscribers with a higher priority are
+      /// called first.
       /// \return A Connection object, which will automatically call
       /// Disconnect when it goes out of scope.
-      public: ConnectionPtr Connect(const CallbackT &_subscriber);
+      public: ConnectionPtr Connect(const CallbackT &_subscriber,
+                                    int _priority = 0);
+
+      /// \brief Connect a callback without allocating a Connection. The
+      /// callback stays connected until Disconnect is called with the
+      /// token or the event is destroyed.
+      /// \param[in] _subscriber Callback function.
+      /// \param[in] _priority Subscribers with a higher priority are
+      /// called first.
+      /// \return Token to pass to Disconnect.
+      public: ConnectionToken ConnectToken(const CallbackT &_subscriber,
+                                           int _priority = 0);
+
+      /// \brief Connect a callback as part of a group. The callback stays
+      /// connected until the group is disconnected or destroyed.
+      ///
+      /// The callbacks of a group with the same priority are stored in one
+      /// block and are called together, in the order they were connected.
+      /// The block is called where the first of them was connected among
+      /// the other subscribers of that priority, so a callback connected
+      /// later to the group runs before subscribers connected in between.
+      /// \param[in] _group Group of the connection.
+      /// \param[in] _subscriber Callback function.
+      /// \param[in] _priority Subscribers with a higher priority are
+      /// called first.
+      public: void Connect(ConnectionGroup &_group,
+                           const CallbackT &_subscriber, int _priority = 0);
 
       /// \brief Disconnect a callback to this event.
       /// \param[in] _id The id of the connection to disconnect.
       public: virtual void Disconnect(int _id);
 
+      /// \brief Disconnect a callback connected with ConnectToken.
+      /// \param[in,out] _token Token of the connection, invalid after this.
+      public: void Disconnect(ConnectionToken &_token);
+
       /// \brief Get the number of connections.
-      /// \return Number of connection to this Event.
+      /// \return Number of connection to this Event. Each callback of a
+      /// group counts as a connection.
       public: unsigned int ConnectionCount() const;
 
       /// \brief Access the signal.
@@ -140,10 +301,25 @@ namespace gz
         this->Cleanup();
 
         this->SetSignaled(true);
-        for (const auto &iter : this->connections)
+        Implementation *state = this->FindState();
+        if (!state)
+          return;
+
+        for (const auto &iter : state->order)
         {
-          if (iter.second->on)
-            iter.second->callback(std::forward<Args>(args)...);
+          EventConnection &conn = *iter.second.connection;
+          if (!conn.on)
+            continue;
+          if (!iter.second.block)
+          {
+            conn.callback(std::forward<Args>(args)...);
+            continue;
+          }
+
+          // Callbacks may connect to or disconnect the group
+          auto &callbacks = iter.second.block->callbacks;
+          for (std::size_t i = 0; i < callbacks.size() && conn.on; ++i)
+            callbacks[i](std::forward<Args>(args)...);
         }
       }
 
@@ -152,6 +328,15 @@ namespace gz
       /// We assume that this function is called from a Signal function.
       private: void Cleanup();
 
+      /// \brief Add a connection.
+      /// \param[in] _priority Priority of the connection.
+      /// \param[in] _subscriber Callback, empty for a block.
+      /// \param[in] _publicConn Connection returned to the subscriber, may
+      /// be null.
+      /// \return Id of the connection.
+      private: int Add(int _priority, const CallbackT &_subscriber,
+                       const ConnectionPtr &_publicConn);
+
       /// \brief A private helper class used in maintaining connections.
       private: class EventConnection
       {
@@ -177,10 +362,83 @@ namespace gz
         public: std::weak_ptr<Connection> publicConnection;
       };
 
+      /// \brief Callbacks of a group connected with the same priority.
+      private: class Block
+      {
+        /// \brief Group of the block, nullptr once disconnected.
+        public: ConnectionGroup *group = nullptr;
+
+        /// \brief Callbacks of the group. A deque keeps the callbacks in
+        /// place while it grows during a signal.
+        public: std::deque<std::function<T>> callbacks;
+      };
+
+      /// \brief A connection in the order in which it is called.
+      private: class Dispatch
+      {
+        /// \brief The connection.
+        public: EventConnection *connection = nullptr;
+
+        /// \brief Block of the connection, nullptr for a single callback.
+        public: Block *block = nullptr;
+      };
+
+      /// \brief Orders connections by decreasing priority, then by id.
+      private: struct DispatchOrder
+      {
+        /// \brief Compare two (priority, id) keys.
+        bool operator()(const std::pair<int, int> &_a,
+                        const std::pair<int, int> &_b) const
+        {
+          if (_a.first != _b.first)
+            return _a.first > _b.first;
+          return _a.second < _b.second;
+        }
+      };
+
       /// \def EvtConnectionMap
       /// \brief Event Connection map typedef.
       typedef std::map<int, std::unique_ptr<EventConnection>> EvtConnectionMap;
 
+      /// \brief State added after the first release of this class. It is
+      /// stored by Event, outside of the object, so that the layout of the
+      /// class and of its connections stays that of the 5.x releases.
+      private: class Implementation : public ExtraState
+      {
+        /// \brief Connections in the order they are called, indexed by
+        /// (priority, id).
+        public: std::map<std::pair<int, int>, Dispatch, DispatchOrder> order;
+
+        /// \brief Priority of each connection.
+        public: std::map<int, int> priorities;
+
+        /// \brief Blocks of group connections, indexed by id.
+        public: std::map<int, Block> blocks;
+
+        /// \brief Id of the next connection.
+        public: int nextId = 0;
+
+        /// \brief Id of the connected block of each group and priority.
+        public: std::map<std::pair<const ConnectionGroup *, int>, int>
+                groupBlocks;
+
+        /// \brief Number of blocks in connections, including disconnected
+        /// blocks which have not been removed yet.
+        public: std::size_t blockCount = 0;
+
+        /// \brief Number of callbacks in these blocks.
+        public: std::size_t blockCallbackCount = 0;
+      };
+
+      /// \brief Get the state added after the first release.
+      /// \return The state, or nullptr if nothing was connected yet.
+      private: Implementation *FindState() const;
+
+      /// \brief Get the state added after the first release, creating it
+      /// if needed.
+      /// \return The state.
+      private: Implementation &State();
+
       /// \brief Array of connection callbacks.
       private: EvtConnectionMap connections;
 
@@ -213,24 +471,101 @@ namespace gz
           publicCon->event = nullptr;
         }
       }
+      if (Implementation *state = this->FindState())
+      {
+        for (auto &block : state->blocks)
+        {
+          if (block.second.group)
+            block.second.group->Remove(this, block.first);
+        }
+      }
       this->connections.clear();
     }
 
+    /// \brief Gets the state added after the first release.
+    template<typename T, typename N>
+    typename EventT<T, N>::Implementation *EventT<T, N>::FindState() const
+    {
+      return static_cast<Implementation *>(this->Extra());
+    }
+
+    /// \brief Gets the state added after the first release, creating it
+    /// if needed.
+    template<typename T, typename N>
+    typename EventT<T, N>::Implementation &EventT<T, N>::State()
+    {
+      Implementation *state = this->FindState();
+      if (!state)
+      {
+        state = static_cast<Implementation *>(
+            this->SetExtra(std::make_unique<Implementation>()));
+      }
+      return *state;
+    }
+
     /// \brief Adds a connection.
+    /// \param[in] _priority the priority of the connection.
     /// \param[in] _subscriber the subscriber to connect.
+    /// \param[in] _publicConn the connection returned to the subscriber.
     template<typename T, typename N>
-    ConnectionPtr EventT<T, N>::Connect(const std::function<T> &_subscriber)
+    int EventT<T, N>::Add(int _priority, const std::function<T> &_subscriber,
+        const ConnectionPtr &_publicConn)
     {
-      int index = 0;
-      if (!this->connections.empty())
+      Implementation &state = this->State();
+      const int index = state.nextId++;
+      auto &conn = this->connections[index];
+      conn.reset(new EventConnection(true, _subscriber, _publicConn));
+      state.priorities[index] = _priority;
+      state.order[std::make_pair(_priority, index)].connection = conn.get();
+      return index;
+    }
+
+    /// \brief Adds a connection.
+    /// \param[in] _subscriber the subscriber to connect.
+    /// \param[in] _priority the priority of the connection.
+    template<typename T, typename N>
+    ConnectionPtr EventT<T, N>::Connect(const std::function<T> &_subscriber,
+        int _priority)
+    {
+      auto connection = ConnectionPtr(
+          new Connection(this, this->State().nextId));
+      this->Add(_priority, _subscriber, connection);
+      return connection;
+    }
+
+    /// \brief Adds a connection without a Connection object.
+    /// \param[in] _subscriber the subscriber to connect.
+    /// \param[in] _priority the priority of the connection.
+    template<typename T, typename N>
+    ConnectionToken EventT<T, N>::ConnectToken(
+        const std::function<T> &_subscriber, int _priority)
+    {
+      return ConnectionToken(this->Add(_priority, _subscriber, nullptr));
+    }
+
+    /// \brief Adds a connection to the block of a group.
+    /// \param[in] _group the group of the connection.
+    /// \param[in] _subscriber the subscriber to connect.
+    /// \param[in] _priority the priority of the connection.
+    template<typename T, typename N>
+    void EventT<T, N>::Connect(ConnectionGroup &_group,
+        const std::function<T> &_subscriber, int _priority)
+    {
+      Implementation &state = this->State();
+      const auto blockKey = std::make_pair(&_group, _priority);
+      auto blockIter = state.groupBlocks.find(blockKey);
+      if (blockIter == state.groupBlocks.end())
       {
-        auto const &iter = this->connections.rbegin();
-        index = iter->first + 1;
+        const int index = this->Add(_priority, nullptr, nullptr);
+        Block &block = state.blocks[index];
+        block.group = &_group;
+        state.order[std::make_pair(_priority, index)].block = &block;
+        _group.Add(this, index);
+        blockIter = state.groupBlocks.emplace(blockKey, index).first;
+        ++state.blockCount;
       }
-      auto connection = ConnectionPtr(new Connection(this, index));
-      this->connections[index].reset(
-          new EventConnection(true, _subscriber, connection));
-      return connection;
+      state.blocks[blockIter->second].callbacks.push_back(_subscriber);
+      ++state.blockCallbackCount;
     }
 
     /// \brief Get the number of connections.
@@ -238,7 +573,11 @@ namespace gz
     template<typename T, typename N>
     unsigned int EventT<T, N>::ConnectionCount() const
     {
-      return this->connections.size();
+      const Implementation *state = this->FindState();
+      if (!state)
+        return static_cast<unsigned int>(this->connections.size());
+      return static_cast<unsigned int>(this->connections.size() -
+          state->blockCount + state->blockCallbackCount);
     }
 
     /// \brief Removes a connection.
@@ -249,7 +588,8 @@ namespace gz
       // Find the connection
       auto const &it = this->connections.find(_id);
 
-      if (it != this->connections.end())
+      // Connections are queued for removal once
+      if (it != this->connections.end() && it->second->on)
       {
         it->second->on = false;
         // The destructor of std::function seems to crashes if the function it
@@ -260,18 +600,61 @@ namespace gz
         // it is likely that EventT::Disconnect is called before the shared
         // library is unloaded via Connection::~Connection.
         it->second->callback = nullptr;
+
+        // Callbacks of a block may be running, they are freed by Cleanup
+        Implementation *state = this->FindState();
+        if (state)
+        {
+          auto block = state->blocks.find(_id);
+          if (block != state->blocks.end() && block->second.group)
+          {
+            state->groupBlocks.erase(std::make_pair(block->second.group,
+                  state->priorities[_id]));
+            block->second.group->Remove(this, _id);
+            block->second.group = nullptr;
+          }
+        }
         this->connectionsToRemove.push_back(it);
       }
     }
 
+    /// \brief Removes a connection made with ConnectToken.
+    /// \param[in] _token the token of the connection.
+    template<typename T, typename N>
+    void EventT<T, N>::Disconnect(ConnectionToken &_token)
+    {
+      if (_token.Valid())
+        this->Disconnect(_token.Id());
+      _token = ConnectionToken();
+    }
+
     /////////////////////////////////////////////
     template<typename T, typename N>
     void EventT<T, N>::Cleanup()
     {
       std::lock_guard<std::mutex> lock(this->mutex);
+      Implementation *state = this->FindState();
       // Remove all queue connections.
       for (auto &conn : this->connectionsToRemove)
+      {
+        if (state)
+        {
+          auto block = state->blocks.find(conn->first);
+          if (block != state->blocks.end())
+          {
+            --state->blockCount;
+            state->blockCallbackCount -= block->second.callbacks.size();
+            state->blocks.erase(block);
+          }
+          auto priority = state->priorities.find(conn->first);
+          if (priority != state->priorities.end())
+          {
+            state->order.erase(std::make_pair(priority->second, conn->first));
+            state->priorities.erase(priority);
+          }
+        }
         this->connections.erase(conn);
+      }
       this->connectionsToRemove.clear();
     }
   }
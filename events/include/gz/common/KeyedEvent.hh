@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_COMMON_KEYEDEVENT_HH_
+#define GZ_COMMON_KEYEDEVENT_HH_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+#include <gz/common/Event.hh>
+
+namespace gz
+{
+  namespace common
+  {
+    /// \brief An event whose subscribers register for a key, e.g. the id of
+    /// an entity, and which is signaled for one key at a time. Signaling
+    /// a key looks it up in a hash table and only calls the subscribers of
+    /// that key, so its cost does not depend on the subscribers of other
+    /// keys.
+    ///
+    /// Each key has its own EventT, with the same priority ordering and
+    /// connection types. The event of a key is freed once all of its
+    /// subscribers are disconnected and the key is signaled.
+    ///
+    /// ~~~
+    /// gz::common::KeyedEventT<void(double), int> poseChanged;
+    /// auto conn = poseChanged.Connect(entityId, [](double _t) { ... });
+    /// poseChanged.Signal(entityId, 1.0);
+    /// ~~~
+    /// \tparam T function event callback function signature
+    /// \tparam Key type of the keys
+    /// \tparam N optional additional type to disambiguate events with same
+    ///   function signature
+    /// \tparam Hash hash function of the keys
+    template<typename T, typename Key, typename N = void,
+             typename Hash = std::hash<Key>>
+    class KeyedEventT
+    {
+      public: using CallbackT = std::function<T>;
+
+      /// \brief Constructor.
+      public: KeyedEventT()
+        : dataPtr(std::make_unique<Implementation>())
+      {
+      }
+
+      /// \brief Connect a callback to a key.
+      /// \param[in] _key Key of the subscriber.
+      /// \param[in] _subscriber Callback function.
+      /// \param[in] _priority Subscribers with a higher priority are
+      /// called first.
+      /// \return A Connection object, which will automatically disconnect
+      /// when it goes out of scope.
+      public: ConnectionPtr Connect(const Key &_key,
+                                    const CallbackT &_subscriber,
+                                    int _priority = 0)
+      {
+        return this->KeyEvent(_key).Connect(_subscriber, _priority);
+      }
+
+      /// \brief Connect a callback to a key without allocating a
+      /// Connection.
+      /// \param[in] _key Key of the subscriber.
+      /// \param[in] _subscriber Callback function.
+      /// \param[in] _priority Subscribers with a higher priority are
+      /// called first.
+      /// \return Token to pass to Disconnect along with the key.
+      public: ConnectionToken ConnectToken(const Key &_key,
+                                           const CallbackT &_subscriber,
+                                           int _priority = 0)
+      {
+        return this->KeyEvent(_key).ConnectToken(_subscriber, _priority);
+      }
+
+      /// \brief Connect a callback to a key as part of a group.
+      /// \param[in] _group Group of the connection.
+      /// \param[in] _key Key of the subscriber.
+      /// \param[in] _subscriber Callback function.
+      /// \param[in] _priority Subscribers with a higher priority are
+      /// called first.
+      public: void Connect(ConnectionGroup &_group, const Key &_key,
+                           const CallbackT &_subscriber, int _priority = 0)
+      {
+        this->KeyEvent(_key).Connect(_group, _subscriber, _priority);
+      }
+
+      /// \brief Disconnect a callback connected with ConnectToken.
+      /// \param[in] _key Key the callback was connected to.
+      /// \param[in,out] _token Token of the connection, invalid after this.
+      public: void Disconnect(const Key &_key, ConnectionToken &_token)
+      {
+        auto iter = this->dataPtr->events.find(_key);
+        if (iter != this->dataPtr->events.end())
+          iter->second->Disconnect(_token);
+      }
+
+      /// \brief Access the signal.
+      /// \param[in] _key Key to signal.
+      public: template<typename ... Args>
+              void operator()(const Key &_key, Args && ... args)
+      {
+        this->Signal(_key, std::forward<Args>(args)...);
+      }
+
+      /// \brief Signal the subscribers of a key.
+      /// \param[in] _key Key to signal.
+      public: template<typename ... Args>
+              void Signal(const Key &_key, Args && ... args)
+      {
+        auto iter = this->dataPtr->events.find(_key);
+        if (iter == this->dataPtr->events.end())
+          return;
+
+        // Subscribers may connect other keys, which can rehash the table,
+        // but the event of a key stays in place
+        EventT<T, N> *event = iter->second.get();
+        ++this->dataPtr->depth;
+        event->Signal(std::forward<Args>(args)...);
+        --this->dataPtr->depth;
+
+        // Free the event of a key without subscribers, unless it is
+        // still being signaled further up the stack
+        if (this->dataPtr->depth == 0 && event->ConnectionCount() == 0)
+          this->dataPtr->events.erase(_key);
+      }
+
+      /// \brief Get the number of connections to a key.
+      /// \param[in] _key The key.
+      /// \return Number of connections, as EventT::ConnectionCount.
+      public: unsigned int ConnectionCount(const Key &_key) const
+      {
+        auto iter = this->dataPtr->events.find(_key);
+        if (iter == this->dataPtr->events.end())
+          return 0;
+        return iter->second->ConnectionCount();
+      }
+
+      /// \brief Get the number of keys with an event.
+      /// \return Number of keys which have, or recently had, subscribers.
+      public: std::size_t KeyCount() const
+      {
+        return this->dataPtr->events.size();
+      }
+
+      /// \brief Get the event of a key, creating it if needed.
+      /// \param[in] _key The key.
+      /// \return Event of the key.
+      private: EventT<T, N> &KeyEvent(const Key &_key)
+      {
+        auto &event = this->dataPtr->events[_key];
+        if (!event)
+          event = std::make_unique<EventT<T, N>>();
+        return *event;
+      }
+
+      /// \brief Private data of KeyedEventT.
+      private: class Implementation
+      {
+        /// \brief Event of each key.
+        public: std::unordered_map<Key, std::unique_ptr<EventT<T, N>>, Hash>
+                events;
+
+        /// \brief Number of signals in progress.
+        public: unsigned int depth = 0;
+      };
+
+      /// \brief Private data pointer, which keeps the layout of the class
+      /// when its state changes.
+      private: std::unique_ptr<Implementation> dataPtr;
+    };
+  }
+}
+#endif
@@ -15,6 +15,15 @@
  *
  */
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gz/utils/NeverDestroyed.hh>
+
 #include "gz/common/Console.hh"
 #include "gz/common/Event.hh"
 #include "gz/common/Util.hh"
@@ -22,6 +31,29 @@
 using namespace gz;
 using namespace common;
 
+namespace
+{
+  /// \brief Extra state of all the events which have one.
+  struct ExtraStates
+  {
+    /// \brief Protects states.
+    std::mutex mutex;
+
+    /// \brief State of each event.
+    std::unordered_map<const Event *, std::unique_ptr<Event::ExtraState>>
+        states;
+  };
+
+  /// \brief Get the extra states. They are never destroyed, as events may
+  /// be destroyed during static destruction.
+  /// \return The extra states.
+  ExtraStates &extraStates()
+  {
+    static gz::utils::NeverDestroyed<ExtraStates> states;
+    return states.Access();
+  }
+}
+
 //////////////////////////////////////////////////
 Event::Event()
   : signaled(false)
@@ -31,6 +63,17 @@ Event::Event()
 //////////////////////////////////////////////////
 Event::~Event()
 {
+  // Destroy the state outside of the lock, it may hold callbacks
+  std::unique_ptr<ExtraState> state;
+  auto &extra = extraStates();
+  {
+    std::lock_guard<std::mutex> lock(extra.mutex);
+    auto iter = extra.states.find(this);
+    if (iter == extra.states.end())
+      return;
+    state = std::move(iter->second);
+    extra.states.erase(iter);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -45,6 +88,31 @@ void Event::SetSignaled(bool _sig)
   this->signaled = _sig;
 }
 
+//////////////////////////////////////////////////
+Event::ExtraState::~ExtraState() = default;
+
+//////////////////////////////////////////////////
+Event::ExtraState *Event::Extra() const
+{
+  auto &extra = extraStates();
+  std::lock_guard<std::mutex> lock(extra.mutex);
+  auto iter = extra.states.find(this);
+  return iter == extra.states.end() ? nullptr : iter->second.get();
+}
+
+//////////////////////////////////////////////////
+Event::ExtraState *Event::SetExtra(std::unique_ptr<ExtraState> _state)
+{
+  // The previous state is destroyed outside of the lock
+  auto &extra = extraStates();
+  ExtraState *result = _state.get();
+  {
+    std::lock_guard<std::mutex> lock(extra.mutex);
+    extra.states[this].swap(_state);
+  }
+  return result;
+}
+
 //////////////////////////////////////////////////
 Connection::Connection(Event *_e, int _i)
 : event(_e), id(_i)
@@ -76,3 +144,52 @@ int Connection::Id() const
 {
   return this->id;
 }
+
+//////////////////////////////////////////////////
+ConnectionGroup::ConnectionGroup() = default;
+
+//////////////////////////////////////////////////
+ConnectionGroup::~ConnectionGroup()
+{
+  this->Disconnect();
+}
+
+//////////////////////////////////////////////////
+void ConnectionGroup::Disconnect()
+{
+  // Events call Remove while disconnecting, release the lock first
+  std::vector<std::pair<Event *, int>> toDisconnect;
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    toDisconnect.swap(this->blocks);
+  }
+  for (const auto &block : toDisconnect)
+    block.first->Disconnect(block.second);
+}
+
+//////////////////////////////////////////////////
+bool ConnectionGroup::Empty() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->blocks.empty();
+}
+
+//////////////////////////////////////////////////
+void ConnectionGroup::Add(Event *_event, int _id)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->blocks.emplace_back(_event, _id);
+}
+
+//////////////////////////////////////////////////
+void ConnectionGroup::Remove(Event *_event, int _id)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  auto iter = std::find(this->blocks.begin(), this->blocks.end(),
+      std::make_pair(_event, _id));
+  if (iter != this->blocks.end())
+  {
+    *iter = this->blocks.back();
+    this->blocks.pop_back();
+  }
+}
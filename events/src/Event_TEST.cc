@@ -20,6 +20,11 @@
 #include "gz/common/testing/AutoLogFixture.hh"
 
 #include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <gz/common/Event.hh>
 #include <gz/common/Util.hh>
 using namespace gz;
@@ -297,3 +302,213 @@ TEST_F(EventTest, DestructionOrder)
   conn.reset();
   SUCCEED();
 }
+
+/////////////////////////////////////////////////
+TEST_F(EventTest, Token)
+{
+  int count = 0;
+  common::EventT<void(int)> evt;
+  common::ConnectionToken invalid;
+  EXPECT_FALSE(invalid.Valid());
+
+  common::ConnectionToken token = evt.ConnectToken(
+      [&count](int _value) { count += _value; });
+  EXPECT_TRUE(token.Valid());
+  common::ConnectionPtr conn = evt.Connect([&count](int) { ++count; });
+  EXPECT_EQ(2u, evt.ConnectionCount());
+  EXPECT_NE(token.Id(), conn->Id());
+
+  evt(10);
+  EXPECT_EQ(11, count);
+
+  evt.Disconnect(token);
+  EXPECT_FALSE(token.Valid());
+  evt.Disconnect(token);
+  evt(10);
+  EXPECT_EQ(12, count);
+  EXPECT_EQ(1u, evt.ConnectionCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(EventTest, Group)
+{
+  int first = 0;
+  int second = 0;
+  common::EventT<void()> evt;
+  common::EventT<void(int)> other;
+  common::ConnectionPtr conn = evt.Connect([&first]() { first += 1000; });
+
+  common::ConnectionGroup group;
+  EXPECT_TRUE(group.Empty());
+  for (int i = 0; i < 1000; ++i)
+  {
+    evt.Connect(group, [&first]() { ++first; });
+    other.Connect(group, [&second](int _value) { second += _value; });
+  }
+  EXPECT_FALSE(group.Empty());
+  EXPECT_EQ(1001u, evt.ConnectionCount());
+  EXPECT_EQ(1000u, other.ConnectionCount());
+
+  evt();
+  other(2);
+  EXPECT_EQ(2000, first);
+  EXPECT_EQ(2000, second);
+
+  group.Disconnect();
+  EXPECT_TRUE(group.Empty());
+  evt();
+  other(2);
+  EXPECT_EQ(3000, first);
+  EXPECT_EQ(2000, second);
+  EXPECT_EQ(1u, evt.ConnectionCount());
+  EXPECT_EQ(0u, other.ConnectionCount());
+
+  // The group can be reused, and is disconnected when destroyed
+  {
+    common::ConnectionGroup scoped;
+    evt.Connect(scoped, [&second]() { ++second; });
+    evt();
+    EXPECT_EQ(2001, second);
+  }
+  evt();
+  EXPECT_EQ(2001, second);
+  EXPECT_EQ(5000, first);
+}
+
+/////////////////////////////////////////////////
+TEST_F(EventTest, GroupDisconnectInCallback)
+{
+  int count = 0;
+  common::EventT<void()> evt;
+  common::ConnectionGroup group;
+  evt.Connect(group, [&]()
+  {
+    ++count;
+    group.Disconnect();
+  });
+  evt.Connect(group, [&count]() { ++count; });
+
+  // The rest of the group is skipped
+  evt();
+  EXPECT_EQ(1, count);
+  evt();
+  EXPECT_EQ(1, count);
+
+  // Connecting to the group while it is signaled
+  evt.Connect(group, [&]()
+  {
+    ++count;
+    if (count < 5)
+      evt.Connect(group, [&count]() { ++count; });
+  });
+  evt();
+  EXPECT_EQ(3, count);
+}
+
+/////////////////////////////////////////////////
+TEST_F(EventTest, GroupDestructionOrder)
+{
+  // Event destroyed before the group
+  common::ConnectionGroup group;
+  {
+    common::EventT<void()> evt;
+    evt.Connect(group, []() {});
+    EXPECT_FALSE(group.Empty());
+  }
+  EXPECT_TRUE(group.Empty());
+  group.Disconnect();
+
+  // Group destroyed before the event
+  common::EventT<void()> evt;
+  {
+    common::ConnectionGroup scoped;
+    evt.Connect(scoped, []() {});
+  }
+  evt();
+  EXPECT_EQ(0u, evt.ConnectionCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(EventTest, Priority)
+{
+  common::EventT<void()> evt;
+  std::string order;
+  auto c1 = evt.Connect([&order]() { order += "a"; });
+  auto c2 = evt.Connect([&order]() { order += "b"; }, 10);
+  auto t3 = evt.ConnectToken([&order]() { order += "c"; }, -5);
+  auto c4 = evt.Connect([&order]() { order += "d"; }, 10);
+  common::ConnectionGroup group;
+  evt.Connect(group, [&order]() { order += "e"; }, -5);
+  evt.Connect(group, [&order]() { order += "f"; });
+  evt.Connect(group, [&order]() { order += "g"; }, -5);
+  EXPECT_EQ(7u, evt.ConnectionCount());
+
+  // Higher priority first, then in connection order
+  evt();
+  EXPECT_EQ("bdafceg", order);
+
+  // Ids are not reused after a disconnection
+  c4.reset();
+  evt.Disconnect(t3);
+  auto c5 = evt.Connect([&order]() { order += "h"; }, 10);
+  order.clear();
+  evt();
+  EXPECT_EQ("bhafeg", order);
+  EXPECT_NE(c2->Id(), c5->Id());
+
+  group.Disconnect();
+  order.clear();
+  evt();
+  EXPECT_EQ("bha", order);
+  EXPECT_EQ(3u, evt.ConnectionCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(EventTest, GroupPriorityPosition)
+{
+  common::EventT<void()> evt;
+  std::string order;
+  common::ConnectionGroup group;
+  evt.Connect(group, [&order]() { order += "a"; });
+  auto c2 = evt.Connect([&order]() { order += "b"; });
+  evt.Connect(group, [&order]() { order += "c"; });
+  evt.Connect(group, [&order]() { order += "d"; }, 1);
+
+  // The callbacks of a group run where its first one was connected
+  evt();
+  EXPECT_EQ("dacb", order);
+}
+
+/////////////////////////////////////////////////
+/// \brief Layout of EventT in the first 5.x releases.
+class EventLayout5 : public common::Event
+{
+  public: void Disconnect(int) override {}
+  public: std::map<int, std::unique_ptr<int>> connections;
+  public: std::mutex mutex;
+  public: std::list<std::map<int, std::unique_ptr<int>>::const_iterator>
+          connectionsToRemove;
+};
+
+/////////////////////////////////////////////////
+TEST_F(EventTest, Layout)
+{
+  // The state of priorities and groups is stored outside of the event
+  EXPECT_EQ(sizeof(EventLayout5), sizeof(common::EventT<void()>));
+  EXPECT_EQ(alignof(EventLayout5), alignof(common::EventT<void()>));
+
+  // It is freed with the event, and a new event at the same address
+  // starts without connections
+  for (int i = 0; i < 2; ++i)
+  {
+    auto event = std::make_unique<common::EventT<void()>>();
+    EXPECT_EQ(0u, event->ConnectionCount());
+    int count = 0;
+    auto conn = event->Connect([&count]() { ++count; }, 1);
+    common::ConnectionGroup group;
+    event->Connect(group, [&count]() { ++count; });
+    event->Signal();
+    EXPECT_EQ(2, count);
+    EXPECT_EQ(2u, event->ConnectionCount());
+  }
+}
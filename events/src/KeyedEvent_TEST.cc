@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "gz/common/KeyedEvent.hh"
+
+#include "gz/common/testing/AutoLogFixture.hh"
+
+using namespace gz;
+
+class KeyedEventTest : public common::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(KeyedEventTest, Signal)
+{
+  common::KeyedEventT<void(int), std::string> evt;
+  std::vector<std::string> calls;
+  auto c1 = evt.Connect("box", [&calls](int _v)
+      { calls.push_back("box" + std::to_string(_v)); });
+  auto c2 = evt.Connect("sphere", [&calls](int _v)
+      { calls.push_back("sphere" + std::to_string(_v)); });
+  auto c3 = evt.Connect("box", [&calls](int _v)
+      { calls.push_back("first" + std::to_string(_v)); }, 1);
+  EXPECT_EQ(2u, evt.KeyCount());
+  EXPECT_EQ(2u, evt.ConnectionCount("box"));
+  EXPECT_EQ(0u, evt.ConnectionCount("cone"));
+
+  // Only the subscribers of the key are called, by priority
+  evt.Signal("box", 1);
+  ASSERT_EQ(2u, calls.size());
+  EXPECT_EQ("first1", calls[0]);
+  EXPECT_EQ("box1", calls[1]);
+
+  calls.clear();
+  evt("sphere", 2);
+  evt("cone", 3);
+  ASSERT_EQ(1u, calls.size());
+  EXPECT_EQ("sphere2", calls[0]);
+
+  // The event of a key is freed when it has no subscribers
+  c2.reset();
+  EXPECT_EQ(2u, evt.KeyCount());
+  calls.clear();
+  evt("sphere", 4);
+  EXPECT_TRUE(calls.empty());
+  EXPECT_EQ(1u, evt.KeyCount());
+
+  // And created again on connection
+  c2 = evt.Connect("sphere", [&calls](int _v)
+      { calls.push_back("sphere" + std::to_string(_v)); });
+  evt("sphere", 5);
+  ASSERT_EQ(1u, calls.size());
+  EXPECT_EQ("sphere5", calls[0]);
+}
+
+/////////////////////////////////////////////////
+TEST_F(KeyedEventTest, TokenAndGroup)
+{
+  common::KeyedEventT<void(), int> evt;
+  int count = 0;
+  auto token = evt.ConnectToken(1, [&count]() { ++count; });
+  common::ConnectionGroup group;
+  for (int key = 0; key < 100; ++key)
+    evt.Connect(group, key, [&count]() { count += 10; });
+  EXPECT_EQ(100u, evt.KeyCount());
+
+  evt(1);
+  EXPECT_EQ(11, count);
+
+  evt.Disconnect(1, token);
+  EXPECT_FALSE(token.Valid());
+  evt(1);
+  EXPECT_EQ(21, count);
+
+  // Unknown key
+  token = evt.ConnectToken(1, [&count]() { ++count; });
+  common::ConnectionToken other = token;
+  evt.Disconnect(500, other);
+  evt(1);
+  EXPECT_EQ(32, count);
+  evt.Disconnect(1, token);
+
+  group.Disconnect();
+  EXPECT_TRUE(group.Empty());
+  for (int key = 0; key < 100; ++key)
+    evt(key);
+  EXPECT_EQ(32, count);
+  EXPECT_EQ(0u, evt.KeyCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(KeyedEventTest, SignalInCallback)
+{
+  common::KeyedEventT<void(int), int> evt;
+  std::vector<common::ConnectionPtr> connections;
+  int count = 0;
+
+  // A subscriber which connects other keys, enough to rehash the table,
+  // and signals its key again
+  connections.push_back(evt.Connect(0, [&](int _depth)
+  {
+    ++count;
+    for (int key = 1; key < 50; ++key)
+      connections.push_back(evt.Connect(key, [&count](int) { ++count; }));
+    if (_depth == 0)
+      evt(0, _depth + 1);
+  }));
+  evt(0, 0);
+  EXPECT_EQ(2, count);
+  EXPECT_EQ(50u, evt.KeyCount());
+  evt(7, 0);
+  EXPECT_EQ(4, count);
+
+  // A subscriber which disconnects itself
+  connections.clear();
+  connections.push_back(evt.Connect(0, [&](int)
+  {
+    ++count;
+    connections[0].reset();
+  }));
+  evt(0, 0);
+  evt(0, 0);
+  EXPECT_EQ(5, count);
+
+  // Keys which are not signaled again keep their empty event
+  EXPECT_EQ(49u, evt.KeyCount());
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cstring>
+#include <iostream>
+
+#include <gz/common/BinaryLog.hh>
+
+// Render a binary log written with gz::common::BinaryLog as text or JSON.
+//
+// Usage: binary_log_decode <file> [--json]
+int main(int argc, char **argv)
+{
+  if (argc < 2 || argc > 3 ||
+      (argc == 3 && std::strcmp(argv[2], "--json") != 0))
+  {
+    std::cerr << "Usage: " << argv[0] << " <file> [--json]" << std::endl;
+    return 1;
+  }
+
+  auto format = argc == 3 ? gz::common::BinaryLogFormat::JSON :
+    gz::common::BinaryLogFormat::TEXT;
+
+  return gz::common::decodeBinaryLog(argv[1], std::cout, format) ? 0 : 1;
+}
@@ -31,6 +31,45 @@ namespace gz
     /// \brief Class used to load mesh files using the assimp lodaer
     class GZ_COMMON_GRAPHICS_VISIBLE AssimpLoader : public MeshLoader
     {
+      /// \brief How textures embedded in a mesh file, e.g. in GLB files,
+      /// are decoded.
+      public: enum class TextureDecoding
+      {
+        /// \brief Decode while loading the mesh.
+        IMMEDIATE,
+
+        /// \brief Keep the compressed data and decode on first access to
+        /// the image, see Image::SetFromCompressedDataDeferred. Loads that
+        /// only use geometry never decode the textures.
+        DEFERRED,
+
+        /// \brief Like DEFERRED, and start decoding on background threads
+        /// once the mesh is loaded.
+        BACKGROUND
+      };
+
+      /// \brief Sets of assimp post-processing steps run on imported
+      /// scenes. Triangulation is always run, the loader needs triangles.
+      public: enum class PostProcessing
+      {
+        /// \brief Join identical vertices, remove redundant materials,
+        /// sort primitives by type, generate missing normals and populate
+        /// armature data.
+        DEFAULT,
+
+        /// \brief Skip joining identical vertices and populating armature
+        /// data. Suited to trusted, well-formed assets, e.g. glTF files,
+        /// whose vertices are already shared.
+        FAST,
+
+        /// \brief DEFAULT, plus validation of the imported data, removal
+        /// of invalid data and vertex cache optimization.
+        QUALITY,
+
+        /// \brief Steps set with SetPostProcessFlags.
+        CUSTOM
+      };
+
       /// \brief Constructor
       public: AssimpLoader();
 
@@ -42,6 +81,41 @@ namespace gz
       /// \return Pointer to a new Mesh
       public: virtual Mesh *Load(const std::string &_filename) override;
 
+      /// \brief Load a mesh, skipping the parts not selected by _options.
+      /// Normals are not generated when they are skipped.
+      /// \param[in] _filename Mesh file to load
+      /// \param[in] _options parts of the mesh to load
+      /// \return Pointer to a new Mesh
+      public: Mesh *Load(const std::string &_filename,
+                         const MeshLoadOptions &_options);
+
+      /// \brief Set how embedded textures are decoded by subsequent loads.
+      /// \param[in] _mode Decoding mode. Default is DEFERRED.
+      public: void SetEmbeddedTextureDecoding(TextureDecoding _mode);
+
+      /// \brief Get how embedded textures are decoded.
+      /// \return Decoding mode.
+      public: TextureDecoding EmbeddedTextureDecoding() const;
+
+      /// \brief Set the post-processing steps run by subsequent loads.
+      /// \param[in] _profile Post-processing profile. Default is DEFAULT.
+      public: void SetPostProcessProfile(PostProcessing _profile);
+
+      /// \brief Get the post-processing profile.
+      /// \return Post-processing profile.
+      public: PostProcessing PostProcessProfile() const;
+
+      /// \brief Set custom post-processing steps and switch to the CUSTOM
+      /// profile.
+      /// \param[in] _flags Bitwise OR of assimp aiPostProcessSteps values.
+      public: void SetPostProcessFlags(unsigned int _flags);
+
+      /// \brief Get the post-processing steps of the current profile. Loads
+      /// with MeshLoadOptions also drop the steps producing data that is
+      /// skipped.
+      /// \return Bitwise OR of assimp aiPostProcessSteps values.
+      public: unsigned int PostProcessFlags() const;
+
       /// \internal
       /// \brief Pointer to private data.
       GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <gz/math/Pose3.hh>
 #include <gz/common/graphics/Export.hh>
@@ -45,6 +46,15 @@ namespace gz
       /// \return A pointer to a new Skeleton
       public: std::unique_ptr<Skeleton> Load(
                   const std::string &_filename, const double _scale);
+
+      /// \brief Load several BVH files, in parallel.
+      /// \param[in] _filenames BVH files to load
+      /// \param[in] _scale Scaling factor to apply to the skeletons
+      /// \return One skeleton per file, in the same order. Files which
+      /// could not be loaded get a nullptr.
+      public: std::vector<std::unique_ptr<Skeleton>> Load(
+                  const std::vector<std::string> &_filenames,
+                  const double _scale);
     };
   }
 }
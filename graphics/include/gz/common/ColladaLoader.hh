@@ -43,6 +43,13 @@ namespace gz
       /// \return Pointer to a new Mesh
       public: virtual Mesh *Load(const std::string &_filename);
 
+      /// \brief Load a mesh, skipping the parts not selected by _options
+      /// \param[in] _filename Collada file to load
+      /// \param[in] _options parts of the mesh to load
+      /// \return Pointer to a new Mesh
+      public: Mesh *Load(const std::string &_filename,
+                         const MeshLoadOptions &_options);
+
       /// \internal
       /// \brief Pointer to private data.
       GZ_UTILS_IMPL_PTR(dataPtr)
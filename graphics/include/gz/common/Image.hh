@@ -137,6 +137,26 @@ namespace gz
                                          unsigned int _size,
                                          Image::PixelFormatType _format);
 
+      /// \brief Set the image from compressed (i.e. png) data without
+      /// decoding it. The data is decoded on first access to the image, or
+      /// when Decode is called, which may happen on another thread.
+      /// \param[in] _data Compressed image data, owned by the image.
+      /// \param[in] _format COMPRESSED_PNG or COMPRESSED_JPEG
+      /// \return False if the format is not supported.
+      public: bool SetFromCompressedDataDeferred(
+                  std::vector<unsigned char> _data,
+                  Image::PixelFormatType _format);
+
+      /// \brief Decode data set with SetFromCompressedDataDeferred, if not
+      /// done yet. Safe to call from several threads.
+      public: void Decode() const;
+
+      /// \brief Check whether the image holds compressed data that was not
+      /// decoded yet.
+      /// \return False if the image was set with
+      /// SetFromCompressedDataDeferred and not accessed since.
+      public: bool Decoded() const;
+
       /// \brief Get the image as a data array
       /// \deprecated Use the function returning std::vector instead
       /// \param[out] _data Pointer to a NULL array of char.
@@ -148,6 +168,13 @@ namespace gz
       /// \return The image data
       public: std::vector<unsigned char> Data() const;
 
+      /// \brief Get the image as a data array
+      /// The existing capacity of _data is reused, so calling this every
+      /// frame with the same vector, or one taken from a BufferPool, does
+      /// not allocate.
+      /// \param[out] _data Resized to hold the image data.
+      public: void Data(std::vector<unsigned char> &_data) const;
+
       /// \brief Get only the RGB data from the image. This will drop the
       /// alpha channel if one is present.
       /// \deprecated Use the function returning std::vector instead
@@ -161,6 +188,14 @@ namespace gz
       /// \return The image RGB data
       public: std::vector<unsigned char> RGBData() const;
 
+      /// \brief Get only the RGB data from the image. This will drop the
+      /// alpha channel if one is present.
+      /// The existing capacity of _data is reused, so calling this every
+      /// frame with the same vector, or one taken from a BufferPool, does
+      /// not allocate.
+      /// \param[out] _data Resized to hold the image RGB data.
+      public: void RGBData(std::vector<unsigned char> &_data) const;
+
       /// \brief Get the RGBA data from the image. This will add an alpha
       /// channel if one is not present.
       /// \deprecated Use the function returning std::vector instead
@@ -174,6 +209,14 @@ namespace gz
       /// \return The image RGBA data
       public: std::vector<unsigned char> RGBAData() const;
 
+      /// \brief Get the RGBA data from the image. This will add an alpha
+      /// channel if one is not present.
+      /// The existing capacity of _data is reused, so calling this every
+      /// frame with the same vector, or one taken from a BufferPool, does
+      /// not allocate.
+      /// \param[out] _data Resized to hold the image RGBA data.
+      public: void RGBAData(std::vector<unsigned char> &_data) const;
+
       /// \brief Get the width
       /// \return The image width
       public: unsigned int Width() const;
@@ -222,6 +265,59 @@ namespace gz
       /// \return true if image has a bitmap
       public: bool Valid() const;
 
+      /// \brief Get channels of the image as separate single channel
+      /// (L_INT8) images. The pixels are read once and all requested
+      /// channels are written in the same pass.
+      /// \param[in] _channels Channel indices in RGBA order, i.e. 0 is red
+      /// and 3 is alpha.
+      /// \return One image per requested channel, in the same order. Empty
+      /// if the image is not valid or a channel index is out of range.
+      public: std::vector<std::shared_ptr<Image>> ChannelImages(
+                  const std::vector<unsigned int> &_channels) const;
+
+      /// \brief Copy channels of 8 bit interleaved pixel data into separate
+      /// single channel planes, in a single pass over the source.
+      /// \param[in] _src Source pixels, _srcChannels bytes per pixel, rows
+      /// tightly packed.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \param[in] _srcChannels Number of channels in _src, 1 to 4.
+      /// \param[in] _channels Source channel to copy into each plane.
+      /// \param[out] _dst One buffer of _width * _height bytes per entry of
+      /// _channels.
+      /// \param[in] _flipVertical True to write the rows bottom up.
+      /// \return False if the arguments are invalid.
+      public: static bool ExtractChannels(const unsigned char *_src,
+                  unsigned int _width, unsigned int _height,
+                  unsigned int _srcChannels,
+                  const std::vector<unsigned int> &_channels,
+                  const std::vector<unsigned char *> &_dst,
+                  bool _flipVertical = false);
+
+      /// \brief Reorder, drop or add channels of 8 bit interleaved pixel
+      /// data in a single pass. For example {2, 1, 0} converts RGB(A) to BGR
+      /// and {0, 1, 2, -1} adds an opaque alpha channel.
+      /// \param[in] _src Source pixels, _srcChannels bytes per pixel, rows
+      /// tightly packed.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \param[in] _srcChannels Number of channels in _src, 1 to 4.
+      /// \param[in] _channelMap Source channel of each destination channel,
+      /// or -1 to write _fill. Its size, 1 to 4, is the number of channels
+      /// of _dst.
+      /// \param[out] _dst Destination of
+      /// _width * _height * _channelMap.size() bytes. Must not overlap _src.
+      /// \param[in] _flipVertical True to write the rows bottom up.
+      /// \param[in] _fill Value of channels mapped to -1.
+      /// \return False if the arguments are invalid.
+      public: static bool SwizzleChannels(const unsigned char *_src,
+                  unsigned int _width, unsigned int _height,
+                  unsigned int _srcChannels,
+                  const std::vector<int> &_channelMap,
+                  unsigned char *_dst,
+                  bool _flipVertical = false,
+                  unsigned char _fill = 255);
+
       /// \brief Convert a single channel image data buffer into an RGB image.
       /// During the conversion, the input image data are normalized to 8 bit
       /// values i.e. [0, 255]. Optionally, specify min and max values to use
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_COMMON_MASSPROPERTIES_HH_
+#define GZ_COMMON_MASSPROPERTIES_HH_
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include <gz/math/Inertial.hh>
+#include <gz/math/Vector3.hh>
+
+#include <gz/utils/ImplPtr.hh>
+
+#include <gz/common/graphics/Export.hh>
+
+namespace gz
+{
+  namespace common
+  {
+    class Mesh;
+    class SubMesh;
+
+    /// \class MassProperties MassProperties.hh gz/common/MassProperties.hh
+    /// \brief Accumulates the volume integrals of closed triangle meshes,
+    /// from which the signed volume, center of mass and inertia tensor are
+    /// computed in a single pass over the triangles.
+    ///
+    /// This uses the polyhedral mass properties algorithm from
+    /// "Polyhedral Mass Properties (Revisited)" by David Eberly. Unlike
+    /// Mesh::Volume, contributions are signed, so the result is correct for
+    /// non-convex meshes as long as the mesh is closed and its triangles
+    /// are consistently wound. Meshes wound clockwise, seen from outside,
+    /// have a negative signed volume; their mass properties are computed
+    /// as if they were wound the other way.
+    class GZ_COMMON_GRAPHICS_VISIBLE MassProperties
+    {
+      /// \brief Constructor, all integrals are zero.
+      public: MassProperties();
+
+      /// \brief Add the triangles of an indexed triangle list. Large lists
+      /// are split across threads.
+      /// \param[in] _vertices Vertex positions.
+      /// \param[in] _indices Vertex indices, three per triangle. All must
+      /// be valid indices in _vertices.
+      /// \param[in] _triangleCount Number of triangles.
+      public: void AddTriangles(const math::Vector3d *_vertices,
+                                const unsigned int *_indices,
+                                std::size_t _triangleCount);
+
+      /// \brief Add the triangles of a submesh.
+      /// \param[in] _subMesh Submesh to add.
+      /// \return False if the submesh is not made of triangles or has
+      /// invalid indices, in which case nothing is added.
+      public: bool AddSubMesh(const SubMesh &_subMesh);
+
+      /// \brief Add the triangles of all the submeshes of a mesh.
+      /// \param[in] _mesh Mesh to add.
+      /// \return False if any submesh could not be added.
+      public: bool AddMesh(const Mesh &_mesh);
+
+      /// \brief Add the integrals of another accumulator.
+      /// \param[in] _other Accumulator to add.
+      /// \return Reference to this accumulator.
+      public: MassProperties &operator+=(const MassProperties &_other);
+
+      /// \brief Get the signed volume of the triangles added so far.
+      /// \return Signed volume.
+      public: double SignedVolume() const;
+
+      /// \brief Get the center of mass, assuming a uniform density.
+      /// \return Center of mass, or zero if the volume is zero.
+      public: math::Vector3d CenterOfMass() const;
+
+      /// \brief Get the mass, center of mass and inertia tensor about the
+      /// center of mass.
+      /// \param[in] _density Density of the material, e.g.
+      /// math::Material::Density.
+      /// \return The inertial, or nullopt if the volume is zero or the
+      /// density is not positive.
+      public: std::optional<math::Inertiald> Inertial(double _density) const;
+
+      /// \brief Compute the mass properties of many meshes in parallel.
+      /// \param[in] _meshes Meshes to process, null entries are skipped.
+      /// \param[in] _density Density of the material.
+      /// \return One result per mesh, in the same order, see Inertial. The
+      /// result is nullopt for null meshes and for meshes with a submesh
+      /// that AddSubMesh would reject.
+      public: static std::vector<std::optional<math::Inertiald>> Compute(
+                  const std::vector<const Mesh *> &_meshes, double _density);
+
+      /// \brief Private data pointer.
+      GZ_UTILS_IMPL_PTR(dataPtr)
+    };
+  }
+}
+#endif
@@ -17,6 +17,8 @@
 #ifndef GZ_COMMON_MESH_HH_
 #define GZ_COMMON_MESH_HH_
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -136,11 +138,38 @@ namespace gz
       public: std::weak_ptr<SubMesh> SubMeshByName(
                   const std::string &_name) const;
 
-      /// \brief Put all the data into flat arrays
+      /// \brief Put all the data into flat arrays. The arrays are
+      /// reallocated on every call and vertices are rounded to float
+      /// precision.
       /// \param[out] _vertArr the vertex array
       /// \param[out] _indArr the index array
+      /// \sa FillVertices, FillIndices
       public: void FillArrays(double **_vertArr, int **_indArr) const;
 
+      /// \brief Copy the vertex positions of all submeshes, in order, into
+      /// a caller provided buffer, as consecutive x, y, z values. Large
+      /// meshes are copied in parallel.
+      /// \param[out] _vertices Buffer of at least 3 * VertexCount() values.
+      /// \param[in] _size Number of values _vertices can hold.
+      /// \return False if the buffer is too small, nothing is written then.
+      public: bool FillVertices(float *_vertices, std::size_t _size) const;
+
+      /// \copydoc FillVertices(float *, std::size_t) const
+      public: bool FillVertices(double *_vertices, std::size_t _size) const;
+
+      /// \brief Copy the indices of all submeshes, in order, into a caller
+      /// provided buffer. Indices are offset to match the vertex order of
+      /// FillVertices. Large meshes are copied in parallel.
+      /// \param[out] _indices Buffer of at least IndexCount() values.
+      /// \param[in] _size Number of values _indices can hold.
+      /// \return False if the buffer is too small or an index does not fit
+      /// in the index type. Part of the buffer may have been written in the
+      /// latter case.
+      public: bool FillIndices(uint16_t *_indices, std::size_t _size) const;
+
+      /// \copydoc FillIndices(uint16_t *, std::size_t) const
+      public: bool FillIndices(uint32_t *_indices, std::size_t _size) const;
+
       /// \brief Recalculate all the normals of each face defined by three
       /// indices.
       public: void RecalculateNormals();
@@ -197,6 +226,9 @@ namespace gz
       /// representation" by Cha Zhang and Tsuhan Chen. Link:
       /// http://chenlab.ece.cornell.edu/Publication/Cha/icip01_Cha.pdf.
       /// The formula does not check for a closed (water tight) mesh.
+      /// Each triangle contributes a positive volume, which is only correct
+      /// for convex meshes; see MassProperties for signed volume, center of
+      /// mass and inertia.
       ///
       /// \return The mesh's volume. The volume can be zero if
       /// the primitive type of the submeshes is not TRIANGLES,
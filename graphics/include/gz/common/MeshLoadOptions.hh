@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_COMMON_MESHLOADOPTIONS_HH_
+#define GZ_COMMON_MESHLOADOPTIONS_HH_
+
+#include <string>
+
+#include <gz/utils/ImplPtr.hh>
+
+#include <gz/common/graphics/Export.hh>
+
+namespace gz
+{
+  namespace common
+  {
+    /// \class MeshLoadOptions MeshLoadOptions.hh gz/common/MeshLoadOptions.hh
+    /// \brief Selects the parts of a mesh file that are loaded. Vertex
+    /// positions and indices are always loaded. By default everything else
+    /// is loaded too; processes that only need geometry, e.g. for physics,
+    /// can skip the rest to load faster and use less memory.
+    class GZ_COMMON_GRAPHICS_VISIBLE MeshLoadOptions
+    {
+      /// \brief Default constructor, loads everything.
+      public: MeshLoadOptions();
+
+      /// \brief Options that only load vertex positions and indices.
+      /// \return The options.
+      public: static MeshLoadOptions GeometryOnly();
+
+      /// \brief Equality operator.
+      /// \param[in] _options Options to compare.
+      /// \return True if both select the same parts.
+      public: bool operator==(const MeshLoadOptions &_options) const;
+
+      /// \brief Inequality operator.
+      /// \param[in] _options Options to compare.
+      /// \return True if the options select different parts.
+      public: bool operator!=(const MeshLoadOptions &_options) const;
+
+      /// \brief Whether vertex normals are loaded.
+      /// \return True if normals are loaded.
+      public: bool Normals() const;
+
+      /// \brief Set whether vertex normals are loaded. Loaders do not
+      /// generate missing normals when this is false.
+      /// \param[in] _load True to load normals.
+      public: void SetNormals(bool _load);
+
+      /// \brief Whether texture coordinates, of all sets, are loaded.
+      /// \return True if texture coordinates are loaded.
+      public: bool TexCoords() const;
+
+      /// \brief Set whether texture coordinates, of all sets, are loaded.
+      /// \param[in] _load True to load texture coordinates.
+      public: void SetTexCoords(bool _load);
+
+      /// \brief Whether materials are loaded.
+      /// \return True if materials are loaded.
+      public: bool Materials() const;
+
+      /// \brief Set whether materials are loaded. Submeshes have no
+      /// material index when this is false.
+      /// \param[in] _load True to load materials.
+      public: void SetMaterials(bool _load);
+
+      /// \brief Whether the textures of materials are loaded.
+      /// \return True if textures are loaded.
+      public: bool Textures() const;
+
+      /// \brief Set whether the textures of materials are loaded. When false,
+      /// materials keep their colors and parameters but reference no
+      /// texture, and embedded images are not decoded.
+      /// \param[in] _load True to load textures.
+      public: void SetTextures(bool _load);
+
+      /// \brief Whether the skeleton and skinning weights are loaded.
+      /// \return True if the skeleton is loaded.
+      public: bool Skeleton() const;
+
+      /// \brief Set whether the skeleton and skinning weights are loaded.
+      /// Skeletal animations are skipped too when this is false.
+      /// \param[in] _load True to load the skeleton.
+      public: void SetSkeleton(bool _load);
+
+      /// \brief Whether skeletal animations are loaded.
+      /// \return True if animations are loaded.
+      public: bool Animations() const;
+
+      /// \brief Set whether skeletal animations are loaded.
+      /// \param[in] _load True to load animations.
+      public: void SetAnimations(bool _load);
+
+      /// \brief Whether these options load everything, i.e. equal the
+      /// default options.
+      /// \return True if nothing is skipped.
+      public: bool LoadsEverything() const;
+
+      /// \brief Get a string identifying the selected parts, used to cache
+      /// meshes loaded with different options separately.
+      /// \return Empty string if everything is loaded, otherwise a string
+      /// that differs for each combination of options.
+      public: std::string CacheKey() const;
+
+      /// \brief Private data pointer.
+      GZ_UTILS_IMPL_PTR(dataPtr)
+    };
+  }
+}
+#endif
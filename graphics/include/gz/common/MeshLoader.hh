@@ -20,6 +20,7 @@
 #include <string>
 
 #include <gz/common/graphics/Export.hh>
+#include <gz/common/MeshLoadOptions.hh>
 
 namespace gz
 {
@@ -41,6 +42,16 @@ namespace gz
       /// \param[in] _filename the path to the mesh
       /// \return a pointer to the created mesh
       public: virtual Mesh *Load(const std::string &_filename) = 0;
+
+      /// \brief Load a 3D mesh, skipping the parts not selected by
+      /// _options. This is not virtual, so that the interface of loaders
+      /// built against earlier versions does not change: it dispatches to
+      /// the loaders of this library, and other loaders load everything.
+      /// \param[in] _filename the path to the mesh
+      /// \param[in] _options parts of the mesh to load
+      /// \return a pointer to the created mesh
+      public: Mesh *Load(const std::string &_filename,
+                         const MeshLoadOptions &_options);
     };
   }
 }
@@ -17,6 +17,7 @@
 #ifndef GZ_COMMON_MESHMANAGER_HH_
 #define GZ_COMMON_MESHMANAGER_HH_
 
+#include <cstddef>
 #include <map>
 #include <utility>
 #include <string>
@@ -33,6 +34,7 @@
 #include <gz/utils/ImplPtr.hh>
 
 #include <gz/common/graphics/Types.hh>
+#include <gz/common/MeshLoadOptions.hh>
 #include <gz/common/SingletonT.hh>
 #include <gz/common/graphics/Export.hh>
 
@@ -50,6 +52,11 @@ namespace gz
     /// and FBX are loaded using assimp loader, however if GZ_MESH_FORCE_ASSIMP
     /// environment variable is set, then MeshManager will use assimp loader for
     /// all supported mesh formats.
+    ///
+    /// The manager also provides built-in meshes such as "unit_box",
+    /// "unit_sphere" and "unit_cylinder". A built-in mesh is created the
+    /// first time it is requested by name, and the manager itself is
+    /// created on the first call to Instance().
     class GZ_COMMON_GRAPHICS_VISIBLE MeshManager
         : public SingletonT<MeshManager>
     {
@@ -73,6 +80,44 @@ namespace gz
       /// \return a pointer to the created mesh
       public: const Mesh *Load(const std::string &_filename);
 
+      /// \brief Load a mesh from a file, skipping the parts not selected by
+      /// _options. Meshes loaded with different options are cached
+      /// separately, the name of a partially loaded mesh is the filename
+      /// followed by MeshLoadOptions::CacheKey().
+      /// \param[in] _filename the path to the mesh
+      /// \param[in] _options parts of the mesh to load
+      /// \return a pointer to the created mesh
+      public: const Mesh *Load(const std::string &_filename,
+                               const MeshLoadOptions &_options);
+
+      /// \brief Load a mesh and get a shared handle to it. The mesh stays
+      /// valid while the handle exists, even if it is removed or evicted
+      /// from the manager.
+      /// \param[in] _filename the path to the mesh
+      /// \param[in] _options parts of the mesh to load
+      /// \return a handle to the mesh, or nullptr if it could not be loaded
+      /// \sa EvictUnused
+      public: ConstMeshPtr LoadHandle(const std::string &_filename,
+                  const MeshLoadOptions &_options = MeshLoadOptions());
+
+      /// \brief Load meshes ahead of time, e.g. all the meshes referenced
+      /// by a world, so that later calls to Load find them in the cache.
+      /// Files are searched on the calling thread using the global
+      /// SystemPaths instance, then parsed in parallel. Image files, e.g.
+      /// textures, are read so that they are in the system's file cache
+      /// when decoded; they are not decoded. Meshes already loaded and
+      /// files of other types are skipped.
+      /// \param[in] _filenames Paths or URIs of meshes and images.
+      /// \param[in] _options Parts of the meshes to load, the same options
+      /// must be passed to Load to find the meshes.
+      /// \param[in] _concurrency Maximum number of files read at the same
+      /// time, zero to use the number of hardware threads.
+      /// \return Number of files that are loaded or read. Meshes which were
+      /// already loaded are counted.
+      public: std::size_t Prefetch(const std::vector<std::string> &_filenames,
+                  const MeshLoadOptions &_options = MeshLoadOptions(),
+                  unsigned int _concurrency = 0);
+
       /// \brief Export a mesh to a file
       /// \param[in] _mesh Pointer to the mesh to be exported
       /// \param[in] _filename Exported file's path and name
@@ -118,16 +163,57 @@ namespace gz
       /// \brief Remove all meshes.
       public: void RemoveAll();
 
-      /// \brief Get a mesh by name.
+      /// \brief Get a mesh by name. Built-in meshes are created on first
+      /// request.
       /// \param[in] _name the name of the mesh to look for
       /// \return the mesh or nullptr if not found
       public: const gz::common::Mesh *MeshByName(
                   const std::string &_name) const;
 
-      /// \brief Return true if the mesh exists.
+      /// \brief Get a shared handle to a mesh. The mesh stays valid while
+      /// the handle exists, even if it is removed or evicted from the
+      /// manager.
+      /// \param[in] _name the name of the mesh to look for
+      /// \return a handle to the mesh or nullptr if not found
+      public: ConstMeshPtr MeshHandle(const std::string &_name) const;
+
+      /// \brief Return true if the mesh exists. Built-in meshes are
+      /// created on first request.
       /// \param[in] _name the name of the mesh
       public: bool HasMesh(const std::string &_name) const;
 
+      /// \brief Remove the meshes loaded from files which are not
+      /// referenced by a handle, see LoadHandle and MeshHandle. Pointers
+      /// returned by Load and MeshByName for these meshes become invalid.
+      /// Meshes created by the manager or added with AddMesh are kept.
+      /// \return Number of meshes removed.
+      public: std::size_t EvictUnused();
+
+      /// \brief Create a scaled variant of a mesh. The variant shares the
+      /// normal, texture coordinate and index buffers of _mesh.
+      /// \param[in] _mesh Mesh to scale.
+      /// \param[in] _factor Scale factor.
+      /// \return The scaled mesh.
+      public: static ConstMeshPtr Scaled(const Mesh &_mesh,
+                  const gz::math::Vector3d &_factor);
+
+      /// \brief Create a variant of a mesh centered at a point. The
+      /// variant shares the normal, texture coordinate and index buffers of
+      /// _mesh.
+      /// \param[in] _mesh Mesh to move.
+      /// \param[in] _center New center of the bounding box of the mesh.
+      /// \return The centered mesh.
+      public: static ConstMeshPtr Centered(const Mesh &_mesh,
+                  const gz::math::Vector3d &_center =
+                  gz::math::Vector3d::Zero);
+
+      /// \brief Create a variant of a mesh with all submeshes merged into
+      /// one, see MergeSubMeshes. A mesh with a single submesh shares its
+      /// buffers with the variant.
+      /// \param[in] _mesh Mesh to merge.
+      /// \return The merged mesh.
+      public: static ConstMeshPtr Merged(const Mesh &_mesh);
+
       /// \brief Create a sphere mesh.
       /// \param[in] _name the name of the mesh
       /// \param[in] _radius radius of the sphere in meter
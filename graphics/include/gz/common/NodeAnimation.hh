@@ -19,6 +19,7 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <gz/math/Matrix4.hh>
 #include <gz/math/Pose3.hh>
@@ -61,6 +62,16 @@ namespace gz
       /// \param[in] _pose the pose
       public: void AddKeyFrame(const double _time, const math::Pose3d &_pose);
 
+      /// \brief Replace all the key frames at once. This is faster than
+      /// adding frames one at a time when loading long animations.
+      /// \param[in] _times Time of each key frame. Frames are sorted by
+      /// time, when a time is repeated the last frame is kept.
+      /// \param[in] _transforms Transformation of each key frame.
+      /// \return False if the number of times and transformations differ,
+      /// in which case the key frames are not changed.
+      public: bool SetKeyFrames(std::vector<double> _times,
+                  std::vector<math::Matrix4d> _transforms);
+
       /// \brief Returns the number of key frames.
       /// \return the count
       public: unsigned int FrameCount() const;
@@ -47,6 +47,14 @@ namespace gz
       /// \return Pointer to a new Mesh
       public: virtual Mesh *Load(const std::string &_filename);
 
+      /// \brief Load a mesh, skipping the parts not selected by _options.
+      /// The material library is not read when materials are skipped.
+      /// \param[in] _filename Mesh file to load
+      /// \param[in] _options parts of the mesh to load
+      /// \return Pointer to a new Mesh
+      public: Mesh *Load(const std::string &_filename,
+                         const MeshLoadOptions &_options);
+
       /// \internal
       /// \brief Private data pointer.
       GZ_UTILS_IMPL_PTR(dataPtr)
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_COMMON_POLYGONTRIANGULATION_HH_
+#define GZ_COMMON_POLYGONTRIANGULATION_HH_
+
+#include <vector>
+
+#include <gz/math/Vector2.hh>
+
+#include <gz/common/graphics/Export.hh>
+
+namespace gz
+{
+  namespace common
+  {
+    /// \class PolygonTriangulation PolygonTriangulation.hh
+    /// gz/common/PolygonTriangulation.hh
+    /// \brief Triangulates simple polygons with holes, without external
+    /// dependencies.
+    ///
+    /// Polygons are first triangulated by ear clipping, holes being joined
+    /// to their outer boundary by bridge edges. Edges that are not on the
+    /// boundary are then flipped until the triangulation is the constrained
+    /// Delaunay triangulation of the polygon, which avoids thin triangles
+    /// where possible. All output triangles are counter-clockwise.
+    class GZ_COMMON_GRAPHICS_VISIBLE PolygonTriangulation
+    {
+      /// \brief Triangulate a polygon with holes.
+      /// \param[in] _rings Boundary of the polygon. The first ring is the
+      /// outer boundary, the others are holes inside of it. Rings can be
+      /// given in either orientation and should not repeat their first
+      /// point at the end, a repeated point is ignored.
+      /// \param[out] _indices Three indices per triangle, into the
+      /// concatenation of all the rings.
+      /// \return False if the outer ring has less than three points, or a
+      /// hole could not be joined to the outer boundary.
+      public: static bool Triangulate(
+                  const std::vector<std::vector<math::Vector2d>> &_rings,
+                  std::vector<unsigned int> &_indices);
+
+      /// \brief Triangulate the area enclosed by closed polylines, given as
+      /// a table of vertices and the edges between them, e.g. the output of
+      /// an SVG path. Rings are classified using the even-odd rule: a ring
+      /// inside another ring is a hole, a ring inside a hole is a new
+      /// polygon and so on. Independent polygons are triangulated in
+      /// parallel.
+      /// \param[in] _vertices Vertices of the polylines.
+      /// \param[in] _edges Edges between two vertices of _vertices. Edges
+      /// must form closed rings which do not intersect each other.
+      /// \param[out] _indices Three indices per triangle, into _vertices.
+      /// \return False if an edge is invalid, the edges do not form closed
+      /// rings, or a polygon could not be triangulated.
+      public: static bool Triangulate(
+                  const std::vector<math::Vector2d> &_vertices,
+                  const std::vector<math::Vector2i> &_edges,
+                  std::vector<unsigned int> &_indices);
+    };
+  }
+}
+#endif
@@ -48,6 +48,13 @@ namespace gz
       /// \param[in] _filename the mesh file
       public: virtual Mesh *Load(const std::string &_filename);
 
+      /// \brief Load a mesh, skipping normals if not selected by _options
+      /// \param[in] _filename Mesh file to load
+      /// \param[in] _options parts of the mesh to load
+      /// \return Pointer to a new Mesh
+      public: Mesh *Load(const std::string &_filename,
+                         const MeshLoadOptions &_options);
+
       /// \brief Reads an ASCII STL (stereolithography) file.
       /// \param[in] _filein the file pointer
       /// \param[out] _mesh the mesh where to load the data
@@ -123,6 +123,40 @@ namespace gz
       public: std::pair<std::string, double> VertNodeWeight(
                   const unsigned int _v, const unsigned int _i) const;
 
+      /// \brief Build a compact copy of the weights added with
+      /// AddVertNodeWeight, for skinning. Each vertex gets a fixed number
+      /// of node handles and weights. Vertices with more weights keep the
+      /// largest ones, the weights of a vertex are normalized to sum to 1
+      /// and unused slots have a handle and weight of 0. The compact
+      /// weights are cleared when the weights or the nodes change.
+      /// \param[in] _influences Number of weights per vertex, usually 4
+      /// or 8.
+      /// \return False if _influences is 0, or a weight refers to a node
+      /// name which is not in the skeleton.
+      /// \sa SkinNodeHandles() SkinWeights()
+      public: bool BuildSkinWeights(const unsigned int _influences = 4);
+
+      /// \brief Number of weights per vertex of the compact weights.
+      /// \return The count, or 0 if the compact weights are not built.
+      /// \sa BuildSkinWeights
+      public: unsigned int SkinInfluenceCount() const;
+
+      /// \brief Number of vertices of the compact weights.
+      /// \return The count, or 0 if the compact weights are not built.
+      public: unsigned int SkinVertexCount() const;
+
+      /// \brief Node handles of the compact weights, SkinInfluenceCount()
+      /// consecutive handles per vertex. See SkeletonNode::Handle.
+      /// \return Pointer to SkinVertexCount() * SkinInfluenceCount()
+      /// handles, or nullptr if the compact weights are not built.
+      public: const unsigned int *SkinNodeHandles() const;
+
+      /// \brief Normalized weights of the compact weights, in the same
+      /// layout as SkinNodeHandles().
+      /// \return Pointer to SkinVertexCount() * SkinInfluenceCount()
+      /// weights, or nullptr if the compact weights are not built.
+      public: const float *SkinWeights() const;
+
       /// \brief Returns the number of animations
       /// \return the count
       public: unsigned int AnimationCount() const;
@@ -151,6 +185,15 @@ namespace gz
       public: std::string NodeNameAnimToSkin(unsigned int _index,
                   const std::string &_animNodeName);
 
+      /// \brief Finding the skin node name that corresponds to
+      /// the given animation node name.
+      /// \param[in] _index the animation index
+      /// \param[in] _animNodeName the given animation node name
+      /// \return The corresponding skin node name in the skeleton, or
+      /// _animNodeName if the node is not mapped
+      public: std::string NodeNameAnimToSkin(unsigned int _index,
+                  const std::string &_animNodeName) const;
+
       /// \brief Get the transformation to align translation from
       /// the animation skeleton to skin skeleton
       /// \param[in] _index the animation index
@@ -159,6 +202,15 @@ namespace gz
       public: math::Matrix4d AlignTranslation(unsigned int _index,
                   const std::string &_animNodeName);
 
+      /// \brief Get the transformation to align translation from
+      /// the animation skeleton to skin skeleton
+      /// \param[in] _index the animation index
+      /// \param[in] _animNodeName the animation node name
+      /// \return The transformation to align translation, identity if
+      /// there is none
+      public: math::Matrix4d AlignTranslation(unsigned int _index,
+                  const std::string &_animNodeName) const;
+
       /// \brief Get the transformation to align rotation from
       /// the animation skeleton to skin skeleton
       /// \param[in] _index the animation index
@@ -167,6 +219,15 @@ namespace gz
       public: math::Matrix4d AlignRotation(unsigned int _index,
                   const std::string &_animNodeName);
 
+      /// \brief Get the transformation to align rotation from
+      /// the animation skeleton to skin skeleton
+      /// \param[in] _index the animation index
+      /// \param[in] _animNodeName the animation node name
+      /// \return The transformation to align rotation, identity if
+      /// there is none
+      public: math::Matrix4d AlignRotation(unsigned int _index,
+                  const std::string &_animNodeName) const;
+
       /// \brief Initializes the hande numbers for each node in the map
       /// using breadth first traversal
       private: void BuildNodeMap();
@@ -20,6 +20,7 @@
 #include <map>
 #include <utility>
 #include <string>
+#include <vector>
 
 #include <gz/math/Matrix4.hh>
 #include <gz/math/Pose3.hh>
@@ -64,6 +65,15 @@ namespace gz
       public: NodeAnimation *NodeAnimationByName(const std::string &_name)
           const;
 
+      /// \brief Returns a node animation by index. Node animations are
+      /// sorted by node name.
+      /// \param[in] _index Index of the node animation, lower than
+      /// NodeCount()
+      /// \return NodeAnimation object, or nullptr if _index is out of
+      /// bounds
+      public: NodeAnimation *NodeAnimationByIndex(
+          const unsigned int _index) const;
+
       /// \brief Check all nodes for x displacement
       /// \return True if x displacement found
       public: bool XDisplacement() const;
@@ -87,6 +97,16 @@ namespace gz
       public: void AddKeyFrame(const std::string &_node, const double _time,
                       const math::Pose3d &_pose);
 
+      /// \brief Replace all the key frames of a named node at once, see
+      /// NodeAnimation::SetKeyFrames.
+      /// \param[in] _node the name of the new or existing node
+      /// \param[in] _times Time of each key frame.
+      /// \param[in] _transforms Transformation of each key frame.
+      /// \return False if the number of times and transformations differ.
+      public: bool SetKeyFrames(const std::string &_node,
+                  std::vector<double> _times,
+                  std::vector<math::Matrix4d> _transforms);
+
       /// \brief Returns the key frame transformation for a named animation at
       /// a specific time
       /// if a node does not exist at that time (with tolerance of 1e-6 sec),
@@ -110,6 +130,18 @@ namespace gz
       public: std::map<std::string, math::Matrix4d> PoseAt(
                   const double _time, const bool _loop = true) const;
 
+      /// \brief Fill a dictionary of transformations indexed by name at
+      /// a specific time. Entries already present in _pose are updated in
+      /// place, so reusing the same map every frame does not allocate.
+      /// \param[in] _time the time
+      /// \param[out] _pose the transformation for every node. Entries of
+      /// nodes that are not animated are removed.
+      /// \param[in] _loop when true, the time is divided by the duration
+      /// (see GetLength)
+      public: void PoseAt(const double _time,
+                  std::map<std::string, math::Matrix4d> &_pose,
+                  const bool _loop = true) const;
+
       /// \brief Returns a dictionary of transformations indexed by name where
       /// a named node transformation's translational value along the X axis is
       /// equal to _x.
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_COMMON_SKELETONRETARGET_HH_
+#define GZ_COMMON_SKELETONRETARGET_HH_
+
+#include <vector>
+
+#include <gz/math/Matrix4.hh>
+
+#include <gz/utils/ImplPtr.hh>
+
+#include <gz/common/graphics/Export.hh>
+
+namespace gz
+{
+  namespace common
+  {
+    class Skeleton;
+    class SkeletonAnimation;
+
+    /// \class SkeletonRetarget SkeletonRetarget.hh
+    /// gz/common/SkeletonRetarget.hh
+    /// \brief Precomputed mapping of an animation of a skeleton onto the
+    /// nodes of that skeleton.
+    ///
+    /// Animations added with Skeleton::AddBvhAnimation animate nodes of
+    /// another skeleton, which are mapped to the skin nodes by name and
+    /// aligned with Skeleton::AlignTranslation and Skeleton::AlignRotation.
+    /// A SkeletonRetarget resolves these lookups once per animation, so
+    /// that sampling a pose only interpolates keyframes and multiplies
+    /// matrices. It refers to the animation of the skeleton, which must
+    /// outlive it.
+    class GZ_COMMON_GRAPHICS_VISIBLE SkeletonRetarget
+    {
+      /// \brief Constructor, creates an invalid retarget.
+      public: SkeletonRetarget();
+
+      /// \brief Constructor, resolves the animated nodes of an animation.
+      /// Animated nodes which do not map to a node of _skeleton are
+      /// ignored.
+      /// \param[in] _skeleton Skeleton to animate.
+      /// \param[in] _index Index of the animation of _skeleton.
+      public: SkeletonRetarget(const Skeleton &_skeleton,
+                  const unsigned int _index);
+
+      /// \brief Check if the retarget was created from an animation.
+      /// \return False if it was default constructed, or the animation
+      /// index was out of bounds.
+      public: bool Valid() const;
+
+      /// \brief Get the animation.
+      /// \return The animation, or nullptr if not valid.
+      public: const SkeletonAnimation *Animation() const;
+
+      /// \brief Get the number of nodes of the skeleton, which is the
+      /// size of the poses.
+      /// \return The node count.
+      public: unsigned int SkinNodeCount() const;
+
+      /// \brief Get the number of animated nodes mapped to the skeleton.
+      /// \return The node count.
+      public: unsigned int NodeCount() const;
+
+      /// \brief Get the skin node of an animated node.
+      /// \param[in] _i Index of the animated node, lower than NodeCount().
+      /// \return Handle of the skin node, see SkeletonNode::Handle.
+      public: unsigned int SkinHandle(const unsigned int _i) const;
+
+      /// \brief Get the translation alignment of an animated node, see
+      /// Skeleton::AlignTranslation.
+      /// \param[in] _i Index of the animated node, lower than NodeCount().
+      /// \return The transformation to align translation.
+      public: math::Matrix4d AlignTranslation(const unsigned int _i) const;
+
+      /// \brief Get the rotation alignment of an animated node, see
+      /// Skeleton::AlignRotation.
+      /// \param[in] _i Index of the animated node, lower than NodeCount().
+      /// \return The transformation to align rotation.
+      public: math::Matrix4d AlignRotation(const unsigned int _i) const;
+
+      /// \brief Get the retargeted pose of the skeleton at a time. The
+      /// transform of an animated skin node is
+      /// AlignTranslation * animation transform * AlignRotation.
+      /// \param[in] _time Time in the animation.
+      /// \param[out] _pose Local transform of each skin node, indexed by
+      /// handle. Nodes which are not animated keep the transform of the
+      /// skin node.
+      /// \param[in] _loop True to loop the animation.
+      public: void PoseAt(const double _time,
+                  std::vector<math::Matrix4d> &_pose,
+                  const bool _loop = true) const;
+
+      /// \brief Get the retargeted poses of many skeletons, e.g. all the
+      /// actors of a world, at once. Large batches are split across
+      /// threads.
+      /// \param[in] _retargets Retarget of each skeleton. Null entries
+      /// get an empty pose.
+      /// \param[in] _times Time in the animation of each skeleton, same
+      /// size as _retargets.
+      /// \param[out] _poses Pose of each skeleton, see PoseAt. Resized to
+      /// the size of _retargets, existing poses are reused.
+      /// \param[in] _loop True to loop the animations.
+      /// \return False if _retargets and _times have different sizes.
+      public: static bool PosesAt(
+                  const std::vector<const SkeletonRetarget *> &_retargets,
+                  const std::vector<double> &_times,
+                  std::vector<std::vector<math::Matrix4d>> &_poses,
+                  const bool _loop = true);
+
+      /// \brief Private data pointer.
+      GZ_UTILS_IMPL_PTR(dataPtr)
+    };
+  }
+}
+#endif
@@ -17,6 +17,8 @@
 #ifndef GZ_COMMON_SUBMESH_HH_
 #define GZ_COMMON_SUBMESH_HH_
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -38,6 +40,10 @@ namespace gz
     class NodeAssignment;
 
     /// \brief A child mesh
+    ///
+    /// Copies of a submesh share their vertex, normal, texture coordinate
+    /// and index buffers until one of the copies modifies them, so copying
+    /// a submesh to derive a variant of it is cheap.
     class GZ_COMMON_GRAPHICS_VISIBLE SubMesh
     {
       /// \brief An enumeration of the geometric mesh primitives
@@ -62,6 +68,21 @@ namespace gz
                 TRISTRIPS
               };
 
+      /// \brief Per vertex or per index data of a submesh, used to track
+      /// which elements changed.
+      /// \sa DirtyRange
+      public: enum class Attribute
+              {
+                /// \brief Vertex positions
+                VERTICES,
+                /// \brief Vertex normals
+                NORMALS,
+                /// \brief Texture coordinates, of all sets
+                TEXCOORDS,
+                /// \brief Vertex indices
+                INDICES
+              };
+
       /// \brief Constructor
       public: SubMesh();
 
@@ -159,7 +180,8 @@ namespace gz
 
       /// \brief Get the raw vertex pointer. This is unsafe, it is the
       /// caller's responsability to ensure it's not indexed out of bounds.
-      /// The valid range is [0; VertexCount())
+      /// The valid range is [0; VertexCount()). The pointer is
+      /// invalidated when the submesh is modified.
       /// \return Raw vertices
       public: const gz::math::Vector3d* VertexPtr() const;
 
@@ -225,7 +247,8 @@ namespace gz
 
       /// \brief Get the raw index pointer. This is unsafe, it is the
       /// caller's responsability to ensure it's not indexed out of bounds.
-      /// The valid range is [0; IndexCount())
+      /// The valid range is [0; IndexCount()). The pointer is
+      /// invalidated when the submesh is modified.
       /// \return Raw indices
       public: const unsigned int* IndexPtr() const;
 
@@ -359,11 +382,38 @@ namespace gz
       /// \return Index of the vertex that matches _v.
       public: int IndexOfVertex(const gz::math::Vector3d &_v) const;
 
-      /// \brief Put all the data into flat arrays
+      /// \brief Put all the data into flat arrays. The arrays are
+      /// reallocated on every call and vertices are rounded to float
+      /// precision.
       /// \param[in] _verArr The vertex array to be filled.
       /// \param[in] _indexndArr The index array to be filled.
+      /// \sa FillVertices, FillIndices
       public: void FillArrays(double **_vertArr, int **_indexndArr) const;
 
+      /// \brief Copy the vertex positions into a caller provided buffer, as
+      /// consecutive x, y, z values.
+      /// \param[out] _vertices Buffer of at least 3 * VertexCount() values.
+      /// \param[in] _size Number of values _vertices can hold.
+      /// \return False if the buffer is too small, nothing is written then.
+      public: bool FillVertices(float *_vertices, std::size_t _size) const;
+
+      /// \copydoc FillVertices(float *, std::size_t) const
+      public: bool FillVertices(double *_vertices, std::size_t _size) const;
+
+      /// \brief Copy the indices into a caller provided buffer.
+      /// \param[out] _indices Buffer of at least IndexCount() values.
+      /// \param[in] _size Number of values _indices can hold.
+      /// \param[in] _offset Value added to every index, e.g. the position
+      /// of the first vertex of this submesh in a shared vertex buffer.
+      /// \return False if the buffer is too small or an index does not fit
+      /// in the index type, nothing is written then.
+      public: bool FillIndices(uint16_t *_indices, std::size_t _size,
+                               unsigned int _offset = 0) const;
+
+      /// \copydoc FillIndices(uint16_t *, std::size_t, unsigned int) const
+      public: bool FillIndices(uint32_t *_indices, std::size_t _size,
+                               unsigned int _offset = 0) const;
+
       /// \brief Recalculate all the normals.
       public: void RecalculateNormals();
 
@@ -407,11 +457,80 @@ namespace gz
       /// representation" by Cha Zhang and Tsuhan Chen. Link:
       /// http://chenlab.ece.cornell.edu/Publication/Cha/icip01_Cha.pdf.
       /// The formula does not check for a closed (water tight) mesh.
+      /// Each triangle contributes a positive volume, which is only correct
+      /// for convex meshes; see MassProperties for signed volume, center of
+      /// mass and inertia.
       ///
       /// \return The submesh's volume. The volume can be zero if
       /// the primitive type is not TRIANGLES, or there are no triangles.
       public: double Volume() const;
 
+      /// \brief Set consecutive vertices. Vertices past the end are
+      /// appended.
+      /// \param[in] _start Index of the first vertex to set, at most
+      /// VertexCount().
+      /// \param[in] _vertices New vertices.
+      /// \param[in] _count Number of vertices in _vertices.
+      /// \return False if _start is past the end, nothing is set then.
+      public: bool SetVertices(unsigned int _start,
+                  const gz::math::Vector3d *_vertices, std::size_t _count);
+
+      /// \brief Set consecutive normals. Normals past the end are
+      /// appended.
+      /// \param[in] _start Index of the first normal to set, at most
+      /// NormalCount().
+      /// \param[in] _normals New normals.
+      /// \param[in] _count Number of normals in _normals.
+      /// \return False if _start is past the end, nothing is set then.
+      public: bool SetNormals(unsigned int _start,
+                  const gz::math::Vector3d *_normals, std::size_t _count);
+
+      /// \brief Set consecutive texture coordinates of a set. Texture
+      /// coordinates past the end are appended, the set is created if
+      /// needed.
+      /// \param[in] _start Index of the first texture coordinate to set, at
+      /// most TexCoordCountBySet(_setIndex).
+      /// \param[in] _texCoords New texture coordinates.
+      /// \param[in] _count Number of texture coordinates in _texCoords.
+      /// \param[in] _setIndex Texture coordinate set index.
+      /// \return False if _start is past the end, nothing is set then.
+      public: bool SetTexCoordsBySet(unsigned int _start,
+                  const gz::math::Vector2d *_texCoords, std::size_t _count,
+                  unsigned int _setIndex);
+
+      /// \brief Set consecutive indices. Indices past the end are appended.
+      /// \param[in] _start Position of the first index to set, at most
+      /// IndexCount().
+      /// \param[in] _indices New indices.
+      /// \param[in] _count Number of indices in _indices.
+      /// \return False if _start is past the end, nothing is set then.
+      public: bool SetIndices(unsigned int _start,
+                  const unsigned int *_indices, std::size_t _count);
+
+      /// \brief Get a counter incremented on every change of the vertices,
+      /// normals, texture coordinates, indices or primitive type. Caches of
+      /// derived data can compare it to know whether they are stale.
+      /// \return The change counter.
+      public: uint64_t Version() const;
+
+      /// \brief Get the range of elements of an attribute that changed since
+      /// the last call to ClearDirty. Added, set and transformed elements
+      /// are included.
+      /// \param[in] _attribute Attribute to check.
+      /// \param[out] _begin First changed element.
+      /// \param[out] _end One past the last changed element.
+      /// \return False if no element changed, _begin and _end are not set
+      /// then.
+      public: bool DirtyRange(Attribute _attribute, unsigned int &_begin,
+                  unsigned int &_end) const;
+
+      /// \brief Mark all attributes as unchanged, e.g. after uploading them.
+      public: void ClearDirty();
+
+      /// \brief Mark an attribute as unchanged.
+      /// \param[in] _attribute Attribute to clear.
+      public: void ClearDirty(Attribute _attribute);
+
       /// \brief Private data pointer.
       GZ_UTILS_IMPL_PTR(dataPtr)
     };
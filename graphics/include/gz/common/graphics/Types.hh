@@ -38,6 +38,10 @@ namespace gz
     /// \brief Standrd shared pointer to a Mesh object
     using MeshPtr = std::shared_ptr<Mesh>;
 
+    /// \def ConstMeshPtr
+    /// \brief Shared pointer to an immutable Mesh object
+    using ConstMeshPtr = std::shared_ptr<const Mesh>;
+
     /// \def SubMeshPtr
     /// \brief Shared pointer to a SubMesh object
     using SubMeshPtr = std::shared_ptr<SubMesh>;
@@ -15,8 +15,12 @@
  *
  */
 
+#include <algorithm>
+#include <memory>
 #include <queue>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "gz/common/graphics/Types.hh"
 #include "gz/common/AssimpLoader.hh"
@@ -29,6 +33,9 @@
 #include "gz/common/SubMesh.hh"
 #include "gz/common/SystemPaths.hh"
 #include "gz/common/Util.hh"
+#include "gz/common/WorkerPool.hh"
+
+#include "ParallelFor.hh"
 
 #ifndef GZ_ASSIMP_PRE_5_2_0
   #include <assimp/GltfMaterial.h>    // GLTF specific material properties
@@ -52,9 +59,49 @@ using ImagePtr = std::shared_ptr<Image>;
 /// \brief Private data for the AssimpLoader class
 class AssimpLoader::Implementation
 {
+  /// \brief A metallic roughness map waiting to be split. Splitting is
+  /// deferred until all materials are created so that the maps of all
+  /// materials can be split in parallel.
+  public: struct MetallicRoughnessTask
+  {
+    /// \brief Material that receives the metalness and roughness maps
+    MaterialPtr material;
+
+    /// \brief The combined map, metalness in B and roughness in G
+    ImagePtr image;
+
+    /// \brief Name of the metalness map
+    std::string metalnessName;
+
+    /// \brief Name of the roughness map
+    std::string roughnessName;
+  };
+
   /// \brief the Assimp importer used to parse meshes
   public: Assimp::Importer importer;
 
+  /// \brief Parts of the mesh being loaded
+  public: MeshLoadOptions options;
+
+  /// \brief How embedded textures are decoded
+  public: AssimpLoader::TextureDecoding textureDecoding{
+      AssimpLoader::TextureDecoding::DEFERRED};
+
+  /// \brief Post-processing profile
+  public: AssimpLoader::PostProcessing postProcessProfile{
+      AssimpLoader::PostProcessing::DEFAULT};
+
+  /// \brief Steps of the CUSTOM post-processing profile
+  public: unsigned int customPostProcessFlags{0};
+
+  /// \brief Threads decoding textures in the background, created on first
+  /// use
+  public: std::unique_ptr<WorkerPool> decodePool;
+
+  /// \brief Start decoding the deferred textures of a mesh on decodePool
+  /// \param[in] _mesh the loaded mesh
+  public: void DecodeTexturesInBackground(const Mesh &_mesh);
+
   /// \brief Convert a color from assimp implementation to Ignition common
   /// \param[in] _color the assimp color to convert
   /// \return the matching math::Color
@@ -69,10 +116,13 @@ class AssimpLoader::Implementation
   /// \param[in] _scene the assimp scene
   /// \param[in] _matIdx index of the material in the scene
   /// \param[in] _path path where the mesh is located
+  /// \param[out] _tasks metallic roughness map to be split for this
+  /// material, if any, is appended here
   /// \return pointer to the converted common::Material
   public: MaterialPtr CreateMaterial(const aiScene* _scene,
-                                     unsigned _matIdx,
-                                     const std::string& _path) const;
+              unsigned _matIdx,
+              const std::string& _path,
+              std::vector<MetallicRoughnessTask> &_tasks) const;
 
   /// \brief Load a texture embedded in a mesh (i.e. for GLB format)
   /// into a gz::common::Image
@@ -109,6 +159,12 @@ class AssimpLoader::Implementation
   public: std::pair<ImagePtr, ImagePtr>
           SplitMetallicRoughnessMap(const common::Image& _img) const;
 
+  /// \brief Split the metallic roughness maps of several materials, in
+  /// parallel, and set the results on the materials
+  /// \param[in] _tasks the maps to split
+  public: void SplitMetallicRoughnessMaps(
+              const std::vector<MetallicRoughnessTask> &_tasks) const;
+
   /// \brief Convert an assimp mesh into a gz::common::SubMesh
   /// \param[in] _assimpMesh the assimp mesh to load
   /// \param[in] _transform the node transform for the mesh
@@ -206,7 +262,8 @@ void AssimpLoader::Implementation::RecursiveCreate(const aiScene* _scene,
     auto subMesh = this->CreateSubMesh(assimpMesh, _transform);
     subMesh.SetName(nodeName);
     // Now add the bones to the skeleton
-    if (assimpMesh->HasBones() && _scene->HasAnimations())
+    if (_mesh->HasSkeleton() && assimpMesh->HasBones() &&
+        _scene->HasAnimations())
     {
       // TODO(luca) merging skeletons here
       auto skeleton = _mesh->MeshSkeleton();
@@ -320,7 +377,8 @@ void AssimpLoader::Implementation::RecursiveSkeletonCreate(const aiNode* _node,
 
 //////////////////////////////////////////////////
 MaterialPtr AssimpLoader::Implementation::CreateMaterial(
-    const aiScene* _scene, unsigned _matIdx, const std::string& _path) const
+    const aiScene* _scene, unsigned _matIdx, const std::string& _path,
+    std::vector<MetallicRoughnessTask> &_tasks) const
 {
   MaterialPtr mat = std::make_shared<Material>();
   aiColor4D color;
@@ -379,11 +437,12 @@ MaterialPtr AssimpLoader::Implementation::CreateMaterial(
 
   // TODO(luca) more than one texture, Gazebo assumes UV index 0
   Pbr pbr;
+  const bool loadTextures = this->options.Textures();
   aiString texturePath(_path.c_str());
   ret = assimpMat->GetTexture(aiTextureType_DIFFUSE, 0, &texturePath);
   // TODO(luca) check other arguments,
   // type of mappings to be UV, uv index, blend mode
-  if (ret == AI_SUCCESS)
+  if (loadTextures && ret == AI_SUCCESS)
   {
     // Check if the texture is embedded or not
     auto [texName, texData] = this->LoadTexture(_scene,
@@ -414,25 +473,26 @@ MaterialPtr AssimpLoader::Implementation::CreateMaterial(
 #ifndef GZ_ASSIMP_PRE_5_2_0
   // Edge case for GLTF, Metal and Rough texture are embedded in a
   // MetallicRoughness texture with metalness in B and roughness in G
-  // Open, preprocess and split into metal and roughness map
+  // Open, preprocess and split into metal and roughness map. The split
+  // itself happens once all materials are created, see
+  // SplitMetallicRoughnessMaps
   ret = assimpMat->GetTexture(
       AI_MATKEY_GLTF_PBRMETALLICROUGHNESS_METALLICROUGHNESS_TEXTURE,
       &texturePath);
-  if (ret == AI_SUCCESS)
+  if (!loadTextures)
+  {
+    // Only the factors below are used
+  }
+  else if (ret == AI_SUCCESS)
   {
     auto [texName, texData] = this->LoadTexture(_scene, texturePath,
         this->GenerateTextureName(_scene, assimpMat, "MetallicRoughness"));
-    // Load it into a common::Image then split it
+    // Load it into a common::Image, to be split later
     auto texImg = texData != nullptr ? texData :
       std::make_shared<common::Image>(joinPaths(_path, texName));
-    auto [metalTexture, roughTexture] =
-      this->SplitMetallicRoughnessMap(*texImg);
-    pbr.SetMetalnessMap(
+    _tasks.push_back({mat, texImg,
         this->GenerateTextureName(_scene, assimpMat, "Metalness"),
-        metalTexture);
-    pbr.SetRoughnessMap(
-        this->GenerateTextureName(_scene, assimpMat, "Roughness"),
-        roughTexture);
+        this->GenerateTextureName(_scene, assimpMat, "Roughness")});
   }
   else
   {
@@ -470,7 +530,7 @@ MaterialPtr AssimpLoader::Implementation::CreateMaterial(
   }
 #endif
   ret = assimpMat->GetTexture(aiTextureType_NORMALS, 0, &texturePath);
-  if (ret == AI_SUCCESS)
+  if (loadTextures && ret == AI_SUCCESS)
   {
     auto [texName, texData] = this->LoadTexture(_scene, texturePath,
         this->GenerateTextureName(_scene, assimpMat, "Normal"));
@@ -478,7 +538,7 @@ MaterialPtr AssimpLoader::Implementation::CreateMaterial(
     pbr.SetNormalMap(texName, NormalMapSpace::TANGENT, texData);
   }
   ret = assimpMat->GetTexture(aiTextureType_EMISSIVE, 0, &texturePath);
-  if (ret == AI_SUCCESS)
+  if (loadTextures && ret == AI_SUCCESS)
   {
     auto [texName, texData] = this->LoadTexture(_scene, texturePath,
         this->GenerateTextureName(_scene, assimpMat, "Emissive"));
@@ -532,37 +592,34 @@ std::pair<ImagePtr, ImagePtr>
     const common::Image& _img) const
 {
   std::pair<ImagePtr, ImagePtr> ret;
-  // Metalness in B roughness in G
-  const auto width = _img.Width();
-  const auto height = _img.Height();
-  const auto bytesPerPixel = 4;
+  // Metalness in B roughness in G, extracted in a single pass into single
+  // channel images
+  auto channels = _img.ChannelImages({2, 1});
+  if (channels.size() == 2)
+  {
+    // First is metal, second is rough
+    ret.first = channels[0];
+    ret.second = channels[1];
+  }
+  return ret;
+}
 
-  std::vector<unsigned char> metalnessData(width * height * bytesPerPixel);
-  std::vector<unsigned char> roughnessData(width * height * bytesPerPixel);
+//////////////////////////////////////////////////
+void AssimpLoader::Implementation::SplitMetallicRoughnessMaps(
+    const std::vector<MetallicRoughnessTask> &_tasks) const
+{
+  std::vector<std::pair<ImagePtr, ImagePtr>> results(_tasks.size());
+  parallelFor(_tasks.size(), [&](const std::size_t _i)
+  {
+    results[_i] = this->SplitMetallicRoughnessMap(*_tasks[_i].image);
+  });
 
-  for (unsigned int y = 0; y < height; ++y)
+  for (std::size_t i = 0; i < _tasks.size(); ++i)
   {
-    for (unsigned int x = 0; x < width; ++x)
-    {
-      // RGBA so 4 bytes per pixel, alpha fully opaque
-      auto baseIndex = bytesPerPixel * (y * width + x);
-      auto color = _img.Pixel(x, (height - y - 1));
-      metalnessData[baseIndex] = color.B() * 255.0;
-      metalnessData[baseIndex + 1] = color.B() * 255.0;
-      metalnessData[baseIndex + 2] = color.B() * 255.0;
-      metalnessData[baseIndex + 3] = 255;
-      roughnessData[baseIndex] = color.G() * 255.0;
-      roughnessData[baseIndex + 1] = color.G() * 255.0;
-      roughnessData[baseIndex + 2] = color.G() * 255.0;
-      roughnessData[baseIndex + 3] = 255;
-    }
+    auto pbr = _tasks[i].material->PbrMaterial();
+    pbr->SetMetalnessMap(_tasks[i].metalnessName, results[i].first);
+    pbr->SetRoughnessMap(_tasks[i].roughnessName, results[i].second);
   }
-  // First is metal, second is rough
-  ret.first = std::make_shared<Image>();
-  ret.first->SetFromData(&metalnessData[0], width, height, Image::RGBA_INT8);
-  ret.second = std::make_shared<Image>();
-  ret.second->SetFromData(&roughnessData[0], width, height, Image::RGBA_INT8);
-  return ret;
 }
 
 //////////////////////////////////////////////////
@@ -583,9 +640,18 @@ ImagePtr AssimpLoader::Implementation::LoadEmbeddedTexture(
     if (format != Image::PixelFormatType::UNKNOWN_PIXEL_FORMAT)
     {
       auto img = std::make_shared<Image>();
-      img->SetFromCompressedData(
-          reinterpret_cast<unsigned char *>(_texture->pcData),
-          _texture->mWidth, format);
+      auto data = reinterpret_cast<unsigned char *>(_texture->pcData);
+      if (this->textureDecoding == AssimpLoader::TextureDecoding::IMMEDIATE)
+      {
+        img->SetFromCompressedData(data, _texture->mWidth, format);
+      }
+      else
+      {
+        // The scene owns pcData, keep a copy of the compressed bytes
+        img->SetFromCompressedDataDeferred(
+            std::vector<unsigned char>(data, data + _texture->mWidth),
+            format);
+      }
       return img;
     }
     else
@@ -618,6 +684,9 @@ SubMesh AssimpLoader::Implementation::CreateSubMesh(
   SubMesh subMesh;
   math::Matrix4d rot = _transform;
   rot.SetTranslation(math::Vector3d::Zero);
+  const bool loadNormals =
+      this->options.Normals() && _assimpMesh->HasNormals();
+  const bool loadTexCoords = this->options.TexCoords();
   // Now create the submesh
   for (unsigned vertexIdx = 0; vertexIdx < _assimpMesh->mNumVertices;
       ++vertexIdx)
@@ -628,17 +697,20 @@ SubMesh AssimpLoader::Implementation::CreateSubMesh(
     vertex.X(_assimpMesh->mVertices[vertexIdx].x);
     vertex.Y(_assimpMesh->mVertices[vertexIdx].y);
     vertex.Z(_assimpMesh->mVertices[vertexIdx].z);
-    normal.X(_assimpMesh->mNormals[vertexIdx].x);
-    normal.Y(_assimpMesh->mNormals[vertexIdx].y);
-    normal.Z(_assimpMesh->mNormals[vertexIdx].z);
     vertex = _transform * vertex;
-    normal = rot * normal;
-    normal.Normalize();
     subMesh.AddVertex(vertex);
-    subMesh.AddNormal(normal);
+    if (loadNormals)
+    {
+      normal.X(_assimpMesh->mNormals[vertexIdx].x);
+      normal.Y(_assimpMesh->mNormals[vertexIdx].y);
+      normal.Z(_assimpMesh->mNormals[vertexIdx].z);
+      normal = rot * normal;
+      normal.Normalize();
+      subMesh.AddNormal(normal);
+    }
     // Iterate over sets of texture coordinates
     int uvIdx = 0;
-    while(_assimpMesh->HasTextureCoords(uvIdx))
+    while (loadTexCoords && _assimpMesh->HasTextureCoords(uvIdx))
     {
       math::Vector3d texcoords;
       texcoords.X(_assimpMesh->mTextureCoords[uvIdx][vertexIdx].x);
@@ -655,7 +727,8 @@ SubMesh AssimpLoader::Implementation::CreateSubMesh(
     subMesh.AddIndex(face.mIndices[1]);
     subMesh.AddIndex(face.mIndices[2]);
   }
-  subMesh.SetMaterialIndex(_assimpMesh->mMaterialIndex);
+  if (this->options.Materials())
+    subMesh.SetMaterialIndex(_assimpMesh->mMaterialIndex);
   return subMesh;
 }
 
@@ -673,21 +746,125 @@ AssimpLoader::~AssimpLoader()
 {
 }
 
+//////////////////////////////////////////////////
+void AssimpLoader::SetEmbeddedTextureDecoding(TextureDecoding _mode)
+{
+  this->dataPtr->textureDecoding = _mode;
+}
+
+//////////////////////////////////////////////////
+AssimpLoader::TextureDecoding AssimpLoader::EmbeddedTextureDecoding() const
+{
+  return this->dataPtr->textureDecoding;
+}
+
+//////////////////////////////////////////////////
+void AssimpLoader::SetPostProcessProfile(PostProcessing _profile)
+{
+  this->dataPtr->postProcessProfile = _profile;
+}
+
+//////////////////////////////////////////////////
+AssimpLoader::PostProcessing AssimpLoader::PostProcessProfile() const
+{
+  return this->dataPtr->postProcessProfile;
+}
+
+//////////////////////////////////////////////////
+void AssimpLoader::SetPostProcessFlags(unsigned int _flags)
+{
+  this->dataPtr->customPostProcessFlags = _flags;
+  this->dataPtr->postProcessProfile = PostProcessing::CUSTOM;
+}
+
+//////////////////////////////////////////////////
+unsigned int AssimpLoader::PostProcessFlags() const
+{
+  unsigned int flags = 0;
+  switch (this->dataPtr->postProcessProfile)
+  {
+    case PostProcessing::FAST:
+      flags = aiProcess_RemoveRedundantMaterials |
+          aiProcess_SortByPType |
+          aiProcess_GenNormals;
+      break;
+    case PostProcessing::CUSTOM:
+      flags = this->dataPtr->customPostProcessFlags;
+      break;
+    case PostProcessing::QUALITY:
+      flags = aiProcess_ValidateDataStructure |
+          aiProcess_FindInvalidData |
+          aiProcess_ImproveCacheLocality;
+      [[fallthrough]];
+    case PostProcessing::DEFAULT:
+    default:
+      flags |= aiProcess_JoinIdenticalVertices |
+          aiProcess_RemoveRedundantMaterials |
+          aiProcess_SortByPType |
+          aiProcess_GenNormals;
+#ifndef GZ_ASSIMP_PRE_5_2_0
+      flags |= aiProcess_PopulateArmatureData;
+#endif
+      break;
+  }
+  return flags | aiProcess_Triangulate;
+}
+
+//////////////////////////////////////////////////
+void AssimpLoader::Implementation::DecodeTexturesInBackground(
+    const Mesh &_mesh)
+{
+  std::vector<std::shared_ptr<const Image>> images;
+  for (unsigned int i = 0; i < _mesh.MaterialCount(); ++i)
+  {
+    auto mat = _mesh.MaterialByIndex(i);
+    if (!mat)
+      continue;
+    images.push_back(mat->TextureData());
+    if (auto pbr = mat->PbrMaterial())
+    {
+      images.push_back(pbr->NormalMapData());
+      images.push_back(pbr->RoughnessMapData());
+      images.push_back(pbr->MetalnessMapData());
+      images.push_back(pbr->EmissiveMapData());
+      images.push_back(pbr->LightMapData());
+    }
+  }
+
+  for (auto &image : images)
+  {
+    if (!image || image->Decoded())
+      continue;
+    if (!this->decodePool)
+      this->decodePool = std::make_unique<WorkerPool>();
+    // The work holds a reference, the image stays alive even if the mesh
+    // is released before it is decoded
+    this->decodePool->AddWork([image]() { image->Decode(); });
+  }
+}
+
 //////////////////////////////////////////////////
 Mesh *AssimpLoader::Load(const std::string &_filename)
 {
+  return this->Load(_filename, MeshLoadOptions());
+}
+
+//////////////////////////////////////////////////
+Mesh *AssimpLoader::Load(const std::string &_filename,
+    const MeshLoadOptions &_options)
+{
+  this->dataPtr->options = _options;
   Mesh *mesh = new Mesh();
   std::string path = common::parentPath(_filename);
-  const aiScene* scene = this->dataPtr->importer.ReadFile(_filename,
-      aiProcess_JoinIdenticalVertices |
-      aiProcess_RemoveRedundantMaterials |
-      aiProcess_SortByPType |
+  unsigned int flags = this->PostProcessFlags();
 #ifndef GZ_ASSIMP_PRE_5_2_0
-      aiProcess_PopulateArmatureData |
+  if (!_options.Skeleton())
+    flags &= ~static_cast<unsigned int>(aiProcess_PopulateArmatureData);
 #endif
-      aiProcess_Triangulate |
-      aiProcess_GenNormals |
-      0);
+  // Generating normals is one of the more expensive steps
+  if (!_options.Normals())
+    flags &= ~static_cast<unsigned int>(aiProcess_GenNormals);
+  const aiScene* scene = this->dataPtr->importer.ReadFile(_filename, flags);
   if (scene == nullptr)
   {
     gzerr << "Unable to import mesh [" << _filename << "]" << std::endl;
@@ -707,12 +884,23 @@ Mesh *AssimpLoader::Load(const std::string &_filename)
   auto rootTransform = this->dataPtr->ConvertTransform(transform);
 
   // Add the materials first
-  for (unsigned _matIdx = 0; _matIdx < scene->mNumMaterials; ++_matIdx)
+  std::vector<Implementation::MetallicRoughnessTask> metallicRoughnessTasks;
+  const unsigned int materialCount =
+      _options.Materials() ? scene->mNumMaterials : 0u;
+  for (unsigned _matIdx = 0; _matIdx < materialCount; ++_matIdx)
   {
-    auto mat = this->dataPtr->CreateMaterial(scene, _matIdx, path);
+    auto mat = this->dataPtr->CreateMaterial(scene, _matIdx, path,
+        metallicRoughnessTasks);
     mesh->AddMaterial(mat);
   }
+  this->dataPtr->SplitMetallicRoughnessMaps(metallicRoughnessTasks);
+  if (this->dataPtr->textureDecoding ==
+      AssimpLoader::TextureDecoding::BACKGROUND)
+  {
+    this->dataPtr->DecodeTexturesInBackground(*mesh);
+  }
   // Create the skeleton
+  if (_options.Skeleton())
   {
     std::unordered_set<std::string> boneNames;
     this->dataPtr->RecursiveStoreBoneNames(scene, rootNode, boneNames);
@@ -737,7 +925,9 @@ Mesh *AssimpLoader::Load(const std::string &_filename)
   // mesh is passed by reference and edited throughout
   this->dataPtr->RecursiveCreate(scene, rootNode, rootTransform, mesh);
   // Add the animations
-  for (unsigned animIdx = 0; animIdx < scene->mNumAnimations; ++animIdx)
+  const unsigned int animationCount =
+      _options.Animations() ? scene->mNumAnimations : 0u;
+  for (unsigned animIdx = 0; animIdx < animationCount; ++animIdx)
   {
     auto& anim = scene->mAnimations[animIdx];
     auto animName = ToString(anim->mName);
@@ -770,7 +960,8 @@ Mesh *AssimpLoader::Load(const std::string &_filename)
     mesh->MeshSkeleton()->AddAnimation(skelAnim);
   }
 
-  this->dataPtr->ApplyInvBindTransform(mesh->MeshSkeleton());
+  if (mesh->HasSkeleton())
+    this->dataPtr->ApplyInvBindTransform(mesh->MeshSkeleton());
 
   return mesh;
 }
@@ -729,6 +729,51 @@ TEST_F(AssimpLoader, LoadGlTF2BoxWithJPEGTexture)
   delete mesh;
 }
 
+/////////////////////////////////////////////////
+TEST_F(AssimpLoader, EmbeddedTextureDecoding)
+{
+  common::AssimpLoader loader;
+  EXPECT_EQ(common::AssimpLoader::TextureDecoding::DEFERRED,
+      loader.EmbeddedTextureDecoding());
+
+  // Deferred, the texture is decoded on first access
+  common::Mesh *mesh = loader.Load(
+      common::testing::TestFile("data", "box_texture_jpg.glb"));
+  ASSERT_NE(nullptr, mesh);
+  auto img = mesh->MaterialByIndex(0u)->TextureData();
+  ASSERT_NE(nullptr, img);
+  EXPECT_FALSE(img->Decoded());
+  EXPECT_TRUE(img->Valid());
+  EXPECT_TRUE(img->Decoded());
+  const auto width = img->Width();
+  EXPECT_GT(width, 0u);
+  delete mesh;
+
+  // Immediate
+  loader.SetEmbeddedTextureDecoding(
+      common::AssimpLoader::TextureDecoding::IMMEDIATE);
+  mesh = loader.Load(
+      common::testing::TestFile("data", "box_texture_jpg.glb"));
+  ASSERT_NE(nullptr, mesh);
+  img = mesh->MaterialByIndex(0u)->TextureData();
+  ASSERT_NE(nullptr, img);
+  EXPECT_TRUE(img->Decoded());
+  EXPECT_EQ(width, img->Width());
+  delete mesh;
+
+  // Background, the result is the same whether or not decoding finished
+  loader.SetEmbeddedTextureDecoding(
+      common::AssimpLoader::TextureDecoding::BACKGROUND);
+  mesh = loader.Load(
+      common::testing::TestFile("data", "box_texture_jpg.glb"));
+  ASSERT_NE(nullptr, mesh);
+  img = mesh->MaterialByIndex(0u)->TextureData();
+  ASSERT_NE(nullptr, img);
+  EXPECT_EQ(width, img->Width());
+  EXPECT_TRUE(img->Decoded());
+  delete mesh;
+}
+
 /////////////////////////////////////////////////
 // Use a fully featured glb test asset, including PBR textures, emissive maps
 // embedded textures, lightmaps, animations to test advanced glb features
@@ -874,3 +919,48 @@ TEST_F(AssimpLoader, LoadGLTF2Triangle)
   EXPECT_EQ(math::Vector2d(0, 1), subMeshB->TexCoord(2u));
   delete mesh;
 }
+
+/////////////////////////////////////////////////
+TEST_F(AssimpLoader, PostProcessProfile)
+{
+  common::AssimpLoader loader;
+  EXPECT_EQ(common::AssimpLoader::PostProcessing::DEFAULT,
+      loader.PostProcessProfile());
+  const unsigned int defaultFlags = loader.PostProcessFlags();
+
+  // FAST runs a subset of the default steps, QUALITY a superset
+  loader.SetPostProcessProfile(common::AssimpLoader::PostProcessing::FAST);
+  const unsigned int fastFlags = loader.PostProcessFlags();
+  EXPECT_NE(defaultFlags, fastFlags);
+  EXPECT_EQ(fastFlags, fastFlags & defaultFlags);
+
+  loader.SetPostProcessProfile(
+      common::AssimpLoader::PostProcessing::QUALITY);
+  const unsigned int qualityFlags = loader.PostProcessFlags();
+  EXPECT_NE(defaultFlags, qualityFlags);
+  EXPECT_EQ(defaultFlags, qualityFlags & defaultFlags);
+
+  // Custom flags always include triangulation
+  loader.SetPostProcessFlags(0u);
+  EXPECT_EQ(common::AssimpLoader::PostProcessing::CUSTOM,
+      loader.PostProcessProfile());
+  EXPECT_NE(0u, loader.PostProcessFlags());
+
+  // Well-formed meshes load the same with every profile
+  for (auto profile : {common::AssimpLoader::PostProcessing::DEFAULT,
+                       common::AssimpLoader::PostProcessing::FAST,
+                       common::AssimpLoader::PostProcessing::QUALITY,
+                       common::AssimpLoader::PostProcessing::CUSTOM})
+  {
+    loader.SetPostProcessProfile(profile);
+    common::Mesh *mesh = loader.Load(
+        common::testing::TestFile("data", "box.glb"));
+    ASSERT_NE(nullptr, mesh);
+    EXPECT_EQ(math::Vector3d(1, 1, 1), mesh->Max());
+    EXPECT_EQ(math::Vector3d(-1, -1, -1), mesh->Min());
+    EXPECT_EQ(24u, mesh->VertexCount());
+    EXPECT_EQ(24u, mesh->NormalCount());
+    EXPECT_EQ(36u, mesh->IndexCount());
+    delete mesh;
+  }
+}
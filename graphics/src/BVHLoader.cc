@@ -15,8 +15,14 @@
  *
 */
 #include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <iterator>
 #include <sstream>
+#include <utility>
+#include <vector>
 
 #include <gz/common/SystemPaths.hh>
 #include <gz/common/Skeleton.hh>
@@ -24,42 +30,100 @@
 #include <gz/common/Console.hh>
 #include <gz/common/BVHLoader.hh>
 
+#include "ParallelFor.hh"
+
 using namespace gz;
 using namespace common;
 
-/////////////////////////////////////////////////
-BVHLoader::BVHLoader()
+namespace
 {
-}
+  /// \brief Channels of a BVH joint
+  enum class Channel
+  {
+    XPOSITION, YPOSITION, ZPOSITION, XROTATION, YROTATION, ZROTATION, OTHER
+  };
 
-/////////////////////////////////////////////////
-BVHLoader::~BVHLoader()
-{
-}
+  /////////////////////////////////////////////////
+  /// \brief Get the type of a channel from its name.
+  /// \param[in] _name Name of the channel, e.g. "Xrotation".
+  /// \return The channel type.
+  Channel channelType(const std::string &_name)
+  {
+    if (_name == "Xposition")
+      return Channel::XPOSITION;
+    if (_name == "Yposition")
+      return Channel::YPOSITION;
+    if (_name == "Zposition")
+      return Channel::ZPOSITION;
+    if (_name == "Xrotation")
+      return Channel::XROTATION;
+    if (_name == "Yrotation")
+      return Channel::YROTATION;
+    if (_name == "Zrotation")
+      return Channel::ZROTATION;
+    return Channel::OTHER;
+  }
 
-/////////////////////////////////////////////////
-std::unique_ptr<Skeleton> BVHLoader::Load(const std::string &_filename,
-    const double _scale)
-{
-  std::string fullname = findFile(_filename);
-  if (fullname.empty())
-    return nullptr;
+  /////////////////////////////////////////////////
+  /// \brief Parse the values of a frame of the MOTION block.
+  /// \param[in] _begin Start of the line.
+  /// \param[in] _end End of the line.
+  /// \param[out] _values Parsed values.
+  /// \param[in] _count Number of values to parse.
+  /// \return Number of values parsed, lower than _count if the line is
+  /// too short or has an invalid value.
+  std::size_t parseFrame(const char *_begin, const char *_end,
+      double *_values, const std::size_t _count)
+  {
+    std::size_t parsed = 0;
+    const char *p = _begin;
+    while (parsed < _count)
+    {
+      while (p < _end && std::isspace(static_cast<unsigned char>(*p)))
+        ++p;
+      if (p == _end)
+        break;
+
+      // Numbers can not span lines, strtod stops at the end of the line
+      char *next = nullptr;
+      _values[parsed] = std::strtod(p, &next);
+      if (next == p)
+        break;
+      p = next;
+      ++parsed;
+    }
+    return parsed;
+  }
 
-  std::unique_ptr<Skeleton> skeleton;
-  std::ifstream file;
-  file.open(fullname.c_str());
-  std::vector<SkeletonNode*> nodes;
-  std::vector<std::vector<std::string> > nodeChannels;
-  unsigned int totalChannels = 0;
-  std::string line;
-  if (file.is_open())
+  /////////////////////////////////////////////////
+  /// \brief Load a BVH file.
+  /// \param[in] _fullname Full path of the file.
+  /// \param[in] _filename Name of the file, used as animation name.
+  /// \param[in] _scale Scaling factor to apply to the skeleton.
+  /// \return The skeleton, or nullptr on error.
+  std::unique_ptr<Skeleton> loadFile(const std::string &_fullname,
+      const std::string &_filename, const double _scale)
   {
+    // Read the whole file at once, the motion block is parsed in place
+    std::string data;
+    {
+      std::ifstream input(_fullname, std::ios::binary);
+      if (!input.is_open())
+        return nullptr;
+      data.assign(std::istreambuf_iterator<char>(input),
+          std::istreambuf_iterator<char>());
+    }
+
+    std::unique_ptr<Skeleton> skeleton;
+    std::istringstream file(data);
+    std::vector<SkeletonNode*> nodes;
+    std::vector<std::vector<std::string> > nodeChannels;
+    unsigned int totalChannels = 0;
+    std::string line;
+
     getline(file, line);
     if (line.find("HIERARCHY") == std::string::npos)
-    {
-      file.close();
       return nullptr;
-    }
 
     SkeletonNode *parent = nullptr;
     SkeletonNode *node = nullptr;
@@ -71,10 +135,7 @@ std::unique_ptr<Skeleton> BVHLoader::Load(const std::string &_filename,
       if (words[0] == "ROOT" || words[0] == "JOINT")
       {
         if (words.size() < 2)
-        {
-          file.close();
           return nullptr;
-        }
         SkeletonNode::SkeletonNodeType type = SkeletonNode::JOINT;
         std::string name = words[1];
         node = new SkeletonNode(parent, name, name, type);
@@ -86,10 +147,7 @@ std::unique_ptr<Skeleton> BVHLoader::Load(const std::string &_filename,
         if (words[0] == "OFFSET")
         {
           if (words.size() < 4)
-          {
-            file.close();
             return nullptr;
-          }
           math::Vector3d offset = math::Vector3d(
               math::parseFloat(words[1]) * _scale,
               math::parseFloat(words[2]) * _scale,
@@ -106,7 +164,6 @@ std::unique_ptr<Skeleton> BVHLoader::Load(const std::string &_filename,
                 static_cast<size_t>(math::parseInt(words[1]) + 2) >
                  words.size())
             {
-              file.close();
               return nullptr;
             }
             nodeChannels.push_back(words);
@@ -137,10 +194,7 @@ std::unique_ptr<Skeleton> BVHLoader::Load(const std::string &_filename,
                 else
                 {
                   if (nodes.empty())
-                  {
-                    file.close();
                     return nullptr;
-                  }
                   skeleton.reset(new Skeleton(nodes[0]));
                   break;
                 }
@@ -150,139 +204,196 @@ std::unique_ptr<Skeleton> BVHLoader::Load(const std::string &_filename,
         }
       }
     }
-  }
-  getline(file, line);
-  trim(line);
-  std::vector<std::string> words = split(line, " ");
-  unsigned int frameCount = 0;
-  double frameTime = 0.0;
-  if (words[0] != "Frames:" || words.size() < 2)
-  {
-    file.close();
-    return nullptr;
-  }
-  else
-  {
-    frameCount = static_cast<unsigned int>(math::parseInt(words[1]));
-  }
-
-  getline(file, line);
-  words.clear();
-  trim(line);
-  words = split(line, " ");
-
-  if (words.size() < 3 || words[0] != "Frame" || words[1] != "Time:")
-  {
-    file.close();
-    return nullptr;
-  }
-  else
-    frameTime = math::parseFloat(words[2]);
 
-  double time = 0.0;
-  unsigned int frameNo = 0;
-
-  SkeletonAnimation *animation = new SkeletonAnimation(_filename);
+    getline(file, line);
+    trim(line);
+    std::vector<std::string> words = split(line, " ");
+    unsigned int frameCount = 0;
+    double frameTime = 0.0;
+    if (words[0] != "Frames:" || words.size() < 2)
+      return nullptr;
+    else
+      frameCount = static_cast<unsigned int>(math::parseInt(words[1]));
 
-  while (!file.eof())
-  {
     getline(file, line);
     words.clear();
     trim(line);
     words = split(line, " ");
-    if (words.size() < totalChannels)
+
+    if (words.size() < 3 || words[0] != "Frame" || words[1] != "Time:")
+      return nullptr;
+    else
+      frameTime = math::parseFloat(words[2]);
+
+    if (nodeChannels.size() != nodes.size())
+    {
+      gzerr << "BVH file [" << _filename << "] has [" << nodes.size()
+            << "] joints but [" << nodeChannels.size()
+            << "] channel lists.\n";
+      return nullptr;
+    }
+
+    // Parse the motion block into a frames x channels matrix. Invalid
+    // frames are skipped but still take time.
+    std::vector<double> motion;
+    std::vector<double> times;
+    const std::size_t stride = totalChannels;
+    const std::streamoff motionStart = file.tellg();
+    if (motionStart >= 0)
+    {
+      const std::size_t maxFrames = stride > 0 ?
+          (data.size() - static_cast<std::size_t>(motionStart)) /
+          (2 * stride) + 1 : 0;
+      motion.reserve(std::min<std::size_t>(frameCount, maxFrames) * stride);
+      times.reserve(std::min<std::size_t>(frameCount, maxFrames));
+    }
+
+    double time = 0.0;
+    unsigned int frameNo = 0;
+    const char *p = motionStart >= 0 ? data.data() + motionStart : nullptr;
+    const char *end = data.data() + data.size();
+    while (p && p < end)
     {
-      gzwarn << "Frame " << frameNo << " invalid.\n";
+      const char *lineEnd = static_cast<const char *>(
+          std::memchr(p, '\n', end - p));
+      if (!lineEnd)
+        lineEnd = end;
+
+      const std::size_t first = motion.size();
+      motion.resize(first + stride);
+      if (parseFrame(p, lineEnd, motion.data() + first, stride) < stride)
+      {
+        gzwarn << "Frame " << frameNo << " invalid.\n";
+        motion.resize(first);
+      }
+      else
+      {
+        times.push_back(time);
+      }
+      p = lineEnd + 1;
+
       frameNo++;
       time += frameTime;
-      continue;
+      if (frameNo == frameCount)
+        break;
     }
+    if (frameNo < frameCount)
+      gzwarn << "BVH file ended unexpectedly.\n";
 
-    unsigned int cursor = 0;
+    // Build the keyframes of each joint in one go
+    SkeletonAnimation *animation = new SkeletonAnimation(_filename);
+    const math::Vector3d xAxis(1, 0, 0);
+    const math::Vector3d yAxis(0, 1, 0);
+    const math::Vector3d zAxis(0, 0, 1);
+    std::vector<Channel> channels;
+    std::vector<math::Matrix4d> mats;
+    std::size_t offset = 0;
     for (unsigned int i = 0; i < nodes.size(); ++i)
     {
-      SkeletonNode *node = nodes[i];
-      std::vector<std::string> channels = nodeChannels[i];
-      math::Vector3d translation = node->Transform().Translation();
-      math::Vector3d xAxis(1, 0, 0);
-      math::Vector3d yAxis(0, 1, 0);
-      math::Vector3d zAxis(0, 0, 1);
-      double xAngle = 0.0;
-      double yAngle = 0.0;
-      double zAngle = 0.0;
-      math::Matrix4d transform(math::Matrix4d::Identity);
-      std::vector<math::Matrix4d> mats;
-      unsigned int chanCount = math::parseInt(channels[1]);
+      SkeletonNode *jointNode = nodes[i];
+      const unsigned int chanCount = math::parseInt(nodeChannels[i][1]);
+      channels.clear();
       for (unsigned int j = 2; j < (2 + chanCount); ++j)
+        channels.push_back(channelType(nodeChannels[i][j]));
+
+      const math::Vector3d restTranslation =
+          jointNode->Transform().Translation();
+      std::vector<math::Matrix4d> transforms;
+      transforms.reserve(times.size());
+      for (std::size_t f = 0; f < times.size(); ++f)
       {
-        double value = math::parseFloat(words[cursor]);
-        cursor++;
-        std::string channel = channels[j];
-        if (channel == "Xposition")
-          translation.X(value * _scale);
-        else
+        const double *values = motion.data() + f * stride + offset;
+        math::Vector3d translation = restTranslation;
+        math::Matrix4d transform(math::Matrix4d::Identity);
+        mats.clear();
+        for (std::size_t j = 0; j < channels.size(); ++j)
         {
-          if (channel == "Yposition")
+          const double value = values[j];
+          switch (channels[j])
           {
-            translation.Y(value * _scale);
-          }
-          else
-          {
-            if (channel == "Zposition")
-            {
+            case Channel::XPOSITION:
+              translation.X(value * _scale);
+              break;
+            case Channel::YPOSITION:
+              translation.Y(value * _scale);
+              break;
+            case Channel::ZPOSITION:
               translation.Z(value * _scale);
-            }
-            else
-            {
-              if (channel == "Zrotation")
-              {
-                zAngle = GZ_DTOR(value);
-                mats.push_back(math::Matrix4d(
-                      math::Quaterniond(zAxis, zAngle)));
-              }
-              else
-              {
-                if (channel == "Xrotation")
-                {
-                  xAngle = GZ_DTOR(value);
-                  mats.push_back(math::Matrix4d(
-                    math::Quaterniond(xAxis, xAngle)));
-                }
-                else
-                {
-                  if (channel == "Yrotation")
-                  {
-                    yAngle = GZ_DTOR(value);
-                    mats.push_back(math::Matrix4d(
-                      math::Quaterniond(yAxis, yAngle)));
-                  }
-                }
-              }
-            }
+              break;
+            case Channel::XROTATION:
+              mats.push_back(math::Matrix4d(
+                  math::Quaterniond(xAxis, GZ_DTOR(value))));
+              break;
+            case Channel::YROTATION:
+              mats.push_back(math::Matrix4d(
+                  math::Quaterniond(yAxis, GZ_DTOR(value))));
+              break;
+            case Channel::ZROTATION:
+              mats.push_back(math::Matrix4d(
+                  math::Quaterniond(zAxis, GZ_DTOR(value))));
+              break;
+            default:
+              break;
           }
         }
+        while (!mats.empty())
+        {
+          transform = mats.back() * transform;
+          mats.pop_back();
+        }
+        math::Matrix4d pos(math::Matrix4d::Identity);
+        pos.SetTranslation(translation);
+        transforms.push_back(pos * transform);
       }
-      while (!mats.empty())
-      {
-        transform = mats.back() * transform;
-        mats.pop_back();
-      }
-      math::Matrix4d pos(math::Matrix4d::Identity);
-      pos.SetTranslation(translation);
-      transform = pos * transform;
-      animation->AddKeyFrame(node->Name(), time, transform);
+      animation->SetKeyFrames(jointNode->Name(), times,
+          std::move(transforms));
+      offset += chanCount;
     }
 
-    frameNo++;
-    time += frameTime;
-    if (frameNo == frameCount)
-      break;
+    skeleton->AddAnimation(animation);
+    return skeleton;
   }
-  if (frameNo < frameCount - 1)
-    gzwarn << "BVH file ended unexpectedly.\n";
+}
 
-  skeleton->AddAnimation(animation);
+/////////////////////////////////////////////////
+BVHLoader::BVHLoader()
+{
+}
+
+/////////////////////////////////////////////////
+BVHLoader::~BVHLoader()
+{
+}
+
+/////////////////////////////////////////////////
+std::unique_ptr<Skeleton> BVHLoader::Load(const std::string &_filename,
+    const double _scale)
+{
+  std::string fullname = findFile(_filename);
+  if (fullname.empty())
+    return nullptr;
+
+  return loadFile(fullname, _filename, _scale);
+}
+
+/////////////////////////////////////////////////
+std::vector<std::unique_ptr<Skeleton>> BVHLoader::Load(
+    const std::vector<std::string> &_filenames, const double _scale)
+{
+  // Resolve the paths on the calling thread
+  std::vector<std::string> fullnames;
+  fullnames.reserve(_filenames.size());
+  for (const auto &filename : _filenames)
+    fullnames.push_back(findFile(filename));
+
+  std::vector<std::unique_ptr<Skeleton>> skeletons(_filenames.size());
+
+  // One file per task
+  parallelFor(fullnames.size(), [&](const std::size_t _i)
+  {
+    if (!fullnames[_i].empty())
+      skeletons[_i] = loadFile(fullnames[_i], _filenames[_i], _scale);
+  });
 
-  file.close();
-  return skeleton;
+  return skeletons;
 }
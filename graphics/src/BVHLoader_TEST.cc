@@ -17,7 +17,13 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
+#include <string>
+#include <vector>
+
 #include "gz/common/BVHLoader.hh"
+#include "gz/common/Filesystem.hh"
+#include "gz/common/NodeAnimation.hh"
 #include "gz/common/Skeleton.hh"
 #include "gz/common/SkeletonAnimation.hh"
 #include "gz/common/testing/AutoLogFixture.hh"
@@ -41,3 +47,72 @@ TEST_F(BHVLoaderTest, LoadBVH)
   EXPECT_EQ(skel->RootNode()->Name(), std::string("Hips"));
   EXPECT_EQ(31u, skel->NodeCount());
 }
+
+/////////////////////////////////////////////////
+TEST_F(BHVLoaderTest, LoadMany)
+{
+  const std::string file = common::testing::TestFile("data", "cmu-13_26.bvh");
+  common::BVHLoader loader;
+  auto skel = loader.Load(file, 0.5);
+  ASSERT_NE(nullptr, skel);
+  ASSERT_EQ(1u, skel->AnimationCount());
+  common::SkeletonAnimation *anim = skel->Animation(0);
+  EXPECT_EQ(31u, anim->NodeCount());
+  common::NodeAnimation *hips = anim->NodeAnimationByName("Hips");
+  ASSERT_NE(nullptr, hips);
+  EXPECT_LT(1u, hips->FrameCount());
+
+  auto skeletons = loader.Load(
+      std::vector<std::string>{file, "no_such_file.bvh", file}, 0.5);
+  ASSERT_EQ(3u, skeletons.size());
+  EXPECT_EQ(nullptr, skeletons[1]);
+  for (std::size_t i : {0u, 2u})
+  {
+    ASSERT_NE(nullptr, skeletons[i]);
+    EXPECT_EQ(31u, skeletons[i]->NodeCount());
+    ASSERT_EQ(1u, skeletons[i]->AnimationCount());
+    common::NodeAnimation *other =
+        skeletons[i]->Animation(0)->NodeAnimationByName("Hips");
+    ASSERT_NE(nullptr, other);
+    ASSERT_EQ(hips->FrameCount(), other->FrameCount());
+    EXPECT_DOUBLE_EQ(hips->Length(), other->Length());
+    const unsigned int last = hips->FrameCount() - 1;
+    EXPECT_EQ(hips->KeyFrame(last).second, other->KeyFrame(last).second);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(BHVLoaderTest, MissingFrame)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+
+  // Keep the hierarchy and the first two frames, but announce three
+  std::ifstream in(common::testing::TestFile("data", "cmu-13_26.bvh"));
+  const std::string path = common::joinPaths(tempDir->Path(), "short.bvh");
+  std::ofstream out(path);
+  std::string line;
+  int frames = -1;
+  while (frames < 2 && std::getline(in, line))
+  {
+    if (line.rfind("Frames:", 0) == 0)
+      line = "Frames: 3";
+    else if (line.rfind("Frame Time:", 0) == 0)
+      frames = 0;
+    else if (frames >= 0)
+      ++frames;
+    out << line << "\n";
+  }
+  out.close();
+
+  common::BVHLoader loader;
+  auto skel = loader.Load(path, 1);
+  ASSERT_NE(nullptr, skel);
+  ASSERT_EQ(1u, skel->AnimationCount());
+  common::NodeAnimation *hips =
+      skel->Animation(0)->NodeAnimationByName("Hips");
+  ASSERT_NE(nullptr, hips);
+  EXPECT_EQ(2u, hips->FrameCount());
+  EXPECT_NE(std::string::npos,
+      this->LogContent().find("BVH file ended unexpectedly"));
+}
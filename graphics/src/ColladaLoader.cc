@@ -14,9 +14,12 @@
  * limitations under the License.
  *
  */
+#include <atomic>
+#include <cstdlib>
 #include <sstream>
 #include <unordered_map>
 #include <map>
+#include <utility>
 #include <vector>
 #include <set>
 
@@ -43,6 +46,37 @@ using namespace common;
 using RawNodeAnim = std::map<double, std::vector<NodeTransform> >;
 using RawSkeletonAnim = std::map<std::string, RawNodeAnim>;
 
+namespace
+{
+  /// \brief Parse the values of a <float_array> element.
+  /// \param[in] _xml The float_array element.
+  /// \param[out] _values The values, parsing stops at the first invalid
+  /// value.
+  void parseFloatArray(const tinyxml2::XMLElement *_xml,
+      std::vector<double> &_values)
+  {
+    _values.clear();
+    if (nullptr == _xml || nullptr == _xml->GetText())
+      return;
+
+    unsigned int count = 0;
+    if (_xml->QueryUnsignedAttribute("count", &count) ==
+        tinyxml2::XML_SUCCESS)
+    {
+      _values.reserve(count);
+    }
+
+    const char *text = _xml->GetText();
+    char *end = nullptr;
+    for (double value = std::strtod(text, &end); end != text;
+        value = std::strtod(text, &end))
+    {
+      _values.push_back(value);
+      text = end;
+    }
+  }
+}
+
 namespace gz
 {
   namespace common
@@ -101,6 +135,9 @@ namespace gz
       /// \brief Current scene being parsed
       public: tinyxml2::XMLElement *currentScene = nullptr;
 
+      /// \brief Parts of the mesh being loaded
+      public: MeshLoadOptions options;
+
       /// \brief Load a controller instance
       /// \param[in] _contrXml Pointer to the control XML instance
       /// \param[in] _skelXml Pointer the skeleton xml instance
@@ -371,6 +408,14 @@ ColladaLoader::~ColladaLoader() = default;
 //////////////////////////////////////////////////
 Mesh *ColladaLoader::Load(const std::string &_filename)
 {
+  return this->Load(_filename, MeshLoadOptions());
+}
+
+//////////////////////////////////////////////////
+Mesh *ColladaLoader::Load(const std::string &_filename,
+    const MeshLoadOptions &_options)
+{
+  this->dataPtr->options = _options;
   this->dataPtr->positionIds.clear();
   this->dataPtr->normalIds.clear();
   this->dataPtr->texcoordIds.clear();
@@ -499,7 +544,7 @@ void ColladaLoader::Implementation::LoadNode(
     if (nodeName.empty())
     {
       // if none of the ancestor node has a name, then create a custom name
-      static int nodeCounter = 0;
+      static std::atomic<int> nodeCounter{0};
       nodeName = "unnamed_submesh_" + std::to_string(nodeCounter++);
     }
     this->currentNodeName = nodeName;
@@ -692,6 +737,14 @@ void ColladaLoader::Implementation::LoadController(
 
   std::string geomURL = skinXml->Attribute("source");
 
+  // Without skeleton only the skinned geometry is loaded
+  if (!this->options.Skeleton())
+  {
+    this->LoadGeometry(this->ElementId("geometry", geomURL), _transform,
+        _mesh);
+    return;
+  }
+
   auto shapeMat = skinXml->FirstChildElement("bind_shape_matrix");
   if (nullptr == shapeMat || nullptr == shapeMat->GetText())
   {
@@ -789,7 +842,8 @@ void ColladaLoader::Implementation::LoadController(
   skeleton->SetBindShapeTransform(bindTrans);
 
   tinyxml2::XMLElement *rootXml = _contrXml->GetDocument()->RootElement();
-  if (rootXml && rootXml->FirstChildElement("library_animations"))
+  if (this->options.Animations() && rootXml &&
+      rootXml->FirstChildElement("library_animations"))
   {
     this->LoadAnimations(rootXml->FirstChildElement("library_animations"),
         skeleton);
@@ -1015,23 +1069,13 @@ void ColladaLoader::Implementation::LoadAnimationSet(tinyxml2::XMLElement *_xml,
 
         inputXml = inputXml->NextSiblingElement("input");
       }
-      tinyxml2::XMLElement *timeArray =
-          frameTimesXml->FirstChildElement("float_array");
-      std::string timeStr = timeArray->GetText();
-      std::vector<std::string> timeStrs = split(timeStr, " \t\r\n");
-
       std::vector<double> times;
-      for (unsigned int i = 0; i < timeStrs.size(); ++i)
-        times.push_back(math::parseFloat(timeStrs[i]));
-
-      tinyxml2::XMLElement *output =
-          frameTransXml->FirstChildElement("float_array");
-      std::string outputStr = output->GetText();
-      std::vector<std::string> outputStrs = split(outputStr, " \t\r\n");
+      parseFloatArray(frameTimesXml->FirstChildElement("float_array"),
+          times);
 
       std::vector<double> values;
-      for (unsigned int i = 0; i < outputStrs.size(); ++i)
-        values.push_back(math::parseFloat(outputStrs[i]));
+      parseFloatArray(frameTransXml->FirstChildElement("float_array"),
+          values);
 
       tinyxml2::XMLElement *accessor =
         frameTransXml->FirstChildElement("technique_common");
@@ -1070,41 +1114,58 @@ void ColladaLoader::Implementation::LoadAnimationSet(tinyxml2::XMLElement *_xml,
       // the nodes are identified by `name` in this loader. Here, we resolve
       // `targetBone` to the node's `name` to prevent missing animations.
       std::string targetBoneName = targetNode->Name();
-      for (unsigned int i = 0; i < times.size(); ++i)
+      RawNodeAnim &nodeAnim = animation[targetBoneName];
+
+      std::vector<NodeTransform> boneTransforms;
+      auto bone = _skel->NodeById(targetBone);
+      if (nullptr != bone)
+      {
+        boneTransforms = bone->Transforms();
+      }
+      else
       {
-        if (animation[targetBoneName].find(times[i]) ==
-            animation[targetBoneName].end())
+        gzerr << "Failed to find node with ID [" << targetBone << "]"
+               << std::endl;
+      }
+
+      // Frames start as copies of the bone transforms, find the transforms
+      // targeted by this channel once
+      std::vector<std::size_t> targets;
+      for (std::size_t j = 0; j < boneTransforms.size(); ++j)
+      {
+        if (boneTransforms[j].SID() == targetTrans)
+          targets.push_back(j);
+      }
+
+      const std::size_t valuesPerFrame = idx1 != -1 ? 1u : stride;
+      if (!targets.empty() && values.size() < times.size() * valuesPerFrame)
+      {
+        gzerr << "Animation channel [" << targetStr << "] has fewer values "
+               << "than key frames" << std::endl;
+        targets.clear();
+      }
+
+      for (std::size_t i = 0; i < times.size(); ++i)
+      {
+        auto frame = nodeAnim.lower_bound(times[i]);
+        if (frame == nodeAnim.end() || frame->first != times[i])
+          frame = nodeAnim.emplace_hint(frame, times[i], boneTransforms);
+
+        for (const std::size_t j : targets)
         {
-          auto bone = _skel->NodeById(targetBone);
-          if (nullptr != bone)
+          if (j >= frame->second.size())
+            continue;
+
+          NodeTransform *nt = &frame->second[j];
+          if (idx1 != -1)
           {
-            animation[targetBoneName][times[i]] = bone->Transforms();
+            int index = (idx2 == -1) ? idx1 : (idx1 * 4) + idx2;
+            nt->SetComponent(index, values[i]);
           }
           else
           {
-            gzerr << "Failed to find node with ID [" << targetBone << "]"
-                   << std::endl;
-          }
-        }
-
-        std::vector<NodeTransform> *frame =
-            &animation[targetBoneName][times[i]];
-
-        for (unsigned int j = 0; j < (*frame).size(); ++j)
-        {
-          NodeTransform *nt = &((*frame)[j]);
-          if (nt->SID() == targetTrans)
-          {
-            if (idx1 != -1)
-            {
-              int index = (idx2 == -1) ? idx1 : (idx1 * 4) + idx2;
-              nt->SetComponent(index, values[i]);
-            }
-            else
-            {
-              for (unsigned int k = 0; k < stride; k++)
-                nt->SetComponent(k, values[(i*stride) + k]);
-            }
+            for (unsigned int k = 0; k < stride; k++)
+              nt->SetComponent(k, values[(i*stride) + k]);
           }
         }
       }
@@ -1117,19 +1178,26 @@ void ColladaLoader::Implementation::LoadAnimationSet(tinyxml2::XMLElement *_xml,
 
   SkeletonAnimation *anim = new SkeletonAnimation(animName.str());
 
-  for (RawSkeletonAnim::iterator iter = animation.begin();
-        iter != animation.end(); ++iter)
-    for (RawNodeAnim::iterator niter = iter->second.begin();
-          niter != iter->second.end(); ++niter)
+  // Frames are sorted by time, each node animation is built in one go
+  for (auto &[boneName, frames] : animation)
+  {
+    std::vector<double> times;
+    std::vector<gz::math::Matrix4d> transforms;
+    times.reserve(frames.size());
+    transforms.reserve(frames.size());
+    for (auto &[time, nodeTransforms] : frames)
     {
       gz::math::Matrix4d transform(gz::math::Matrix4d::Identity);
-      for (unsigned int i = 0; i < niter->second.size(); ++i)
+      for (auto &nodeTransform : nodeTransforms)
       {
-        niter->second[i].RecalculateMatrix();
-        transform = transform * niter->second[i]();
+        nodeTransform.RecalculateMatrix();
+        transform = transform * nodeTransform();
       }
-      anim->AddKeyFrame(iter->first, niter->first, transform);
+      times.push_back(time);
+      transforms.push_back(transform);
     }
+    anim->SetKeyFrames(boneName, std::move(times), std::move(transforms));
+  }
 
   _skel->AddAnimation(anim);
 }
@@ -1883,7 +1951,8 @@ void ColladaLoader::Implementation::LoadColorOrTexture(
     else if (_type == "specular")
       _mat->SetSpecular(color);
   }
-  else if (typeElem->FirstChildElement("texture"))
+  else if (typeElem->FirstChildElement("texture") &&
+           this->options.Textures())
   {
     if (_type == "ambient")
     {
@@ -1973,7 +2042,7 @@ void ColladaLoader::Implementation::LoadPolylist(
 
   subMesh->SetPrimitiveType(SubMesh::TRIANGLES);
 
-  if (_polylistXml->Attribute("material"))
+  if (this->options.Materials() && _polylistXml->Attribute("material"))
   {
     std::map<std::string, std::string>::iterator iter;
     std::string matStr = _polylistXml->Attribute("material");
@@ -2033,16 +2102,16 @@ void ColladaLoader::Implementation::LoadPolylist(
       this->LoadVertices(source, _transform, verts, norms,
           positionDupMap, normalDupMap);
       if (norms.size() > count)
-        combinedVertNorms = true;
+        combinedVertNorms = this->options.Normals();
       inputs[VERTEX].insert(gz::math::parseInt(offset));
     }
-    else if (semantic == "NORMAL")
+    else if (semantic == "NORMAL" && this->options.Normals())
     {
       this->LoadNormals(source, _transform, norms, normalDupMap);
       combinedVertNorms = false;
       inputs[NORMAL].insert(gz::math::parseInt(offset));
     }
-    else if (semantic == "TEXCOORD")
+    else if (semantic == "TEXCOORD" && this->options.TexCoords())
     {
       int offsetInt = gz::math::parseInt(offset);
       unsigned int set = 0u;
@@ -2055,9 +2124,13 @@ void ColladaLoader::Implementation::LoadPolylist(
     }
     else
     {
+      // Skipped inputs still take a slot in <p>
       inputs[otherSemantics++].insert(gz::math::parseInt(offset));
-      gzwarn << "Polylist input semantic: '" << semantic << "' is currently"
-          << " not supported" << std::endl;
+      if (semantic != "NORMAL" && semantic != "TEXCOORD")
+      {
+        gzwarn << "Polylist input semantic: '" << semantic << "' is "
+            << "currently not supported" << std::endl;
+      }
     }
 
     polylistInputXml = polylistInputXml->NextSiblingElement("input");
@@ -2306,7 +2379,7 @@ void ColladaLoader::Implementation::LoadTriangles(
 
   subMesh->SetPrimitiveType(SubMesh::TRIANGLES);
 
-  if (_trianglesXml->Attribute("material"))
+  if (this->options.Materials() && _trianglesXml->Attribute("material"))
   {
     std::map<std::string, std::string>::iterator iter;
     std::string matStr = _trianglesXml->Attribute("material");
@@ -2365,11 +2438,11 @@ void ColladaLoader::Implementation::LoadTriangles(
       this->LoadVertices(source, _transform, verts, norms,
           positionDupMap, normalDupMap);
       if (norms.size() > count)
-        combinedVertNorms = true;
+        combinedVertNorms = this->options.Normals();
       inputs[VERTEX].insert(gz::math::parseInt(offset));
       hasVertices = true;
     }
-    else if (semantic == "NORMAL")
+    else if (semantic == "NORMAL" && this->options.Normals())
     {
       this->LoadNormals(source, _transform, norms, normalDupMap);
       combinedVertNorms = false;
@@ -2377,7 +2450,7 @@ void ColladaLoader::Implementation::LoadTriangles(
       if (norms.size() > 0)
         hasNormals = true;
     }
-    else if (semantic == "TEXCOORD")
+    else if (semantic == "TEXCOORD" && this->options.TexCoords())
     {
       int offsetInt = gz::math::parseInt(offset);
       unsigned int set = 0u;
@@ -2391,9 +2464,13 @@ void ColladaLoader::Implementation::LoadTriangles(
     }
     else
     {
+      // Skipped inputs still take a slot in <p>
       inputs[otherSemantics++].insert(gz::math::parseInt(offset));
-      gzwarn << "Triangle input semantic: '" << semantic << "' is currently"
-          << " not supported" << std::endl;
+      if (semantic != "NORMAL" && semantic != "TEXCOORD")
+      {
+        gzwarn << "Triangle input semantic: '" << semantic << "' is "
+            << "currently not supported" << std::endl;
+      }
     }
     trianglesInputXml = trianglesInputXml->NextSiblingElement("input");
   }
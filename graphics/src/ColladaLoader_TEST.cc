@@ -503,3 +503,29 @@ TEST_F(ColladaLoader, LoadCylinderAnimatedFrom3dsMax)
   EXPECT_TRUE(anim->HasNode("Bone02"));
   delete mesh;
 }
+
+/////////////////////////////////////////////////
+TEST_F(ColladaLoader, LoadOptions)
+{
+  common::ColladaLoader loader;
+  const std::string file = common::testing::TestFile("data",
+      "cylinder_animated_from_3ds_max.dae");
+
+  common::MeshLoadOptions options;
+  options.SetAnimations(false);
+  common::Mesh *mesh = loader.Load(file, options);
+  EXPECT_EQ(202u, mesh->NormalCount());
+  EXPECT_TRUE(mesh->HasSkeleton());
+  ASSERT_NE(nullptr, mesh->MeshSkeleton());
+  EXPECT_EQ(0u, mesh->MeshSkeleton()->AnimationCount());
+  delete mesh;
+
+  mesh = loader.Load(file, common::MeshLoadOptions::GeometryOnly());
+  EXPECT_LT(0u, mesh->VertexCount());
+  EXPECT_EQ(852u, mesh->IndexCount());
+  EXPECT_EQ(0u, mesh->NormalCount());
+  EXPECT_EQ(0u, mesh->TexCoordCount());
+  EXPECT_EQ(0u, mesh->MaterialCount());
+  EXPECT_FALSE(mesh->HasSkeleton());
+  delete mesh;
+}
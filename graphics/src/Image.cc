@@ -19,10 +19,16 @@
 #endif
 #include <FreeImage.h>
 
+#include <atomic>
 #include <cstring>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <gz/common/Console.hh>
+#include <gz/common/Pool.hh>
 #include <gz/common/Util.hh>
 #include <gz/common/Image.hh>
 
@@ -36,8 +42,32 @@ namespace gz
     /// \brief Private data class
     class Image::Implementation
     {
-      /// \brief bitmap data
-      public: FIBITMAP *bitmap;
+      /// \brief Compressed data set with SetFromCompressedDataDeferred
+      public: struct PendingData
+      {
+        /// \brief Protects the decoding
+        std::mutex mutex;
+
+        /// \brief Compressed bytes, released once decoded
+        std::vector<unsigned char> data;
+
+        /// \brief Format of data
+        FREE_IMAGE_FORMAT format{FIF_UNKNOWN};
+
+        /// \brief True once data was decoded into bitmap
+        std::atomic<bool> decoded{false};
+      };
+
+      /// \brief bitmap data. Mutable because deferred data is decoded on
+      /// first access, which may be through a const function.
+      public: mutable FIBITMAP *bitmap;
+
+      /// \brief Data waiting to be decoded, null if the image was not set
+      /// with SetFromCompressedDataDeferred.
+      public: std::shared_ptr<PendingData> pending;
+
+      /// \brief Decode pending data into bitmap, if not done yet
+      public: void Decode() const;
 
       /// \brief path name of the image file
       public: std::string fullName;
@@ -48,8 +78,11 @@ namespace gz
       public: void DataImpl(unsigned char **_data, unsigned int &_count,
           FIBITMAP *_img) const;
 
-      /// \brief Implementation of Data, returns vector of bytes
-      public: std::vector<unsigned char> DataImpl(FIBITMAP *_img) const;
+      /// \brief Implementation of Data, fills a vector of bytes
+      /// \param[in] _img Bitmap to read.
+      /// \param[out] _data Resized and filled with the raw bits of _img.
+      public: void DataImpl(FIBITMAP *_img,
+                            std::vector<unsigned char> &_data) const;
 
       /// \brief Returns true if SwapRedBlue can and should be called
       /// If it returns false, it may not be safe to call SwapRedBlue
@@ -81,16 +114,125 @@ namespace gz
   }
 }
 
+namespace
+{
+  /// \brief Get the FreeImage format of a compressed pixel format.
+  /// \param[in] _format Pixel format.
+  /// \return FIF_UNKNOWN if the format is not a supported compressed format.
+  FREE_IMAGE_FORMAT compressedFormat(const Image::PixelFormatType _format)
+  {
+    switch (_format)
+    {
+      case Image::COMPRESSED_PNG:
+        return FIF_PNG;
+      case Image::COMPRESSED_JPEG:
+        return FIF_JPEG;
+      default:
+        return FIF_UNKNOWN;
+    }
+  }
+
+  /// \brief Decode compressed image data.
+  /// \param[in] _data Compressed data.
+  /// \param[in] _size Size of _data in bytes.
+  /// \param[in] _format Format of _data.
+  /// \return The decoded bitmap, null on failure.
+  FIBITMAP *decodeCompressed(const unsigned char *_data, unsigned int _size,
+      const FREE_IMAGE_FORMAT _format)
+  {
+    // FreeImage does not write to the memory it reads from
+    FIMEMORY *fiMem = FreeImage_OpenMemory(
+        const_cast<unsigned char *>(_data), _size);
+    FIBITMAP *bitmap = FreeImage_LoadFromMemory(_format, fiMem);
+    FreeImage_CloseMemory(fiMem);
+    return bitmap;
+  }
+
+  /// \brief Copy one channel of a row of pixels. The strides are template
+  /// parameters so that the compiler can vectorize the loop.
+  /// \param[in] _src First source byte of the channel.
+  /// \param[out] _dst First destination byte of the channel.
+  /// \param[in] _width Number of pixels.
+  template<unsigned int SrcStride, unsigned int DstStride>
+  void copyChannelRow(const unsigned char *_src, unsigned char *_dst,
+      const unsigned int _width)
+  {
+    for (unsigned int x = 0; x < _width; ++x)
+      _dst[x * DstStride] = _src[x * SrcStride];
+  }
+
+  /// \brief Fill one channel of a row of pixels.
+  /// \param[out] _dst First destination byte of the channel.
+  /// \param[in] _value Value to write.
+  /// \param[in] _width Number of pixels.
+  template<unsigned int DstStride>
+  void fillChannelRow(unsigned char *_dst, const unsigned char _value,
+      const unsigned int _width)
+  {
+    for (unsigned int x = 0; x < _width; ++x)
+      _dst[x * DstStride] = _value;
+  }
+
+  /// \brief Row kernel copying one channel.
+  using CopyChannelRowFn =
+      void (*)(const unsigned char *, unsigned char *, unsigned int);
+
+  /// \brief Row kernel filling one channel.
+  using FillChannelRowFn = void (*)(unsigned char *, unsigned char,
+      unsigned int);
+
+  /// \brief Get the kernel for the given strides.
+  /// \param[in] _srcStride Source bytes per pixel, 1 to 4.
+  /// \param[in] _dstStride Destination bytes per pixel, 1 to 4.
+  /// \return Row kernel.
+  CopyChannelRowFn copyChannelRowFn(const unsigned int _srcStride,
+      const unsigned int _dstStride)
+  {
+    static const CopyChannelRowFn kernels[4][4] =
+    {
+      {&copyChannelRow<1, 1>, &copyChannelRow<1, 2>,
+       &copyChannelRow<1, 3>, &copyChannelRow<1, 4>},
+      {&copyChannelRow<2, 1>, &copyChannelRow<2, 2>,
+       &copyChannelRow<2, 3>, &copyChannelRow<2, 4>},
+      {&copyChannelRow<3, 1>, &copyChannelRow<3, 2>,
+       &copyChannelRow<3, 3>, &copyChannelRow<3, 4>},
+      {&copyChannelRow<4, 1>, &copyChannelRow<4, 2>,
+       &copyChannelRow<4, 3>, &copyChannelRow<4, 4>}
+    };
+    return kernels[_srcStride - 1][_dstStride - 1];
+  }
+
+  /// \brief Get the fill kernel for the given stride.
+  /// \param[in] _dstStride Destination bytes per pixel, 1 to 4.
+  /// \return Row kernel.
+  FillChannelRowFn fillChannelRowFn(const unsigned int _dstStride)
+  {
+    static const FillChannelRowFn kernels[4] =
+    {
+      &fillChannelRow<1>, &fillChannelRow<2>,
+      &fillChannelRow<3>, &fillChannelRow<4>
+    };
+    return kernels[_dstStride - 1];
+  }
+}
+
 static int count = 0;
 
+/// \brief Protects count, images can be created and destroyed from several
+/// threads, e.g. while loading meshes.
+static std::mutex countMutex;
+
 //////////////////////////////////////////////////
 Image::Image(const std::string &_filename)
 : dataPtr(gz::utils::MakeImpl<Implementation>())
 {
-  if (count == 0)
-    FreeImage_Initialise();
+  {
+    std::lock_guard<std::mutex> lock(countMutex);
+    if (count == 0)
+      FreeImage_Initialise();
 
-  count++;
+    count++;
+  }
 
   this->dataPtr->bitmap = NULL;
   if (!_filename.empty())
@@ -106,12 +248,12 @@ Image::Image(const std::string &_filename)
 //////////////////////////////////////////////////
 Image::~Image()
 {
-  count--;
-
   if (this->dataPtr->bitmap)
     FreeImage_Unload(this->dataPtr->bitmap);
   this->dataPtr->bitmap = NULL;
 
+  std::lock_guard<std::mutex> lock(countMutex);
+  count--;
   if (count == 0)
     FreeImage_DeInitialise();
 }
@@ -120,6 +262,7 @@ Image::~Image()
 //////////////////////////////////////////////////
 int Image::Load(const std::string &_filename)
 {
+  this->dataPtr->pending.reset();
   this->dataPtr->fullName = _filename;
   if (!exists(this->dataPtr->fullName))
   {
@@ -167,6 +310,7 @@ int Image::Load(const std::string &_filename)
 //////////////////////////////////////////////////
 void Image::SavePNG(const std::string &_filename)
 {
+  this->dataPtr->Decode();
   FreeImage_Save(FIF_PNG, this->dataPtr->bitmap, _filename.c_str(),
       PNG_DEFAULT);
 }
@@ -174,6 +318,7 @@ void Image::SavePNG(const std::string &_filename)
 //////////////////////////////////////////////////
 void Image::SavePNGToBuffer(std::vector<unsigned char>& buffer)
 {
+  this->dataPtr->Decode();
   FIMEMORY *hmem = FreeImage_OpenMemory();
   FreeImage_SaveToMemory(FIF_PNG, this->dataPtr->bitmap, hmem);
   unsigned char *memBuffer = nullptr;
@@ -194,6 +339,7 @@ void Image::SetFromData(const unsigned char *_data,
     unsigned int _height,
     Image::PixelFormatType _format)
 {
+  this->dataPtr->pending.reset();
   if (this->dataPtr->bitmap)
     FreeImage_Unload(this->dataPtr->bitmap);
   this->dataPtr->bitmap = NULL;
@@ -270,27 +416,15 @@ void Image::SetFromCompressedData(unsigned char *_data,
                                   unsigned int _size,
                                   Image::PixelFormatType _format)
 {
+  this->dataPtr->pending.reset();
   if (this->dataPtr->bitmap)
     FreeImage_Unload(this->dataPtr->bitmap);
   this->dataPtr->bitmap = nullptr;
 
-  FREE_IMAGE_FORMAT format = FIF_UNKNOWN;
-  switch (_format)
-  {
-    case COMPRESSED_PNG:
-      format = FIF_PNG;
-      break;
-    case COMPRESSED_JPEG:
-      format = FIF_JPEG;
-      break;
-    default:
-      break;
-  }
+  FREE_IMAGE_FORMAT format = compressedFormat(_format);
   if (format != FIF_UNKNOWN)
   {
-    FIMEMORY *fiMem = FreeImage_OpenMemory(_data, _size);
-    this->dataPtr->bitmap = FreeImage_LoadFromMemory(format, fiMem);
-    FreeImage_CloseMemory(fiMem);
+    this->dataPtr->bitmap = decodeCompressed(_data, _size, format);
   }
   else
   {
@@ -299,15 +433,74 @@ void Image::SetFromCompressedData(unsigned char *_data,
   }
 }
 
+//////////////////////////////////////////////////
+bool Image::SetFromCompressedDataDeferred(std::vector<unsigned char> _data,
+    Image::PixelFormatType _format)
+{
+  FREE_IMAGE_FORMAT format = compressedFormat(_format);
+  if (format == FIF_UNKNOWN)
+  {
+    gzerr << "Unable to handle format[" << _format << "]\n";
+    return false;
+  }
+
+  if (this->dataPtr->bitmap)
+    FreeImage_Unload(this->dataPtr->bitmap);
+  this->dataPtr->bitmap = nullptr;
+
+  this->dataPtr->pending = std::make_shared<Implementation::PendingData>();
+  this->dataPtr->pending->data = std::move(_data);
+  this->dataPtr->pending->format = format;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void Image::Decode() const
+{
+  this->dataPtr->Decode();
+}
+
+//////////////////////////////////////////////////
+bool Image::Decoded() const
+{
+  return !this->dataPtr->pending ||
+      this->dataPtr->pending->decoded.load(std::memory_order_acquire);
+}
+
+//////////////////////////////////////////////////
+void Image::Implementation::Decode() const
+{
+  if (!this->pending ||
+      this->pending->decoded.load(std::memory_order_acquire))
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->pending->mutex);
+  if (this->pending->decoded.load(std::memory_order_relaxed))
+    return;
+
+  this->bitmap = decodeCompressed(this->pending->data.data(),
+      static_cast<unsigned int>(this->pending->data.size()),
+      this->pending->format);
+  if (!this->bitmap)
+    gzerr << "Unable to decode compressed image data\n";
+
+  std::vector<unsigned char>().swap(this->pending->data);
+  this->pending->decoded.store(true, std::memory_order_release);
+}
+
 //////////////////////////////////////////////////
 int Image::Pitch() const
 {
+  this->dataPtr->Decode();
   return FreeImage_GetLine(this->dataPtr->bitmap);
 }
 
 //////////////////////////////////////////////////
 void Image::RGBData(unsigned char **_data, unsigned int &_count) const
 {
+  this->dataPtr->Decode();
   FIBITMAP *tmp = this->dataPtr->bitmap;
   FIBITMAP *tmp2 = nullptr;
   if (this->dataPtr->ShouldSwapRedBlue())
@@ -326,7 +519,14 @@ void Image::RGBData(unsigned char **_data, unsigned int &_count) const
 std::vector<unsigned char> Image::RGBData() const
 {
   std::vector<unsigned char> data;
+  this->RGBData(data);
+  return data;
+}
 
+//////////////////////////////////////////////////
+void Image::RGBData(std::vector<unsigned char> &_data) const
+{
+  this->dataPtr->Decode();
   FIBITMAP *tmp = this->dataPtr->bitmap;
   FIBITMAP *tmp2 = nullptr;
   if (this->dataPtr->ShouldSwapRedBlue())
@@ -335,17 +535,16 @@ std::vector<unsigned char> Image::RGBData() const
     tmp2 = tmp;
   }
   tmp = FreeImage_ConvertTo24Bits(tmp);
-  data = this->dataPtr->DataImpl(tmp);
+  this->dataPtr->DataImpl(tmp, _data);
   FreeImage_Unload(tmp);
   if (tmp2)
     FreeImage_Unload(tmp2);
-
-  return data;
 }
 
 //////////////////////////////////////////////////
 void Image::RGBAData(unsigned char **_data, unsigned int &_count) const
 {
+  this->dataPtr->Decode();
   FIBITMAP *tmp = this->dataPtr->bitmap;
   FIBITMAP *tmp2 = nullptr;
   if (this->dataPtr->ShouldSwapRedBlue())
@@ -364,7 +563,14 @@ void Image::RGBAData(unsigned char **_data, unsigned int &_count) const
 std::vector<unsigned char> Image::RGBAData() const
 {
   std::vector<unsigned char> data;
+  this->RGBAData(data);
+  return data;
+}
 
+//////////////////////////////////////////////////
+void Image::RGBAData(std::vector<unsigned char> &_data) const
+{
+  this->dataPtr->Decode();
   FIBITMAP *tmp = this->dataPtr->bitmap;
   FIBITMAP *tmp2 = nullptr;
   if (this->dataPtr->ShouldSwapRedBlue())
@@ -373,17 +579,16 @@ std::vector<unsigned char> Image::RGBAData() const
     tmp2 = tmp;
   }
   tmp = FreeImage_ConvertTo32Bits(tmp);
-  data = this->dataPtr->DataImpl(tmp);
+  this->dataPtr->DataImpl(tmp, _data);
   FreeImage_Unload(tmp);
   if (tmp2)
     FreeImage_Unload(tmp2);
-
-  return data;
 }
 
 //////////////////////////////////////////////////
 void Image::Data(unsigned char **_data, unsigned int &_count) const
 {
+  this->dataPtr->Decode();
   if (this->dataPtr->ShouldSwapRedBlue())
   {
     FIBITMAP *tmp = this->dataPtr->SwapRedBlue(this->Width(), this->Height());
@@ -400,21 +605,29 @@ void Image::Data(unsigned char **_data, unsigned int &_count) const
 std::vector<unsigned char> Image::Data() const
 {
   std::vector<unsigned char> data;
+  this->Data(data);
+  return data;
+}
+
+//////////////////////////////////////////////////
+void Image::Data(std::vector<unsigned char> &_data) const
+{
+  this->dataPtr->Decode();
   if (this->dataPtr->ShouldSwapRedBlue())
   {
     FIBITMAP *tmp = this->dataPtr->SwapRedBlue(this->Width(), this->Height());
-    data = this->dataPtr->DataImpl(tmp);
+    this->dataPtr->DataImpl(tmp, _data);
     FreeImage_Unload(tmp);
   }
   else
   {
-    data = this->dataPtr->DataImpl(this->dataPtr->bitmap);
+    this->dataPtr->DataImpl(this->dataPtr->bitmap, _data);
   }
-  return data;
 }
 
 //////////////////////////////////////////////////
-std::vector<unsigned char> Image::Implementation::DataImpl(FIBITMAP *_img) const
+void Image::Implementation::DataImpl(FIBITMAP *_img,
+    std::vector<unsigned char> &_data) const
 {
   int redmask = FI_RGBA_RED_MASK;
   // int bluemask = 0x00ff0000;
@@ -427,12 +640,11 @@ std::vector<unsigned char> Image::Implementation::DataImpl(FIBITMAP *_img) const
 
   int scanWidth = FreeImage_GetLine(_img);
 
-  std::vector<unsigned char> data(scanWidth * FreeImage_GetHeight(_img));
+  // resize only allocates when _data is smaller than the image
+  _data.resize(scanWidth * FreeImage_GetHeight(_img));
 
-  FreeImage_ConvertToRawBits(reinterpret_cast<BYTE*>(&data[0]), _img,
+  FreeImage_ConvertToRawBits(reinterpret_cast<BYTE*>(_data.data()), _img,
       scanWidth, FreeImage_GetBPP(_img), redmask, greenmask, bluemask, true);
-
-  return data;
 }
 
 //////////////////////////////////////////////////
@@ -690,6 +902,7 @@ BOOL Image::Implementation::PixelIndex(
 //////////////////////////////////////////////////
 void Image::Rescale(int _width, int _height)
 {
+  this->dataPtr->Decode();
   auto *scaled = FreeImage_Rescale(
       this->dataPtr->bitmap, _width, _height, FILTER_LANCZOS3);
 
@@ -706,9 +919,160 @@ void Image::Rescale(int _width, int _height)
 //////////////////////////////////////////////////
 bool Image::Valid() const
 {
+  this->dataPtr->Decode();
   return this->dataPtr->bitmap != NULL;
 }
 
+//////////////////////////////////////////////////
+std::vector<std::shared_ptr<Image>> Image::ChannelImages(
+    const std::vector<unsigned int> &_channels) const
+{
+  std::vector<std::shared_ptr<Image>> images;
+  if (!this->Valid())
+    return images;
+
+  for (auto channel : _channels)
+  {
+    if (channel > 3u)
+    {
+      gzerr << "Invalid channel index [" << channel << "]\n";
+      return images;
+    }
+  }
+
+  const unsigned int width = this->Width();
+  const unsigned int height = this->Height();
+  const std::size_t pixels = static_cast<std::size_t>(width) * height;
+
+  // The RGBA copy and the planes are only needed for the duration of the
+  // call, take them from the shared pool
+  auto &pool = BufferPool::Default();
+  auto rgba = pool.Acquire(pixels * 4u);
+  this->RGBAData(rgba);
+  if (rgba.size() < pixels * 4u)
+  {
+    gzerr << "Unable to read image data\n";
+    pool.Release(std::move(rgba));
+    return images;
+  }
+
+  std::vector<BufferPool::Buffer> planes;
+  std::vector<unsigned char *> dst;
+  planes.reserve(_channels.size());
+  dst.reserve(_channels.size());
+  for (std::size_t i = 0; i < _channels.size(); ++i)
+  {
+    planes.push_back(pool.Acquire(pixels));
+    dst.push_back(planes.back().data());
+  }
+
+  ExtractChannels(rgba.data(), width, height, 4u, _channels, dst);
+  pool.Release(std::move(rgba));
+
+  images.reserve(_channels.size());
+  for (auto &plane : planes)
+  {
+    auto image = std::make_shared<Image>();
+    image->SetFromData(plane.data(), width, height, Image::L_INT8);
+    images.push_back(image);
+    pool.Release(std::move(plane));
+  }
+  return images;
+}
+
+//////////////////////////////////////////////////
+bool Image::ExtractChannels(const unsigned char *_src,
+    const unsigned int _width, const unsigned int _height,
+    const unsigned int _srcChannels,
+    const std::vector<unsigned int> &_channels,
+    const std::vector<unsigned char *> &_dst,
+    const bool _flipVertical)
+{
+  if (_src == nullptr || _srcChannels < 1u || _srcChannels > 4u ||
+      _channels.size() != _dst.size())
+  {
+    return false;
+  }
+
+  for (std::size_t i = 0; i < _channels.size(); ++i)
+  {
+    if (_channels[i] >= _srcChannels || _dst[i] == nullptr)
+      return false;
+  }
+
+  const CopyChannelRowFn copyRow = copyChannelRowFn(_srcChannels, 1u);
+  const std::size_t srcPitch = static_cast<std::size_t>(_width) * _srcChannels;
+
+  // Row by row, so that each source row is read from memory once and stays
+  // in cache while all planes are written
+  for (unsigned int y = 0; y < _height; ++y)
+  {
+    const unsigned char *srcRow = _src + y * srcPitch;
+    const unsigned int dstY = _flipVertical ? _height - 1u - y : y;
+    const std::size_t dstOffset = static_cast<std::size_t>(dstY) * _width;
+    for (std::size_t i = 0; i < _channels.size(); ++i)
+      copyRow(srcRow + _channels[i], _dst[i] + dstOffset, _width);
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Image::SwizzleChannels(const unsigned char *_src,
+    const unsigned int _width, const unsigned int _height,
+    const unsigned int _srcChannels,
+    const std::vector<int> &_channelMap,
+    unsigned char *_dst,
+    const bool _flipVertical,
+    const unsigned char _fill)
+{
+  if (_src == nullptr || _dst == nullptr || _srcChannels < 1u ||
+      _srcChannels > 4u || _channelMap.empty() || _channelMap.size() > 4u)
+  {
+    return false;
+  }
+
+  for (auto channel : _channelMap)
+  {
+    if (channel < -1 || channel >= static_cast<int>(_srcChannels))
+      return false;
+  }
+
+  const unsigned int dstChannels =
+      static_cast<unsigned int>(_channelMap.size());
+  const std::size_t srcPitch = static_cast<std::size_t>(_width) * _srcChannels;
+  const std::size_t dstPitch = static_cast<std::size_t>(_width) * dstChannels;
+
+  // Identity mapping, rows can be copied as a whole
+  bool identity = dstChannels == _srcChannels;
+  for (unsigned int c = 0; identity && c < dstChannels; ++c)
+    identity = _channelMap[c] == static_cast<int>(c);
+
+  const CopyChannelRowFn copyRow =
+      copyChannelRowFn(_srcChannels, dstChannels);
+  const FillChannelRowFn fillRow = fillChannelRowFn(dstChannels);
+
+  for (unsigned int y = 0; y < _height; ++y)
+  {
+    const unsigned char *srcRow = _src + y * srcPitch;
+    const unsigned int dstY = _flipVertical ? _height - 1u - y : y;
+    unsigned char *dstRow = _dst + dstY * dstPitch;
+    if (identity)
+    {
+      std::memcpy(dstRow, srcRow, srcPitch);
+      continue;
+    }
+
+    for (unsigned int c = 0; c < dstChannels; ++c)
+    {
+      if (_channelMap[c] < 0)
+        fillRow(dstRow + c, _fill, _width);
+      else
+        copyRow(srcRow + _channelMap[c], dstRow + c, _width);
+    }
+  }
+  return true;
+}
+
 //////////////////////////////////////////////////
 std::string Image::Filename() const
 {
@@ -718,6 +1082,7 @@ std::string Image::Filename() const
 //////////////////////////////////////////////////
 Image::PixelFormatType Image::PixelFormat() const
 {
+  this->dataPtr->Decode();
   Image::PixelFormatType fmt = UNKNOWN_PIXEL_FORMAT;
   FREE_IMAGE_TYPE type = FreeImage_GetImageType(this->dataPtr->bitmap);
 
@@ -14,7 +14,11 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
 #include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -260,6 +264,118 @@ TEST_F(ImageTest, Data)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(ImageTest, DataIntoBuffer)
+{
+  common::Image img;
+  ASSERT_EQ(0, img.Load(kTestData));
+  ASSERT_TRUE(img.Valid());
+
+  // The output vector is resized and its storage reused
+  std::vector<unsigned char> data(kSize_RGBA * 2, 7);
+  const unsigned char *storage = data.data();
+  img.Data(data);
+  EXPECT_EQ(img.Data(), data);
+  EXPECT_EQ(storage, data.data());
+
+  img.RGBData(data);
+  EXPECT_EQ(img.RGBData(), data);
+  EXPECT_EQ(storage, data.data());
+
+  img.RGBAData(data);
+  EXPECT_EQ(img.RGBAData(), data);
+  EXPECT_EQ(storage, data.data());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ImageTest, ExtractChannels)
+{
+  // 2x2 RGBA
+  const std::vector<unsigned char> src{
+      1, 2, 3, 4,     5, 6, 7, 8,
+      9, 10, 11, 12,  13, 14, 15, 16};
+
+  std::vector<unsigned char> blue(4);
+  std::vector<unsigned char> green(4);
+  EXPECT_TRUE(common::Image::ExtractChannels(src.data(), 2, 2, 4, {2, 1},
+      {blue.data(), green.data()}));
+  EXPECT_EQ((std::vector<unsigned char>{3, 7, 11, 15}), blue);
+  EXPECT_EQ((std::vector<unsigned char>{2, 6, 10, 14}), green);
+
+  // Flipped
+  EXPECT_TRUE(common::Image::ExtractChannels(src.data(), 2, 2, 4, {3},
+      {blue.data()}, true));
+  EXPECT_EQ((std::vector<unsigned char>{12, 16, 4, 8}), blue);
+
+  // Invalid arguments
+  EXPECT_FALSE(common::Image::ExtractChannels(src.data(), 2, 2, 4, {4},
+      {blue.data()}));
+  EXPECT_FALSE(common::Image::ExtractChannels(src.data(), 2, 2, 5, {0},
+      {blue.data()}));
+  EXPECT_FALSE(common::Image::ExtractChannels(src.data(), 2, 2, 4, {0, 1},
+      {blue.data()}));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ImageTest, SwizzleChannels)
+{
+  // 2x1 RGB
+  const std::vector<unsigned char> src{1, 2, 3, 4, 5, 6};
+
+  // RGB to BGRA
+  std::vector<unsigned char> dst(8);
+  EXPECT_TRUE(common::Image::SwizzleChannels(src.data(), 2, 1, 3,
+      {2, 1, 0, -1}, dst.data()));
+  EXPECT_EQ((std::vector<unsigned char>{3, 2, 1, 255, 6, 5, 4, 255}), dst);
+
+  // Identity, flipped
+  dst.resize(6);
+  EXPECT_TRUE(common::Image::SwizzleChannels(src.data(), 1, 2, 3,
+      {0, 1, 2}, dst.data(), true));
+  EXPECT_EQ((std::vector<unsigned char>{4, 5, 6, 1, 2, 3}), dst);
+
+  // Single channel with fill value
+  dst.resize(4);
+  EXPECT_TRUE(common::Image::SwizzleChannels(src.data(), 2, 1, 3,
+      {1, -1}, dst.data(), false, 9));
+  EXPECT_EQ((std::vector<unsigned char>{2, 9, 5, 9}), dst);
+
+  EXPECT_FALSE(common::Image::SwizzleChannels(src.data(), 2, 1, 3,
+      {3}, dst.data()));
+  EXPECT_FALSE(common::Image::SwizzleChannels(src.data(), 2, 1, 3,
+      {}, dst.data()));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ImageTest, ChannelImages)
+{
+  common::Image img;
+  EXPECT_TRUE(img.ChannelImages({0}).empty());
+
+  ASSERT_EQ(0, img.Load(kTestData));
+  EXPECT_TRUE(img.ChannelImages({4}).empty());
+
+  auto channels = img.ChannelImages({0, 2});
+  ASSERT_EQ(2u, channels.size());
+  for (const auto &channel : channels)
+  {
+    ASSERT_NE(nullptr, channel);
+    EXPECT_EQ(kWidth, channel->Width());
+    EXPECT_EQ(kHeight, channel->Height());
+    EXPECT_EQ(common::Image::PixelFormatType::L_INT8,
+        channel->PixelFormat());
+  }
+
+  // Red on the left, blue on the right
+  for (auto y : {0u, kHeight / 2, kHeight - 1})
+  {
+    EXPECT_FLOAT_EQ(1.0f, channels[0]->Pixel(10, y).R());
+    EXPECT_FLOAT_EQ(0.0f, channels[0]->Pixel(100, y).R());
+    EXPECT_FLOAT_EQ(0.0f, channels[1]->Pixel(10, y).R());
+    EXPECT_FLOAT_EQ(1.0f, channels[1]->Pixel(100, y).R());
+  }
+}
+
 /////////////////////////////////////////////////
 TEST_F(ImageTest, SetFromData)
 {
@@ -325,6 +441,53 @@ TEST_F(ImageTest, SetFromCompressedData)
   ASSERT_FALSE(img.Valid());
 }
 
+/////////////////////////////////////////////////
+TEST_F(ImageTest, SetFromCompressedDataDeferred)
+{
+  std::ifstream ifs(kTestData, std::ios::binary);
+  std::vector<unsigned char> buffer((std::istreambuf_iterator<char>(ifs)),
+      std::istreambuf_iterator<char>());
+  ASSERT_FALSE(buffer.empty());
+
+  common::Image img;
+  EXPECT_FALSE(img.SetFromCompressedDataDeferred(buffer,
+      common::Image::PixelFormatType::RGB_INT8));
+  EXPECT_TRUE(img.Decoded());
+
+  ASSERT_TRUE(img.SetFromCompressedDataDeferred(buffer,
+      common::Image::PixelFormatType::COMPRESSED_PNG));
+  EXPECT_FALSE(img.Decoded());
+
+  // Concurrent first accesses decode once
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([&img]
+    {
+      EXPECT_EQ(kWidth, img.Width());
+      EXPECT_EQ(math::Color::Red, img.Pixel(10, 10));
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  EXPECT_TRUE(img.Decoded());
+  CheckImageRGBA(img);
+
+  // Corrupt data fails on first access
+  std::fill(buffer.begin(), buffer.begin() + 16, 0);
+  ASSERT_TRUE(img.SetFromCompressedDataDeferred(buffer,
+      common::Image::PixelFormatType::COMPRESSED_PNG));
+  EXPECT_FALSE(img.Valid());
+  EXPECT_TRUE(img.Decoded());
+
+  // Setting other data drops the pending data
+  ASSERT_TRUE(img.SetFromCompressedDataDeferred(buffer,
+      common::Image::PixelFormatType::COMPRESSED_PNG));
+  EXPECT_EQ(0, img.Load(kTestData));
+  EXPECT_TRUE(img.Decoded());
+  CheckImageRGBA(img);
+}
+
 TEST_F(ImageTest, DeprecatedDataFunctions)
 {
   common::Image img;
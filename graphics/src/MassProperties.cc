@@ -0,0 +1,362 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gz/math/MassMatrix3.hh>
+#include <gz/math/Pose3.hh>
+
+#include "gz/common/Console.hh"
+#include "gz/common/MassProperties.hh"
+#include "gz/common/Mesh.hh"
+#include "gz/common/SubMesh.hh"
+
+#include "ParallelFor.hh"
+
+using namespace gz;
+using namespace common;
+
+namespace
+{
+  /// \brief Volume integrals of 1, x, y, z, x^2, y^2, z^2, xy, yz and zx.
+  using Integrals = std::array<double, 10>;
+
+  /// \brief Triangle lists smaller than this are processed on the calling
+  /// thread, starting threads would cost more than it saves.
+  constexpr std::size_t kParallelTriangles = 1u << 16;
+
+  /// \brief Integrate a range of triangles.
+  /// \param[in] _vertices Vertex positions.
+  /// \param[in] _indices Vertex indices, three per triangle.
+  /// \param[in] _begin First triangle.
+  /// \param[in] _end One past the last triangle.
+  /// \param[in,out] _integrals Integrals to add to, not yet scaled by the
+  /// constant factors applied in finalize().
+  void integrate(const math::Vector3d *_vertices,
+      const unsigned int *_indices, const std::size_t _begin,
+      const std::size_t _end, Integrals &_integrals)
+  {
+    // Keep the sums in locals, the loop body is straight-line arithmetic
+    double s0 = 0, s1 = 0, s2 = 0, s3 = 0, s4 = 0;
+    double s5 = 0, s6 = 0, s7 = 0, s8 = 0, s9 = 0;
+    for (std::size_t t = _begin; t < _end; ++t)
+    {
+      const math::Vector3d &p0 = _vertices[_indices[3 * t]];
+      const math::Vector3d &p1 = _vertices[_indices[3 * t + 1]];
+      const math::Vector3d &p2 = _vertices[_indices[3 * t + 2]];
+      const double x0 = p0.X(), y0 = p0.Y(), z0 = p0.Z();
+      const double x1 = p1.X(), y1 = p1.Y(), z1 = p1.Z();
+      const double x2 = p2.X(), y2 = p2.Y(), z2 = p2.Z();
+
+      // Edges and cross product
+      const double a1 = x1 - x0, b1 = y1 - y0, c1 = z1 - z0;
+      const double a2 = x2 - x0, b2 = y2 - y0, c2 = z2 - z0;
+      const double d0 = b1 * c2 - b2 * c1;
+      const double d1 = a2 * c1 - a1 * c2;
+      const double d2 = a1 * b2 - a2 * b1;
+
+      // Subexpressions of the integral terms, per axis
+      double t0 = x0 + x1;
+      double t1 = x0 * x0;
+      double t2 = t1 + x1 * t0;
+      const double f1x = t0 + x2;
+      const double f2x = t2 + x2 * f1x;
+      const double f3x = x0 * t1 + x1 * t2 + x2 * f2x;
+      const double g0x = f2x + x0 * (f1x + x0);
+      const double g1x = f2x + x1 * (f1x + x1);
+      const double g2x = f2x + x2 * (f1x + x2);
+
+      t0 = y0 + y1;
+      t1 = y0 * y0;
+      t2 = t1 + y1 * t0;
+      const double f1y = t0 + y2;
+      const double f2y = t2 + y2 * f1y;
+      const double f3y = y0 * t1 + y1 * t2 + y2 * f2y;
+      const double g0y = f2y + y0 * (f1y + y0);
+      const double g1y = f2y + y1 * (f1y + y1);
+      const double g2y = f2y + y2 * (f1y + y2);
+
+      t0 = z0 + z1;
+      t1 = z0 * z0;
+      t2 = t1 + z1 * t0;
+      const double f1z = t0 + z2;
+      const double f2z = t2 + z2 * f1z;
+      const double f3z = z0 * t1 + z1 * t2 + z2 * f2z;
+      const double g0z = f2z + z0 * (f1z + z0);
+      const double g1z = f2z + z1 * (f1z + z1);
+      const double g2z = f2z + z2 * (f1z + z2);
+
+      s0 += d0 * f1x;
+      s1 += d0 * f2x;
+      s2 += d1 * f2y;
+      s3 += d2 * f2z;
+      s4 += d0 * f3x;
+      s5 += d1 * f3y;
+      s6 += d2 * f3z;
+      s7 += d0 * (y0 * g0x + y1 * g1x + y2 * g2x);
+      s8 += d1 * (z0 * g0y + z1 * g1y + z2 * g2y);
+      s9 += d2 * (x0 * g0z + x1 * g1z + x2 * g2z);
+    }
+
+    _integrals[0] += s0;
+    _integrals[1] += s1;
+    _integrals[2] += s2;
+    _integrals[3] += s3;
+    _integrals[4] += s4;
+    _integrals[5] += s5;
+    _integrals[6] += s6;
+    _integrals[7] += s7;
+    _integrals[8] += s8;
+    _integrals[9] += s9;
+  }
+
+  /// \brief Integrate a triangle list, splitting large lists across
+  /// threads.
+  /// \param[in] _vertices Vertex positions.
+  /// \param[in] _indices Vertex indices, three per triangle.
+  /// \param[in] _count Number of triangles.
+  /// \param[in] _parallel False to stay on the calling thread.
+  /// \param[in,out] _integrals Integrals to add to.
+  void integrateAll(const math::Vector3d *_vertices,
+      const unsigned int *_indices, const std::size_t _count,
+      const bool _parallel, Integrals &_integrals)
+  {
+    const std::size_t threadCount = _parallel ?
+        std::min<std::size_t>(_count / kParallelTriangles + 1,
+            std::max(1u, std::thread::hardware_concurrency())) : 1u;
+    if (threadCount <= 1)
+    {
+      integrate(_vertices, _indices, 0, _count, _integrals);
+      return;
+    }
+
+    // Each thread sums its own chunk, the partial sums are added in order
+    // so that the result does not depend on scheduling
+    std::vector<Integrals> partial(threadCount, Integrals{});
+    const std::size_t chunk = (_count + threadCount - 1) / threadCount;
+    parallelFor(threadCount, [&](std::size_t _i)
+    {
+      integrate(_vertices, _indices, std::min(_count, _i * chunk),
+          std::min(_count, (_i + 1) * chunk), partial[_i]);
+    }, static_cast<unsigned int>(threadCount));
+
+    for (const auto &p : partial)
+    {
+      for (std::size_t i = 0; i < _integrals.size(); ++i)
+        _integrals[i] += p[i];
+    }
+  }
+
+  /// \brief Integrate the triangles of a submesh.
+  /// \param[in] _subMesh Submesh to integrate.
+  /// \param[in] _parallel False to stay on the calling thread.
+  /// \param[in,out] _integrals Integrals to add to.
+  /// \return False if the submesh can not be integrated.
+  bool integrateSubMesh(const SubMesh &_subMesh, const bool _parallel,
+      Integrals &_integrals)
+  {
+    if (_subMesh.SubMeshPrimitiveType() != SubMesh::TRIANGLES)
+    {
+      gzerr << "Mass properties can only be computed for a triangulated "
+            << "mesh.\n";
+      return false;
+    }
+
+    const unsigned int indexCount = _subMesh.IndexCount();
+    if (indexCount % 3 != 0)
+    {
+      gzerr << "The number of indices is not a multiple of three.\n";
+      return false;
+    }
+    if (indexCount == 0)
+      return true;
+
+    // Reading out of bounds would be worse than a slow check
+    const unsigned int *indices = _subMesh.IndexPtr();
+    const unsigned int vertexCount = _subMesh.VertexCount();
+    if (*std::max_element(indices, indices + indexCount) >= vertexCount)
+    {
+      gzerr << "Submesh [" << _subMesh.Name() << "] has indices out of "
+            << "range.\n";
+      return false;
+    }
+
+    integrateAll(_subMesh.VertexPtr(), indices, indexCount / 3, _parallel,
+        _integrals);
+    return true;
+  }
+
+  /// \brief Integrate the triangles of a mesh.
+  /// \param[in] _mesh Mesh to integrate.
+  /// \param[in] _parallel False to stay on the calling thread.
+  /// \param[in,out] _integrals Integrals to add to.
+  /// \return False if a submesh can not be integrated.
+  bool integrateMesh(const Mesh &_mesh, const bool _parallel,
+      Integrals &_integrals)
+  {
+    bool result = true;
+    for (unsigned int i = 0; i < _mesh.SubMeshCount(); ++i)
+    {
+      auto subMesh = _mesh.SubMeshByIndex(i).lock();
+      if (subMesh)
+        result = integrateSubMesh(*subMesh, _parallel, _integrals) && result;
+    }
+    return result;
+  }
+
+  /// \brief Apply the constant factors of the integrals.
+  /// \param[in] _integrals Raw sums from integrate().
+  /// \return Scaled integrals.
+  Integrals finalize(const Integrals &_integrals)
+  {
+    Integrals result = _integrals;
+    result[0] /= 6.0;
+    for (std::size_t i = 1; i < 4; ++i)
+      result[i] /= 24.0;
+    for (std::size_t i = 4; i < 7; ++i)
+      result[i] /= 60.0;
+    for (std::size_t i = 7; i < 10; ++i)
+      result[i] /= 120.0;
+    return result;
+  }
+
+  /// \brief Compute the inertial from raw integrals.
+  /// \param[in] _integrals Raw sums from integrate().
+  /// \param[in] _density Density of the material.
+  /// \return The inertial, or nullopt if it is undefined.
+  std::optional<math::Inertiald> inertialFromIntegrals(
+      const Integrals &_integrals, const double _density)
+  {
+    Integrals intg = finalize(_integrals);
+    if (!(_density > 0.0) || std::abs(intg[0]) <= 0.0)
+      return std::nullopt;
+
+    // Inverted winding flips the sign of every integral
+    if (intg[0] < 0.0)
+    {
+      for (auto &value : intg)
+        value = -value;
+    }
+
+    const double volume = intg[0];
+    const math::Vector3d com(intg[1] / volume, intg[2] / volume,
+        intg[3] / volume);
+
+    // Inertia about the center of mass, per unit density
+    const double ixx = intg[5] + intg[6] -
+        volume * (com.Y() * com.Y() + com.Z() * com.Z());
+    const double iyy = intg[4] + intg[6] -
+        volume * (com.Z() * com.Z() + com.X() * com.X());
+    const double izz = intg[4] + intg[5] -
+        volume * (com.X() * com.X() + com.Y() * com.Y());
+    const double ixy = -(intg[7] - volume * com.X() * com.Y());
+    const double iyz = -(intg[8] - volume * com.Y() * com.Z());
+    const double ixz = -(intg[9] - volume * com.Z() * com.X());
+
+    math::MassMatrix3d massMatrix(volume * _density,
+        math::Vector3d(ixx, iyy, izz) * _density,
+        math::Vector3d(ixy, ixz, iyz) * _density);
+    return math::Inertiald(massMatrix,
+        math::Pose3d(com, math::Quaterniond::Identity));
+  }
+}
+
+/// \brief Private data for MassProperties class
+class gz::common::MassProperties::Implementation
+{
+  /// \brief Raw volume integrals, see integrate()
+  public: Integrals integrals{};
+};
+
+//////////////////////////////////////////////////
+MassProperties::MassProperties()
+: dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+void MassProperties::AddTriangles(const math::Vector3d *_vertices,
+    const unsigned int *_indices, const std::size_t _triangleCount)
+{
+  integrateAll(_vertices, _indices, _triangleCount, true,
+      this->dataPtr->integrals);
+}
+
+//////////////////////////////////////////////////
+bool MassProperties::AddSubMesh(const SubMesh &_subMesh)
+{
+  return integrateSubMesh(_subMesh, true, this->dataPtr->integrals);
+}
+
+//////////////////////////////////////////////////
+bool MassProperties::AddMesh(const Mesh &_mesh)
+{
+  return integrateMesh(_mesh, true, this->dataPtr->integrals);
+}
+
+//////////////////////////////////////////////////
+MassProperties &MassProperties::operator+=(const MassProperties &_other)
+{
+  for (std::size_t i = 0; i < this->dataPtr->integrals.size(); ++i)
+    this->dataPtr->integrals[i] += _other.dataPtr->integrals[i];
+  return *this;
+}
+
+//////////////////////////////////////////////////
+double MassProperties::SignedVolume() const
+{
+  return this->dataPtr->integrals[0] / 6.0;
+}
+
+//////////////////////////////////////////////////
+math::Vector3d MassProperties::CenterOfMass() const
+{
+  const Integrals intg = finalize(this->dataPtr->integrals);
+  if (std::abs(intg[0]) <= 0.0)
+    return math::Vector3d::Zero;
+  return math::Vector3d(intg[1], intg[2], intg[3]) / intg[0];
+}
+
+//////////////////////////////////////////////////
+std::optional<math::Inertiald> MassProperties::Inertial(
+    const double _density) const
+{
+  return inertialFromIntegrals(this->dataPtr->integrals, _density);
+}
+
+//////////////////////////////////////////////////
+std::vector<std::optional<math::Inertiald>> MassProperties::Compute(
+    const std::vector<const Mesh *> &_meshes, const double _density)
+{
+  std::vector<std::optional<math::Inertiald>> results(_meshes.size());
+
+  // One mesh per task, each mesh stays on a single thread
+  parallelFor(_meshes.size(), [&](std::size_t _i)
+  {
+    if (!_meshes[_i])
+      return;
+    Integrals integrals{};
+    if (integrateMesh(*_meshes[_i], false, integrals))
+      results[_i] = inertialFromIntegrals(integrals, _density);
+  });
+
+  return results;
+}
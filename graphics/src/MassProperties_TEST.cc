@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "gz/common/MassProperties.hh"
+#include "gz/common/Mesh.hh"
+#include "gz/common/MeshManager.hh"
+#include "gz/common/SubMesh.hh"
+
+#include "gz/common/testing/AutoLogFixture.hh"
+
+using namespace gz;
+
+class MassPropertiesTest : public common::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Get a copy of the first submesh of a box created by MeshManager.
+common::SubMesh boxSubMesh(const math::Vector3d &_size)
+{
+  auto mgr = common::MeshManager::Instance();
+  const std::string name = "mass_box_" + std::to_string(_size.X()) + "_" +
+      std::to_string(_size.Y()) + "_" + std::to_string(_size.Z());
+  mgr->CreateBox(name, _size, math::Vector2d::One);
+  return *mgr->MeshByName(name)->SubMeshByIndex(0).lock();
+}
+
+/////////////////////////////////////////////////
+/// \brief Reverse the winding of all the triangles of a submesh.
+void flip(common::SubMesh &_subMesh)
+{
+  for (unsigned int i = 0; i < _subMesh.IndexCount(); i += 3)
+  {
+    const int first = _subMesh.Index(i);
+    _subMesh.SetIndex(i, _subMesh.Index(i + 1));
+    _subMesh.SetIndex(i + 1, first);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(MassPropertiesTest, Box)
+{
+  common::SubMesh box = boxSubMesh(math::Vector3d(2, 3, 4));
+  common::MassProperties props;
+  EXPECT_FALSE(props.Inertial(1.0).has_value());
+  ASSERT_TRUE(props.AddSubMesh(box));
+  EXPECT_NEAR(24.0, std::abs(props.SignedVolume()), 1e-9);
+  EXPECT_EQ(math::Vector3d::Zero, props.CenterOfMass());
+
+  auto inertial = props.Inertial(2.0);
+  ASSERT_TRUE(inertial.has_value());
+  EXPECT_NEAR(48.0, inertial->MassMatrix().Mass(), 1e-9);
+
+  // m / 12 * (b^2 + c^2)
+  const math::Vector3d diag = inertial->MassMatrix().DiagonalMoments();
+  EXPECT_NEAR(4.0 * (9 + 16), diag.X(), 1e-9);
+  EXPECT_NEAR(4.0 * (4 + 16), diag.Y(), 1e-9);
+  EXPECT_NEAR(4.0 * (4 + 9), diag.Z(), 1e-9);
+  EXPECT_NEAR(0.0,
+      inertial->MassMatrix().OffDiagonalMoments().Length(), 1e-9);
+
+  // Translation moves the center of mass only
+  box.Translate(math::Vector3d(1, 2, 3));
+  common::MassProperties moved;
+  ASSERT_TRUE(moved.AddSubMesh(box));
+  auto movedInertial = moved.Inertial(2.0);
+  ASSERT_TRUE(movedInertial.has_value());
+  EXPECT_EQ(math::Vector3d(1, 2, 3), movedInertial->Pose().Pos());
+  EXPECT_EQ(diag, movedInertial->MassMatrix().DiagonalMoments());
+
+  // Not a density
+  EXPECT_FALSE(props.Inertial(0.0).has_value());
+}
+
+/////////////////////////////////////////////////
+TEST_F(MassPropertiesTest, Winding)
+{
+  common::SubMesh box = boxSubMesh(math::Vector3d(1, 1, 1));
+  common::MassProperties props;
+  ASSERT_TRUE(props.AddSubMesh(box));
+
+  flip(box);
+  common::MassProperties flipped;
+  ASSERT_TRUE(flipped.AddSubMesh(box));
+  EXPECT_NEAR(-props.SignedVolume(), flipped.SignedVolume(), 1e-12);
+
+  // Either winding gives the same result
+  auto inertial = props.Inertial(1.0);
+  auto flippedInertial = flipped.Inertial(1.0);
+  ASSERT_TRUE(inertial.has_value());
+  ASSERT_TRUE(flippedInertial.has_value());
+  EXPECT_NEAR(inertial->MassMatrix().Mass(),
+      flippedInertial->MassMatrix().Mass(), 1e-12);
+  EXPECT_EQ(inertial->MassMatrix().DiagonalMoments(),
+      flippedInertial->MassMatrix().DiagonalMoments());
+}
+
+/////////////////////////////////////////////////
+TEST_F(MassPropertiesTest, NonConvex)
+{
+  // A 2x2x2 box with a 1x1x1 cavity, the cavity is wound the other way
+  common::SubMesh outer = boxSubMesh(math::Vector3d(2, 2, 2));
+  common::SubMesh inner = boxSubMesh(math::Vector3d(1, 1, 1));
+  flip(inner);
+  inner.Translate(math::Vector3d(0.25, 0, 0));
+
+  common::Mesh mesh;
+  mesh.AddSubMesh(outer);
+  mesh.AddSubMesh(inner);
+
+  common::MassProperties props;
+  ASSERT_TRUE(props.AddMesh(mesh));
+  EXPECT_NEAR(7.0, std::abs(props.SignedVolume()), 1e-9);
+
+  // The cavity shifts the center of mass away from it
+  EXPECT_NEAR(-0.25 / 7.0, props.CenterOfMass().X(), 1e-9);
+  EXPECT_NEAR(0.0, props.CenterOfMass().Y(), 1e-9);
+
+  // Mesh::Volume adds the cavity instead
+  EXPECT_NEAR(9.0, mesh.Volume(), 1e-9);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MassPropertiesTest, LargeSubMesh)
+{
+  // Enough triangles to be split across threads
+  auto mgr = common::MeshManager::Instance();
+  mgr->CreateSphere("mass_sphere", 2.5, 300, 300);
+  const common::Mesh *sphere = mgr->MeshByName("mass_sphere");
+  ASSERT_NE(nullptr, sphere);
+  auto subMesh = sphere->SubMeshByIndex(0).lock();
+  ASSERT_NE(nullptr, subMesh);
+
+  // The seam of the sphere is not exactly closed, both methods agree
+  // closely but not to rounding error
+  common::MassProperties props;
+  ASSERT_TRUE(props.AddSubMesh(*subMesh));
+  EXPECT_NEAR(sphere->Volume(), std::abs(props.SignedVolume()),
+      sphere->Volume() * 1e-6);
+
+  // Same result when added one triangle range at a time
+  common::MassProperties pieces;
+  const std::size_t triangles = subMesh->IndexCount() / 3;
+  const std::size_t half = triangles / 2;
+  pieces.AddTriangles(subMesh->VertexPtr(), subMesh->IndexPtr(), half);
+  common::MassProperties rest;
+  rest.AddTriangles(subMesh->VertexPtr(), subMesh->IndexPtr() + half * 3,
+      triangles - half);
+  pieces += rest;
+  EXPECT_NEAR(props.SignedVolume(), pieces.SignedVolume(), 1e-9);
+
+  // Solid sphere, 2/5 m r^2
+  auto inertial = props.Inertial(1.0);
+  ASSERT_TRUE(inertial.has_value());
+  const double mass = inertial->MassMatrix().Mass();
+  const double expected = 0.4 * mass * 2.5 * 2.5;
+  EXPECT_NEAR(expected, inertial->MassMatrix().DiagonalMoments().X(),
+      expected * 1e-3);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MassPropertiesTest, Invalid)
+{
+  common::SubMesh box = boxSubMesh(math::Vector3d(1, 1, 1));
+  box.SetPrimitiveType(common::SubMesh::LINES);
+  common::MassProperties props;
+  EXPECT_FALSE(props.AddSubMesh(box));
+
+  box.SetPrimitiveType(common::SubMesh::TRIANGLES);
+  box.AddIndex(1);
+  EXPECT_FALSE(props.AddSubMesh(box));
+
+  common::SubMesh outOfRange;
+  outOfRange.SetPrimitiveType(common::SubMesh::TRIANGLES);
+  outOfRange.AddVertex(math::Vector3d::Zero);
+  outOfRange.AddIndex(0);
+  outOfRange.AddIndex(1);
+  outOfRange.AddIndex(2);
+  EXPECT_FALSE(props.AddSubMesh(outOfRange));
+  EXPECT_DOUBLE_EQ(0.0, props.SignedVolume());
+}
+
+/////////////////////////////////////////////////
+TEST_F(MassPropertiesTest, Compute)
+{
+  std::vector<common::Mesh> meshes(8);
+  std::vector<const common::Mesh *> pointers;
+  for (std::size_t i = 0; i < meshes.size(); ++i)
+  {
+    const double size = static_cast<double>(i + 1);
+    meshes[i].AddSubMesh(boxSubMesh(math::Vector3d(size, size, size)));
+    pointers.push_back(&meshes[i]);
+  }
+  pointers.push_back(nullptr);
+
+  // A valid submesh does not hide an invalid one
+  common::Mesh invalid;
+  invalid.AddSubMesh(boxSubMesh(math::Vector3d(1, 1, 1)));
+  common::SubMesh lines = boxSubMesh(math::Vector3d(1, 1, 1));
+  lines.SetPrimitiveType(common::SubMesh::LINES);
+  invalid.AddSubMesh(lines);
+  pointers.push_back(&invalid);
+
+  auto results = common::MassProperties::Compute(pointers, 1000.0);
+  ASSERT_EQ(pointers.size(), results.size());
+  for (std::size_t i = 0; i < meshes.size(); ++i)
+  {
+    ASSERT_TRUE(results[i].has_value());
+    const double size = static_cast<double>(i + 1);
+    EXPECT_NEAR(1000.0 * size * size * size,
+        results[i]->MassMatrix().Mass(), 1e-6);
+  }
+  EXPECT_FALSE(results[meshes.size()].has_value());
+  EXPECT_FALSE(results.back().has_value());
+}
@@ -17,6 +17,9 @@
 
 #include <string>
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
 
 #include "gz/math/Helpers.hh"
 
@@ -26,9 +29,97 @@
 #include "gz/common/SubMesh.hh"
 #include "gz/common/Mesh.hh"
 
+#include "ParallelFor.hh"
+
 using namespace gz;
 using namespace common;
 
+namespace
+{
+  /// \brief Meshes with fewer values than this are copied on the calling
+  /// thread.
+  constexpr std::size_t kParallelFillSize = 1u << 16;
+
+  /// \brief Run a function on every submesh, in parallel if there is
+  /// enough data to copy.
+  /// \param[in] _submeshes Submeshes to process.
+  /// \param[in] _total Total number of values copied.
+  /// \param[in] _func Function called with the submesh index, returns
+  /// false on failure.
+  /// \return False if any call failed.
+  template<typename Func>
+  bool forEachSubMesh(const std::vector<std::shared_ptr<SubMesh>> &_submeshes,
+      const std::size_t _total, Func &&_func)
+  {
+    std::atomic<bool> result{true};
+    parallelFor(_submeshes.size(), [&](const std::size_t _i)
+    {
+      if (!_func(_i))
+        result = false;
+    }, _total < kParallelFillSize ? 1u : 0u);
+    return result;
+  }
+
+  /// \brief Copy the vertices of all submeshes to a flat buffer.
+  /// \param[in] _submeshes Submeshes to copy.
+  /// \param[out] _out Destination buffer.
+  /// \param[in] _size Number of values _out can hold.
+  /// \return False if the buffer is too small.
+  template<typename T>
+  bool fillMeshVertices(
+      const std::vector<std::shared_ptr<SubMesh>> &_submeshes,
+      T *_out, const std::size_t _size)
+  {
+    // Offsets are known up front, submeshes are copied independently
+    std::vector<std::size_t> offsets(_submeshes.size());
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < _submeshes.size(); ++i)
+    {
+      offsets[i] = total;
+      total += _submeshes[i]->VertexCount() * 3u;
+    }
+    if (_size < total)
+      return false;
+
+    return forEachSubMesh(_submeshes, total, [&](const std::size_t _i)
+    {
+      return _submeshes[_i]->FillVertices(_out + offsets[_i],
+          _size - offsets[_i]);
+    });
+  }
+
+  /// \brief Copy the indices of all submeshes to a buffer.
+  /// \param[in] _submeshes Submeshes to copy.
+  /// \param[out] _out Destination buffer.
+  /// \param[in] _size Number of values _out can hold.
+  /// \return False if the buffer is too small or an index does not fit.
+  template<typename T>
+  bool fillMeshIndices(
+      const std::vector<std::shared_ptr<SubMesh>> &_submeshes,
+      T *_out, const std::size_t _size)
+  {
+    std::vector<std::size_t> offsets(_submeshes.size());
+    std::vector<unsigned int> vertexOffsets(_submeshes.size());
+    std::size_t total = 0;
+    unsigned int vertexCount = 0;
+    for (std::size_t i = 0; i < _submeshes.size(); ++i)
+    {
+      offsets[i] = total;
+      vertexOffsets[i] = vertexCount;
+      total += _submeshes[i]->IndexCount();
+      vertexCount += _submeshes[i]->VertexCount();
+    }
+    if (_size < total)
+      return false;
+
+    return forEachSubMesh(_submeshes, total, [&](const std::size_t _i)
+    {
+      return _submeshes[_i]->FillIndices(_out + offsets[_i],
+          _size - offsets[_i], vertexOffsets[_i]);
+    });
+  }
+}
+
 /// \brief Private data for Mesh
 class gz::common::Mesh::Implementation
 {
@@ -293,24 +384,48 @@ void Mesh::FillArrays(double **_vertArr, int **_indArr) const
 
   for (const auto &submesh : this->dataPtr->submeshes)
   {
-    double *vertTmp = NULL;
-    int *indTmp = NULL;
-    submesh->FillArrays(&vertTmp, &indTmp);
-
-    memcpy(vPtr, vertTmp, sizeof(vertTmp[0])*submesh->VertexCount()*3);
+    // Copy straight into the output, keeping the float rounding of
+    // SubMesh::FillArrays
+    const gz::math::Vector3d *vertices = submesh->VertexPtr();
+    for (unsigned int i = 0; i < submesh->VertexCount(); ++i)
+    {
+      *vPtr++ = static_cast<float>(vertices[i].X());
+      *vPtr++ = static_cast<float>(vertices[i].Y());
+      *vPtr++ = static_cast<float>(vertices[i].Z());
+    }
 
+    const unsigned int *indices = submesh->IndexPtr();
     for (unsigned int i = 0; i < submesh->IndexCount(); ++i)
     {
-      (*_indArr)[index++] = submesh->Index(i) + offset;
+      (*_indArr)[index++] = indices[i] + offset;
     }
 
     offset = offset + submesh->MaxIndex() + 1;
+  }
+}
 
-    vPtr += submesh->VertexCount()*3;
+//////////////////////////////////////////////////
+bool Mesh::FillVertices(float *_vertices, const std::size_t _size) const
+{
+  return fillMeshVertices(this->dataPtr->submeshes, _vertices, _size);
+}
 
-    delete [] vertTmp;
-    delete [] indTmp;
-  }
+//////////////////////////////////////////////////
+bool Mesh::FillVertices(double *_vertices, const std::size_t _size) const
+{
+  return fillMeshVertices(this->dataPtr->submeshes, _vertices, _size);
+}
+
+//////////////////////////////////////////////////
+bool Mesh::FillIndices(uint16_t *_indices, const std::size_t _size) const
+{
+  return fillMeshIndices(this->dataPtr->submeshes, _indices, _size);
+}
+
+//////////////////////////////////////////////////
+bool Mesh::FillIndices(uint32_t *_indices, const std::size_t _size) const
+{
+  return fillMeshIndices(this->dataPtr->submeshes, _indices, _size);
 }
 
 //////////////////////////////////////////////////
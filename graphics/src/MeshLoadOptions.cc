@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <string>
+
+#include "gz/common/MeshLoadOptions.hh"
+
+/// \brief Private data for MeshLoadOptions class
+class gz::common::MeshLoadOptions::Implementation
+{
+  /// \brief Load normals
+  public: bool normals = true;
+
+  /// \brief Load texture coordinates
+  public: bool texCoords = true;
+
+  /// \brief Load materials
+  public: bool materials = true;
+
+  /// \brief Load textures
+  public: bool textures = true;
+
+  /// \brief Load skeleton and skinning weights
+  public: bool skeleton = true;
+
+  /// \brief Load skeletal animations
+  public: bool animations = true;
+};
+
+using namespace gz;
+using namespace common;
+
+//////////////////////////////////////////////////
+MeshLoadOptions::MeshLoadOptions()
+  : dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+MeshLoadOptions MeshLoadOptions::GeometryOnly()
+{
+  MeshLoadOptions options;
+  options.SetNormals(false);
+  options.SetTexCoords(false);
+  options.SetMaterials(false);
+  options.SetTextures(false);
+  options.SetSkeleton(false);
+  options.SetAnimations(false);
+  return options;
+}
+
+//////////////////////////////////////////////////
+bool MeshLoadOptions::operator==(const MeshLoadOptions &_options) const
+{
+  return this->CacheKey() == _options.CacheKey();
+}
+
+//////////////////////////////////////////////////
+bool MeshLoadOptions::operator!=(const MeshLoadOptions &_options) const
+{
+  return !(*this == _options);
+}
+
+//////////////////////////////////////////////////
+bool MeshLoadOptions::Normals() const
+{
+  return this->dataPtr->normals;
+}
+
+//////////////////////////////////////////////////
+void MeshLoadOptions::SetNormals(bool _load)
+{
+  this->dataPtr->normals = _load;
+}
+
+//////////////////////////////////////////////////
+bool MeshLoadOptions::TexCoords() const
+{
+  return this->dataPtr->texCoords;
+}
+
+//////////////////////////////////////////////////
+void MeshLoadOptions::SetTexCoords(bool _load)
+{
+  this->dataPtr->texCoords = _load;
+}
+
+//////////////////////////////////////////////////
+bool MeshLoadOptions::Materials() const
+{
+  return this->dataPtr->materials;
+}
+
+//////////////////////////////////////////////////
+void MeshLoadOptions::SetMaterials(bool _load)
+{
+  this->dataPtr->materials = _load;
+}
+
+//////////////////////////////////////////////////
+bool MeshLoadOptions::Textures() const
+{
+  return this->dataPtr->materials && this->dataPtr->textures;
+}
+
+//////////////////////////////////////////////////
+void MeshLoadOptions::SetTextures(bool _load)
+{
+  this->dataPtr->textures = _load;
+}
+
+//////////////////////////////////////////////////
+bool MeshLoadOptions::Skeleton() const
+{
+  return this->dataPtr->skeleton;
+}
+
+//////////////////////////////////////////////////
+void MeshLoadOptions::SetSkeleton(bool _load)
+{
+  this->dataPtr->skeleton = _load;
+}
+
+//////////////////////////////////////////////////
+bool MeshLoadOptions::Animations() const
+{
+  return this->dataPtr->skeleton && this->dataPtr->animations;
+}
+
+//////////////////////////////////////////////////
+void MeshLoadOptions::SetAnimations(bool _load)
+{
+  this->dataPtr->animations = _load;
+}
+
+//////////////////////////////////////////////////
+bool MeshLoadOptions::LoadsEverything() const
+{
+  return this->CacheKey().empty();
+}
+
+//////////////////////////////////////////////////
+std::string MeshLoadOptions::CacheKey() const
+{
+  // Use the effective values, so that options loading the same data share
+  // their key
+  std::string key;
+  if (!this->Normals())
+    key += "n";
+  if (!this->TexCoords())
+    key += "u";
+  if (!this->Materials())
+    key += "m";
+  if (!this->Textures())
+    key += "t";
+  if (!this->Skeleton())
+    key += "s";
+  if (!this->Animations())
+    key += "a";
+
+  if (!key.empty())
+    key = "#skip=" + key;
+  return key;
+}
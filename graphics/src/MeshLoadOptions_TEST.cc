@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include "gz/common/MeshLoadOptions.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+TEST(MeshLoadOptions, Defaults)
+{
+  common::MeshLoadOptions options;
+  EXPECT_TRUE(options.Normals());
+  EXPECT_TRUE(options.TexCoords());
+  EXPECT_TRUE(options.Materials());
+  EXPECT_TRUE(options.Textures());
+  EXPECT_TRUE(options.Skeleton());
+  EXPECT_TRUE(options.Animations());
+  EXPECT_TRUE(options.LoadsEverything());
+  EXPECT_EQ("", options.CacheKey());
+}
+
+/////////////////////////////////////////////////
+TEST(MeshLoadOptions, GeometryOnly)
+{
+  auto options = common::MeshLoadOptions::GeometryOnly();
+  EXPECT_FALSE(options.Normals());
+  EXPECT_FALSE(options.TexCoords());
+  EXPECT_FALSE(options.Materials());
+  EXPECT_FALSE(options.Textures());
+  EXPECT_FALSE(options.Skeleton());
+  EXPECT_FALSE(options.Animations());
+  EXPECT_FALSE(options.LoadsEverything());
+  EXPECT_EQ("#skip=numtsa", options.CacheKey());
+  EXPECT_NE(common::MeshLoadOptions(), options);
+}
+
+/////////////////////////////////////////////////
+TEST(MeshLoadOptions, Dependencies)
+{
+  // Textures are part of materials and animations need a skeleton
+  common::MeshLoadOptions options;
+  options.SetMaterials(false);
+  EXPECT_FALSE(options.Textures());
+  options.SetSkeleton(false);
+  EXPECT_FALSE(options.Animations());
+
+  // Options loading the same data compare equal
+  common::MeshLoadOptions other = options;
+  other.SetTextures(false);
+  other.SetAnimations(false);
+  EXPECT_EQ(options, other);
+  EXPECT_EQ(options.CacheKey(), other.CacheKey());
+
+  other.SetNormals(false);
+  EXPECT_NE(options, other);
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <string>
+
+#include "gz/common/AssimpLoader.hh"
+#include "gz/common/ColladaLoader.hh"
+#include "gz/common/MeshLoader.hh"
+#include "gz/common/OBJLoader.hh"
+#include "gz/common/STLLoader.hh"
+
+using namespace gz;
+using namespace common;
+
+//////////////////////////////////////////////////
+Mesh *MeshLoader::Load(const std::string &_filename,
+    const MeshLoadOptions &_options)
+{
+  if (auto *stl = dynamic_cast<STLLoader *>(this))
+    return stl->Load(_filename, _options);
+  if (auto *collada = dynamic_cast<ColladaLoader *>(this))
+    return collada->Load(_filename, _options);
+  if (auto *obj = dynamic_cast<OBJLoader *>(this))
+    return obj->Load(_filename, _options);
+  if (auto *assimp = dynamic_cast<AssimpLoader *>(this))
+    return assimp->Load(_filename, _options);
+
+  // Loaders without options support load everything
+  return this->Load(_filename);
+}
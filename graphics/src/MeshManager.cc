@@ -17,11 +17,15 @@
 
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -40,17 +44,18 @@
 #endif
 
 #ifndef _WIN32
-  #include "gz/common/GTSMeshUtils.hh"
   #include "gz/common/MeshCSG.hh"
 #endif
 
 #include "gz/common/Console.hh"
+#include "gz/common/MappedFile.hh"
 #include "gz/common/Mesh.hh"
 #include "gz/common/SubMesh.hh"
 #include "gz/common/AssimpLoader.hh"
 #include "gz/common/ColladaLoader.hh"
 #include "gz/common/ColladaExporter.hh"
 #include "gz/common/OBJLoader.hh"
+#include "gz/common/PolygonTriangulation.hh"
 #include "gz/common/STLLoader.hh"
 #include "gz/common/Timer.hh"
 #include "gz/common/Util.hh"
@@ -58,8 +63,123 @@
 
 #include "gz/common/MeshManager.hh"
 
+#include "ParallelFor.hh"
+
 using namespace gz::common;
 
+namespace
+{
+  /// \brief Create a mesh that shares the submesh buffers, materials and
+  /// skeleton of another mesh. Buffers are copied when the new mesh
+  /// modifies them.
+  /// \param[in] _mesh Mesh to copy.
+  /// \return The new mesh.
+  std::shared_ptr<Mesh> shareMesh(const Mesh &_mesh)
+  {
+    auto mesh = std::make_shared<Mesh>();
+    mesh->SetName(_mesh.Name());
+    mesh->SetPath(_mesh.Path());
+    for (unsigned int i = 0; i < _mesh.SubMeshCount(); ++i)
+    {
+      if (auto subMesh = _mesh.SubMeshByIndex(i).lock())
+        mesh->AddSubMesh(*subMesh);
+    }
+    for (unsigned int i = 0; i < _mesh.MaterialCount(); ++i)
+      mesh->AddMaterial(_mesh.MaterialByIndex(i));
+    mesh->SetSkeleton(_mesh.MeshSkeleton());
+    return mesh;
+  }
+
+  /// \brief Loaders of mesh files.
+  enum class LoaderType
+  {
+    NONE,
+    STL,
+    COLLADA,
+    OBJ,
+    ASSIMP
+  };
+
+  /// \brief Get the lower case extension of a file.
+  /// \param[in] _filename File name.
+  /// \return Extension without the dot.
+  std::string lowerExtension(const std::string &_filename)
+  {
+    std::string extension = _filename.substr(_filename.rfind(".") + 1);
+    std::transform(extension.begin(), extension.end(),
+        extension.begin(), ::tolower);
+    return extension;
+  }
+
+  /// \brief Get the loader of a mesh file.
+  /// \param[in] _extension Lower case extension of the file.
+  /// \param[in] _forceAssimp True to load all formats with assimp.
+  /// \return Loader type, NONE if the format is not supported.
+  LoaderType loaderType(const std::string &_extension, bool _forceAssimp)
+  {
+    if (_forceAssimp)
+      return LoaderType::ASSIMP;
+    if (_extension == "stl" || _extension == "stlb" || _extension == "stla")
+      return LoaderType::STL;
+    if (_extension == "dae")
+      return LoaderType::COLLADA;
+    if (_extension == "obj")
+      return LoaderType::OBJ;
+    if (_extension == "gltf" || _extension == "glb" || _extension == "fbx")
+      return LoaderType::ASSIMP;
+    return LoaderType::NONE;
+  }
+
+  /// \brief Create a loader, loaders keep state while loading so each
+  /// thread needs its own.
+  /// \param[in] _type Loader type, not NONE.
+  /// \return New loader.
+  std::unique_ptr<MeshLoader> newLoader(LoaderType _type)
+  {
+    switch (_type)
+    {
+      case LoaderType::STL:
+        return std::make_unique<STLLoader>();
+      case LoaderType::COLLADA:
+        return std::make_unique<ColladaLoader>();
+      case LoaderType::OBJ:
+        return std::make_unique<OBJLoader>();
+      case LoaderType::ASSIMP:
+      case LoaderType::NONE:
+      default:
+        return std::make_unique<AssimpLoader>();
+    }
+  }
+
+  /// \brief Check whether a file is an image which can be prefetched.
+  /// \param[in] _extension Lower case extension of the file.
+  /// \return True for image formats.
+  bool isImage(const std::string &_extension)
+  {
+    static const std::unordered_set<std::string> kImageExtensions{
+      "png", "jpg", "jpeg", "tga", "bmp", "tif", "tiff", "dds", "ktx",
+      "hdr", "exr", "gif", "webp"};
+    return kImageExtensions.count(_extension) > 0;
+  }
+
+  /// \brief Read a file so that it is in the system's file cache.
+  /// \param[in] _path File to read.
+  /// \return True if the file could be read.
+  bool readAhead(const std::string &_path)
+  {
+    MappedFile file(_path, MappedFile::Advice::WILL_NEED);
+    if (!file.Valid())
+      return false;
+
+    // Touch one byte per page to wait for the pages
+    const std::string_view data = file.View();
+    volatile char sink = 0;
+    for (std::size_t i = 0; i < data.size(); i += 4096)
+      sink = sink ^ data[i];
+    return true;
+  }
+}
+
 class gz::common::MeshManager::Implementation
 {
 #ifdef _WIN32
@@ -83,46 +203,146 @@ class gz::common::MeshManager::Implementation
   public: AssimpLoader assimpLoader;
 
   /// \brief Dictionary of meshes, indexed by name
-  public: std::unordered_map<std::string, Mesh*> meshes;
+  public: std::unordered_map<std::string, std::shared_ptr<Mesh>> meshes;
+
+  /// \brief Names of the meshes loaded from files, which can be evicted
+  public: std::unordered_set<std::string> loadedMeshes;
+
+  /// \brief Functions creating the built-in meshes which have not been
+  /// requested yet, indexed by mesh name
+  public: std::unordered_map<std::string, std::function<void()>> builtins;
 
   /// \brief supported file extensions for meshes
   public: std::unordered_set<std::string> fileExtensions;
 
-  /// \brief Mutex to protect the mesh map
-  public: std::mutex mutex;
+  /// \brief Mutex to protect the mesh map and the built-in mesh functions.
+  /// It is recursive because creating a built-in mesh while holding it
+  /// looks up and inserts the mesh through the public functions.
+  public: mutable std::recursive_mutex mutex;
 
   /// \brief True if assimp is used for loading all supported mesh formats
   public: bool forceAssimp;
+
+  /// \brief Create a built-in mesh if it has not been created yet.
+  /// The caller must hold the mutex.
+  /// \param[in] _name Name of the mesh.
+  public: void CreateBuiltin(const std::string &_name);
+
+  /// \brief Find a mesh, creating it if it is a built-in mesh.
+  /// The caller must hold the mutex.
+  /// \param[in] _name Name of the mesh.
+  /// \return The mesh, or null if there is no mesh with this name.
+  public: std::shared_ptr<Mesh> FindMesh(const std::string &_name);
+
+  /// \brief Add a fully built mesh unless one with the same name exists.
+  /// Meshes are only published once complete, so other threads never see
+  /// a mesh while it is being filled.
+  /// \param[in] _name Name of the mesh.
+  /// \param[in] _mesh The mesh, destroyed if it is not added.
+  /// \return False if a mesh with the same name already exists.
+  public: bool InsertMesh(const std::string &_name,
+              std::unique_ptr<Mesh> _mesh);
 #ifdef _WIN32
 #pragma warning(pop)
 #endif
 };
 
+//////////////////////////////////////////////////
+void MeshManager::Implementation::CreateBuiltin(const std::string &_name)
+{
+  auto iter = this->builtins.find(_name);
+  if (iter == this->builtins.end())
+    return;
+
+  // Remove the function first, creating the mesh checks if it exists
+  auto create = std::move(iter->second);
+  this->builtins.erase(iter);
+  create();
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<Mesh> MeshManager::Implementation::FindMesh(
+    const std::string &_name)
+{
+  auto iter = this->meshes.find(_name);
+  if (iter == this->meshes.end())
+  {
+    this->CreateBuiltin(_name);
+    iter = this->meshes.find(_name);
+  }
+  if (iter != this->meshes.end())
+    return iter->second;
+
+  return nullptr;
+}
+
+//////////////////////////////////////////////////
+bool MeshManager::Implementation::InsertMesh(const std::string &_name,
+    std::unique_ptr<Mesh> _mesh)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->mutex);
+  return this->meshes.try_emplace(_name, std::move(_mesh)).second;
+}
+
 //////////////////////////////////////////////////
 MeshManager::MeshManager()
 : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
 {
-  // Create some basic shapes
-  this->CreatePlane("unit_plane",
-      gz::math::Planed(
-        gz::math::Vector3d(0, 0, 1), gz::math::Vector2d(1, 1), 0),
-      gz::math::Vector2d(1, 1),
-      gz::math::Vector2d(1, 1));
-
-  this->CreateSphere("unit_sphere", 0.5f, 32, 32);
-  this->CreateSphere("joint_anchor", 0.01f, 32, 32);
-  this->CreateBox("body_cg", gz::math::Vector3d(0.014, 0.014, 0.014),
-      gz::math::Vector2d(0.014, 0.014));
-  this->CreateBox("unit_box", gz::math::Vector3d(1, 1, 1),
-      gz::math::Vector2d(1, 1));
-  this->CreateCylinder("unit_cylinder", 0.5, 1.0, 1, 32);
-  this->CreateCone("unit_cone", 0.5, 1.0, 5, 32);
-  this->CreateCamera("unit_camera", 0.5);
-
-  this->CreateCylinder("axis_shaft", 0.01f, 0.2f, 1, 16);
-  this->CreateCone("axis_head", 0.02f, 0.08f, 1, 16);
-
-  this->CreateTube("selection_tube", 1.0f, 1.2f, 0.01f, 1, 64);
+  // Some basic shapes, created the first time they are requested
+  auto &builtins = this->dataPtr->builtins;
+  builtins["unit_plane"] = [this]
+  {
+    this->CreatePlane("unit_plane",
+        gz::math::Planed(
+          gz::math::Vector3d(0, 0, 1), gz::math::Vector2d(1, 1), 0),
+        gz::math::Vector2d(1, 1),
+        gz::math::Vector2d(1, 1));
+  };
+
+  builtins["unit_sphere"] = [this]
+  {
+    this->CreateSphere("unit_sphere", 0.5f, 32, 32);
+  };
+  builtins["joint_anchor"] = [this]
+  {
+    this->CreateSphere("joint_anchor", 0.01f, 32, 32);
+  };
+  builtins["body_cg"] = [this]
+  {
+    this->CreateBox("body_cg", gz::math::Vector3d(0.014, 0.014, 0.014),
+        gz::math::Vector2d(0.014, 0.014));
+  };
+  builtins["unit_box"] = [this]
+  {
+    this->CreateBox("unit_box", gz::math::Vector3d(1, 1, 1),
+        gz::math::Vector2d(1, 1));
+  };
+  builtins["unit_cylinder"] = [this]
+  {
+    this->CreateCylinder("unit_cylinder", 0.5, 1.0, 1, 32);
+  };
+  builtins["unit_cone"] = [this]
+  {
+    this->CreateCone("unit_cone", 0.5, 1.0, 5, 32);
+  };
+  builtins["unit_camera"] = [this]
+  {
+    this->CreateCamera("unit_camera", 0.5);
+  };
+
+  builtins["axis_shaft"] = [this]
+  {
+    this->CreateCylinder("axis_shaft", 0.01f, 0.2f, 1, 16);
+  };
+  builtins["axis_head"] = [this]
+  {
+    this->CreateCone("axis_head", 0.02f, 0.08f, 1, 16);
+  };
+
+  builtins["selection_tube"] = [this]
+  {
+    this->CreateTube("selection_tube", 1.0f, 1.2f, 0.01f, 1, 64);
+  };
 
   this->dataPtr->fileExtensions.insert("stl");
   this->dataPtr->fileExtensions.insert("dae");
@@ -136,14 +356,27 @@ MeshManager::MeshManager()
 //////////////////////////////////////////////////
 MeshManager::~MeshManager()
 {
-  for (auto iter = this->dataPtr->meshes.begin();
-      iter != this->dataPtr->meshes.end(); ++iter)
-    delete iter->second;
   this->dataPtr->meshes.clear();
 }
 
 //////////////////////////////////////////////////
 const Mesh *MeshManager::Load(const std::string &_filename)
+{
+  return this->Load(_filename, MeshLoadOptions());
+}
+
+//////////////////////////////////////////////////
+const Mesh *MeshManager::Load(const std::string &_filename,
+    const MeshLoadOptions &_options)
+{
+  // The manager keeps a reference, the pointer stays valid after the
+  // handle is released
+  return this->LoadHandle(_filename, _options).get();
+}
+
+//////////////////////////////////////////////////
+ConstMeshPtr MeshManager::LoadHandle(const std::string &_filename,
+    const MeshLoadOptions &_options)
 {
   if (!this->IsValidFilename(_filename))
   {
@@ -151,61 +384,60 @@ const Mesh *MeshManager::Load(const std::string &_filename)
     return nullptr;
   }
 
-  Mesh *mesh = nullptr;
+  std::shared_ptr<Mesh> mesh;
 
   std::string extension;
 
-  if (this->HasMesh(_filename))
+  const std::string key = _filename + _options.CacheKey();
   {
-    return this->dataPtr->meshes[_filename];
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+    auto iter = this->dataPtr->meshes.find(key);
+    if (iter != this->dataPtr->meshes.end())
+      return iter->second;
   }
 
   std::string fullname = common::findFile(_filename);
 
   if (!fullname.empty())
   {
-    extension = fullname.substr(fullname.rfind(".")+1, fullname.size());
-    std::transform(extension.begin(), extension.end(),
-        extension.begin(), ::tolower);
+    extension = lowerExtension(fullname);
     MeshLoader *loader = nullptr;
     this->SetAssimpEnvs();
-    if (this->dataPtr->forceAssimp)
+    switch (loaderType(extension, this->dataPtr->forceAssimp))
     {
-      loader = &this->dataPtr->assimpLoader;
-    }
-    else
-    {
-      if (extension == "stl" || extension == "stlb" || extension == "stla")
-          loader = &this->dataPtr->stlLoader;
-      else if (extension == "dae")
+      case LoaderType::STL:
+        loader = &this->dataPtr->stlLoader;
+        break;
+      case LoaderType::COLLADA:
         loader = &this->dataPtr->colladaLoader;
-      else if (extension == "obj")
+        break;
+      case LoaderType::OBJ:
         loader = &this->dataPtr->objLoader;
-      else if (extension == "gltf" || extension == "glb" || extension == "fbx")
+        break;
+      case LoaderType::ASSIMP:
         loader = &this->dataPtr->assimpLoader;
-      else
-      {
+        break;
+      case LoaderType::NONE:
+      default:
         gzerr << "Unsupported mesh format for file[" << _filename << "]\n";
         return nullptr;
-      }
     }
     // This mutex prevents two threads from loading the same mesh at the
     // same time.
-    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-    if (!this->HasMesh(_filename))
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+    mesh = this->dataPtr->FindMesh(key);
+    if (!mesh)
     {
-      if ((mesh = loader->Load(fullname)) != nullptr)
+      mesh.reset(loader->Load(fullname, _options));
+      if (mesh)
       {
-        mesh->SetName(_filename);
-        this->dataPtr->meshes.insert(std::make_pair(_filename, mesh));
+        mesh->SetName(key);
+        this->dataPtr->meshes.insert(std::make_pair(key, mesh));
+        this->dataPtr->loadedMeshes.insert(key);
       }
       else
         gzerr << "Unable to load mesh[" << fullname << "]\n";
     }
-    else
-    {
-      mesh = this->dataPtr->meshes[_filename];
-    }
   }
   else
     gzerr << "Unable to find file[" << _filename << "]\n";
@@ -213,6 +445,92 @@ const Mesh *MeshManager::Load(const std::string &_filename)
   return mesh;
 }
 
+//////////////////////////////////////////////////
+std::size_t MeshManager::Prefetch(const std::vector<std::string> &_filenames,
+    const MeshLoadOptions &_options, unsigned int _concurrency)
+{
+  /// \brief A file to read
+  struct Task
+  {
+    /// \brief Cache key of a mesh, empty for an image
+    std::string key;
+
+    /// \brief Path of the file
+    std::string fullname;
+
+    /// \brief Loader of a mesh
+    LoaderType type;
+  };
+
+  // Search the files on this thread, SystemPaths callbacks may not be
+  // thread safe
+  this->SetAssimpEnvs();
+  std::vector<Task> tasks;
+  std::unordered_set<std::string> seen;
+  std::size_t ready = 0;
+  for (const auto &filename : _filenames)
+  {
+    const std::string extension = lowerExtension(filename);
+    const bool image = isImage(extension);
+    if ((!image && !this->IsValidFilename(filename)) ||
+        !seen.insert(filename).second)
+    {
+      continue;
+    }
+    const LoaderType type = image ? LoaderType::NONE :
+        loaderType(extension, this->dataPtr->forceAssimp);
+
+    std::string key;
+    if (!image)
+    {
+      key = filename + _options.CacheKey();
+      std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+      if (this->dataPtr->meshes.count(key) > 0)
+      {
+        ++ready;
+        continue;
+      }
+    }
+
+    std::string fullname = common::findFile(filename);
+    if (fullname.empty())
+    {
+      gzerr << "Unable to find file[" << filename << "]\n";
+      continue;
+    }
+    tasks.push_back({key, fullname, type});
+  }
+
+  std::atomic<std::size_t> loaded{0};
+  parallelFor(tasks.size(), [&](const std::size_t _i)
+  {
+    const Task &task = tasks[_i];
+    if (task.type == LoaderType::NONE)
+    {
+      if (readAhead(task.fullname))
+        ++loaded;
+      return;
+    }
+
+    std::shared_ptr<Mesh> mesh(
+        newLoader(task.type)->Load(task.fullname, _options));
+    if (!mesh)
+    {
+      gzerr << "Unable to load mesh[" << task.fullname << "]\n";
+      return;
+    }
+
+    // A mesh loaded meanwhile by Load is kept
+    mesh->SetName(task.key);
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->meshes.emplace(task.key, mesh).second)
+      this->dataPtr->loadedMeshes.insert(task.key);
+    ++loaded;
+  }, _concurrency);
+
+  return ready + loaded;
+}
+
 //////////////////////////////////////////////////
 void MeshManager::Export(const Mesh *_mesh, const std::string &_filename,
     const std::string &_extension, bool _exportTextures)
@@ -247,61 +565,127 @@ void MeshManager::MeshAABB(const Mesh *_mesh,
     gz::math::Vector3d &_center,
     gz::math::Vector3d &_minXYZ, gz::math::Vector3d &_maxXYZ)
 {
-  if (this->HasMesh(_mesh->Name()))
-    this->dataPtr->meshes[_mesh->Name()]->AABB(_center, _minXYZ, _maxXYZ);
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+  auto mesh = this->dataPtr->FindMesh(_mesh->Name());
+  if (mesh)
+    mesh->AABB(_center, _minXYZ, _maxXYZ);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::GenSphericalTexCoord(const Mesh *_mesh,
     const gz::math::Vector3d &_center)
 {
-  if (this->HasMesh(_mesh->Name()))
-    this->dataPtr->meshes[_mesh->Name()]->GenSphericalTexCoord(_center);
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+  auto mesh = this->dataPtr->FindMesh(_mesh->Name());
+  if (mesh)
+    mesh->GenSphericalTexCoord(_center);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::AddMesh(Mesh *_mesh)
 {
-  if (!this->HasMesh(_mesh->Name()))
-    this->dataPtr->meshes[_mesh->Name()] = _mesh;
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->FindMesh(_mesh->Name()))
+    this->dataPtr->meshes[_mesh->Name()] = std::shared_ptr<Mesh>(_mesh);
 }
 
 //////////////////////////////////////////////////
 const Mesh *MeshManager::MeshByName(const std::string &_name) const
 {
-  auto iter = this->dataPtr->meshes.find(_name);
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->FindMesh(_name).get();
+}
 
-  if (iter != this->dataPtr->meshes.end())
-    return iter->second;
+//////////////////////////////////////////////////
+ConstMeshPtr MeshManager::MeshHandle(const std::string &_name) const
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->FindMesh(_name);
+}
 
-  return nullptr;
+//////////////////////////////////////////////////
+std::size_t MeshManager::EvictUnused()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+  std::size_t count = 0;
+  for (auto name = this->dataPtr->loadedMeshes.begin();
+      name != this->dataPtr->loadedMeshes.end();)
+  {
+    auto iter = this->dataPtr->meshes.find(*name);
+    if (iter == this->dataPtr->meshes.end())
+    {
+      name = this->dataPtr->loadedMeshes.erase(name);
+    }
+    // Only referenced by the manager
+    else if (iter->second.use_count() == 1)
+    {
+      this->dataPtr->meshes.erase(iter);
+      name = this->dataPtr->loadedMeshes.erase(name);
+      ++count;
+    }
+    else
+    {
+      ++name;
+    }
+  }
+  return count;
 }
 
 //////////////////////////////////////////////////
-void MeshManager::RemoveAll()
+ConstMeshPtr MeshManager::Scaled(const Mesh &_mesh,
+    const gz::math::Vector3d &_factor)
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  for (auto m : this->dataPtr->meshes)
+  auto mesh = shareMesh(_mesh);
+  mesh->Scale(_factor);
+  return mesh;
+}
+
+//////////////////////////////////////////////////
+ConstMeshPtr MeshManager::Centered(const Mesh &_mesh,
+    const gz::math::Vector3d &_center)
+{
+  auto mesh = shareMesh(_mesh);
+  mesh->Center(_center);
+  return mesh;
+}
+
+//////////////////////////////////////////////////
+ConstMeshPtr MeshManager::Merged(const Mesh &_mesh)
+{
+  // Nothing to merge, share the buffers
+  if (_mesh.SubMeshCount() <= 1u)
   {
-    delete m.second;
+    auto mesh = shareMesh(_mesh);
+    mesh->SetName(_mesh.Name() + "_merged");
+    return mesh;
   }
+  return MergeSubMeshes(_mesh);
+}
+
+//////////////////////////////////////////////////
+void MeshManager::RemoveAll()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
   this->dataPtr->meshes.clear();
+  this->dataPtr->loadedMeshes.clear();
+  this->dataPtr->builtins.clear();
 }
 
 //////////////////////////////////////////////////
 bool MeshManager::RemoveMesh(const std::string &_name)
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
 
   auto iter = this->dataPtr->meshes.find(_name);
   if (iter != this->dataPtr->meshes.end())
   {
-    delete iter->second;
     this->dataPtr->meshes.erase(iter);
+    this->dataPtr->loadedMeshes.erase(_name);
     return true;
   }
 
-  return false;
+  // A built-in mesh which has not been created yet
+  return this->dataPtr->builtins.erase(_name) > 0;
 }
 
 //////////////////////////////////////////////////
@@ -310,9 +694,8 @@ bool MeshManager::HasMesh(const std::string &_name) const
   if (_name.empty())
     return false;
 
-  auto iter = this->dataPtr->meshes.find(_name);
-
-  return iter != this->dataPtr->meshes.end();
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->FindMesh(_name) != nullptr;
 }
 
 //////////////////////////////////////////////////
@@ -330,9 +713,8 @@ void MeshManager::CreateSphere(const std::string &name, float radius,
   gz::math::Vector3d vert, norm;
   unsigned int verticeIndex = 0;
 
-  Mesh *mesh = new Mesh();
+  auto mesh = std::make_unique<Mesh>();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
 
   SubMesh subMesh;
 
@@ -373,6 +755,7 @@ void MeshManager::CreateSphere(const std::string &name, float radius,
     }
   }
   mesh->AddSubMesh(subMesh);
+  this->dataPtr->InsertMesh(name, std::move(mesh));
 }
 
 //////////////////////////////////////////////////
@@ -398,9 +781,8 @@ void MeshManager::CreatePlane(const std::string &_name,
     return;
   }
 
-  Mesh *mesh = new Mesh();
+  auto mesh = std::make_unique<Mesh>();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
 
   SubMesh subMesh;
 
@@ -470,6 +852,7 @@ void MeshManager::CreatePlane(const std::string &_name,
       static_cast<int>(_segments.X() + 1),
       static_cast<int>(_segments.Y() + 1), false);
   mesh->AddSubMesh(subMesh);
+  this->dataPtr->InsertMesh(_name, std::move(mesh));
 }
 
 //////////////////////////////////////////////////
@@ -484,9 +867,8 @@ void MeshManager::CreateBox(const std::string &_name,
     return;
   }
 
-  Mesh *mesh = new Mesh();
+  auto mesh = std::make_unique<Mesh>();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
 
   SubMesh subMesh;
 
@@ -572,6 +954,7 @@ void MeshManager::CreateBox(const std::string &_name,
   for (i = 0; i < 36; ++i)
     subMesh.AddIndex(ind[i]);
   mesh->AddSubMesh(subMesh);
+  this->dataPtr->InsertMesh(_name, std::move(mesh));
 }
 
 //////////////////////////////////////////////////
@@ -579,7 +962,6 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
     const std::vector<std::vector<gz::math::Vector2d> > &_polys,
     double _height)
 {
-#ifndef _WIN32
   // distance tolerence between 2 points. This is used when creating a list
   // of distinct points in the polylines.
   double tol = 1e-4;
@@ -606,7 +988,7 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
     return;
   }
 
-  Mesh *mesh = new Mesh();
+  auto mesh = std::make_unique<Mesh>();
   mesh->SetName(_name);
 
   SubMesh subMesh;
@@ -617,91 +999,43 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
                                                   tol,
                                                   vertices,
                                                   edges);
-  if (!GTSMeshUtils::DelaunayTriangulation(vertices, edges, &subMesh))
+  std::vector<unsigned int> triangles;
+  if (edges.empty() ||
+      !PolygonTriangulation::Triangulate(vertices, edges, triangles))
   {
     gzerr << "Unable to triangulate polyline." << std::endl;
-    delete mesh;
     return;
   }
 
-  std::vector<gz::math::Vector3d> normals;
-  for (unsigned int i  = 0; i < edges.size(); ++i)
+  // The triangles keep the vertex table, and are counter-clockwise: the
+  // inside of the shape is on the left of their directed edges.
+  std::unordered_set<uint64_t> triangleEdges;
+  auto edgeKey = [](unsigned int _from, unsigned int _to)
   {
-    // we retrieve each edge's coordinates
-    int i0 = edges[i][0];
-    int i1 = edges[i][1];
-    gz::math::Vector2d edgeV0 = vertices[i0];
-    gz::math::Vector2d edgeV1 = vertices[i1];
+    return (static_cast<uint64_t>(_from) << 32) | _to;
+  };
+  for (unsigned int i = 0; i < triangles.size(); i += 3)
+  {
+    triangleEdges.insert(edgeKey(triangles[i], triangles[i+1]));
+    triangleEdges.insert(edgeKey(triangles[i+1], triangles[i+2]));
+    triangleEdges.insert(edgeKey(triangles[i+2], triangles[i]));
+  }
 
-    // we look for those points in the subMesh (where indices may have changed)
-    for (unsigned int j = 0; j < subMesh.IndexCount(); j+=3)
+  // Find the outward normal of each exterior edge, on the right of the
+  // triangle edge it matches
+  std::vector<gz::math::Vector3d> normals;
+  normals.reserve(edges.size());
+  for (const auto &edge : edges)
+  {
+    gz::math::Vector2d dir = vertices[edge[1]] - vertices[edge[0]];
+    if (!triangleEdges.count(edgeKey(edge[0], edge[1])))
     {
-      gz::math::Vector3d v0 = subMesh.Vertex(subMesh.Index(j));
-      gz::math::Vector3d v1 = subMesh.Vertex(subMesh.Index(j+1));
-      gz::math::Vector3d v2 = subMesh.Vertex(subMesh.Index(j+2));
-
-      std::vector<gz::math::Vector3d> triangle;
-      triangle.push_back(v0);
-      triangle.push_back(v1);
-      triangle.push_back(v2);
-
-      int ev0 = -1;
-      for (unsigned int k = 0; k < triangle.size(); ++k)
-      {
-        if (gz::math::Vector2d(triangle[k].X(), triangle[k].Y()) ==
-            edgeV0)
-        {
-          // found a vertex in triangle that matches the vertex of the edge
-          ev0 = k;
-          break;
-        }
-      }
-      if (ev0 >=0)
-      {
-        int ev1 = -1;
-        int ev2 = -1;
-        for (unsigned int k = 0; k < triangle.size()-1; ++k)
-        {
-          int index = (ev0 + k + 1) % triangle.size();
-          gz::math::Vector3d triV = triangle[index];
-          if (math::Vector2d(triV.X(), triV.Y()) == edgeV1)
-          {
-            // found another vertex in triangle that matches the vertex of the
-            // other edge.
-            ev1 = index;
-            // Store the index of the third triangle vertex.
-            // It's either 0, 1, or 2. Find it using simple bitwise operation.
-            ev2 =  ~(ev1 | ev0) & 0x03;
-            break;
-          }
-        }
-        if (ev1 >= 0 && ev2 >= 0 && ev0 != ev1 && ev0 != ev2)
-        {
-          // Found an edge in triangle that matches the exterior edge.
-          // Now find its normal.
-
-          gz::math::Vector3d edgeVec = triangle[ev0] - triangle[ev1];
-          edgeVec.Normalize();
-          gz::math::Vector3d normal(edgeVec.Y(), -edgeVec.X(), 0);
-
-          gz::math::Vector3d otherEdgeVec = triangle[ev0] - triangle[ev2];
-          otherEdgeVec.Normalize();
-          double angle0 = otherEdgeVec.Dot(normal);
-          double angle1 = otherEdgeVec.Dot(-normal);
-
-          if (angle0 > angle1)
-          {
-            if (angle0 >= 0)
-              normals.push_back(normal);
-          }
-          else
-          {
-            if (angle1 >= 0)
-              normals.push_back(-normal);
-          }
-        }
-      }
+      if (!triangleEdges.count(edgeKey(edge[1], edge[0])))
+        break;
+      dir = -dir;
     }
+    gz::math::Vector3d normal(dir.Y(), -dir.X(), 0);
+    normals.push_back(normal.Normalize());
   }
 
   // number of exterior edge normals found should be equal to the number of
@@ -709,10 +1043,19 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
   if (normals.size() != edges.size())
   {
     gzerr << "Unable to extrude mesh. Triangulation failed" << std::endl;
-    delete mesh;
     return;
   }
 
+  // the bottom face faces down
+  for (const auto &v : vertices)
+    subMesh.AddVertex(v.X(), v.Y(), 0);
+  for (unsigned int i = 0; i < triangles.size(); i += 3)
+  {
+    subMesh.AddIndex(triangles[i]);
+    subMesh.AddIndex(triangles[i+2]);
+    subMesh.AddIndex(triangles[i+1]);
+  }
+
   unsigned int numVertices = subMesh.VertexCount();
 
   // add normal for bottom face
@@ -782,9 +1125,7 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
   }
 
   mesh->AddSubMesh(subMesh);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
-#endif
-  return;
+  this->dataPtr->InsertMesh(_name, std::move(mesh));
 }
 
 //////////////////////////////////////////////////
@@ -797,9 +1138,8 @@ void MeshManager::CreateCamera(const std::string &_name, float _scale)
     return;
   }
 
-  Mesh *mesh = new Mesh();
+  auto mesh = std::make_unique<Mesh>();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
 
   SubMesh subMesh;
 
@@ -882,6 +1222,7 @@ void MeshManager::CreateCamera(const std::string &_name, float _scale)
 
   mesh->AddSubMesh(subMesh);
   mesh->RecalculateNormals();
+  this->dataPtr->InsertMesh(_name, std::move(mesh));
 }
 
 //////////////////////////////////////////////////
@@ -895,9 +1236,8 @@ void MeshManager::CreateEllipsoid(const std::string &_name,
     return;
   }
 
-  Mesh *mesh = new Mesh();
+  auto mesh = std::make_unique<Mesh>();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
 
   SubMesh subMesh;
 
@@ -961,6 +1301,7 @@ void MeshManager::CreateEllipsoid(const std::string &_name,
     }
   }
   mesh->AddSubMesh(subMesh);
+  this->dataPtr->InsertMesh(_name, std::move(mesh));
 }
 
 //////////////////////////////////////////////////
@@ -975,9 +1316,8 @@ void MeshManager::CreateCapsule(const std::string &_name,
     return;
   }
 
-  Mesh *mesh = new Mesh();
+  auto mesh = std::make_unique<Mesh>();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
 
   SubMesh subMesh;
 
@@ -1120,6 +1460,7 @@ void MeshManager::CreateCapsule(const std::string &_name,
   }
 
   mesh->AddSubMesh(subMesh);
+  this->dataPtr->InsertMesh(_name, std::move(mesh));
 }
 
 //////////////////////////////////////////////////
@@ -1136,9 +1477,8 @@ void MeshManager::CreateCylinder(const std::string &name, float radius,
     return;
   }
 
-  Mesh *mesh = new Mesh();
+  auto mesh = std::make_unique<Mesh>();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
 
   SubMesh subMesh;
 
@@ -1237,6 +1577,7 @@ void MeshManager::CreateCylinder(const std::string &name, float radius,
     }
   }
   mesh->AddSubMesh(subMesh);
+  this->dataPtr->InsertMesh(name, std::move(mesh));
 }
 
 //////////////////////////////////////////////////
@@ -1253,9 +1594,8 @@ void MeshManager::CreateCone(const std::string &name, float radius,
     return;
   }
 
-  Mesh *mesh = new Mesh();
+  auto mesh = std::make_unique<Mesh>();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
 
   SubMesh subMesh;
 
@@ -1347,6 +1687,7 @@ void MeshManager::CreateCone(const std::string &name, float radius,
 
   mesh->AddSubMesh(subMesh);
   mesh->RecalculateNormals();
+  this->dataPtr->InsertMesh(name, std::move(mesh));
 }
 
 //////////////////////////////////////////////////
@@ -1370,9 +1711,8 @@ void MeshManager::CreateTube(const std::string &_name, float _innerRadius,
   if (this->HasMesh(_name))
     return;
 
-  Mesh *mesh = new Mesh();
+  auto mesh = std::make_unique<Mesh>();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
   SubMesh subMesh;
 
   // Generate the group of rings for the outsides of the cylinder
@@ -1514,6 +1854,7 @@ void MeshManager::CreateTube(const std::string &_name, float _innerRadius,
 
   mesh->AddSubMesh(subMesh);
   mesh->RecalculateNormals();
+  this->dataPtr->InsertMesh(_name, std::move(mesh));
 }
 
 //////////////////////////////////////////////////
@@ -1591,9 +1932,10 @@ void MeshManager::CreateBoolean(const std::string &_name, const Mesh *_m1,
 
 #ifndef _WIN32
   MeshCSG csg;
-  Mesh *mesh = csg.CreateBoolean(_m1, _m2, _operation, _offset);
+  std::unique_ptr<Mesh> mesh(
+      csg.CreateBoolean(_m1, _m2, _operation, _offset));
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->InsertMesh(_name, std::move(mesh));
 #endif
 }
 
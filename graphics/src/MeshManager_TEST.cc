@@ -17,6 +17,10 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "gz/common/Mesh.hh"
 #include "gz/common/SubMesh.hh"
 #include "gz/common/MeshManager.hh"
@@ -30,6 +34,94 @@ using namespace gz;
 #ifndef _WIN32
 class MeshManager : public common::testing::AutoLogFixture { };
 
+/////////////////////////////////////////////////
+TEST_F(MeshManager, Builtins)
+{
+  auto mgr = common::MeshManager::Instance();
+
+  // Created once when first requested by several threads
+  const std::vector<std::string> names{
+      "unit_plane", "joint_anchor", "body_cg", "axis_shaft", "axis_head"};
+  std::vector<std::vector<const common::Mesh *>> found(4);
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < found.size(); ++t)
+  {
+    threads.emplace_back([&, t]
+    {
+      for (const auto &name : names)
+      {
+        EXPECT_TRUE(mgr->HasMesh(name));
+        found[t].push_back(t % 2 == 0 ?
+            mgr->MeshByName(name) : mgr->MeshHandle(name).get());
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  for (std::size_t i = 0; i < names.size(); ++i)
+  {
+    ASSERT_NE(nullptr, found[0][i]);
+    EXPECT_EQ(names[i], found[0][i]->Name());
+    for (const auto &meshes : found)
+      EXPECT_EQ(found[0][i], meshes[i]);
+  }
+
+  // Created when first requested
+  EXPECT_TRUE(mgr->HasMesh("unit_box"));
+  const common::Mesh *sphere = mgr->MeshByName("unit_sphere");
+  ASSERT_NE(nullptr, sphere);
+  EXPECT_EQ("unit_sphere", sphere->Name());
+  EXPECT_EQ(sphere, mgr->MeshByName("unit_sphere"));
+  EXPECT_EQ(sphere, mgr->MeshHandle("unit_sphere").get());
+  EXPECT_NE(nullptr, mgr->MeshHandle("selection_tube"));
+
+  // A built-in mesh is not replaced by another mesh with the same name
+  mgr->CreateBox("unit_cylinder", math::Vector3d::One, math::Vector2d::One);
+  const common::Mesh *cylinder = mgr->MeshByName("unit_cylinder");
+  ASSERT_NE(nullptr, cylinder);
+  EXPECT_LT(24u, cylinder->VertexCount());
+
+  // Removed built-in meshes are not created again
+  EXPECT_TRUE(mgr->RemoveMesh("unit_cone"));
+  EXPECT_FALSE(mgr->HasMesh("unit_cone"));
+  EXPECT_FALSE(mgr->RemoveMesh("unit_cone"));
+  EXPECT_TRUE(mgr->RemoveMesh("unit_box"));
+  EXPECT_EQ(nullptr, mgr->MeshByName("unit_box"));
+
+  mgr->RemoveAll();
+  EXPECT_FALSE(mgr->HasMesh("unit_camera"));
+  EXPECT_EQ(nullptr, mgr->MeshByName("unit_sphere"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, CreateConcurrently)
+{
+  auto mgr = common::MeshManager::Instance();
+
+  // Meshes are published once complete, whichever thread creates them
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([mgr]
+    {
+      for (int i = 0; i < 20; ++i)
+      {
+        const std::string name = "concurrent_sphere_" + std::to_string(i);
+        mgr->CreateSphere(name, 1.0f, 16, 16);
+        auto mesh = mgr->MeshHandle(name);
+        ASSERT_NE(nullptr, mesh);
+        EXPECT_EQ(1u, mesh->SubMeshCount());
+        EXPECT_LT(0u, mesh->VertexCount());
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  for (int i = 0; i < 20; ++i)
+    EXPECT_TRUE(mgr->RemoveMesh("concurrent_sphere_" + std::to_string(i)));
+}
+
 /////////////////////////////////////////////////
 TEST_F(MeshManager, CreateExtrudedPolyline)
 {
@@ -291,6 +383,74 @@ TEST_F(MeshManager, Remove)
   EXPECT_FALSE(mgr->HasMesh("sphere"));
 }
 
+/////////////////////////////////////////////////
+TEST_F(MeshManager, LoadOptions)
+{
+  auto mgr = common::MeshManager::Instance();
+  const std::string file = common::testing::TestFile("data", "box.obj");
+  auto options = common::MeshLoadOptions::GeometryOnly();
+
+  const common::Mesh *full = mgr->Load(file);
+  const common::Mesh *geometry = mgr->Load(file, options);
+  ASSERT_NE(nullptr, full);
+  ASSERT_NE(nullptr, geometry);
+
+  // Both variants are cached
+  EXPECT_NE(full, geometry);
+  EXPECT_EQ(full, mgr->Load(file));
+  EXPECT_EQ(geometry, mgr->Load(file, options));
+  EXPECT_EQ(full, mgr->Load(file, common::MeshLoadOptions()));
+  EXPECT_TRUE(mgr->HasMesh(file + options.CacheKey()));
+
+  EXPECT_EQ(36u, full->NormalCount());
+  EXPECT_EQ(0u, geometry->NormalCount());
+  EXPECT_EQ(0u, geometry->MaterialCount());
+  EXPECT_EQ(full->VertexCount(), geometry->VertexCount());
+
+  mgr->RemoveAll();
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, Prefetch)
+{
+  auto mgr = common::MeshManager::Instance();
+  mgr->RemoveAll();
+  const std::string obj = common::testing::TestFile("data", "box.obj");
+  const std::string dae = common::testing::TestFile("data", "box.dae");
+  const std::string stl =
+      common::testing::TestFile("data", "cube_binary.stl");
+  const std::string image =
+      common::testing::TestFile("data", "heightmap_bowl.png");
+
+  // Duplicates, missing files and other formats are skipped
+  EXPECT_EQ(4u, mgr->Prefetch({obj, dae, stl, image, obj,
+      common::testing::TestFile("data", "no_such_mesh.dae"),
+      common::testing::TestFile("data", "box.mtl")},
+      common::MeshLoadOptions(), 2));
+  EXPECT_TRUE(mgr->HasMesh(obj));
+  EXPECT_TRUE(mgr->HasMesh(dae));
+  EXPECT_TRUE(mgr->HasMesh(stl));
+  EXPECT_FALSE(mgr->HasMesh(image));
+
+  const common::Mesh *box = mgr->MeshByName(obj);
+  ASSERT_NE(nullptr, box);
+  EXPECT_EQ(box, mgr->Load(obj));
+  EXPECT_EQ(36u, box->NormalCount());
+  EXPECT_EQ(1u, mgr->Prefetch({obj}));
+
+  // Options select a separate cache entry
+  auto options = common::MeshLoadOptions::GeometryOnly();
+  EXPECT_EQ(1u, mgr->Prefetch({obj}, options));
+  const common::Mesh *geometry = mgr->MeshByName(obj + options.CacheKey());
+  ASSERT_NE(nullptr, geometry);
+  EXPECT_EQ(geometry, mgr->Load(obj, options));
+  EXPECT_EQ(0u, geometry->NormalCount());
+
+  // Prefetched meshes can be evicted like loaded ones
+  EXPECT_EQ(4u, mgr->EvictUnused());
+  mgr->RemoveAll();
+}
+
 /////////////////////////////////////////////////
 TEST_F(MeshManager, ConvexDecomposition)
 {
@@ -426,4 +586,70 @@ TEST_F(MeshManager, MergeSubMeshes)
   EXPECT_EQ(math::Vector2d(0, 0.6), mergedSubmesh->TexCoordBySet(5u, 2u));
 }
 
+/////////////////////////////////////////////////
+TEST_F(MeshManager, Handles)
+{
+  auto mgr = common::MeshManager::Instance();
+  const std::string file = common::testing::TestFile("data", "box.obj");
+  const std::string other = common::testing::TestFile("data", "box.dae");
+
+  // Start without meshes loaded by other tests
+  mgr->EvictUnused();
+  mgr->CreateBox("handle_box", math::Vector3d::One, math::Vector2d::One);
+
+  common::ConstMeshPtr box = mgr->LoadHandle(file);
+  ASSERT_NE(nullptr, box);
+  EXPECT_EQ(box.get(), mgr->Load(file));
+  EXPECT_EQ(box, mgr->MeshHandle(file));
+  EXPECT_EQ(nullptr, mgr->MeshHandle("no_such_mesh"));
+  ASSERT_NE(nullptr, mgr->Load(other));
+
+  // Only unreferenced meshes loaded from files are evicted
+  EXPECT_EQ(1u, mgr->EvictUnused());
+  EXPECT_TRUE(mgr->HasMesh(file));
+  EXPECT_FALSE(mgr->HasMesh(other));
+  EXPECT_TRUE(mgr->HasMesh("handle_box"));
+
+  // Variants share the buffers they do not modify
+  auto subMesh = box->SubMeshByIndex(0).lock();
+  ASSERT_NE(nullptr, subMesh);
+  common::ConstMeshPtr scaled =
+      common::MeshManager::Scaled(*box, math::Vector3d(2, 2, 2));
+  ASSERT_NE(nullptr, scaled);
+  auto scaledSubMesh = scaled->SubMeshByIndex(0).lock();
+  ASSERT_NE(nullptr, scaledSubMesh);
+  EXPECT_EQ(subMesh->IndexPtr(), scaledSubMesh->IndexPtr());
+  EXPECT_NE(subMesh->VertexPtr(), scaledSubMesh->VertexPtr());
+  EXPECT_EQ(box->Max() * 2, scaled->Max());
+  EXPECT_EQ(box->MaterialCount(), scaled->MaterialCount());
+
+  common::ConstMeshPtr centered = common::MeshManager::Centered(*scaled,
+      math::Vector3d(1, 0, 0));
+  ASSERT_NE(nullptr, centered);
+  EXPECT_EQ(math::Vector3d(1, 0, 0),
+      (centered->Max() + centered->Min()) * 0.5);
+  EXPECT_EQ(subMesh->IndexPtr(),
+      centered->SubMeshByIndex(0).lock()->IndexPtr());
+
+  common::ConstMeshPtr merged = common::MeshManager::Merged(*box);
+  ASSERT_NE(nullptr, merged);
+  EXPECT_EQ(subMesh->VertexPtr(),
+      merged->SubMeshByIndex(0).lock()->VertexPtr());
+
+  // Handles keep meshes alive after they are removed from the manager
+  EXPECT_TRUE(mgr->RemoveMesh(file));
+  EXPECT_FALSE(mgr->HasMesh(file));
+  EXPECT_EQ(36u, box->NormalCount());
+  EXPECT_EQ(0u, mgr->EvictUnused());
+
+  // Evicted meshes are loaded again on demand
+  const common::Mesh *reloaded = mgr->Load(file);
+  ASSERT_NE(nullptr, reloaded);
+  EXPECT_NE(box.get(), reloaded);
+  EXPECT_EQ(1u, mgr->EvictUnused());
+  EXPECT_FALSE(mgr->HasMesh(file));
+
+  mgr->RemoveAll();
+}
+
 #endif
@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <vector>
+
 #include "gz/common/Material.hh"
 #include "gz/common/Mesh.hh"
 #include "gz/common/Skeleton.hh"
@@ -159,3 +162,69 @@ TEST_F(MeshTest, Mesh)
   delete [] vertices;
   delete [] indices;
 }
+
+/////////////////////////////////////////////////
+TEST_F(MeshTest, FillBuffers)
+{
+  common::Mesh mesh;
+  for (int s = 0; s < 2; ++s)
+  {
+    common::SubMesh submesh;
+    submesh.SetPrimitiveType(common::SubMesh::TRIANGLES);
+    for (int v = 0; v < 3; ++v)
+      submesh.AddVertex(s, v, 0.5);
+    submesh.AddIndex(0);
+    submesh.AddIndex(1);
+    submesh.AddIndex(2);
+    mesh.AddSubMesh(submesh);
+  }
+
+  std::vector<float> vertices(18);
+  EXPECT_FALSE(mesh.FillVertices(vertices.data(), 17));
+  ASSERT_TRUE(mesh.FillVertices(vertices.data(), vertices.size()));
+  EXPECT_FLOAT_EQ(0.0f, vertices[0]);
+  EXPECT_FLOAT_EQ(1.0f, vertices[9]);
+  EXPECT_FLOAT_EQ(2.0f, vertices[16]);
+  EXPECT_FLOAT_EQ(0.5f, vertices[17]);
+
+  // Indices of the second submesh refer to its vertices
+  std::vector<uint16_t> indices(6);
+  EXPECT_FALSE(mesh.FillIndices(indices.data(), 5));
+  ASSERT_TRUE(mesh.FillIndices(indices.data(), indices.size()));
+  EXPECT_EQ((std::vector<uint16_t>{0, 1, 2, 3, 4, 5}), indices);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshTest, FillBuffersParallel)
+{
+  // Large enough to be copied on several threads
+  common::Mesh mesh;
+  const unsigned int perSubMesh = 30000;
+  for (int s = 0; s < 4; ++s)
+  {
+    common::SubMesh submesh;
+    submesh.SetPrimitiveType(common::SubMesh::TRIANGLES);
+    for (unsigned int v = 0; v < perSubMesh; ++v)
+    {
+      submesh.AddVertex(s, v, 0);
+      submesh.AddIndex(perSubMesh - 1 - v);
+    }
+    mesh.AddSubMesh(submesh);
+  }
+
+  std::vector<double> vertices(mesh.VertexCount() * 3);
+  ASSERT_TRUE(mesh.FillVertices(vertices.data(), vertices.size()));
+  std::vector<uint32_t> indices(mesh.IndexCount());
+  ASSERT_TRUE(mesh.FillIndices(indices.data(), indices.size()));
+  for (unsigned int s = 0; s < 4; ++s)
+  {
+    const std::size_t first = s * perSubMesh;
+    EXPECT_DOUBLE_EQ(s, vertices[first * 3]);
+    EXPECT_EQ(first + perSubMesh - 1, indices[first]);
+    EXPECT_EQ(first, indices[first + perSubMesh - 1]);
+  }
+
+  // More than 65536 vertices do not fit in 16 bit indices
+  std::vector<uint16_t> shorts(mesh.IndexCount());
+  EXPECT_FALSE(mesh.FillIndices(shorts.data(), shorts.size()));
+}
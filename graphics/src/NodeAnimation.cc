@@ -14,7 +14,11 @@
  * limitations under the License.
  *
 */
-#include <map>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
+
 #include "gz/common/Console.hh"
 #include "gz/common/NodeAnimation.hh"
 
@@ -27,8 +31,11 @@ class gz::common::NodeAnimation::Implementation
   /// \brief the name of the animation
   public: std::string name;
 
-  /// \brief the dictionary of key frames, indexed by time
-  public: std::map<double, math::Matrix4d> keyFrames;
+  /// \brief Key frame times, sorted in increasing order
+  public: std::vector<double> times;
+
+  /// \brief Key frame transformations, in the same order as times
+  public: std::vector<math::Matrix4d> transforms;
 
   /// \brief the duration of the animations (time of last key frame)
   public: double length = 0.0;
@@ -65,7 +72,28 @@ void NodeAnimation::AddKeyFrame(const double _time,
   if (_time > this->dataPtr->length)
     this->dataPtr->length = _time;
 
-  this->dataPtr->keyFrames[_time] = _trans;
+  auto &times = this->dataPtr->times;
+  auto &transforms = this->dataPtr->transforms;
+
+  // Frames are usually added in order
+  if (times.empty() || _time > times.back())
+  {
+    times.push_back(_time);
+    transforms.push_back(_trans);
+    return;
+  }
+
+  auto it = std::lower_bound(times.begin(), times.end(), _time);
+  const auto index = it - times.begin();
+  if (*it == _time)
+  {
+    transforms[index] = _trans;
+  }
+  else
+  {
+    times.insert(it, _time);
+    transforms.insert(transforms.begin() + index, _trans);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -77,30 +105,77 @@ void NodeAnimation::AddKeyFrame(const double _time, const math::Pose3d &_pose)
   this->AddKeyFrame(_time, mat);
 }
 
+//////////////////////////////////////////////////
+bool NodeAnimation::SetKeyFrames(std::vector<double> _times,
+    std::vector<math::Matrix4d> _transforms)
+{
+  if (_times.size() != _transforms.size())
+  {
+    gzerr << "Number of key frame times [" << _times.size()
+          << "] and transformations [" << _transforms.size()
+          << "] differ" << std::endl;
+    return false;
+  }
+
+  if (!std::is_sorted(_times.begin(), _times.end()) ||
+      std::adjacent_find(_times.begin(), _times.end()) != _times.end())
+  {
+    // Same result as adding the frames one at a time: sorted by time, the
+    // last frame wins when times are repeated
+    std::vector<std::size_t> order(_times.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(),
+        [&](const std::size_t _a, const std::size_t _b)
+        {
+          return _times[_a] < _times[_b];
+        });
+
+    std::vector<double> times;
+    std::vector<math::Matrix4d> transforms;
+    times.reserve(order.size());
+    transforms.reserve(order.size());
+    for (const auto i : order)
+    {
+      if (!times.empty() && times.back() == _times[i])
+      {
+        transforms.back() = _transforms[i];
+      }
+      else
+      {
+        times.push_back(_times[i]);
+        transforms.push_back(_transforms[i]);
+      }
+    }
+    _times = std::move(times);
+    _transforms = std::move(transforms);
+  }
+
+  this->dataPtr->times = std::move(_times);
+  this->dataPtr->transforms = std::move(_transforms);
+  this->dataPtr->length = this->dataPtr->times.empty() ? 0.0 :
+      std::max(0.0, this->dataPtr->times.back());
+  return true;
+}
+
 //////////////////////////////////////////////////
 unsigned int NodeAnimation::FrameCount() const
 {
-  return this->dataPtr->keyFrames.size();
+  return this->dataPtr->times.size();
 }
 
 //////////////////////////////////////////////////
 void NodeAnimation::KeyFrame(const unsigned int _i, double &_time,
         math::Matrix4d &_trans) const
 {
-  if (_i >= this->dataPtr->keyFrames.size())
+  if (_i >= this->dataPtr->times.size())
   {
     gzerr << "Invalid key frame index " << _i << "\n";
     _time = -1.0;
   }
   else
   {
-    std::map<double, math::Matrix4d>::const_iterator iter =
-      this->dataPtr->keyFrames.begin();
-
-    std::advance(iter, _i);
-
-    _time = iter->first;
-    _trans = iter->second;
+    _time = this->dataPtr->times[_i];
+    _trans = this->dataPtr->transforms[_i];
   }
 }
 
@@ -138,24 +213,28 @@ math::Matrix4d NodeAnimation::FrameAt(double _time, bool _loop) const
     }
   }
 
-  if (math::equal(time, this->dataPtr->length))
-    return this->dataPtr->keyFrames.rbegin()->second;
+  const auto &times = this->dataPtr->times;
+  const auto &transforms = this->dataPtr->transforms;
+  if (transforms.empty())
+    return math::Matrix4d::Identity;
 
-  std::map<double, math::Matrix4d>::const_iterator it1 =
-    this->dataPtr->keyFrames.upper_bound(time);
+  if (math::equal(time, this->dataPtr->length))
+    return transforms.back();
 
-  if (it1 == this->dataPtr->keyFrames.begin() || math::equal(it1->first, time))
-    return it1->second;
+  const std::size_t next = std::upper_bound(times.begin(), times.end(), time) -
+      times.begin();
+  if (next == times.size())
+    return transforms.back();
 
-  std::map<double, math::Matrix4d>::const_iterator it2 = it1--;
+  if (next == 0 || math::equal(times[next], time))
+    return transforms[next];
 
-  if (math::equal(it2->first, time))
-    return it2->second;
+  const std::size_t prev = next - 1;
 
-  double nextKey = it2->first;
-  math::Matrix4d nextTrans = it2->second;
-  double prevKey = it1->first;
-  math::Matrix4d prevTrans = it1->second;
+  double nextKey = times[next];
+  const math::Matrix4d &nextTrans = transforms[next];
+  double prevKey = times[prev];
+  const math::Matrix4d &prevTrans = transforms[prev];
 
   double t = (time - prevKey) / (nextKey - prevKey);
 
@@ -185,36 +264,36 @@ math::Matrix4d NodeAnimation::FrameAt(double _time, bool _loop) const
 //////////////////////////////////////////////////
 void NodeAnimation::Scale(const double _scale)
 {
-  for (std::map<double, math::Matrix4d>::iterator iter =
-      this->dataPtr->keyFrames.begin();
-      iter != this->dataPtr->keyFrames.end(); ++iter)
+  for (auto &mat : this->dataPtr->transforms)
   {
-    math::Matrix4d *mat = &iter->second;
-    math::Vector3d pos = mat->Translation();
-    mat->SetTranslation(pos * _scale);
+    math::Vector3d pos = mat.Translation();
+    mat.SetTranslation(pos * _scale);
   }
 }
 
 //////////////////////////////////////////////////
 double NodeAnimation::TimeAtX(const double _x) const
 {
-  std::map<double, math::Matrix4d>::const_iterator it1 =
-    this->dataPtr->keyFrames.begin();
+  const auto &times = this->dataPtr->times;
+  const auto &transforms = this->dataPtr->transforms;
 
-  while (it1->second.Translation().X() < _x)
-    ++it1;
+  std::size_t next = 0;
+  while (next + 1 < transforms.size() &&
+      transforms[next].Translation().X() < _x)
+  {
+    ++next;
+  }
 
-  if (it1 == this->dataPtr->keyFrames.begin() ||
-      math::equal(it1->second.Translation().X(), _x))
+  if (next == 0 || math::equal(transforms[next].Translation().X(), _x))
   {
-    return it1->first;
+    return times[next];
   }
 
-  std::map<double, math::Matrix4d>::const_iterator it2 = it1--;
-  double x1 = it1->second.Translation().X();
-  double x2 = it2->second.Translation().X();
-  double t1 = it1->first;
-  double t2 = it2->first;
+  const std::size_t prev = next - 1;
+  double x1 = transforms[prev].Translation().X();
+  double x2 = transforms[next].Translation().X();
+  double t1 = times[prev];
+  double t2 = times[next];
 
   return t1 + ((t2 - t1) * (_x - x1) / (x2 - x1));
 }
@@ -55,14 +55,27 @@ OBJLoader::~OBJLoader()
 
 //////////////////////////////////////////////////
 Mesh *OBJLoader::Load(const std::string &_filename)
+{
+  return this->Load(_filename, MeshLoadOptions());
+}
+
+//////////////////////////////////////////////////
+Mesh *OBJLoader::Load(const std::string &_filename,
+    const MeshLoadOptions &_options)
 {
   std::map<std::string, Material *> materialIds;
   std::string path = common::parentPath(_filename);
+  const bool loadMaterials = _options.Materials();
+  const bool loadTextures = _options.Textures();
+  const bool loadNormals = _options.Normals();
+  const bool loadTexCoords = _options.TexCoords();
 
   // check if obj is exported by blender
   // blender shoves BR fields in standard textures
   bool exportedByBlender = false;
-  std::ifstream infile(_filename);
+  std::ifstream infile;
+  if (loadTextures)
+    infile.open(_filename);
   if (infile.good())
   {
     std::string line;
@@ -83,8 +96,26 @@ Mesh *OBJLoader::Load(const std::string &_filename)
 
   std::string warn;
   std::string err;
-  bool ret = tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err,
-      _filename.c_str(), path.c_str(), triangulate);
+  bool ret = false;
+  if (loadMaterials)
+  {
+    ret = tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err,
+        _filename.c_str(), path.c_str(), triangulate);
+  }
+  else
+  {
+    // Without a material reader the mtllib statements are ignored
+    std::ifstream objFile(_filename);
+    if (objFile)
+    {
+      ret = tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err,
+          &objFile, nullptr, triangulate);
+    }
+    else
+    {
+      err = "Cannot open file [" + _filename + "]";
+    }
+  }
 
   if (!warn.empty())
   {
@@ -144,46 +175,49 @@ Mesh *OBJLoader::Load(const std::string &_filename)
                 math::Color(m.emission[0], m.emission[1], m.emission[2]));
             mat->SetShininess(m.shininess);
             mat->SetTransparency(1.0 - m.dissolve);
-            if (!m.diffuse_texname.empty())
+            if (loadTextures && !m.diffuse_texname.empty())
               mat->SetTextureImage(m.diffuse_texname, path.c_str());
 
-            // load PBR textures
-            // Some obj exporters put PBR maps in the standard textures
-            // while others have proper support for obj PBR extension
             Pbr pbrMat;
-            // PBR shoved into standard textures
-            if (!m.specular_texname.empty())
-              pbrMat.SetRoughnessMap(m.specular_texname);
-
-            // check if obj is exported by blender
-            // blender obj exporter puts roughness map in specular highlight
-            // field and metalness map in reflection map field!
-            // see summary in https://developer.blender.org/D8868
-            // detailing the existing exporter issues
-            // todo(anyone) add a check for blender version to avoid this hack
-            // when blender fixes their exporter issue
-            if (!m.specular_highlight_texname.empty() && exportedByBlender)
+            if (loadTextures)
             {
-              pbrMat.SetRoughnessMap(m.specular_highlight_texname);
-              if (!m.reflection_texname.empty())
-                pbrMat.SetMetalnessMap(m.reflection_texname);
-            }
-            else if (!m.reflection_texname.empty())
-            {
-              pbrMat.SetEnvironmentMap(m.reflection_texname);
+              // load PBR textures
+              // Some obj exporters put PBR maps in the standard textures
+              // while others have proper support for obj PBR extension
+              // PBR shoved into standard textures
+              if (!m.specular_texname.empty())
+                pbrMat.SetRoughnessMap(m.specular_texname);
+
+              // check if obj is exported by blender
+              // blender obj exporter puts roughness map in specular
+              // highlight field and metalness map in reflection map field!
+              // see summary in https://developer.blender.org/D8868
+              // detailing the existing exporter issues
+              // todo(anyone) add a check for blender version to avoid this
+              // hack when blender fixes their exporter issue
+              if (!m.specular_highlight_texname.empty() && exportedByBlender)
+              {
+                pbrMat.SetRoughnessMap(m.specular_highlight_texname);
+                if (!m.reflection_texname.empty())
+                  pbrMat.SetMetalnessMap(m.reflection_texname);
+              }
+              else if (!m.reflection_texname.empty())
+              {
+                pbrMat.SetEnvironmentMap(m.reflection_texname);
+              }
+              if (!m.bump_texname.empty())
+                pbrMat.SetNormalMap(m.bump_texname);
+
+              // PBR extension - overrides standard materials
+              if (!m.roughness_texname.empty())
+                pbrMat.SetRoughnessMap(m.roughness_texname);
+              if (!m.metallic_texname.empty())
+                pbrMat.SetMetalnessMap(m.metallic_texname);
+              if (!m.normal_texname.empty())
+                pbrMat.SetNormalMap(m.normal_texname);
+              if (!m.emissive_texname.empty())
+                pbrMat.SetEmissiveMap(m.emissive_texname);
             }
-            if (!m.bump_texname.empty())
-              pbrMat.SetNormalMap(m.bump_texname);
-
-            // PBR extension - overrides standard materials
-            if (!m.roughness_texname.empty())
-              pbrMat.SetRoughnessMap(m.roughness_texname);
-            if (!m.metallic_texname.empty())
-              pbrMat.SetMetalnessMap(m.metallic_texname);
-            if (!m.normal_texname.empty())
-              pbrMat.SetNormalMap(m.normal_texname);
-            if (!m.emissive_texname.empty())
-              pbrMat.SetEmissiveMap(m.emissive_texname);
 
             pbrMat.SetRoughness(m.roughness);
             pbrMat.SetMetalness(m.metallic);
@@ -197,7 +231,7 @@ Mesh *OBJLoader::Load(const std::string &_filename)
             matIndex = mesh->AddMaterial(MaterialPtr(mat));
           subMesh->SetMaterialIndex(matIndex);
         }
-        else
+        else if (loadMaterials)
         {
           gzwarn << "Missing material for shape[" << s.name << "] "
               << "in OBJ file[" << _filename << "]" << std::endl;
@@ -228,7 +262,7 @@ Mesh *OBJLoader::Load(const std::string &_filename)
         subMesh->AddVertex(vertex);
 
         // normals
-        if (attrib.normals.size() > 0)
+        if (loadNormals && attrib.normals.size() > 0)
         {
           int nIdx = i.normal_index;
           gz::math::Vector3d normal(attrib.normals[3 * nIdx],
@@ -238,7 +272,7 @@ Mesh *OBJLoader::Load(const std::string &_filename)
           subMesh->AddNormal(normal);
         }
         // texcoords
-        if (attrib.texcoords.size() > 0)
+        if (loadTexCoords && attrib.texcoords.size() > 0)
         {
           int tIdx = i.texcoord_index;
           gz::math::Vector2d uv(attrib.texcoords[2 * tIdx],
@@ -16,6 +16,8 @@
 */
 #include <gtest/gtest.h>
 
+#include <memory>
+
 #include "gz/common/Mesh.hh"
 #include "gz/common/SubMesh.hh"
 #include "gz/common/Material.hh"
@@ -63,6 +65,52 @@ TEST_F(OBJLoaderTest, LoadObjBox)
   delete mesh;
 }
 
+/////////////////////////////////////////////////
+TEST_F(OBJLoaderTest, LoadOptions)
+{
+  common::OBJLoader loader;
+  common::Mesh *mesh = loader.Load(
+      common::testing::TestFile("data", "box.obj"),
+      common::MeshLoadOptions::GeometryOnly());
+
+  EXPECT_EQ(gz::math::Vector3d(1, 1, 1), mesh->Max());
+  EXPECT_EQ(gz::math::Vector3d(-1, -1, -1), mesh->Min());
+  EXPECT_EQ(36u, mesh->VertexCount());
+  EXPECT_EQ(0u, mesh->NormalCount());
+  EXPECT_EQ(36u, mesh->IndexCount());
+  EXPECT_EQ(1u, mesh->SubMeshCount());
+  EXPECT_EQ(0u, mesh->MaterialCount());
+  delete mesh;
+
+  // Materials without their textures
+  common::MeshLoadOptions options;
+  options.SetTextures(false);
+  mesh = loader.Load(
+      common::testing::TestFile("data", "cube_pbr.obj"), options);
+  ASSERT_EQ(1u, mesh->MaterialCount());
+  const common::MaterialPtr mat = mesh->MaterialByIndex(0u);
+  ASSERT_NE(nullptr, mat);
+  EXPECT_TRUE(mat->TextureImage().empty());
+  ASSERT_NE(nullptr, mat->PbrMaterial());
+  EXPECT_TRUE(mat->PbrMaterial()->MetalnessMap().empty());
+  delete mesh;
+}
+
+/////////////////////////////////////////////////
+TEST_F(OBJLoaderTest, LoadOptionsFromBase)
+{
+  // Options are applied when loading through the base class
+  common::OBJLoader objLoader;
+  common::MeshLoader &loader = objLoader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(
+      common::testing::TestFile("data", "box.obj"),
+      common::MeshLoadOptions::GeometryOnly()));
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(36u, mesh->VertexCount());
+  EXPECT_EQ(0u, mesh->NormalCount());
+  EXPECT_EQ(0u, mesh->MaterialCount());
+}
+
 /////////////////////////////////////////////////
 // This tests opening an OBJ file that has an invalid material reference
 TEST_F(OBJLoaderTest, InvalidMaterial)
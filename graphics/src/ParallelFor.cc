@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <gz/utils/NeverDestroyed.hh>
+
+#include "gz/common/WorkerPool.hh"
+
+#include "ParallelFor.hh"
+
+using namespace gz;
+using namespace common;
+
+namespace
+{
+  /// \brief State shared by the calling thread and the helpers of a
+  /// parallelFor. Helpers may start after the call returned, so they own
+  /// a reference to it.
+  struct ParallelState
+  {
+    /// \brief Function to call for each index.
+    std::function<void(std::size_t)> work;
+
+    /// \brief Number of indices.
+    std::size_t count{0};
+
+    /// \brief Next index to hand out.
+    std::atomic<std::size_t> next{0};
+
+    /// \brief Protects active.
+    std::mutex mutex;
+
+    /// \brief Notified when the last active helper is done.
+    std::condition_variable done;
+
+    /// \brief Number of helpers which may still call work.
+    unsigned int active{0};
+  };
+
+  /// \brief Call the work function until all indices are handed out.
+  /// \param[in] _state State of the parallelFor.
+  void runIndices(ParallelState &_state)
+  {
+    for (std::size_t i = _state.next++; i < _state.count; i = _state.next++)
+      _state.work(i);
+  }
+
+  /// \brief Get the pool shared by the graphics library. It is never
+  /// destroyed, as it may be used during static destruction.
+  /// \return The pool, with one thread per hardware thread.
+  WorkerPool &sharedPool()
+  {
+    static gz::utils::NeverDestroyed<WorkerPool> pool;
+    return pool.Access();
+  }
+}
+
+//////////////////////////////////////////////////
+void common::parallelFor(const std::size_t _count,
+    const std::function<void(std::size_t)> &_work,
+    const unsigned int _concurrency)
+{
+  const unsigned int concurrency = _concurrency > 0 ? _concurrency :
+      std::max(1u, std::thread::hardware_concurrency());
+  const std::size_t threads = std::min<std::size_t>(_count, concurrency);
+  if (threads <= 1)
+  {
+    for (std::size_t i = 0; i < _count; ++i)
+      _work(i);
+    return;
+  }
+
+  auto state = std::make_shared<ParallelState>();
+  state->work = _work;
+  state->count = _count;
+
+  auto &pool = sharedPool();
+  for (std::size_t i = 1; i < threads; ++i)
+  {
+    pool.AddWork([state]
+    {
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->next >= state->count)
+          return;
+        ++state->active;
+      }
+      runIndices(*state);
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (--state->active == 0)
+        state->done.notify_all();
+    });
+  }
+
+  // On failure, stop handing out indices and let the helpers finish their
+  // current call before the exception leaves this frame
+  try
+  {
+    runIndices(*state);
+  }
+  catch (...)
+  {
+    state->next = state->count;
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&state] { return state->active == 0; });
+    throw;
+  }
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->done.wait(lock, [&state] { return state->active == 0; });
+}
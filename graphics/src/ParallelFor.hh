@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_COMMON_PARALLELFOR_HH_
+#define GZ_COMMON_PARALLELFOR_HH_
+
+#include <cstddef>
+#include <functional>
+
+namespace gz
+{
+  namespace common
+  {
+    /// \brief Call a function for each index in [0, _count), on the calling
+    /// thread and the threads of a WorkerPool shared by the graphics
+    /// library. Indices are handed out one at a time, so uneven work is
+    /// balanced. Returns once every call has returned.
+    ///
+    /// The calling thread takes part in the work and never waits for
+    /// helpers which have not started, so this can be called from work
+    /// that already runs on the shared pool.
+    /// \param[in] _count Number of indices.
+    /// \param[in] _work Function called with each index, possibly from
+    /// several threads at once.
+    /// \param[in] _concurrency Maximum number of threads working at once,
+    /// including the calling thread. Zero uses the hardware concurrency.
+    void parallelFor(const std::size_t _count,
+        const std::function<void(std::size_t)> &_work,
+        const unsigned int _concurrency = 0u);
+  }
+}
+#endif
@@ -0,0 +1,852 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "gz/common/Console.hh"
+#include "gz/common/PolygonTriangulation.hh"
+
+#include "ParallelFor.hh"
+
+using namespace gz;
+using namespace common;
+
+namespace
+{
+  /// \brief Inputs with less vertices than this, in total, are triangulated
+  /// on the calling thread only.
+  constexpr std::size_t kParallelTriangulationSize = 1u << 12;
+
+  /// \brief Marks a missing node, edge or triangle.
+  constexpr std::size_t kNone = std::numeric_limits<std::size_t>::max();
+
+  /// \brief A closed ring of vertex indices. The first vertex is not
+  /// repeated at the end.
+  using Ring = std::vector<unsigned int>;
+
+  /// \brief Outer boundary and holes of a polygon.
+  struct Polygon
+  {
+    /// \brief Outer boundary.
+    Ring outer;
+
+    /// \brief Holes inside the outer boundary.
+    std::vector<Ring> holes;
+  };
+
+  /// \brief Twice the signed area of a triangle.
+  /// \return Positive if the triangle is counter-clockwise.
+  double orient(const math::Vector2d &_a, const math::Vector2d &_b,
+      const math::Vector2d &_c)
+  {
+    return (_b.X() - _a.X()) * (_c.Y() - _a.Y()) -
+           (_b.Y() - _a.Y()) * (_c.X() - _a.X());
+  }
+
+  /// \brief Check whether a point is inside or on the boundary of a
+  /// triangle, in either orientation.
+  bool insideTriangle(const math::Vector2d &_a, const math::Vector2d &_b,
+      const math::Vector2d &_c, const math::Vector2d &_p)
+  {
+    const double ab = orient(_a, _b, _p);
+    const double bc = orient(_b, _c, _p);
+    const double ca = orient(_c, _a, _p);
+    return (ab >= 0 && bc >= 0 && ca >= 0) || (ab <= 0 && bc <= 0 && ca <= 0);
+  }
+
+  /// \brief Check whether a point is strictly inside the circumcircle of a
+  /// counter-clockwise triangle.
+  bool insideCircle(const math::Vector2d &_a, const math::Vector2d &_b,
+      const math::Vector2d &_c, const math::Vector2d &_p)
+  {
+    const double adx = _a.X() - _p.X();
+    const double ady = _a.Y() - _p.Y();
+    const double bdx = _b.X() - _p.X();
+    const double bdy = _b.Y() - _p.Y();
+    const double cdx = _c.X() - _p.X();
+    const double cdy = _c.Y() - _p.Y();
+    const double alift = adx * adx + ady * ady;
+    const double blift = bdx * bdx + bdy * bdy;
+    const double clift = cdx * cdx + cdy * cdy;
+    const double det = alift * (bdx * cdy - cdx * bdy) +
+                       blift * (cdx * ady - adx * cdy) +
+                       clift * (adx * bdy - bdx * ady);
+
+    // Cocircular points are left alone, so that flips can not cycle
+    const double magnitude =
+        alift * (std::abs(bdx * cdy) + std::abs(cdx * bdy)) +
+        blift * (std::abs(cdx * ady) + std::abs(adx * cdy)) +
+        clift * (std::abs(adx * bdy) + std::abs(bdx * ady));
+    return det > magnitude * 1e-12;
+  }
+
+  /// \brief Signed area of a ring.
+  /// \return Positive if the ring is counter-clockwise.
+  double ringArea(const std::vector<math::Vector2d> &_v, const Ring &_ring)
+  {
+    double area = 0;
+    for (std::size_t i = 0, j = _ring.size() - 1; i < _ring.size(); j = i++)
+    {
+      area += _v[_ring[j]].X() * _v[_ring[i]].Y() -
+              _v[_ring[i]].X() * _v[_ring[j]].Y();
+    }
+    return area * 0.5;
+  }
+
+  /// \brief Even-odd point in polygon test.
+  bool insideRing(const std::vector<math::Vector2d> &_v, const Ring &_ring,
+      const math::Vector2d &_p)
+  {
+    bool inside = false;
+    for (std::size_t i = 0, j = _ring.size() - 1; i < _ring.size(); j = i++)
+    {
+      const math::Vector2d &a = _v[_ring[i]];
+      const math::Vector2d &b = _v[_ring[j]];
+      if ((a.Y() > _p.Y()) != (b.Y() > _p.Y()) &&
+          _p.X() < (b.X() - a.X()) * (_p.Y() - a.Y()) / (b.Y() - a.Y()) +
+          a.X())
+      {
+        inside = !inside;
+      }
+    }
+    return inside;
+  }
+
+  /// \brief Key of an undirected edge.
+  uint64_t edgeKey(const unsigned int _a, const unsigned int _b)
+  {
+    return _a < _b ? (static_cast<uint64_t>(_a) << 32) | _b :
+                     (static_cast<uint64_t>(_b) << 32) | _a;
+  }
+
+  /// \brief Run _func for indices in [0, _count), on several threads if
+  /// there is enough work.
+  /// \param[in] _count Number of tasks.
+  /// \param[in] _work Total amount of work, in vertices.
+  /// \param[in] _func Task, returns false on failure.
+  /// \return False if any task failed.
+  template<typename Func>
+  bool forEachIndex(const std::size_t _count, const std::size_t _work,
+      Func &&_func)
+  {
+    std::atomic<bool> result{true};
+    parallelFor(_count, [&](const std::size_t _i)
+    {
+      if (!_func(_i))
+        result = false;
+    }, _work < kParallelTriangulationSize ? 1u : 0u);
+    return result;
+  }
+
+  /// \brief Ear clipping on circular doubly linked lists of polygon
+  /// vertices. A vertex can be in a list more than once, which happens at
+  /// both ends of the bridges joining holes to the outer boundary.
+  class EarClipper
+  {
+    /// \brief Constructor.
+    /// \param[in] _vertices Vertex positions.
+    public: explicit EarClipper(const std::vector<math::Vector2d> &_vertices)
+            : vertices(_vertices)
+    {
+    }
+
+    /// \brief Add a ring as a new list.
+    /// \param[in] _ring Ring to add.
+    /// \param[in] _ccw Orientation of the list, the ring is reversed if
+    /// needed.
+    /// \return First node of the list.
+    public: std::size_t AddRing(const Ring &_ring, const bool _ccw)
+    {
+      const bool reverse = (ringArea(this->vertices, _ring) > 0) != _ccw;
+      const std::size_t first = this->index.size();
+      const std::size_t n = _ring.size();
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        this->index.push_back(_ring[reverse ? n - 1 - i : i]);
+        this->prev.push_back(first + (i + n - 1) % n);
+        this->next.push_back(first + (i + 1) % n);
+      }
+      return first;
+    }
+
+    /// \brief Get the rightmost point of a list.
+    /// \param[in] _node Any node of the list.
+    /// \return The node of the rightmost point.
+    public: std::size_t Rightmost(const std::size_t _node) const
+    {
+      std::size_t result = _node;
+      for (std::size_t p = this->next[_node]; p != _node; p = this->next[p])
+      {
+        if (this->Point(p).X() > this->Point(result).X())
+          result = p;
+      }
+      return result;
+    }
+
+    /// \brief Join a clockwise hole to a counter-clockwise outer list,
+    /// with a bridge from the rightmost point of the hole to a visible
+    /// point of the outer list. See "Triangulation by Ear Clipping" by
+    /// David Eberly. Holes to the right of this one must have been joined
+    /// already.
+    /// \param[in] _outer Any node of the outer list.
+    /// \param[in] _hole Any node of the hole.
+    /// \return False if no visible point was found.
+    public: bool MergeHole(const std::size_t _outer, const std::size_t _hole)
+    {
+      const std::size_t m = this->Rightmost(_hole);
+      const math::Vector2d &mp = this->Point(m);
+
+      // Closest point of the boundary hit by a ray from the hole going
+      // right. A vertex on the ray is visible, otherwise the end of the
+      // edge hit furthest right is a candidate for the bridge.
+      std::size_t bridge = kNone;
+      double closest = std::numeric_limits<double>::max();
+      bool onRay = false;
+      std::size_t p = _outer;
+      do
+      {
+        const std::size_t q = this->next[p];
+        const math::Vector2d &a = this->Point(p);
+        const math::Vector2d &b = this->Point(q);
+        if (a.Y() == mp.Y())
+        {
+          if (a.X() >= mp.X() && a.X() < closest)
+          {
+            closest = a.X();
+            onRay = true;
+            bridge = p;
+          }
+        }
+        else if ((a.Y() < mp.Y()) != (b.Y() < mp.Y()) && b.Y() != mp.Y())
+        {
+          const double x = a.X() + (mp.Y() - a.Y()) * (b.X() - a.X()) /
+              (b.Y() - a.Y());
+          if (x >= mp.X() && x < closest)
+          {
+            closest = x;
+            onRay = false;
+            bridge = a.X() > b.X() ? p : q;
+          }
+        }
+        p = q;
+      }
+      while (p != _outer);
+
+      if (bridge == kNone)
+        return false;
+
+      // Reflex points inside the triangle made of the hole point, the ray
+      // hit and the candidate hide the candidate. The one closest in angle
+      // to the ray is visible then.
+      if (!onRay)
+      {
+        const math::Vector2d hit(closest, mp.Y());
+        const math::Vector2d candidate = this->Point(bridge);
+        double bestTan = std::numeric_limits<double>::max();
+        p = _outer;
+        do
+        {
+          const math::Vector2d &r = this->Point(p);
+          if (r.X() > mp.X() && this->index[p] != this->index[bridge] &&
+              !this->Convex(p) && insideTriangle(mp, hit, candidate, r))
+          {
+            const double tan = std::abs(r.Y() - mp.Y()) / (r.X() - mp.X());
+            if (tan < bestTan ||
+                (tan == bestTan && r.X() < this->Point(bridge).X()))
+            {
+              bestTan = tan;
+              bridge = p;
+            }
+          }
+          p = this->next[p];
+        }
+        while (p != _outer);
+      }
+
+      // Holes joined earlier duplicate points, pick the copy that faces
+      // the hole
+      p = bridge;
+      do
+      {
+        if (this->index[p] == this->index[bridge] &&
+            this->LocallyInside(p, mp))
+        {
+          bridge = p;
+          break;
+        }
+        p = this->next[p];
+      }
+      while (p != bridge);
+
+      this->Split(bridge, m);
+      return true;
+    }
+
+    /// \brief Clip all the ears of a list.
+    /// \param[in] _node Any node of the list.
+    /// \param[out] _out Three vertex indices per triangle.
+    public: void Clip(std::size_t _node, std::vector<unsigned int> &_out)
+    {
+      std::size_t count = 1;
+      for (std::size_t p = this->next[_node]; p != _node; p = this->next[p])
+        ++count;
+
+      std::size_t stop = _node;
+      while (count > 3)
+      {
+        if (this->IsEar(_node))
+        {
+          const std::size_t following = this->next[_node];
+          this->Emit(_node, _out);
+          this->Remove(_node);
+          --count;
+          _node = following;
+          stop = _node;
+          continue;
+        }
+
+        _node = this->next[_node];
+        if (_node == stop)
+        {
+          // No ear left, the remaining points are degenerate, e.g.
+          // collinear. Clip a vertex anyway so that every boundary edge
+          // is part of a triangle.
+          std::size_t forced = _node;
+          do
+          {
+            if (this->Convex(forced))
+              break;
+            forced = this->next[forced];
+          }
+          while (forced != _node);
+
+          _node = this->next[forced];
+          this->Emit(forced, _out);
+          this->Remove(forced);
+          --count;
+          stop = _node;
+        }
+      }
+      this->Emit(_node, _out);
+    }
+
+    /// \brief Get the position of a node.
+    private: const math::Vector2d &Point(const std::size_t _node) const
+    {
+      return this->vertices[this->index[_node]];
+    }
+
+    /// \brief Check whether a node is a convex corner of its list.
+    private: bool Convex(const std::size_t _node) const
+    {
+      return orient(this->Point(this->prev[_node]), this->Point(_node),
+          this->Point(this->next[_node])) > 0;
+    }
+
+    /// \brief Check whether the direction from a node to a point is inside
+    /// the polygon, near the node.
+    private: bool LocallyInside(const std::size_t _node,
+                 const math::Vector2d &_p) const
+    {
+      const math::Vector2d &a = this->Point(_node);
+      const math::Vector2d &before = this->Point(this->prev[_node]);
+      const math::Vector2d &after = this->Point(this->next[_node]);
+      if (this->Convex(_node))
+        return orient(a, after, _p) >= 0 && orient(before, a, _p) >= 0;
+      return orient(a, after, _p) >= 0 || orient(before, a, _p) >= 0;
+    }
+
+    /// \brief Check whether a node and its neighbours form an ear, that is
+    /// a convex corner without other points inside.
+    private: bool IsEar(const std::size_t _node) const
+    {
+      const std::size_t before = this->prev[_node];
+      const std::size_t after = this->next[_node];
+      const math::Vector2d &a = this->Point(before);
+      const math::Vector2d &b = this->Point(_node);
+      const math::Vector2d &c = this->Point(after);
+      if (orient(a, b, c) <= 0)
+        return false;
+
+      // Only reflex points can be inside a convex corner
+      for (std::size_t p = this->next[after]; p != before; p = this->next[p])
+      {
+        const unsigned int i = this->index[p];
+        if (i == this->index[before] || i == this->index[_node] ||
+            i == this->index[after])
+        {
+          continue;
+        }
+        if (!this->Convex(p) && insideTriangle(a, b, c, this->Point(p)))
+          return false;
+      }
+      return true;
+    }
+
+    /// \brief Output the triangle made of a node and its neighbours.
+    private: void Emit(const std::size_t _node,
+                 std::vector<unsigned int> &_out) const
+    {
+      _out.push_back(this->index[this->prev[_node]]);
+      _out.push_back(this->index[_node]);
+      _out.push_back(this->index[this->next[_node]]);
+    }
+
+    /// \brief Unlink a node from its list.
+    private: void Remove(const std::size_t _node)
+    {
+      this->next[this->prev[_node]] = this->next[_node];
+      this->prev[this->next[_node]] = this->prev[_node];
+    }
+
+    /// \brief Join two lists with a bridge between two nodes. Both nodes
+    /// are duplicated, so that the bridge is walked once in each
+    /// direction.
+    private: void Split(const std::size_t _a, const std::size_t _b)
+    {
+      const std::size_t a2 = this->index.size();
+      const std::size_t b2 = a2 + 1;
+      this->index.push_back(this->index[_a]);
+      this->index.push_back(this->index[_b]);
+      this->prev.resize(b2 + 1);
+      this->next.resize(b2 + 1);
+
+      const std::size_t an = this->next[_a];
+      const std::size_t bp = this->prev[_b];
+      this->next[_a] = _b;
+      this->prev[_b] = _a;
+      this->next[a2] = an;
+      this->prev[an] = a2;
+      this->next[b2] = a2;
+      this->prev[a2] = b2;
+      this->next[bp] = b2;
+      this->prev[b2] = bp;
+    }
+
+    /// \brief Vertex positions.
+    private: const std::vector<math::Vector2d> &vertices;
+
+    /// \brief Vertex index of each node.
+    private: std::vector<unsigned int> index;
+
+    /// \brief Previous node of each node.
+    private: std::vector<std::size_t> prev;
+
+    /// \brief Next node of each node.
+    private: std::vector<std::size_t> next;
+  };
+
+  /// \brief Flip the edges of a triangulation that are not constrained,
+  /// until every edge is locally Delaunay. This is Lawson's algorithm, the
+  /// result is the constrained Delaunay triangulation.
+  /// \param[in] _v Vertex positions.
+  /// \param[in] _constraints Edges which must not be flipped.
+  /// \param[in,out] _indices Counter-clockwise triangles.
+  void makeDelaunay(const std::vector<math::Vector2d> &_v,
+      const std::unordered_set<uint64_t> &_constraints,
+      std::vector<unsigned int> &_indices)
+  {
+    // The triangles on both sides of each edge. Edges with more than two
+    // triangles can only come from degenerate input and are not flipped.
+    const std::size_t triangleCount = _indices.size() / 3;
+    std::unordered_map<uint64_t, std::array<std::size_t, 2>> sides;
+    sides.reserve(triangleCount * 2);
+    for (std::size_t t = 0; t < triangleCount; ++t)
+    {
+      for (std::size_t k = 0; k < 3; ++k)
+      {
+        const uint64_t key = edgeKey(_indices[t * 3 + k],
+            _indices[t * 3 + (k + 1) % 3]);
+        auto it = sides.find(key);
+        if (it == sides.end())
+          sides[key] = {t, kNone};
+        else if (it->second[1] == kNone)
+          it->second[1] = t;
+        else
+          it->second = {kNone, kNone};
+      }
+    }
+
+    std::vector<uint64_t> stack;
+    for (const auto &[key, triangles] : sides)
+    {
+      if (triangles[1] != kNone && !_constraints.count(key))
+        stack.push_back(key);
+    }
+
+    auto opposite = [&](const std::size_t _t, const uint64_t _key)
+    {
+      for (std::size_t k = 0; k < 3; ++k)
+      {
+        const unsigned int i = _indices[_t * 3 + k];
+        if (i != (_key >> 32) && i != (_key & 0xffffffffu))
+          return i;
+      }
+      return _indices[_t * 3];
+    };
+    auto replace = [&](const uint64_t _key, const std::size_t _from,
+        const std::size_t _to)
+    {
+      auto it = sides.find(_key);
+      if (it == sides.end())
+        return;
+      for (auto &t : it->second)
+      {
+        if (t == _from)
+          t = _to;
+      }
+    };
+
+    while (!stack.empty())
+    {
+      const uint64_t key = stack.back();
+      stack.pop_back();
+      auto it = sides.find(key);
+      if (it == sides.end() || it->second[1] == kNone)
+        continue;
+
+      const std::size_t t0 = it->second[0];
+      const std::size_t t1 = it->second[1];
+      unsigned int a = static_cast<unsigned int>(key >> 32);
+      unsigned int b = static_cast<unsigned int>(key & 0xffffffffu);
+      const unsigned int c = opposite(t0, key);
+      const unsigned int d = opposite(t1, key);
+      if (orient(_v[a], _v[b], _v[c]) < 0)
+        std::swap(a, b);
+
+      // The quad a, d, b, c must be convex for c-d to be a valid edge
+      if (orient(_v[a], _v[b], _v[d]) >= 0 ||
+          !insideCircle(_v[a], _v[b], _v[c], _v[d]) ||
+          orient(_v[c], _v[a], _v[d]) <= 0 ||
+          orient(_v[d], _v[b], _v[c]) <= 0 ||
+          sides.count(edgeKey(c, d)))
+      {
+        continue;
+      }
+
+      _indices[t0 * 3] = c;
+      _indices[t0 * 3 + 1] = a;
+      _indices[t0 * 3 + 2] = d;
+      _indices[t1 * 3] = d;
+      _indices[t1 * 3 + 1] = b;
+      _indices[t1 * 3 + 2] = c;
+
+      sides.erase(it);
+      sides[edgeKey(c, d)] = {t0, t1};
+      replace(edgeKey(a, d), t1, t0);
+      replace(edgeKey(b, c), t0, t1);
+
+      for (const uint64_t edge : {edgeKey(a, d), edgeKey(d, b),
+                                  edgeKey(b, c), edgeKey(c, a)})
+      {
+        if (!_constraints.count(edge))
+          stack.push_back(edge);
+      }
+    }
+  }
+
+  /// \brief Triangulate a polygon with holes.
+  /// \param[in] _v Vertex positions.
+  /// \param[in] _polygon Polygon to triangulate.
+  /// \param[out] _out Three vertex indices per triangle, counter-clockwise.
+  /// \return False if the polygon could not be triangulated.
+  bool triangulatePolygon(const std::vector<math::Vector2d> &_v,
+      const Polygon &_polygon, std::vector<unsigned int> &_out)
+  {
+    if (_polygon.outer.size() < 3)
+      return false;
+
+    EarClipper clipper(_v);
+    const std::size_t outer = clipper.AddRing(_polygon.outer, true);
+
+    // Holes are joined from right to left, so that the ray cast from each
+    // hole only meets holes that are already part of the boundary.
+    std::vector<std::pair<double, std::size_t>> holes;
+    std::size_t size = _polygon.outer.size();
+    for (const auto &hole : _polygon.holes)
+    {
+      if (hole.size() < 3)
+        continue;
+      const std::size_t node = clipper.AddRing(hole, false);
+      holes.emplace_back(_v[hole[0]].X(), node);
+      for (const unsigned int i : hole)
+        holes.back().first = std::max(holes.back().first, _v[i].X());
+      size += hole.size();
+    }
+    std::sort(holes.begin(), holes.end(), std::greater<>());
+    for (const auto &hole : holes)
+    {
+      if (!clipper.MergeHole(outer, hole.second))
+        return false;
+    }
+
+    _out.clear();
+    _out.reserve((size + holes.size() * 2) * 3);
+    clipper.Clip(outer, _out);
+
+    std::unordered_set<uint64_t> constraints;
+    auto constrain = [&constraints](const Ring &_ring)
+    {
+      for (std::size_t i = 0, j = _ring.size() - 1; i < _ring.size(); j = i++)
+        constraints.insert(edgeKey(_ring[j], _ring[i]));
+    };
+    constrain(_polygon.outer);
+    for (const auto &hole : _polygon.holes)
+      constrain(hole);
+    makeDelaunay(_v, constraints, _out);
+    return true;
+  }
+
+  /// \brief Chain edges into closed rings.
+  /// \param[in] _v Vertex positions.
+  /// \param[in] _edges Edges to chain.
+  /// \param[out] _rings Closed rings.
+  /// \return False if an edge is invalid or a ring is not closed.
+  bool buildRings(const std::vector<math::Vector2d> &_v,
+      const std::vector<math::Vector2i> &_edges, std::vector<Ring> &_rings)
+  {
+    std::vector<std::vector<std::size_t>> incident(_v.size());
+    for (std::size_t i = 0; i < _edges.size(); ++i)
+    {
+      const math::Vector2i &e = _edges[i];
+      if (e.X() < 0 || e.Y() < 0 || e.X() == e.Y() ||
+          static_cast<std::size_t>(e.X()) >= _v.size() ||
+          static_cast<std::size_t>(e.Y()) >= _v.size())
+      {
+        gzerr << "Invalid edge [" << e << "]" << std::endl;
+        return false;
+      }
+      incident[e.X()].push_back(i);
+      incident[e.Y()].push_back(i);
+    }
+
+    std::vector<bool> used(_edges.size(), false);
+    for (std::size_t first = 0; first < _edges.size(); ++first)
+    {
+      if (used[first])
+        continue;
+      used[first] = true;
+
+      const unsigned int start = _edges[first].X();
+      unsigned int current = _edges[first].Y();
+      std::size_t last = first;
+      Ring ring{start};
+      while (current != start)
+      {
+        ring.push_back(current);
+
+        // Polylines are usually given edge after edge, otherwise any
+        // unused edge at the current vertex continues the ring
+        std::size_t edge = kNone;
+        if (last + 1 < _edges.size() && !used[last + 1] &&
+            static_cast<unsigned int>(_edges[last + 1].X()) == current)
+        {
+          edge = last + 1;
+        }
+        else
+        {
+          for (const std::size_t e : incident[current])
+          {
+            if (!used[e])
+            {
+              edge = e;
+              break;
+            }
+          }
+        }
+
+        if (edge == kNone)
+        {
+          gzerr << "Polyline is not closed at [" << _v[current] << "]"
+                << std::endl;
+          return false;
+        }
+        used[edge] = true;
+        last = edge;
+        current = static_cast<unsigned int>(_edges[edge].X()) == current ?
+            _edges[edge].Y() : _edges[edge].X();
+      }
+      _rings.push_back(std::move(ring));
+    }
+    return true;
+  }
+
+  /// \brief Group rings into polygons with holes, using the even-odd rule.
+  /// \param[in] _v Vertex positions.
+  /// \param[in] _rings Non-intersecting rings.
+  /// \return The polygons.
+  std::vector<Polygon> buildPolygons(const std::vector<math::Vector2d> &_v,
+      const std::vector<Ring> &_rings)
+  {
+    const std::size_t n = _rings.size();
+    std::vector<double> areas(n);
+    std::vector<math::Vector2d> mins(n);
+    std::vector<math::Vector2d> maxs(n);
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      areas[i] = std::abs(ringArea(_v, _rings[i]));
+      mins[i] = maxs[i] = _v[_rings[i][0]];
+      for (const unsigned int v : _rings[i])
+      {
+        mins[i].X(std::min(mins[i].X(), _v[v].X()));
+        mins[i].Y(std::min(mins[i].Y(), _v[v].Y()));
+        maxs[i].X(std::max(maxs[i].X(), _v[v].X()));
+        maxs[i].Y(std::max(maxs[i].Y(), _v[v].Y()));
+      }
+      total += _rings[i].size();
+    }
+
+    // Rings that contain each ring. Only larger rings with overlapping
+    // bounds are tested, which skips most pairs in floor plans.
+    std::vector<std::vector<std::size_t>> containers(n);
+    forEachIndex(n, total, [&](const std::size_t _i)
+    {
+      for (std::size_t j = 0; j < n; ++j)
+      {
+        if (j == _i || areas[j] <= areas[_i] ||
+            mins[j].X() > mins[_i].X() || mins[j].Y() > mins[_i].Y() ||
+            maxs[j].X() < maxs[_i].X() || maxs[j].Y() < maxs[_i].Y())
+        {
+          continue;
+        }
+
+        // Rings can share vertices, test one that is not shared
+        for (const unsigned int v : _rings[_i])
+        {
+          if (std::find(_rings[j].begin(), _rings[j].end(), v) ==
+              _rings[j].end())
+          {
+            if (insideRing(_v, _rings[j], _v[v]))
+              containers[_i].push_back(j);
+            break;
+          }
+        }
+      }
+      return true;
+    });
+
+    // Rings inside an even number of rings are outer boundaries, the
+    // others are holes of the innermost ring around them
+    std::vector<Polygon> polygons;
+    std::vector<std::size_t> polygonIndex(n, kNone);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      if (containers[i].size() % 2 == 0)
+      {
+        polygonIndex[i] = polygons.size();
+        polygons.push_back({_rings[i], {}});
+      }
+    }
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      if (containers[i].size() % 2 == 0)
+        continue;
+
+      std::size_t parent = containers[i][0];
+      for (const std::size_t j : containers[i])
+      {
+        if (containers[j].size() > containers[parent].size())
+          parent = j;
+      }
+      if (polygonIndex[parent] != kNone)
+        polygons[polygonIndex[parent]].holes.push_back(_rings[i]);
+    }
+    return polygons;
+  }
+}
+
+//////////////////////////////////////////////////
+bool PolygonTriangulation::Triangulate(
+    const std::vector<std::vector<math::Vector2d>> &_rings,
+    std::vector<unsigned int> &_indices)
+{
+  _indices.clear();
+  if (_rings.empty())
+    return false;
+
+  std::vector<math::Vector2d> vertices;
+  Polygon polygon;
+  for (std::size_t r = 0; r < _rings.size(); ++r)
+  {
+    const auto &points = _rings[r];
+    std::size_t count = points.size();
+    if (count > 1 && points.front() == points.back())
+      --count;
+
+    Ring ring;
+    for (std::size_t i = 0; i < count; ++i)
+      ring.push_back(static_cast<unsigned int>(vertices.size() + i));
+    vertices.insert(vertices.end(), points.begin(), points.end());
+
+    if (r == 0)
+      polygon.outer = std::move(ring);
+    else
+      polygon.holes.push_back(std::move(ring));
+  }
+  return triangulatePolygon(vertices, polygon, _indices);
+}
+
+//////////////////////////////////////////////////
+bool PolygonTriangulation::Triangulate(
+    const std::vector<math::Vector2d> &_vertices,
+    const std::vector<math::Vector2i> &_edges,
+    std::vector<unsigned int> &_indices)
+{
+  _indices.clear();
+  std::vector<Ring> rings;
+  if (!buildRings(_vertices, _edges, rings))
+    return false;
+
+  // Rings without area, e.g. made of collinear points, enclose nothing
+  rings.erase(std::remove_if(rings.begin(), rings.end(),
+      [&_vertices](const Ring &_ring)
+      {
+        return _ring.size() < 3 ||
+            std::abs(ringArea(_vertices, _ring)) <=
+            std::numeric_limits<double>::epsilon();
+      }), rings.end());
+  if (rings.empty())
+    return false;
+
+  const std::vector<Polygon> polygons = buildPolygons(_vertices, rings);
+  std::size_t total = 0;
+  for (const auto &ring : rings)
+    total += ring.size();
+
+  // Polygons are independent, each is triangulated in its own buffer
+  std::vector<std::vector<unsigned int>> results(polygons.size());
+  const bool result = forEachIndex(polygons.size(), total,
+      [&](const std::size_t _i)
+      {
+        return triangulatePolygon(_vertices, polygons[_i], results[_i]);
+      });
+
+  for (const auto &triangles : results)
+    _indices.insert(_indices.end(), triangles.begin(), triangles.end());
+  return result;
+}
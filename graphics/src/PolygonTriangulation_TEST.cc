@@ -0,0 +1,255 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "gz/common/PolygonTriangulation.hh"
+
+#include "gz/common/testing/AutoLogFixture.hh"
+
+using namespace gz;
+
+class PolygonTriangulationTest : public common::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Twice the signed area of a triangle.
+double orient(const math::Vector2d &_a, const math::Vector2d &_b,
+    const math::Vector2d &_c)
+{
+  return (_b.X() - _a.X()) * (_c.Y() - _a.Y()) -
+         (_b.Y() - _a.Y()) * (_c.X() - _a.X());
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that all triangles are counter-clockwise and return their
+/// total area.
+double area(const std::vector<math::Vector2d> &_vertices,
+    const std::vector<unsigned int> &_indices)
+{
+  EXPECT_EQ(0u, _indices.size() % 3);
+  double total = 0;
+  for (std::size_t i = 0; i + 2 < _indices.size(); i += 3)
+  {
+    const double a = orient(_vertices[_indices[i]],
+        _vertices[_indices[i + 1]], _vertices[_indices[i + 2]]);
+    EXPECT_GT(a, 0.0);
+    total += a * 0.5;
+  }
+  return total;
+}
+
+/////////////////////////////////////////////////
+/// \brief Add a counter-clockwise square to a ring list.
+std::vector<math::Vector2d> square(double _x, double _y, double _size)
+{
+  return {
+    math::Vector2d(_x, _y), math::Vector2d(_x + _size, _y),
+    math::Vector2d(_x + _size, _y + _size), math::Vector2d(_x, _y + _size)};
+}
+
+/////////////////////////////////////////////////
+/// \brief Add a closed ring to a table of vertices and edges.
+void addRing(const std::vector<math::Vector2d> &_ring,
+    std::vector<math::Vector2d> &_vertices,
+    std::vector<math::Vector2i> &_edges)
+{
+  const int first = static_cast<int>(_vertices.size());
+  const int n = static_cast<int>(_ring.size());
+  for (int i = 0; i < n; ++i)
+  {
+    _vertices.push_back(_ring[i]);
+    _edges.push_back(math::Vector2i(first + i, first + (i + 1) % n));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(PolygonTriangulationTest, Simple)
+{
+  std::vector<unsigned int> indices;
+  EXPECT_FALSE(common::PolygonTriangulation::Triangulate(
+      std::vector<std::vector<math::Vector2d>>(), indices));
+
+  // Clockwise, with the first point repeated
+  std::vector<math::Vector2d> ring{
+    math::Vector2d(0, 0), math::Vector2d(0, 1), math::Vector2d(1, 1),
+    math::Vector2d(1, 0), math::Vector2d(0, 0)};
+  ASSERT_TRUE(common::PolygonTriangulation::Triangulate({ring}, indices));
+  EXPECT_EQ(6u, indices.size());
+  EXPECT_DOUBLE_EQ(1.0, area(ring, indices));
+  for (auto i : indices)
+    EXPECT_LT(i, 4u);
+
+  // Concave
+  ring = {
+    math::Vector2d(0, 0), math::Vector2d(3, 0), math::Vector2d(3, 3),
+    math::Vector2d(2, 3), math::Vector2d(2, 1), math::Vector2d(1, 1),
+    math::Vector2d(1, 3), math::Vector2d(0, 3)};
+  ASSERT_TRUE(common::PolygonTriangulation::Triangulate({ring}, indices));
+  EXPECT_EQ(18u, indices.size());
+  EXPECT_DOUBLE_EQ(7.0, area(ring, indices));
+
+  ring.resize(2);
+  EXPECT_FALSE(common::PolygonTriangulation::Triangulate({ring}, indices));
+}
+
+/////////////////////////////////////////////////
+TEST_F(PolygonTriangulationTest, Holes)
+{
+  // Same as the GTS test: a square with a square hole
+  std::vector<std::vector<math::Vector2d>> rings{
+    square(0, 0, 1), square(0.25, 0.25, 0.5)};
+  std::vector<unsigned int> indices;
+  ASSERT_TRUE(common::PolygonTriangulation::Triangulate(rings, indices));
+  EXPECT_EQ(8u, indices.size() / 3);
+
+  std::vector<math::Vector2d> vertices = rings[0];
+  vertices.insert(vertices.end(), rings[1].begin(), rings[1].end());
+  EXPECT_NEAR(0.75, area(vertices, indices), 1e-12);
+
+  // Several holes side by side, joined right to left
+  rings = {square(0, 0, 10)};
+  for (int i = 0; i < 4; ++i)
+    rings.push_back(square(1 + i * 2.0, 1 + i * 0.5, 1));
+  ASSERT_TRUE(common::PolygonTriangulation::Triangulate(rings, indices));
+  vertices.clear();
+  for (const auto &ring : rings)
+    vertices.insert(vertices.end(), ring.begin(), ring.end());
+  EXPECT_NEAR(96.0, area(vertices, indices), 1e-9);
+}
+
+/////////////////////////////////////////////////
+TEST_F(PolygonTriangulationTest, Delaunay)
+{
+  // Any triangulation of a convex polygon is valid, the Delaunay one has
+  // no vertex inside the circumcircle of a triangle
+  std::vector<math::Vector2d> ring;
+  for (int i = 0; i < 32; ++i)
+  {
+    const double angle = 2 * GZ_PI * i / 32;
+    ring.push_back(math::Vector2d(4 * std::cos(angle), std::sin(angle)));
+  }
+  std::vector<unsigned int> indices;
+  ASSERT_TRUE(common::PolygonTriangulation::Triangulate({ring}, indices));
+  EXPECT_EQ(30u, indices.size() / 3);
+  EXPECT_NEAR(4 * 32 * std::sin(2 * GZ_PI / 32) / 2,
+      area(ring, indices), 1e-9);
+
+  for (std::size_t t = 0; t < indices.size(); t += 3)
+  {
+    const math::Vector2d &a = ring[indices[t]];
+    const math::Vector2d &b = ring[indices[t + 1]];
+    const math::Vector2d &c = ring[indices[t + 2]];
+    for (const auto &p : ring)
+    {
+      const double adx = a.X() - p.X(), ady = a.Y() - p.Y();
+      const double bdx = b.X() - p.X(), bdy = b.Y() - p.Y();
+      const double cdx = c.X() - p.X(), cdy = c.Y() - p.Y();
+      const double det =
+          (adx * adx + ady * ady) * (bdx * cdy - cdx * bdy) +
+          (bdx * bdx + bdy * bdy) * (cdx * ady - adx * cdy) +
+          (cdx * cdx + cdy * cdy) * (adx * bdy - bdx * ady);
+      EXPECT_LT(det, 1e-9);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(PolygonTriangulationTest, Edges)
+{
+  // A square with a hole, an island in the hole and a separate square
+  std::vector<math::Vector2d> vertices;
+  std::vector<math::Vector2i> edges;
+  addRing(square(0, 0, 10), vertices, edges);
+  addRing(square(2, 2, 6), vertices, edges);
+  addRing(square(4, 4, 2), vertices, edges);
+  addRing(square(20, 0, 1), vertices, edges);
+
+  std::vector<unsigned int> indices;
+  ASSERT_TRUE(common::PolygonTriangulation::Triangulate(vertices, edges,
+      indices));
+  EXPECT_NEAR(100 - 36 + 4 + 1, area(vertices, indices), 1e-9);
+
+  // Every edge is part of a triangle
+  for (const auto &edge : edges)
+  {
+    bool found = false;
+    for (std::size_t t = 0; t < indices.size() && !found; t += 3)
+    {
+      for (std::size_t k = 0; k < 3; ++k)
+      {
+        if (static_cast<int>(indices[t + k]) == edge.X() &&
+            static_cast<int>(indices[t + (k + 1) % 3]) == edge.Y())
+          found = true;
+        if (static_cast<int>(indices[t + k]) == edge.Y() &&
+            static_cast<int>(indices[t + (k + 1) % 3]) == edge.X())
+          found = true;
+      }
+    }
+    EXPECT_TRUE(found) << edge;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(PolygonTriangulationTest, EdgesInvalid)
+{
+  std::vector<unsigned int> indices;
+  std::vector<math::Vector2d> vertices{
+    math::Vector2d(0, 0), math::Vector2d(0, 1), math::Vector2d(0, 2)};
+
+  // Not closed
+  std::vector<math::Vector2i> edges{
+    math::Vector2i(0, 1), math::Vector2i(1, 2)};
+  EXPECT_FALSE(common::PolygonTriangulation::Triangulate(vertices, edges,
+      indices));
+
+  // Closed, but without area
+  edges.push_back(math::Vector2i(2, 0));
+  EXPECT_FALSE(common::PolygonTriangulation::Triangulate(vertices, edges,
+      indices));
+
+  edges.push_back(math::Vector2i(2, 3));
+  EXPECT_FALSE(common::PolygonTriangulation::Triangulate(vertices, edges,
+      indices));
+  EXPECT_TRUE(indices.empty());
+}
+
+/////////////////////////////////////////////////
+TEST_F(PolygonTriangulationTest, Parallel)
+{
+  // A floor plan large enough to be split across threads: rooms with a
+  // pillar each
+  std::vector<math::Vector2d> vertices;
+  std::vector<math::Vector2i> edges;
+  const int rooms = 40;
+  for (int i = 0; i < rooms; ++i)
+  {
+    for (int j = 0; j < rooms; ++j)
+    {
+      addRing(square(i * 5.0, j * 5.0, 4), vertices, edges);
+      addRing(square(i * 5.0 + 1, j * 5.0 + 1, 1), vertices, edges);
+    }
+  }
+
+  std::vector<unsigned int> indices;
+  ASSERT_TRUE(common::PolygonTriangulation::Triangulate(vertices, edges,
+      indices));
+  EXPECT_EQ(static_cast<std::size_t>(rooms * rooms * 8), indices.size() / 3);
+  EXPECT_NEAR(rooms * rooms * 15.0, area(vertices, indices), 1e-6);
+}
@@ -17,10 +17,16 @@
 #include <string.h>
 #include <ctype.h>
 #include <stdio.h>
+#include <cstring>
 #include <memory>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "gz/math/Helpers.hh"
 #include "gz/common/Console.hh"
+#include "gz/common/MappedFile.hh"
 #include "gz/common/Mesh.hh"
 #include "gz/common/SubMesh.hh"
 #include "gz/common/STLLoader.hh"
@@ -28,10 +34,77 @@
 using namespace gz;
 using namespace common;
 
+namespace
+{
+  /// \brief Size of the header of a binary STL file: 80 bytes of comment
+  /// and the number of faces.
+  constexpr std::size_t kBinaryHeaderSize = 84;
+
+  /// \brief Size of a face of a binary STL file: normal, three vertices
+  /// and a 2 byte attribute.
+  constexpr std::size_t kBinaryFaceSize = 50;
+
+  /// \brief Read three floats of a binary STL file.
+  /// \param[in] _data First byte of the floats.
+  /// \return The floats as a vector.
+  math::Vector3d readVector(const char *_data)
+  {
+    float v[3];
+    std::memcpy(v, _data, sizeof(v));
+    return math::Vector3d(v[0], v[1], v[2]);
+  }
+
+  /// \brief Parse the content of a binary STL file.
+  /// \param[in] _data Content of the file.
+  /// \param[in] _loadNormals True to load the face normals.
+  /// \param[out] _mesh Mesh to add the faces to.
+  /// \return False if the file is truncated.
+  bool readBinary(std::string_view _data, bool _loadNormals, Mesh *_mesh)
+  {
+    if (_data.size() < kBinaryHeaderSize)
+      return false;
+
+    uint32_t faceNum;
+    std::memcpy(&faceNum, _data.data() + 80, sizeof(faceNum));
+    if ((_data.size() - kBinaryHeaderSize) / kBinaryFaceSize < faceNum)
+      return false;
+
+    const std::size_t count = static_cast<std::size_t>(faceNum) * 3;
+    std::vector<math::Vector3d> vertices(count);
+    std::vector<math::Vector3d> normals(_loadNormals ? count : 0);
+    std::vector<unsigned int> indices(count);
+    std::iota(indices.begin(), indices.end(), 0u);
+
+    const char *face = _data.data() + kBinaryHeaderSize;
+    for (std::size_t i = 0; i < count; i += 3, face += kBinaryFaceSize)
+    {
+      if (_loadNormals)
+      {
+        const math::Vector3d normal = readVector(face);
+        normals[i] = normal;
+        normals[i + 1] = normal;
+        normals[i + 2] = normal;
+      }
+      vertices[i] = readVector(face + 12);
+      vertices[i + 1] = readVector(face + 24);
+      vertices[i + 2] = readVector(face + 36);
+    }
+
+    SubMesh subMesh;
+    subMesh.SetVertices(0, vertices.data(), vertices.size());
+    subMesh.SetNormals(0, normals.data(), normals.size());
+    subMesh.SetIndices(0, indices.data(), indices.size());
+    _mesh->AddSubMesh(subMesh);
+    return true;
+  }
+}
+
 
 //////////////////////////////////////////////////
 class gz::common::STLLoader::Implementation
 {
+  /// \brief Options of the mesh being loaded
+  public: MeshLoadOptions options;
 };
 
 //////////////////////////////////////////////////
@@ -49,6 +122,14 @@ STLLoader::~STLLoader()
 //////////////////////////////////////////////////
 Mesh *STLLoader::Load(const std::string &_filename)
 {
+  return this->Load(_filename, MeshLoadOptions());
+}
+
+//////////////////////////////////////////////////
+Mesh *STLLoader::Load(const std::string &_filename,
+    const MeshLoadOptions &_options)
+{
+  this->dataPtr->options = _options;
   FILE *file = fopen(_filename.c_str(), "r");
 
   if (!file)
@@ -60,15 +141,18 @@ Mesh *STLLoader::Load(const std::string &_filename)
   Mesh *mesh = new Mesh();
 
   // Try to read ASCII first. If that fails, try binary
-  if (!this->ReadAscii(file, mesh))
+  const bool ascii = this->ReadAscii(file, mesh);
+  fclose(file);
+  if (!ascii)
   {
-    fclose(file);
-    file = fopen(_filename.c_str(), "rb");
-    if (!this->ReadBinary(file, mesh))
+    MappedFile data(_filename);
+    if (!data.Valid() ||
+        !readBinary(data.View(), this->dataPtr->options.Normals(), mesh))
+    {
       gzerr << "Unable to read STL[" << _filename << "]\n";
+    }
   }
 
-  fclose(file);
   return mesh;
 }
 
@@ -87,6 +171,7 @@ bool STLLoader::ReadAscii(FILE *_filein, Mesh *_mesh)
   bool result = true;
 
   SubMesh subMesh;
+  const bool loadNormals = this->dataPtr->options.Normals();
 
   // Read the next line of the file into INPUT.
   while (fgets (input, LINE_MAX_LEN, _filein) != nullptr)
@@ -144,7 +229,8 @@ bool STLLoader::ReadAscii(FILE *_filein, Mesh *_mesh)
         vertex.Z(r3);
 
         subMesh.AddVertex(vertex);
-        subMesh.AddNormal(normal);
+        if (loadNormals)
+          subMesh.AddNormal(normal);
         subMesh.AddIndex(subMesh.IndexOfVertex(vertex));
       }
 
@@ -190,73 +276,12 @@ bool STLLoader::ReadAscii(FILE *_filein, Mesh *_mesh)
 //////////////////////////////////////////////////
 bool STLLoader::ReadBinary(FILE *_filein, Mesh *_mesh)
 {
-  int i;
-  int iface;
-  int face_num;
-
-  SubMesh subMesh;
-
-  // 80 byte Header.
-  for (i = 0; i < 80; ++i)
-    fgetc(_filein);
-
-  // Number of faces.
-  face_num = this->LongIntRead(_filein);
-
-  gz::math::Vector3d normal;
-  gz::math::Vector3d vertex;
-
-  // For each (triangular) face,
-  // components of normal vector,
-  // coordinates of three vertices,
-  // 2 byte "attribute".
-  for (iface = 0; iface < face_num; iface++)
-  {
-    if (!this->FloatRead(_filein, normal.X()))
-      return false;
-    if (!this->FloatRead(_filein, normal.Y()))
-      return false;
-    if (!this->FloatRead(_filein, normal.Z()))
-      return false;
-
-    if (!this->FloatRead(_filein, vertex.X()))
-      return false;
-    if (!this->FloatRead(_filein, vertex.Y()))
-      return false;
-    if (!this->FloatRead(_filein, vertex.Z()))
-      return false;
-
-    subMesh.AddVertex(vertex);
-    subMesh.AddNormal(normal);
-    subMesh.AddIndex(subMesh.VertexCount()-1);
-
-    if (!this->FloatRead(_filein, vertex.X()))
-      return false;
-    if (!this->FloatRead(_filein, vertex.Y()))
-      return false;
-    if (!this->FloatRead(_filein, vertex.Z()))
-      return false;
-    subMesh.AddVertex(vertex);
-    subMesh.AddNormal(normal);
-    subMesh.AddIndex(subMesh.VertexCount()-1);
-
-    if (!this->FloatRead(_filein, vertex.X()))
-      return false;
-    if (!this->FloatRead(_filein, vertex.Y()))
-      return false;
-    if (!this->FloatRead(_filein, vertex.Z()))
-      return false;
-    subMesh.AddVertex(vertex);
-    subMesh.AddNormal(normal);
-    subMesh.AddIndex(subMesh.VertexCount()-1);
-
-    uint16_t shortTmp;
-    if (!ShortIntRead(_filein, shortTmp))
-      return false;
-  }
-
-  _mesh->AddSubMesh(subMesh);
-  return true;
+  std::string data;
+  char buffer[65536];
+  std::size_t read;
+  while ((read = fread(buffer, 1, sizeof(buffer), _filein)) > 0)
+    data.append(buffer, read);
+  return readBinary(data, this->dataPtr->options.Normals(), _mesh);
 }
 
 //////////////////////////////////////////////////
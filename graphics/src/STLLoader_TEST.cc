@@ -91,3 +91,19 @@ TEST_F(STLLoaderTest, LoadSTL)
   EXPECT_STREQ("", mesh->SubMeshByIndex(0).lock()->Name().c_str());
   delete mesh;
 }
+
+/////////////////////////////////////////////////
+TEST_F(STLLoaderTest, LoadOptions)
+{
+  common::STLLoader loader;
+  for (const std::string file : {"cube.stl", "cube_binary.stl"})
+  {
+    auto mesh = loader.Load(common::testing::TestFile("data", file),
+        common::MeshLoadOptions::GeometryOnly());
+    ASSERT_NE(nullptr, mesh);
+    EXPECT_EQ(36u, mesh->VertexCount());
+    EXPECT_EQ(0u, mesh->NormalCount());
+    EXPECT_EQ(36u, mesh->IndexCount());
+    delete mesh;
+  }
+}
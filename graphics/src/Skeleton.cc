@@ -14,7 +14,9 @@
  * limitations under the License.
  *
  */
+#include <algorithm>
 #include <list>
+#include <unordered_map>
 #include <gz/common/Console.hh>
 #include <gz/common/SkeletonAnimation.hh>
 #include <gz/common/Skeleton.hh>
@@ -26,21 +28,46 @@ using namespace common;
 /// Private data class
 class gz::common::Skeleton::Implementation
 {
-  typedef std::vector<std::vector<std::pair<std::string, double> > >
+  /// \brief Weights of each vertex, as pairs of an index in
+  /// weightNodeNames and a weight
+  typedef std::vector<std::vector<std::pair<unsigned int, double> > >
     RawNodeWeights;
 
+  /// \brief Clear the compact skinning weights.
+  public: void ClearSkinWeights();
+
   /// \brief the root node
   public: SkeletonNode *root{nullptr};
 
-  /// \brief The dictionary of nodes, indexed by name
+  /// \brief The dictionary of nodes, indexed by handle
   public: SkeletonNodeMap nodes;
 
+  /// \brief The nodes indexed by name. If several nodes have the same
+  /// name, the one with the lowest handle.
+  public: std::unordered_map<std::string, SkeletonNode *> nodesByName;
+
   /// \brief the bind pose skeletal transform
   public: math::Matrix4d bindShapeTransform{math::Matrix4d::Identity};
 
   /// \brief the node weight table
   public: RawNodeWeights rawNodeWeights;
 
+  /// \brief Names of the nodes used by the node weight table
+  public: std::vector<std::string> weightNodeNames;
+
+  /// \brief Index of each name in weightNodeNames
+  public: std::unordered_map<std::string, unsigned int> weightNodeIndices;
+
+  /// \brief Number of influences per vertex of the compact skinning
+  /// weights, 0 if they are not built
+  public: unsigned int skinInfluences{0};
+
+  /// \brief Node handles of the compact skinning weights
+  public: std::vector<unsigned int> skinHandles;
+
+  /// \brief Normalized weights of the compact skinning weights
+  public: std::vector<float> skinWeights;
+
   /// \brief the array of animations
   public: std::vector<SkeletonAnimation *> anims;
 
@@ -64,6 +91,14 @@ class gz::common::Skeleton::Implementation
   public: std::vector<std::map<std::string, math::Matrix4d>> alignRotate;
 };
 
+//////////////////////////////////////////////////
+void Skeleton::Implementation::ClearSkinWeights()
+{
+  this->skinInfluences = 0;
+  this->skinHandles.clear();
+  this->skinWeights.clear();
+}
+
 //////////////////////////////////////////////////
 Skeleton::Skeleton()
 : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
@@ -105,14 +140,8 @@ SkeletonNode *Skeleton::RootNode() const
 //////////////////////////////////////////////////
 SkeletonNode *Skeleton::NodeByName(const std::string &_name) const
 {
-  for (SkeletonNodeMap::const_iterator iter =
-      this->dataPtr->nodes.begin(); iter != this->dataPtr->nodes.end(); ++iter)
-  {
-    if (iter->second->Name() == _name)
-      return iter->second;
-  }
-
-  return NULL;
+  auto iter = this->dataPtr->nodesByName.find(_name);
+  return iter != this->dataPtr->nodesByName.end() ? iter->second : NULL;
 }
 
 //////////////////////////////////////////////////
@@ -206,6 +235,14 @@ void Skeleton::BuildNodeMap()
     this->dataPtr->nodes[handle] = node;
     handle++;
   }
+
+  // Nodes are visited in handle order, the first node with a name is kept
+  this->dataPtr->nodesByName.clear();
+  for (const auto &kv : this->dataPtr->nodes)
+    this->dataPtr->nodesByName.emplace(kv.second->Name(), kv.second);
+
+  // Handles may have changed
+  this->dataPtr->ClearSkinWeights();
 }
 
 //////////////////////////////////////////////////
@@ -272,6 +309,7 @@ void Skeleton::SetNumVertAttached(const unsigned int _vertices)
 {
   this->dataPtr->rawNodeWeights.clear();
   this->dataPtr->rawNodeWeights.resize(_vertices);
+  this->dataPtr->ClearSkinWeights();
 }
 
 //////////////////////////////////////////////////
@@ -281,8 +319,14 @@ void Skeleton::AddVertNodeWeight(
 {
   if (_vertex < this->dataPtr->rawNodeWeights.size())
   {
+    auto index = this->dataPtr->weightNodeIndices.emplace(_node,
+        static_cast<unsigned int>(this->dataPtr->weightNodeNames.size()));
+    if (index.second)
+      this->dataPtr->weightNodeNames.push_back(_node);
+
     this->dataPtr->rawNodeWeights[_vertex].push_back(
-        std::make_pair(_node, _weight));
+        std::make_pair(index.first->second, _weight));
+    this->dataPtr->ClearSkinWeights();
   }
 }
 
@@ -304,12 +348,108 @@ std::pair<std::string, double> Skeleton::VertNodeWeight(
   if (_v < this->dataPtr->rawNodeWeights.size() &&
       _i < this->dataPtr->rawNodeWeights[_v].size())
   {
-    result = this->dataPtr->rawNodeWeights[_v][_i];
+    const auto &weight = this->dataPtr->rawNodeWeights[_v][_i];
+    result.first = this->dataPtr->weightNodeNames[weight.first];
+    result.second = weight.second;
   }
 
   return result;
 }
 
+//////////////////////////////////////////////////
+bool Skeleton::BuildSkinWeights(const unsigned int _influences)
+{
+  this->dataPtr->ClearSkinWeights();
+  if (_influences == 0)
+  {
+    gzerr << "Skinning weights need at least one influence per vertex"
+          << std::endl;
+    return false;
+  }
+
+  // Resolve each node name once
+  std::vector<unsigned int> handles;
+  handles.reserve(this->dataPtr->weightNodeNames.size());
+  for (const auto &name : this->dataPtr->weightNodeNames)
+  {
+    SkeletonNode *node = this->NodeByName(name);
+    if (nullptr == node)
+    {
+      gzerr << "Skinning weight refers to node [" << name
+            << "] which is not in the skeleton" << std::endl;
+      return false;
+    }
+    handles.push_back(node->Handle());
+  }
+
+  const std::size_t vertexCount = this->dataPtr->rawNodeWeights.size();
+  std::vector<unsigned int> skinHandles(vertexCount * _influences, 0u);
+  std::vector<float> skinWeights(vertexCount * _influences, 0.0f);
+
+  std::vector<std::pair<unsigned int, double>> weights;
+  for (std::size_t v = 0; v < vertexCount; ++v)
+  {
+    // Keep the largest weights, in the order they were added if equal
+    weights = this->dataPtr->rawNodeWeights[v];
+    std::stable_sort(weights.begin(), weights.end(),
+        [](const std::pair<unsigned int, double> &_a,
+           const std::pair<unsigned int, double> &_b)
+        {
+          return _a.second > _b.second;
+        });
+    if (weights.size() > _influences)
+      weights.resize(_influences);
+
+    double total = 0.0;
+    for (const auto &weight : weights)
+      total += weight.second;
+
+    const std::size_t offset = v * _influences;
+    for (std::size_t i = 0; i < weights.size(); ++i)
+    {
+      skinHandles[offset + i] = handles[weights[i].first];
+      skinWeights[offset + i] = total > 0.0 ?
+          static_cast<float>(weights[i].second / total) : 0.0f;
+    }
+  }
+
+  this->dataPtr->skinInfluences = _influences;
+  this->dataPtr->skinHandles = std::move(skinHandles);
+  this->dataPtr->skinWeights = std::move(skinWeights);
+  return true;
+}
+
+//////////////////////////////////////////////////
+unsigned int Skeleton::SkinInfluenceCount() const
+{
+  return this->dataPtr->skinInfluences;
+}
+
+//////////////////////////////////////////////////
+unsigned int Skeleton::SkinVertexCount() const
+{
+  if (this->dataPtr->skinInfluences == 0)
+    return 0;
+  return static_cast<unsigned int>(
+      this->dataPtr->skinWeights.size() / this->dataPtr->skinInfluences);
+}
+
+//////////////////////////////////////////////////
+const unsigned int *Skeleton::SkinNodeHandles() const
+{
+  if (this->dataPtr->skinInfluences == 0)
+    return nullptr;
+  return this->dataPtr->skinHandles.data();
+}
+
+//////////////////////////////////////////////////
+const float *Skeleton::SkinWeights() const
+{
+  if (this->dataPtr->skinInfluences == 0)
+    return nullptr;
+  return this->dataPtr->skinWeights.data();
+}
+
 //////////////////////////////////////////////////
 unsigned int Skeleton::AnimationCount() const
 {
@@ -477,10 +617,19 @@ bool Skeleton::AddBvhAnimation(const std::string &_bvhFile, double _scale)
 std::string Skeleton::NodeNameAnimToSkin(unsigned int _index,
       const std::string &_animNodeName)
 {
-  if (this->dataPtr->mapAnimSkin[_index].find(_animNodeName)
-        != this->dataPtr->mapAnimSkin[_index].end())
+  return static_cast<const Skeleton *>(this)->NodeNameAnimToSkin(
+      _index, _animNodeName);
+}
+
+//////////////////////////////////////////////////
+std::string Skeleton::NodeNameAnimToSkin(unsigned int _index,
+      const std::string &_animNodeName) const
+{
+  if (_index < this->dataPtr->mapAnimSkin.size())
   {
-    return this->dataPtr->mapAnimSkin[_index][_animNodeName];
+    auto iter = this->dataPtr->mapAnimSkin[_index].find(_animNodeName);
+    if (iter != this->dataPtr->mapAnimSkin[_index].end())
+      return iter->second;
   }
   return _animNodeName;
 }
@@ -489,10 +638,19 @@ std::string Skeleton::NodeNameAnimToSkin(unsigned int _index,
 math::Matrix4d Skeleton::AlignTranslation(unsigned int _index,
       const std::string &_animNodeName)
 {
-  if (this->dataPtr->alignTranslate[_index].find(_animNodeName)
-        != this->dataPtr->alignTranslate[_index].end())
+  return static_cast<const Skeleton *>(this)->AlignTranslation(
+      _index, _animNodeName);
+}
+
+//////////////////////////////////////////////////
+math::Matrix4d Skeleton::AlignTranslation(unsigned int _index,
+      const std::string &_animNodeName) const
+{
+  if (_index < this->dataPtr->alignTranslate.size())
   {
-    return this->dataPtr->alignTranslate[_index][_animNodeName];
+    auto iter = this->dataPtr->alignTranslate[_index].find(_animNodeName);
+    if (iter != this->dataPtr->alignTranslate[_index].end())
+      return iter->second;
   }
   return math::Matrix4d::Identity;
 }
@@ -501,10 +659,19 @@ math::Matrix4d Skeleton::AlignTranslation(unsigned int _index,
 math::Matrix4d Skeleton::AlignRotation(unsigned int _index,
       const std::string &_animNodeName)
 {
-  if (this->dataPtr->alignRotate[_index].find(_animNodeName)
-        != this->dataPtr->alignRotate[_index].end())
+  return static_cast<const Skeleton *>(this)->AlignRotation(
+      _index, _animNodeName);
+}
+
+//////////////////////////////////////////////////
+math::Matrix4d Skeleton::AlignRotation(unsigned int _index,
+      const std::string &_animNodeName) const
+{
+  if (_index < this->dataPtr->alignRotate.size())
   {
-    return this->dataPtr->alignRotate[_index][_animNodeName];
+    auto iter = this->dataPtr->alignRotate[_index].find(_animNodeName);
+    if (iter != this->dataPtr->alignRotate[_index].end())
+      return iter->second;
   }
   return math::Matrix4d::Identity;
 }
@@ -15,6 +15,11 @@
  *
 */
 
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "gz/common/Console.hh"
 #include "gz/common/NodeAnimation.hh"
 #include "gz/common/SkeletonAnimation.hh"
@@ -29,7 +34,7 @@ class gz::common::SkeletonAnimation::Implementation
   public: std::string name;
 
   /// \brief the duration of the longest animation
-  public: double length;
+  public: double length = 0.0;
 
   /// \brief a dictionary of node animations
   public: std::map<std::string, std::shared_ptr<NodeAnimation>> animations;
@@ -75,6 +80,15 @@ NodeAnimation *SkeletonAnimation::NodeAnimationByName(
   return nullptr;
 }
 
+//////////////////////////////////////////////////
+NodeAnimation *SkeletonAnimation::NodeAnimationByIndex(
+    const unsigned int _index) const
+{
+  if (_index >= this->dataPtr->animations.size())
+    return nullptr;
+  return std::next(this->dataPtr->animations.begin(), _index)->second.get();
+}
+
 //////////////////////////////////////////////////
 bool SkeletonAnimation::XDisplacement() const
 {
@@ -128,6 +142,23 @@ void SkeletonAnimation::AddKeyFrame(const std::string &_node,
   this->dataPtr->animations[_node]->AddKeyFrame(_time, _pose);
 }
 
+//////////////////////////////////////////////////
+bool SkeletonAnimation::SetKeyFrames(const std::string &_node,
+    std::vector<double> _times, std::vector<math::Matrix4d> _transforms)
+{
+  auto iter = this->dataPtr->animations.find(_node);
+  auto anim = iter != this->dataPtr->animations.end() ? iter->second :
+      std::make_shared<NodeAnimation>(_node);
+
+  if (!anim->SetKeyFrames(std::move(_times), std::move(_transforms)))
+    return false;
+  this->dataPtr->animations[_node] = anim;
+
+  if (anim->Length() > this->dataPtr->length)
+    this->dataPtr->length = anim->Length();
+  return true;
+}
+
 //////////////////////////////////////////////////
 math::Matrix4d SkeletonAnimation::NodePoseAt(const std::string &_node,
     const double _time, const bool _loop) const
@@ -152,13 +183,29 @@ std::map<std::string, math::Matrix4d> SkeletonAnimation::PoseAt(
   ///  prev and next keyframe for each node at each time step, but rather
   ///  doing it only once per time step.
   std::map<std::string, math::Matrix4d> pose;
-  for (auto iter = this->dataPtr->animations.begin();
-      iter != this->dataPtr->animations.end(); ++iter)
+  this->PoseAt(_time, pose, _loop);
+  return pose;
+}
+
+//////////////////////////////////////////////////
+void SkeletonAnimation::PoseAt(const double _time,
+    std::map<std::string, math::Matrix4d> &_pose, const bool _loop) const
+{
+  // Both maps are sorted by name, so walk them together and only insert
+  // or erase nodes when the set of animated nodes changed.
+  auto out = _pose.begin();
+  for (const auto &[name, anim] : this->dataPtr->animations)
   {
-    pose[iter->first] = iter->second->FrameAt(_time, _loop);
-  }
+    while (out != _pose.end() && out->first < name)
+      out = _pose.erase(out);
 
-  return pose;
+    if (out == _pose.end() || out->first != name)
+      out = _pose.emplace_hint(out, name, math::Matrix4d::Identity);
+
+    out->second = anim->FrameAt(_time, _loop);
+    ++out;
+  }
+  _pose.erase(out, _pose.end());
 }
 
 //////////////////////////////////////////////////
@@ -16,6 +16,8 @@
 */
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "gz/common/Skeleton.hh"
 #include "gz/common/SkeletonAnimation.hh"
 
@@ -35,3 +37,76 @@ TEST_F(SkeletonAnimation, CheckNoXDisplacement)
 
   delete skelAnim;
 }
+
+/////////////////////////////////////////////////
+TEST_F(SkeletonAnimation, PoseAtReuse)
+{
+  common::SkeletonAnimation anim("anim");
+  math::Matrix4d start = math::Matrix4d::Identity;
+  math::Matrix4d end(math::Pose3d(2, 0, 0, 0, 0, 0));
+  anim.AddKeyFrame("b", 0.0, start);
+  anim.AddKeyFrame("b", 1.0, end);
+  anim.AddKeyFrame("d", 0.0, start);
+  anim.AddKeyFrame("d", 1.0, end);
+
+  // Stale entries are removed, missing ones are added
+  std::map<std::string, math::Matrix4d> pose;
+  pose["a"] = math::Matrix4d::Zero;
+  pose["c"] = math::Matrix4d::Zero;
+  pose["e"] = math::Matrix4d::Zero;
+  anim.PoseAt(0.5, pose, false);
+  ASSERT_EQ(2u, pose.size());
+  EXPECT_EQ(pose, anim.PoseAt(0.5, false));
+  EXPECT_NEAR(1.0, pose["b"].Translation().X(), 1e-6);
+  EXPECT_NEAR(1.0, pose["d"].Translation().X(), 1e-6);
+
+  // Existing entries are updated in place
+  const math::Matrix4d *b = &pose["b"];
+  anim.PoseAt(1.0, pose, false);
+  EXPECT_EQ(b, &pose["b"]);
+  EXPECT_NEAR(2.0, pose["b"].Translation().X(), 1e-6);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SkeletonAnimation, SetKeyFrames)
+{
+  // Out of order, with a repeated time
+  std::vector<double> times{2.0, 0.0, 1.0, 1.0};
+  std::vector<math::Matrix4d> transforms;
+  for (double x : {20.0, 0.0, 10.0, 11.0})
+  {
+    math::Matrix4d mat = math::Matrix4d::Identity;
+    mat.SetTranslation(math::Vector3d(x, 0, 0));
+    transforms.push_back(mat);
+  }
+
+  // Same result as adding the frames one at a time
+  common::SkeletonAnimation added("added");
+  for (std::size_t i = 0; i < times.size(); ++i)
+    added.AddKeyFrame("node", times[i], transforms[i]);
+
+  common::SkeletonAnimation bulk("bulk");
+  ASSERT_TRUE(bulk.SetKeyFrames("node", times, transforms));
+  EXPECT_DOUBLE_EQ(2.0, bulk.Length());
+
+  common::NodeAnimation *expected = added.NodeAnimationByName("node");
+  common::NodeAnimation *actual = bulk.NodeAnimationByName("node");
+  ASSERT_NE(nullptr, expected);
+  ASSERT_NE(nullptr, actual);
+  ASSERT_EQ(3u, actual->FrameCount());
+  ASSERT_EQ(expected->FrameCount(), actual->FrameCount());
+  for (unsigned int i = 0; i < actual->FrameCount(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(expected->KeyFrame(i).first, actual->KeyFrame(i).first);
+    EXPECT_EQ(expected->KeyFrame(i).second, actual->KeyFrame(i).second);
+  }
+  EXPECT_DOUBLE_EQ(11.0, actual->KeyFrame(1).second.Translation().X());
+  EXPECT_DOUBLE_EQ(expected->Length(), actual->Length());
+
+  // Mismatched sizes leave the animation unchanged
+  transforms.pop_back();
+  EXPECT_FALSE(bulk.SetKeyFrames("node", times, transforms));
+  EXPECT_EQ(3u, actual->FrameCount());
+  EXPECT_FALSE(bulk.SetKeyFrames("other", times, transforms));
+  EXPECT_FALSE(bulk.HasNode("other"));
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gz/common/Console.hh"
+#include "gz/common/NodeAnimation.hh"
+#include "gz/common/Skeleton.hh"
+#include "gz/common/SkeletonAnimation.hh"
+#include "gz/common/SkeletonNode.hh"
+#include "gz/common/SkeletonRetarget.hh"
+
+#include "ParallelFor.hh"
+
+using namespace gz;
+using namespace common;
+
+namespace
+{
+  /// \brief Batches with fewer animated nodes per thread than this are
+  /// sampled on the calling thread.
+  constexpr std::size_t kParallelNodes = 4096;
+}
+
+/// \brief Private data for SkeletonRetarget
+class gz::common::SkeletonRetarget::Implementation
+{
+  /// \brief The animation, null if not valid
+  public: const SkeletonAnimation *animation{nullptr};
+
+  /// \brief Animation of each animated node
+  public: std::vector<const NodeAnimation *> nodeAnims;
+
+  /// \brief Skin node handle of each animated node
+  public: std::vector<unsigned int> skinHandles;
+
+  /// \brief Translation alignment of each animated node
+  public: std::vector<math::Matrix4d> alignTranslate;
+
+  /// \brief Rotation alignment of each animated node
+  public: std::vector<math::Matrix4d> alignRotate;
+
+  /// \brief False if both alignments of an animated node are identity
+  public: std::vector<bool> aligned;
+
+  /// \brief Transform of each skin node, indexed by handle
+  public: std::vector<math::Matrix4d> skinTransforms;
+};
+
+//////////////////////////////////////////////////
+SkeletonRetarget::SkeletonRetarget()
+: dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+SkeletonRetarget::SkeletonRetarget(const Skeleton &_skeleton,
+    const unsigned int _index)
+: SkeletonRetarget()
+{
+  const SkeletonAnimation *anim = _skeleton.Animation(_index);
+  if (nullptr == anim)
+  {
+    gzerr << "Skeleton has no animation with index [" << _index << "]"
+          << std::endl;
+    return;
+  }
+  this->dataPtr->animation = anim;
+
+  this->dataPtr->skinTransforms.resize(_skeleton.NodeCount(),
+      math::Matrix4d::Identity);
+  for (const auto &kv : _skeleton.Nodes())
+  {
+    if (kv.first < this->dataPtr->skinTransforms.size())
+      this->dataPtr->skinTransforms[kv.first] = kv.second->Transform();
+  }
+
+  for (unsigned int i = 0; i < anim->NodeCount(); ++i)
+  {
+    const NodeAnimation *nodeAnim = anim->NodeAnimationByIndex(i);
+    const std::string animName = nodeAnim->Name();
+    const SkeletonNode *skinNode = _skeleton.NodeByName(
+        _skeleton.NodeNameAnimToSkin(_index, animName));
+    if (nullptr == skinNode ||
+        skinNode->Handle() >= this->dataPtr->skinTransforms.size())
+    {
+      continue;
+    }
+
+    const math::Matrix4d translate =
+        _skeleton.AlignTranslation(_index, animName);
+    const math::Matrix4d rotate = _skeleton.AlignRotation(_index, animName);
+    this->dataPtr->nodeAnims.push_back(nodeAnim);
+    this->dataPtr->skinHandles.push_back(skinNode->Handle());
+    this->dataPtr->alignTranslate.push_back(translate);
+    this->dataPtr->alignRotate.push_back(rotate);
+    this->dataPtr->aligned.push_back(
+        translate != math::Matrix4d::Identity ||
+        rotate != math::Matrix4d::Identity);
+  }
+}
+
+//////////////////////////////////////////////////
+bool SkeletonRetarget::Valid() const
+{
+  return nullptr != this->dataPtr->animation;
+}
+
+//////////////////////////////////////////////////
+const SkeletonAnimation *SkeletonRetarget::Animation() const
+{
+  return this->dataPtr->animation;
+}
+
+//////////////////////////////////////////////////
+unsigned int SkeletonRetarget::SkinNodeCount() const
+{
+  return static_cast<unsigned int>(this->dataPtr->skinTransforms.size());
+}
+
+//////////////////////////////////////////////////
+unsigned int SkeletonRetarget::NodeCount() const
+{
+  return static_cast<unsigned int>(this->dataPtr->nodeAnims.size());
+}
+
+//////////////////////////////////////////////////
+unsigned int SkeletonRetarget::SkinHandle(const unsigned int _i) const
+{
+  return this->dataPtr->skinHandles[_i];
+}
+
+//////////////////////////////////////////////////
+math::Matrix4d SkeletonRetarget::AlignTranslation(const unsigned int _i) const
+{
+  return this->dataPtr->alignTranslate[_i];
+}
+
+//////////////////////////////////////////////////
+math::Matrix4d SkeletonRetarget::AlignRotation(const unsigned int _i) const
+{
+  return this->dataPtr->alignRotate[_i];
+}
+
+//////////////////////////////////////////////////
+void SkeletonRetarget::PoseAt(const double _time,
+    std::vector<math::Matrix4d> &_pose, const bool _loop) const
+{
+  _pose.assign(this->dataPtr->skinTransforms.begin(),
+      this->dataPtr->skinTransforms.end());
+
+  for (std::size_t i = 0; i < this->dataPtr->nodeAnims.size(); ++i)
+  {
+    math::Matrix4d &transform = _pose[this->dataPtr->skinHandles[i]];
+    transform = this->dataPtr->nodeAnims[i]->FrameAt(_time, _loop);
+    if (this->dataPtr->aligned[i])
+    {
+      transform = this->dataPtr->alignTranslate[i] * transform *
+          this->dataPtr->alignRotate[i];
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+bool SkeletonRetarget::PosesAt(
+    const std::vector<const SkeletonRetarget *> &_retargets,
+    const std::vector<double> &_times,
+    std::vector<std::vector<math::Matrix4d>> &_poses, const bool _loop)
+{
+  if (_retargets.size() != _times.size())
+  {
+    gzerr << "Number of retargets [" << _retargets.size()
+          << "] and times [" << _times.size() << "] differ" << std::endl;
+    return false;
+  }
+
+  _poses.resize(_retargets.size());
+
+  std::size_t nodeCount = 0;
+  for (const auto *retarget : _retargets)
+  {
+    if (retarget)
+      nodeCount += retarget->dataPtr->nodeAnims.size();
+  }
+
+  // One skeleton per task
+  const std::size_t threadCount = std::min<std::size_t>(
+      nodeCount / kParallelNodes + 1,
+      std::max(1u, std::thread::hardware_concurrency()));
+  parallelFor(_retargets.size(), [&](const std::size_t _i)
+  {
+    if (_retargets[_i])
+      _retargets[_i]->PoseAt(_times[_i], _poses[_i], _loop);
+    else
+      _poses[_i].clear();
+  }, static_cast<unsigned int>(threadCount));
+
+  return true;
+}
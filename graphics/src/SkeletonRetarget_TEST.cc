@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gz/common/ColladaLoader.hh"
+#include "gz/common/Mesh.hh"
+#include "gz/common/Skeleton.hh"
+#include "gz/common/SkeletonAnimation.hh"
+#include "gz/common/SkeletonRetarget.hh"
+
+#include "gz/common/testing/AutoLogFixture.hh"
+#include "gz/common/testing/TestPaths.hh"
+
+using namespace gz;
+
+class SkeletonRetargetTest : public common::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Check a retargeted pose against the name based lookups.
+void checkPose(const common::Skeleton &_skeleton, unsigned int _index,
+    double _time)
+{
+  common::SkeletonRetarget retarget(_skeleton, _index);
+  ASSERT_TRUE(retarget.Valid());
+  EXPECT_EQ(_skeleton.NodeCount(), retarget.SkinNodeCount());
+
+  std::vector<math::Matrix4d> pose;
+  retarget.PoseAt(_time, pose);
+  ASSERT_EQ(_skeleton.NodeCount(), pose.size());
+
+  auto animPose = _skeleton.Animation(_index)->PoseAt(_time, true);
+  std::map<std::string, math::Matrix4d> expected;
+  for (const auto &[animName, animTf] : animPose)
+  {
+    expected[_skeleton.NodeNameAnimToSkin(_index, animName)] =
+        _skeleton.AlignTranslation(_index, animName) * animTf *
+        _skeleton.AlignRotation(_index, animName);
+  }
+
+  unsigned int animated = 0;
+  for (const auto &[handle, node] : _skeleton.Nodes())
+  {
+    auto iter = expected.find(node->Name());
+    if (iter != expected.end())
+    {
+      EXPECT_EQ(iter->second, pose[handle]) << node->Name();
+      ++animated;
+    }
+    else
+    {
+      EXPECT_EQ(node->Transform(), pose[handle]) << node->Name();
+    }
+  }
+  EXPECT_EQ(animated, retarget.NodeCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(SkeletonRetargetTest, Collada)
+{
+  common::ColladaLoader loader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(
+      common::testing::TestFile("data", "walk.dae")));
+  ASSERT_NE(nullptr, mesh);
+  auto skeleton = mesh->MeshSkeleton();
+  ASSERT_NE(nullptr, skeleton);
+  ASSERT_LT(0u, skeleton->AnimationCount());
+
+  for (double time : {0.0, 0.3, 1.7, 100.0})
+    checkPose(*skeleton, 0, time);
+
+  common::SkeletonRetarget retarget(*skeleton, 0);
+  EXPECT_EQ(skeleton->Animation(0), retarget.Animation());
+  ASSERT_LT(0u, retarget.NodeCount());
+  EXPECT_EQ(math::Matrix4d::Identity, retarget.AlignTranslation(0));
+  EXPECT_EQ(math::Matrix4d::Identity, retarget.AlignRotation(0));
+  EXPECT_EQ(skeleton->NodeByName(
+      skeleton->Animation(0)->NodeAnimationByIndex(0)->Name())->Handle(),
+      retarget.SkinHandle(0));
+
+  common::SkeletonRetarget invalid(*skeleton, 100);
+  EXPECT_FALSE(invalid.Valid());
+  EXPECT_FALSE(common::SkeletonRetarget().Valid());
+  EXPECT_EQ(nullptr, invalid.Animation());
+
+  // Lookups for an invalid animation fall back to the animation node
+  EXPECT_EQ("node", skeleton->NodeNameAnimToSkin(100, "node"));
+  EXPECT_EQ(math::Matrix4d::Identity, skeleton->AlignTranslation(100, "node"));
+  EXPECT_EQ(math::Matrix4d::Identity, skeleton->AlignRotation(100, "node"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(SkeletonRetargetTest, Bvh)
+{
+  common::ColladaLoader loader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(
+      common::testing::TestFile("data", "walk.dae")));
+  ASSERT_NE(nullptr, mesh);
+  auto skeleton = mesh->MeshSkeleton();
+  ASSERT_NE(nullptr, skeleton);
+  const unsigned int index = skeleton->AnimationCount();
+  ASSERT_TRUE(skeleton->AddBvhAnimation(
+      common::testing::TestFile("data", "cmu-13_26.bvh"), 0.055));
+
+  for (double time : {0.0, 0.5, 2.25})
+    checkPose(*skeleton, index, time);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SkeletonRetargetTest, PosesAt)
+{
+  common::ColladaLoader loader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(
+      common::testing::TestFile("data", "walk.dae")));
+  ASSERT_NE(nullptr, mesh);
+  common::SkeletonRetarget retarget(*mesh->MeshSkeleton(), 0);
+
+  // Enough actors to be split across threads
+  std::vector<const common::SkeletonRetarget *> retargets(2000, &retarget);
+  retargets[1] = nullptr;
+  std::vector<double> times;
+  for (std::size_t i = 0; i < retargets.size(); ++i)
+    times.push_back(i * 0.01);
+
+  std::vector<std::vector<math::Matrix4d>> poses;
+  ASSERT_TRUE(common::SkeletonRetarget::PosesAt(retargets, times, poses));
+  ASSERT_EQ(retargets.size(), poses.size());
+  EXPECT_TRUE(poses[1].empty());
+
+  std::vector<math::Matrix4d> pose;
+  for (std::size_t i : {0u, 2u, 999u, 1999u})
+  {
+    retarget.PoseAt(times[i], pose);
+    EXPECT_EQ(pose, poses[i]);
+  }
+
+  times.pop_back();
+  EXPECT_FALSE(common::SkeletonRetarget::PosesAt(retargets, times, poses));
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include "gz/common/Skeleton.hh"
+#include "gz/common/SkeletonNode.hh"
+
+#include "gz/common/testing/AutoLogFixture.hh"
+
+using namespace gz;
+
+class SkeletonTest : public common::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(SkeletonTest, SkinWeights)
+{
+  auto root = new common::SkeletonNode(nullptr, "root", "root_id");
+  auto arm = new common::SkeletonNode(root, "arm", "arm_id");
+  auto hand = new common::SkeletonNode(arm, "hand", "hand_id");
+  auto leg = new common::SkeletonNode(root, "leg", "leg_id");
+  common::Skeleton skeleton(root);
+  EXPECT_EQ(hand, skeleton.NodeByName("hand"));
+  EXPECT_EQ(nullptr, skeleton.NodeByName("tail"));
+
+  skeleton.SetNumVertAttached(3);
+  skeleton.AddVertNodeWeight(0, "arm", 0.5);
+  skeleton.AddVertNodeWeight(0, "hand", 1.5);
+  skeleton.AddVertNodeWeight(1, "root", 0.1);
+  skeleton.AddVertNodeWeight(1, "arm", 0.2);
+  skeleton.AddVertNodeWeight(1, "hand", 0.3);
+  skeleton.AddVertNodeWeight(1, "leg", 0.4);
+  skeleton.AddVertNodeWeight(3, "leg", 1.0);
+
+  // The original weights are kept
+  EXPECT_EQ(2u, skeleton.VertNodeWeightCount(0));
+  EXPECT_EQ(0u, skeleton.VertNodeWeightCount(3));
+  EXPECT_EQ("hand", skeleton.VertNodeWeight(0, 1).first);
+  EXPECT_DOUBLE_EQ(1.5, skeleton.VertNodeWeight(0, 1).second);
+  EXPECT_EQ("leg", skeleton.VertNodeWeight(1, 3).first);
+  EXPECT_EQ("", skeleton.VertNodeWeight(2, 0).first);
+
+  EXPECT_EQ(0u, skeleton.SkinInfluenceCount());
+  EXPECT_EQ(nullptr, skeleton.SkinNodeHandles());
+  EXPECT_FALSE(skeleton.BuildSkinWeights(0));
+
+  ASSERT_TRUE(skeleton.BuildSkinWeights(2));
+  EXPECT_EQ(2u, skeleton.SkinInfluenceCount());
+  ASSERT_EQ(3u, skeleton.SkinVertexCount());
+  const unsigned int *handles = skeleton.SkinNodeHandles();
+  const float *weights = skeleton.SkinWeights();
+  ASSERT_NE(nullptr, handles);
+  ASSERT_NE(nullptr, weights);
+
+  // Largest weights first, normalized
+  EXPECT_EQ(hand->Handle(), handles[0]);
+  EXPECT_EQ(arm->Handle(), handles[1]);
+  EXPECT_FLOAT_EQ(0.75f, weights[0]);
+  EXPECT_FLOAT_EQ(0.25f, weights[1]);
+
+  // Only the two largest of four weights are kept
+  EXPECT_EQ(leg->Handle(), handles[2]);
+  EXPECT_EQ(hand->Handle(), handles[3]);
+  EXPECT_FLOAT_EQ(0.4f / 0.7f, weights[2]);
+  EXPECT_FLOAT_EQ(0.3f / 0.7f, weights[3]);
+
+  // No weights
+  EXPECT_EQ(0u, handles[4]);
+  EXPECT_FLOAT_EQ(0.0f, weights[4] + weights[5]);
+
+  ASSERT_TRUE(skeleton.BuildSkinWeights(8));
+  EXPECT_EQ(24u, skeleton.SkinVertexCount() * skeleton.SkinInfluenceCount());
+  EXPECT_FLOAT_EQ(0.1f, skeleton.SkinWeights()[8 + 3]);
+
+  // Modifying the weights clears the compact weights
+  skeleton.AddVertNodeWeight(2, "tail", 1.0);
+  EXPECT_EQ(0u, skeleton.SkinVertexCount());
+  EXPECT_EQ(nullptr, skeleton.SkinWeights());
+
+  // Unknown node
+  EXPECT_FALSE(skeleton.BuildSkinWeights(4));
+  EXPECT_EQ(0u, skeleton.SkinInfluenceCount());
+}
@@ -16,8 +16,11 @@
  */
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <limits>
 #include <map>
+#include <memory>
 #include <optional>
 #include <string>
 
@@ -30,21 +33,50 @@
 using namespace gz;
 using namespace common;
 
+namespace
+{
+  /// \brief Buffer shared between copies of a submesh until one of them
+  /// modifies it.
+  template<typename T>
+  class CopyOnWrite
+  {
+    /// \brief Read access, never copies.
+    /// \return The buffer.
+    public: const T &Get() const
+    {
+      return *this->data;
+    }
+
+    /// \brief Write access. The buffer is copied first if it is shared
+    /// with another submesh.
+    /// \return The buffer, owned only by this submesh.
+    public: T &Edit()
+    {
+      if (this->data.use_count() > 1)
+        this->data = std::make_shared<T>(*this->data);
+      return *this->data;
+    }
+
+    /// \brief The buffer.
+    private: std::shared_ptr<T> data = std::make_shared<T>();
+  };
+}
+
 /// \brief Private data for SubMesh
 class gz::common::SubMesh::Implementation
 {
   /// \brief the vertex array
-  public: std::vector<gz::math::Vector3d> vertices;
+  public: CopyOnWrite<std::vector<gz::math::Vector3d>> vertices;
 
   /// \brief the normal array
-  public: std::vector<gz::math::Vector3d> normals;
+  public: CopyOnWrite<std::vector<gz::math::Vector3d>> normals;
 
   /// \brief A map of texcoord set index to texture coordinate array
-  public: std::map<unsigned int, std::vector<gz::math::Vector2d>>
-      texCoords;
+  public: CopyOnWrite<std::map<unsigned int,
+      std::vector<gz::math::Vector2d>>> texCoords;
 
   /// \brief the vertex index array
-  public: std::vector<unsigned int> indices;
+  public: CopyOnWrite<std::vector<unsigned int>> indices;
 
   /// \brief node assignment array
   public: std::vector<NodeAssignment> nodeAssignments;
@@ -58,6 +90,45 @@ class gz::common::SubMesh::Implementation
 
   /// \brief The name of the sub-mesh
   public: std::string name;
+
+  /// \brief Range of changed elements, [begin, end). Empty if begin >= end.
+  public: struct Range
+  {
+    /// \brief First changed element
+    unsigned int begin = std::numeric_limits<unsigned int>::max();
+
+    /// \brief One past the last changed element
+    unsigned int end = 0;
+  };
+
+  /// \brief Changed elements, indexed by SubMesh::Attribute
+  public: std::array<Range, 4> dirty;
+
+  /// \brief Change counter
+  public: uint64_t version = 0;
+
+  /// \brief Record a change of elements of an attribute
+  /// \param[in] _attribute The attribute that changed
+  /// \param[in] _begin First changed element
+  /// \param[in] _end One past the last changed element
+  public: void Modified(SubMesh::Attribute _attribute, std::size_t _begin,
+      std::size_t _end)
+  {
+    ++this->version;
+    if (_begin >= _end)
+      return;
+    auto &range = this->dirty[static_cast<std::size_t>(_attribute)];
+    range.begin = std::min(range.begin, static_cast<unsigned int>(_begin));
+    range.end = std::max(range.end, static_cast<unsigned int>(_end));
+  }
+
+  /// \brief Record a change of all elements of an attribute
+  /// \param[in] _attribute The attribute that changed
+  /// \param[in] _count Number of elements
+  public: void ModifiedAll(SubMesh::Attribute _attribute, std::size_t _count)
+  {
+    this->Modified(_attribute, 0, _count);
+  }
 };
 
 //////////////////////////////////////////////////
@@ -82,6 +153,7 @@ SubMesh::~SubMesh()
 void SubMesh::SetPrimitiveType(PrimitiveType _type)
 {
   this->dataPtr->primitiveType = _type;
+  ++this->dataPtr->version;
 }
 
 //////////////////////////////////////////////////
@@ -93,13 +165,19 @@ SubMesh::PrimitiveType SubMesh::SubMeshPrimitiveType() const
 //////////////////////////////////////////////////
 void SubMesh::AddIndex(const unsigned int _index)
 {
-  this->dataPtr->indices.push_back(_index);
+  auto &indices = this->dataPtr->indices.Edit();
+  indices.push_back(_index);
+  this->dataPtr->Modified(Attribute::INDICES,
+      indices.size() - 1, indices.size());
 }
 
 //////////////////////////////////////////////////
 void SubMesh::AddVertex(const gz::math::Vector3d &_v)
 {
-  this->dataPtr->vertices.push_back(_v);
+  auto &vertices = this->dataPtr->vertices.Edit();
+  vertices.push_back(_v);
+  this->dataPtr->Modified(Attribute::VERTICES,
+      vertices.size() - 1, vertices.size());
 }
 
 //////////////////////////////////////////////////
@@ -111,7 +189,10 @@ void SubMesh::AddVertex(const double _x, const double _y, const double _z)
 //////////////////////////////////////////////////
 void SubMesh::AddNormal(const gz::math::Vector3d &_n)
 {
-  this->dataPtr->normals.push_back(_n);
+  auto &normals = this->dataPtr->normals.Edit();
+  normals.push_back(_n);
+  this->dataPtr->Modified(Attribute::NORMALS,
+      normals.size() - 1, normals.size());
 }
 
 //////////////////////////////////////////////////
@@ -124,8 +205,8 @@ void SubMesh::AddNormal(const double _x, const double _y, const double _z)
 void SubMesh::AddTexCoord(const double _u, const double _v)
 {
   unsigned firstSetIndex = 0u;
-  if (!this->dataPtr->texCoords.empty())
-    firstSetIndex = this->dataPtr->texCoords.begin()->first;
+  if (!this->dataPtr->texCoords.Get().empty())
+    firstSetIndex = this->dataPtr->texCoords.Get().begin()->first;
   this->AddTexCoordBySet(_u, _v, firstSetIndex);
 }
 
@@ -138,8 +219,10 @@ void SubMesh::AddTexCoord(const gz::math::Vector2d &_uv)
 //////////////////////////////////////////////////
 void SubMesh::AddTexCoordBySet(double _u, double _v, unsigned int _setIndex)
 {
-  this->dataPtr->texCoords[_setIndex].push_back(
-      gz::math::Vector2d(_u, _v));
+  auto &texCoords = this->dataPtr->texCoords.Edit()[_setIndex];
+  texCoords.push_back(gz::math::Vector2d(_u, _v));
+  this->dataPtr->Modified(Attribute::TEXCOORDS, texCoords.size() - 1,
+      texCoords.size());
 }
 
 //////////////////////////////////////////////////
@@ -164,67 +247,68 @@ void SubMesh::AddNodeAssignment(const unsigned int _vertex,
 //////////////////////////////////////////////////
 gz::math::Vector3d SubMesh::Vertex(const unsigned int _index) const
 {
-  if (_index >= this->dataPtr->vertices.size())
+  if (_index >= this->dataPtr->vertices.Get().size())
   {
     gzerr << "Index too large" << std::endl;
     return math::Vector3d::Zero;
   }
 
-  return this->dataPtr->vertices[_index];
+  return this->dataPtr->vertices.Get()[_index];
 }
 
 //////////////////////////////////////////////////
 const gz::math::Vector3d* SubMesh::VertexPtr() const
 {
-  return this->dataPtr->vertices.data();
+  return this->dataPtr->vertices.Get().data();
 }
 
 //////////////////////////////////////////////////
 bool SubMesh::HasVertex(const unsigned int _index) const
 {
-  return _index < this->dataPtr->vertices.size();
+  return _index < this->dataPtr->vertices.Get().size();
 }
 
 //////////////////////////////////////////////////
 void SubMesh::SetVertex(const unsigned int _index,
     const gz::math::Vector3d &_v)
 {
-  if (_index >= this->dataPtr->vertices.size())
+  if (_index >= this->dataPtr->vertices.Get().size())
   {
     gzerr << "Index too large" << std::endl;
     return;
   }
 
-  this->dataPtr->vertices[_index] = _v;
+  this->dataPtr->vertices.Edit()[_index] = _v;
+  this->dataPtr->Modified(Attribute::VERTICES, _index, _index + 1u);
 }
 
 //////////////////////////////////////////////////
 gz::math::Vector3d SubMesh::Normal(const unsigned int _index) const
 {
-  if (_index >= this->dataPtr->normals.size())
+  if (_index >= this->dataPtr->normals.Get().size())
   {
     gzerr << "Index too large" << std::endl;
     return math::Vector3d::Zero;
   }
 
-  return this->dataPtr->normals[_index];
+  return this->dataPtr->normals.Get()[_index];
 }
 
 //////////////////////////////////////////////////
 bool SubMesh::HasNormal(const unsigned int _index) const
 {
-  return _index < this->dataPtr->normals.size();
+  return _index < this->dataPtr->normals.Get().size();
 }
 
 //////////////////////////////////////////////////
 bool SubMesh::HasTexCoord(const unsigned int _index) const
 {
-  if (this->dataPtr->texCoords.empty())
+  if (this->dataPtr->texCoords.Get().empty())
     return false;
 
-  unsigned firstSetIndex = this->dataPtr->texCoords.begin()->first;
+  unsigned firstSetIndex = this->dataPtr->texCoords.Get().begin()->first;
 
-  if (this->dataPtr->texCoords.size() > 1u)
+  if (this->dataPtr->texCoords.Get().size() > 1u)
   {
     gzwarn << "Multiple texture coordinate sets exist in submesh: "
             << this->dataPtr->name << ". Checking first set with index: "
@@ -238,8 +322,8 @@ bool SubMesh::HasTexCoord(const unsigned int _index) const
 bool SubMesh::HasTexCoordBySet(unsigned int _index,
     unsigned int _setIndex) const
 {
-  auto it = this->dataPtr->texCoords.find(_setIndex);
-  if (it == this->dataPtr->texCoords.end())
+  auto it = this->dataPtr->texCoords.Get().find(_setIndex);
+  if (it == this->dataPtr->texCoords.Get().end())
     return false;
   return _index < it->second.size();
 }
@@ -254,26 +338,27 @@ bool SubMesh::HasNodeAssignment(const unsigned int _index) const
 void SubMesh::SetNormal(const unsigned int _index,
     const gz::math::Vector3d &_n)
 {
-  if (_index >= this->dataPtr->normals.size())
+  if (_index >= this->dataPtr->normals.Get().size())
   {
     gzerr << "Index too large" << std::endl;
     return;
   }
 
-  this->dataPtr->normals[_index] = _n;
+  this->dataPtr->normals.Edit()[_index] = _n;
+  this->dataPtr->Modified(Attribute::NORMALS, _index, _index + 1u);
 }
 
 //////////////////////////////////////////////////
 gz::math::Vector2d SubMesh::TexCoord(const unsigned int _index) const
 {
-  if (this->dataPtr->texCoords.empty())
+  if (this->dataPtr->texCoords.Get().empty())
   {
     gzerr << "Texture coordinate sets are empty" << std::endl;
     return math::Vector2d::Zero;
   }
-  unsigned firstSetIndex = this->dataPtr->texCoords.begin()->first;
+  unsigned firstSetIndex = this->dataPtr->texCoords.Get().begin()->first;
 
-  if (this->dataPtr->texCoords.size() > 1u)
+  if (this->dataPtr->texCoords.Get().size() > 1u)
   {
     gzwarn << "Multiple texture coordinate sets exist in submesh: "
             << this->dataPtr->name << ". Checking first set with index: "
@@ -287,8 +372,8 @@ gz::math::Vector2d SubMesh::TexCoord(const unsigned int _index) const
 gz::math::Vector2d SubMesh::TexCoordBySet(unsigned int _index,
     unsigned int _setIndex) const
 {
-  auto it = this->dataPtr->texCoords.find(_setIndex);
-  if (it == this->dataPtr->texCoords.end())
+  auto it = this->dataPtr->texCoords.Get().find(_setIndex);
+  if (it == this->dataPtr->texCoords.Get().end())
   {
     gzerr << "Texture coordinate set does not exist: " << _setIndex
            << std::endl;
@@ -309,10 +394,10 @@ void SubMesh::SetTexCoord(const unsigned int _index,
     const gz::math::Vector2d &_t)
 {
   unsigned firstSetIndex = 0u;
-  if (!this->dataPtr->texCoords.empty())
-    firstSetIndex = this->dataPtr->texCoords.begin()->first;
+  if (!this->dataPtr->texCoords.Get().empty())
+    firstSetIndex = this->dataPtr->texCoords.Get().begin()->first;
 
-  if (this->dataPtr->texCoords.size() > 1u)
+  if (this->dataPtr->texCoords.Get().size() > 1u)
   {
     gzwarn << "Multiple texture coordinate sets exist in submesh: "
             << this->dataPtr->name << ". Checking first set with index: "
@@ -326,8 +411,8 @@ void SubMesh::SetTexCoord(const unsigned int _index,
 void SubMesh::SetTexCoordBySet(unsigned int _index,
     const gz::math::Vector2d &_t, unsigned int _setIndex)
 {
-  auto it = this->dataPtr->texCoords.find(_setIndex);
-  if (it == this->dataPtr->texCoords.end())
+  auto it = this->dataPtr->texCoords.Get().find(_setIndex);
+  if (it == this->dataPtr->texCoords.Get().end())
   {
     gzerr << "Texture coordinate set does not exist: " << _setIndex
            << std::endl;
@@ -340,37 +425,39 @@ void SubMesh::SetTexCoordBySet(unsigned int _index,
     return;
   }
 
-  it->second[_index] = _t;
+  this->dataPtr->texCoords.Edit()[_setIndex][_index] = _t;
+  this->dataPtr->Modified(Attribute::TEXCOORDS, _index, _index + 1u);
 }
 
 //////////////////////////////////////////////////
 int SubMesh::Index(const unsigned int _index) const
 {
-  if (_index >= this->dataPtr->indices.size())
+  if (_index >= this->dataPtr->indices.Get().size())
   {
     gzerr << "Index too large" << std::endl;
     return -1;
   }
 
-  return this->dataPtr->indices[_index];
+  return this->dataPtr->indices.Get()[_index];
 }
 
 //////////////////////////////////////////////////
 const unsigned int* SubMesh::IndexPtr() const
 {
-  return this->dataPtr->indices.data();
+  return this->dataPtr->indices.Get().data();
 }
 
 //////////////////////////////////////////////////
 void SubMesh::SetIndex(const unsigned int _index, const unsigned int _i)
 {
-  if (_index >= this->dataPtr->indices.size())
+  if (_index >= this->dataPtr->indices.Get().size())
   {
     gzerr << "Index too large" << std::endl;
     return;
   }
 
-  this->dataPtr->indices[_index] = _i;
+  this->dataPtr->indices.Edit()[_index] = _i;
+  this->dataPtr->Modified(Attribute::INDICES, _index, _index + 1u);
 }
 
 //////////////////////////////////////////////////
@@ -389,7 +476,7 @@ NodeAssignment SubMesh::NodeAssignmentByIndex(
 //////////////////////////////////////////////////
 gz::math::Vector3d SubMesh::Max() const
 {
-  if (this->dataPtr->vertices.empty())
+  if (this->dataPtr->vertices.Get().empty())
     return gz::math::Vector3d::Zero;
 
   gz::math::Vector3d max;
@@ -398,7 +485,7 @@ gz::math::Vector3d SubMesh::Max() const
   max.Y(-gz::math::MAX_F);
   max.Z(-gz::math::MAX_F);
 
-  for (const auto &v : this->dataPtr->vertices)
+  for (const auto &v : this->dataPtr->vertices.Get())
   {
     max.X(std::max(max.X(), v.X()));
     max.Y(std::max(max.Y(), v.Y()));
@@ -411,7 +498,7 @@ gz::math::Vector3d SubMesh::Max() const
 //////////////////////////////////////////////////
 gz::math::Vector3d SubMesh::Min() const
 {
-  if (this->dataPtr->vertices.empty())
+  if (this->dataPtr->vertices.Get().empty())
     return gz::math::Vector3d::Zero;
 
   gz::math::Vector3d min;
@@ -420,7 +507,7 @@ gz::math::Vector3d SubMesh::Min() const
   min.Y(gz::math::MAX_F);
   min.Z(gz::math::MAX_F);
 
-  for (const auto &v : this->dataPtr->vertices)
+  for (const auto &v : this->dataPtr->vertices.Get())
   {
     min.X(std::min(min.X(), v.X()));
     min.Y(std::min(min.Y(), v.Y()));
@@ -433,29 +520,29 @@ gz::math::Vector3d SubMesh::Min() const
 //////////////////////////////////////////////////
 unsigned int SubMesh::VertexCount() const
 {
-  return this->dataPtr->vertices.size();
+  return this->dataPtr->vertices.Get().size();
 }
 
 //////////////////////////////////////////////////
 unsigned int SubMesh::NormalCount() const
 {
-  return this->dataPtr->normals.size();
+  return this->dataPtr->normals.Get().size();
 }
 
 //////////////////////////////////////////////////
 unsigned int SubMesh::IndexCount() const
 {
-  return this->dataPtr->indices.size();
+  return this->dataPtr->indices.Get().size();
 }
 
 //////////////////////////////////////////////////
 unsigned int SubMesh::TexCoordCount() const
 {
-  if (this->dataPtr->texCoords.empty())
+  if (this->dataPtr->texCoords.Get().empty())
     return 0u;
-  unsigned firstSetIndex = this->dataPtr->texCoords.begin()->first;
+  unsigned firstSetIndex = this->dataPtr->texCoords.Get().begin()->first;
 
-  if (this->dataPtr->texCoords.size() > 1u)
+  if (this->dataPtr->texCoords.Get().size() > 1u)
   {
     gzwarn << "Multiple texture coordinate sets exist in submesh: "
             << this->dataPtr->name << ". Checking first set with index: "
@@ -468,8 +555,8 @@ unsigned int SubMesh::TexCoordCount() const
 //////////////////////////////////////////////////
 unsigned int SubMesh::TexCoordCountBySet(unsigned int _setIndex) const
 {
-  auto it = this->dataPtr->texCoords.find(_setIndex);
-  if (it == this->dataPtr->texCoords.end())
+  auto it = this->dataPtr->texCoords.Get().find(_setIndex);
+  if (it == this->dataPtr->texCoords.Get().end())
     return 0u;
 
   return it->second.size();
@@ -478,7 +565,7 @@ unsigned int SubMesh::TexCoordCountBySet(unsigned int _setIndex) const
 //////////////////////////////////////////////////
 unsigned int SubMesh::TexCoordSetCount() const
 {
-  return this->dataPtr->texCoords.size();
+  return this->dataPtr->texCoords.Get().size();
 }
 
 //////////////////////////////////////////////////
@@ -490,10 +577,10 @@ unsigned int SubMesh::NodeAssignmentsCount() const
 //////////////////////////////////////////////////
 unsigned int SubMesh::MaxIndex() const
 {
-  auto maxIter = std::max_element(this->dataPtr->indices.begin(),
-      this->dataPtr->indices.end());
+  auto maxIter = std::max_element(this->dataPtr->indices.Get().begin(),
+      this->dataPtr->indices.Get().end());
 
-  if (maxIter != this->dataPtr->indices.end())
+  if (maxIter != this->dataPtr->indices.Get().end())
     return *maxIter;
 
   return 0;
@@ -521,7 +608,7 @@ std::optional<unsigned int> SubMesh::GetMaterialIndex() const
 //////////////////////////////////////////////////
 bool SubMesh::HasVertex(const gz::math::Vector3d &_v) const
 {
-  for (const auto &v : this->dataPtr->vertices)
+  for (const auto &v : this->dataPtr->vertices.Get())
     if (_v.Equal(v))
       return true;
 
@@ -531,11 +618,11 @@ bool SubMesh::HasVertex(const gz::math::Vector3d &_v) const
 //////////////////////////////////////////////////
 int SubMesh::IndexOfVertex(const gz::math::Vector3d &_v) const
 {
-  for (auto iter = this->dataPtr->vertices.begin();
-      iter != this->dataPtr->vertices.end(); ++iter)
+  for (auto iter = this->dataPtr->vertices.Get().begin();
+      iter != this->dataPtr->vertices.Get().end(); ++iter)
   {
     if (_v.Equal(*iter))
-      return iter - this->dataPtr->vertices.begin();
+      return iter - this->dataPtr->vertices.Get().begin();
   }
   return -1;
 }
@@ -543,7 +630,8 @@ int SubMesh::IndexOfVertex(const gz::math::Vector3d &_v) const
 //////////////////////////////////////////////////
 void SubMesh::FillArrays(double **_vertArr, int **_indArr) const
 {
-  if (this->dataPtr->vertices.empty() || this->dataPtr->indices.empty())
+  if (this->dataPtr->vertices.Get().empty() ||
+      this->dataPtr->indices.Get().empty())
   {
     gzerr << "No vertices or indices\n";
     return;
@@ -555,11 +643,11 @@ void SubMesh::FillArrays(double **_vertArr, int **_indArr) const
   if (*_indArr)
     delete [] *_indArr;
 
-  *_vertArr = new double[this->dataPtr->vertices.size() * 3];
-  *_indArr = new int[this->dataPtr->indices.size()];
+  *_vertArr = new double[this->dataPtr->vertices.Get().size() * 3];
+  *_indArr = new int[this->dataPtr->indices.Get().size()];
 
   unsigned int vi = 0;
-  for (auto &v : this->dataPtr->vertices)
+  for (auto &v : this->dataPtr->vertices.Get())
   {
     (*_vertArr)[vi++] = static_cast<float>(v.X());
     (*_vertArr)[vi++] = static_cast<float>(v.Y());
@@ -567,60 +655,162 @@ void SubMesh::FillArrays(double **_vertArr, int **_indArr) const
   }
 
   unsigned int ii = 0;
-  for (auto &i : this->dataPtr->indices)
+  for (auto &i : this->dataPtr->indices.Get())
   {
     (*_indArr)[ii++] = i;
   }
 }
 
+//////////////////////////////////////////////////
+namespace
+{
+  /// \brief Copy vertex positions to a flat buffer.
+  /// \param[in] _vertices Vertices to copy.
+  /// \param[out] _out Destination buffer.
+  /// \param[in] _size Number of values _out can hold.
+  /// \return False if the buffer is too small.
+  template<typename T>
+  bool fillVertices(const std::vector<gz::math::Vector3d> &_vertices,
+      T *_out, const std::size_t _size)
+  {
+    if (_size < _vertices.size() * 3u)
+      return false;
+
+    for (const auto &v : _vertices)
+    {
+      *_out++ = static_cast<T>(v.X());
+      *_out++ = static_cast<T>(v.Y());
+      *_out++ = static_cast<T>(v.Z());
+    }
+    return true;
+  }
+
+  /// \brief Copy indices to a buffer, adding an offset.
+  /// \param[in] _indices Indices to copy.
+  /// \param[out] _out Destination buffer.
+  /// \param[in] _size Number of values _out can hold.
+  /// \param[in] _offset Value added to every index.
+  /// \return False if the buffer is too small or an index does not fit.
+  template<typename T>
+  bool fillIndices(const std::vector<unsigned int> &_indices,
+      T *_out, const std::size_t _size, const unsigned int _offset)
+  {
+    if (_size < _indices.size())
+      return false;
+
+    if (!_indices.empty())
+    {
+      const uint64_t maxIndex = static_cast<uint64_t>(
+          *std::max_element(_indices.begin(), _indices.end())) + _offset;
+      if (maxIndex > std::numeric_limits<T>::max())
+        return false;
+    }
+
+    for (const auto i : _indices)
+      *_out++ = static_cast<T>(i + _offset);
+    return true;
+  }
+
+  /// \brief Overwrite or append consecutive elements of a vector.
+  /// \param[in,out] _data Vector to update.
+  /// \param[in] _start Position of the first element to set.
+  /// \param[in] _values New values.
+  /// \param[in] _count Number of values.
+  /// \return False if _start is past the end.
+  template<typename T>
+  bool setRange(std::vector<T> &_data, const unsigned int _start,
+      const T *_values, const std::size_t _count)
+  {
+    if (_start > _data.size())
+    {
+      gzerr << "Start index [" << _start << "] is past the end ["
+            << _data.size() << "]" << std::endl;
+      return false;
+    }
+
+    if (_start + _count > _data.size())
+      _data.resize(_start + _count);
+    std::copy(_values, _values + _count, _data.begin() + _start);
+    return true;
+  }
+}
+
+//////////////////////////////////////////////////
+bool SubMesh::FillVertices(float *_vertices, const std::size_t _size) const
+{
+  return fillVertices(this->dataPtr->vertices.Get(), _vertices, _size);
+}
+
+//////////////////////////////////////////////////
+bool SubMesh::FillVertices(double *_vertices, const std::size_t _size) const
+{
+  return fillVertices(this->dataPtr->vertices.Get(), _vertices, _size);
+}
+
+//////////////////////////////////////////////////
+bool SubMesh::FillIndices(uint16_t *_indices, const std::size_t _size,
+    const unsigned int _offset) const
+{
+  return fillIndices(this->dataPtr->indices.Get(), _indices, _size, _offset);
+}
+
+//////////////////////////////////////////////////
+bool SubMesh::FillIndices(uint32_t *_indices, const std::size_t _size,
+    const unsigned int _offset) const
+{
+  return fillIndices(this->dataPtr->indices.Get(), _indices, _size, _offset);
+}
+
 //////////////////////////////////////////////////
 void SubMesh::RecalculateNormals()
 {
-  if (this->dataPtr->normals.size() < 3u)
+  if (this->dataPtr->normals.Get().size() < 3u)
     return;
 
+  const auto &vertices = this->dataPtr->vertices.Get();
+  const auto &indices = this->dataPtr->indices.Get();
+  auto &normals = this->dataPtr->normals.Edit();
+
   // Reset all the normals
-  for (auto &n : this->dataPtr->normals)
+  for (auto &n : normals)
     n.Set(0, 0, 0);
 
-  if (this->dataPtr->normals.size() != this->dataPtr->vertices.size())
-    this->dataPtr->normals.resize(this->dataPtr->vertices.size());
+  if (normals.size() != vertices.size())
+    normals.resize(vertices.size());
 
   // For each face, which is defined by three indices, calculate the normals
-  for (unsigned int i = 0; i < this->dataPtr->indices.size(); i+= 3)
-  {
-    gz::math::Vector3d v1 =
-        this->dataPtr->vertices[this->dataPtr->indices[i]];
-    gz::math::Vector3d v2 =
-        this->dataPtr->vertices[this->dataPtr->indices[i+1]];
-    gz::math::Vector3d v3 =
-        this->dataPtr->vertices[this->dataPtr->indices[i+2]];
+  for (unsigned int i = 0; i < indices.size(); i+= 3)
+  {
+    gz::math::Vector3d v1 = vertices[indices[i]];
+    gz::math::Vector3d v2 = vertices[indices[i+1]];
+    gz::math::Vector3d v3 = vertices[indices[i+2]];
     gz::math::Vector3d n = gz::math::Vector3d::Normal(v1, v2, v3);
 
-    for (unsigned int j = 0; j < this->dataPtr->vertices.size(); ++j)
+    for (unsigned int j = 0; j < vertices.size(); ++j)
     {
-      gz::math::Vector3d v = this->dataPtr->vertices[j];
+      gz::math::Vector3d v = vertices[j];
       if (v == v1 || v == v2 || v == v3)
       {
-        this->dataPtr->normals[j] += n;
+        normals[j] += n;
       }
     }
   }
 
   // Normalize the results
-  for (auto &n : this->dataPtr->normals)
+  for (auto &n : normals)
   {
     n.Normalize();
   }
+  this->dataPtr->ModifiedAll(Attribute::NORMALS, normals.size());
 }
 
 //////////////////////////////////////////////////
 void SubMesh::GenSphericalTexCoord(const gz::math::Vector3d &_center)
 {
-  if (this->dataPtr->texCoords.empty())
+  if (this->dataPtr->texCoords.Get().empty())
     return;
 
-  unsigned firstSetIndex = this->dataPtr->texCoords.begin()->first;
+  unsigned firstSetIndex = this->dataPtr->texCoords.Get().begin()->first;
   this->GenSphericalTexCoordBySet(_center, firstSetIndex);
 }
 
@@ -628,9 +818,9 @@ void SubMesh::GenSphericalTexCoord(const gz::math::Vector3d &_center)
 void SubMesh::GenSphericalTexCoordBySet(const gz::math::Vector3d &_center,
     unsigned int _setIndex)
 {
-  this->dataPtr->texCoords[_setIndex].clear();
+  this->dataPtr->texCoords.Edit()[_setIndex].clear();
 
-  for (const auto &vert : this->dataPtr->vertices)
+  for (const auto &vert : this->dataPtr->vertices.Get())
   {
     // generate projected texture coordinates, projected from center
     //  x, y, z for computing texture coordinate projections
@@ -645,20 +835,26 @@ void SubMesh::GenSphericalTexCoordBySet(const gz::math::Vector3d &_center,
     double v = acos(t) / GZ_PI;
     this->AddTexCoordBySet(u, v, _setIndex);
   }
+  this->dataPtr->ModifiedAll(Attribute::TEXCOORDS,
+      this->dataPtr->texCoords.Get().at(_setIndex).size());
 }
 
 //////////////////////////////////////////////////
 void SubMesh::Scale(const gz::math::Vector3d &_factor)
 {
-  for (auto &v : this->dataPtr->vertices)
+  for (auto &v : this->dataPtr->vertices.Edit())
     v *= _factor;
+  this->dataPtr->ModifiedAll(Attribute::VERTICES,
+      this->dataPtr->vertices.Get().size());
 }
 
 //////////////////////////////////////////////////
 void SubMesh::Scale(const double &_factor)
 {
-  for (auto &v : this->dataPtr->vertices)
+  for (auto &v : this->dataPtr->vertices.Edit())
     v *= _factor;
+  this->dataPtr->ModifiedAll(Attribute::VERTICES,
+      this->dataPtr->vertices.Get().size());
 }
 
 //////////////////////////////////////////////////
@@ -675,8 +871,10 @@ void SubMesh::Center(const gz::math::Vector3d &_center)
 //////////////////////////////////////////////////
 void SubMesh::Translate(const gz::math::Vector3d &_vec)
 {
-  for (auto &v : this->dataPtr->vertices)
+  for (auto &v : this->dataPtr->vertices.Edit())
     v += _vec;
+  this->dataPtr->ModifiedAll(Attribute::VERTICES,
+      this->dataPtr->vertices.Get().size());
 }
 
 //////////////////////////////////////////////////
@@ -697,16 +895,15 @@ double SubMesh::Volume() const
   double volume = 0.0;
   if (this->dataPtr->primitiveType == SubMesh::TRIANGLES)
   {
-    if (this->dataPtr->indices.size() % 3 == 0)
+    const auto &vertices = this->dataPtr->vertices.Get();
+    const auto &indices = this->dataPtr->indices.Get();
+    if (indices.size() % 3 == 0)
     {
-      for (unsigned int idx = 0; idx < this->dataPtr->indices.size(); idx += 3)
+      for (unsigned int idx = 0; idx < indices.size(); idx += 3)
       {
-        gz::math::Vector3d v1 =
-          this->dataPtr->vertices[this->dataPtr->indices[idx]];
-        gz::math::Vector3d v2 =
-          this->dataPtr->vertices[this->dataPtr->indices[idx+1]];
-        gz::math::Vector3d v3 =
-          this->dataPtr->vertices[this->dataPtr->indices[idx+2]];
+        gz::math::Vector3d v1 = vertices[indices[idx]];
+        gz::math::Vector3d v2 = vertices[indices[idx+1]];
+        gz::math::Vector3d v3 = vertices[indices[idx+2]];
 
         volume += std::abs(v1.Cross(v2).Dot(v3) / 6.0);
       }
@@ -725,9 +922,92 @@ double SubMesh::Volume() const
   return volume;
 }
 
+//////////////////////////////////////////////////
+bool SubMesh::SetVertices(const unsigned int _start,
+    const gz::math::Vector3d *_vertices, const std::size_t _count)
+{
+  if (!setRange(this->dataPtr->vertices.Edit(), _start, _vertices, _count))
+    return false;
+  this->dataPtr->Modified(Attribute::VERTICES, _start, _start + _count);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SubMesh::SetNormals(const unsigned int _start,
+    const gz::math::Vector3d *_normals, const std::size_t _count)
+{
+  if (!setRange(this->dataPtr->normals.Edit(), _start, _normals, _count))
+    return false;
+  this->dataPtr->Modified(Attribute::NORMALS, _start, _start + _count);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SubMesh::SetTexCoordsBySet(const unsigned int _start,
+    const gz::math::Vector2d *_texCoords, const std::size_t _count,
+    const unsigned int _setIndex)
+{
+  if (_start != 0 && this->dataPtr->texCoords.Get().find(_setIndex) ==
+      this->dataPtr->texCoords.Get().end())
+  {
+    gzerr << "Texture coordinate set does not exist: " << _setIndex
+          << std::endl;
+    return false;
+  }
+  auto &texCoords = this->dataPtr->texCoords.Edit();
+  auto it = texCoords.emplace(_setIndex,
+      std::vector<gz::math::Vector2d>()).first;
+
+  if (!setRange(it->second, _start, _texCoords, _count))
+    return false;
+  this->dataPtr->Modified(Attribute::TEXCOORDS, _start, _start + _count);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SubMesh::SetIndices(const unsigned int _start,
+    const unsigned int *_indices, const std::size_t _count)
+{
+  if (!setRange(this->dataPtr->indices.Edit(), _start, _indices, _count))
+    return false;
+  this->dataPtr->Modified(Attribute::INDICES, _start, _start + _count);
+  return true;
+}
+
+//////////////////////////////////////////////////
+uint64_t SubMesh::Version() const
+{
+  return this->dataPtr->version;
+}
+
+//////////////////////////////////////////////////
+bool SubMesh::DirtyRange(const Attribute _attribute, unsigned int &_begin,
+    unsigned int &_end) const
+{
+  const auto &range =
+      this->dataPtr->dirty[static_cast<std::size_t>(_attribute)];
+  if (range.begin >= range.end)
+    return false;
+  _begin = range.begin;
+  _end = range.end;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void SubMesh::ClearDirty()
+{
+  this->dataPtr->dirty.fill(Implementation::Range());
+}
+
+//////////////////////////////////////////////////
+void SubMesh::ClearDirty(const Attribute _attribute)
+{
+  this->dataPtr->dirty[static_cast<std::size_t>(_attribute)] =
+      Implementation::Range();
+}
+
 //////////////////////////////////////////////////
 NodeAssignment::NodeAssignment()
   : vertexIndex(0), nodeIndex(0), weight(0.0)
 {
 }
-
@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <vector>
+
 #include "gz/math/Vector3.hh"
 #include "gz/common/Mesh.hh"
 #include "gz/common/SubMesh.hh"
@@ -353,8 +356,9 @@ TEST_F(SubMeshTest, SubMesh)
   // recalculate normal and verify they are different
   submesh->RecalculateNormals();
 
-  EXPECT_NE(submeshCopy->VertexPtr(), submesh->VertexPtr());
-  EXPECT_NE(submeshCopy->IndexPtr(), submesh->IndexPtr());
+  // Vertices and indices were not modified, they are still shared
+  EXPECT_EQ(submeshCopy->VertexPtr(), submesh->VertexPtr());
+  EXPECT_EQ(submeshCopy->IndexPtr(), submesh->IndexPtr());
 
   for (unsigned int i = 0; i < submeshCopy->NormalCount(); ++i)
     EXPECT_NE(submeshCopy->Normal(i), submesh->Normal(i));
@@ -585,3 +589,177 @@ TEST_F(SubMeshTest, Volume)
   boxSub.AddIndex(1);
   EXPECT_DOUBLE_EQ(0.0, boxSub.Volume());
 }
+
+/////////////////////////////////////////////////
+TEST_F(SubMeshTest, FillBuffers)
+{
+  common::SubMesh submesh;
+  submesh.SetPrimitiveType(common::SubMesh::TRIANGLES);
+  submesh.AddVertex(0.1, 0.2, 0.3);
+  submesh.AddVertex(1, 2, 3);
+  submesh.AddVertex(-1, -2, -3);
+  submesh.AddIndex(0);
+  submesh.AddIndex(2);
+  submesh.AddIndex(1);
+
+  // Too small
+  std::vector<double> vertices(8, -5.0);
+  EXPECT_FALSE(submesh.FillVertices(vertices.data(), vertices.size()));
+  EXPECT_DOUBLE_EQ(-5.0, vertices[0]);
+
+  // Doubles are copied without loss of precision
+  vertices.resize(9);
+  ASSERT_TRUE(submesh.FillVertices(vertices.data(), vertices.size()));
+  EXPECT_DOUBLE_EQ(0.1, vertices[0]);
+  EXPECT_DOUBLE_EQ(0.3, vertices[2]);
+  EXPECT_DOUBLE_EQ(-3.0, vertices[8]);
+
+  std::vector<float> floats(9);
+  ASSERT_TRUE(submesh.FillVertices(floats.data(), floats.size()));
+  EXPECT_FLOAT_EQ(0.2f, floats[1]);
+  EXPECT_FLOAT_EQ(2.0f, floats[4]);
+
+  std::vector<uint32_t> indices(3);
+  EXPECT_FALSE(submesh.FillIndices(indices.data(), 2));
+  ASSERT_TRUE(submesh.FillIndices(indices.data(), indices.size()));
+  EXPECT_EQ((std::vector<uint32_t>{0, 2, 1}), indices);
+  ASSERT_TRUE(submesh.FillIndices(indices.data(), indices.size(), 100));
+  EXPECT_EQ((std::vector<uint32_t>{100, 102, 101}), indices);
+
+  // 16 bit indices that would overflow are rejected
+  std::vector<uint16_t> shorts(3, 7);
+  ASSERT_TRUE(submesh.FillIndices(shorts.data(), shorts.size(), 65533));
+  EXPECT_EQ((std::vector<uint16_t>{65533, 65535, 65534}), shorts);
+  EXPECT_FALSE(submesh.FillIndices(shorts.data(), shorts.size(), 65534));
+  EXPECT_EQ((std::vector<uint16_t>{65533, 65535, 65534}), shorts);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SubMeshTest, DirtyRanges)
+{
+  using Attribute = common::SubMesh::Attribute;
+  common::SubMesh submesh;
+  unsigned int begin = 100;
+  unsigned int end = 100;
+  EXPECT_FALSE(submesh.DirtyRange(Attribute::VERTICES, begin, end));
+  EXPECT_EQ(100u, begin);
+  const uint64_t version = submesh.Version();
+
+  for (int i = 0; i < 4; ++i)
+    submesh.AddVertex(i, i, i);
+  EXPECT_LT(version, submesh.Version());
+  ASSERT_TRUE(submesh.DirtyRange(Attribute::VERTICES, begin, end));
+  EXPECT_EQ(0u, begin);
+  EXPECT_EQ(4u, end);
+  EXPECT_FALSE(submesh.DirtyRange(Attribute::INDICES, begin, end));
+
+  submesh.ClearDirty();
+  EXPECT_FALSE(submesh.DirtyRange(Attribute::VERTICES, begin, end));
+
+  submesh.SetVertex(2, math::Vector3d(5, 5, 5));
+  ASSERT_TRUE(submesh.DirtyRange(Attribute::VERTICES, begin, end));
+  EXPECT_EQ(2u, begin);
+  EXPECT_EQ(3u, end);
+
+  // Overwrite the last vertex and append two more
+  std::vector<math::Vector3d> vertices{
+    math::Vector3d(7, 7, 7), math::Vector3d(8, 8, 8),
+    math::Vector3d(9, 9, 9)};
+  ASSERT_TRUE(submesh.SetVertices(3, vertices.data(), vertices.size()));
+  EXPECT_EQ(6u, submesh.VertexCount());
+  EXPECT_EQ(math::Vector3d(7, 7, 7), submesh.Vertex(3));
+  EXPECT_EQ(math::Vector3d(9, 9, 9), submesh.Vertex(5));
+  ASSERT_TRUE(submesh.DirtyRange(Attribute::VERTICES, begin, end));
+  EXPECT_EQ(2u, begin);
+  EXPECT_EQ(6u, end);
+
+  // Gaps are not allowed
+  const uint64_t before = submesh.Version();
+  EXPECT_FALSE(submesh.SetVertices(7, vertices.data(), vertices.size()));
+  EXPECT_EQ(6u, submesh.VertexCount());
+  EXPECT_EQ(before, submesh.Version());
+
+  std::vector<unsigned int> indices{0, 1, 2, 3, 4, 5};
+  ASSERT_TRUE(submesh.SetIndices(0, indices.data(), indices.size()));
+  EXPECT_EQ(6u, submesh.IndexCount());
+  ASSERT_TRUE(submesh.SetIndices(4, indices.data(), 1));
+  EXPECT_EQ(0, submesh.Index(4));
+  ASSERT_TRUE(submesh.DirtyRange(Attribute::INDICES, begin, end));
+  EXPECT_EQ(0u, begin);
+  EXPECT_EQ(6u, end);
+
+  std::vector<math::Vector3d> normals(6, math::Vector3d::UnitZ);
+  ASSERT_TRUE(submesh.SetNormals(0, normals.data(), normals.size()));
+  EXPECT_EQ(6u, submesh.NormalCount());
+
+  std::vector<math::Vector2d> texCoords(6, math::Vector2d(0.5, 0.5));
+  EXPECT_FALSE(submesh.SetTexCoordsBySet(1, texCoords.data(),
+      texCoords.size(), 1));
+  ASSERT_TRUE(submesh.SetTexCoordsBySet(0, texCoords.data(),
+      texCoords.size(), 1));
+  EXPECT_EQ(6u, submesh.TexCoordCountBySet(1));
+  ASSERT_TRUE(submesh.DirtyRange(Attribute::TEXCOORDS, begin, end));
+  EXPECT_EQ(0u, begin);
+  EXPECT_EQ(6u, end);
+
+  // Clearing one attribute leaves the others dirty
+  submesh.ClearDirty(Attribute::INDICES);
+  EXPECT_FALSE(submesh.DirtyRange(Attribute::INDICES, begin, end));
+  EXPECT_TRUE(submesh.DirtyRange(Attribute::NORMALS, begin, end));
+
+  // Transforms touch every vertex
+  submesh.ClearDirty();
+  submesh.Translate(math::Vector3d(1, 0, 0));
+  ASSERT_TRUE(submesh.DirtyRange(Attribute::VERTICES, begin, end));
+  EXPECT_EQ(0u, begin);
+  EXPECT_EQ(6u, end);
+  EXPECT_FALSE(submesh.DirtyRange(Attribute::NORMALS, begin, end));
+}
+
+/////////////////////////////////////////////////
+TEST_F(SubMeshTest, CopyOnWrite)
+{
+  common::SubMesh submesh;
+  for (int i = 0; i < 3; ++i)
+  {
+    submesh.AddVertex(i, 0, 0);
+    submesh.AddNormal(0, 0, 1);
+    submesh.AddIndex(i);
+    submesh.AddTexCoord(i, 0);
+  }
+
+  // Copies share their buffers
+  common::SubMesh copy = submesh;
+  EXPECT_EQ(submesh.VertexPtr(), copy.VertexPtr());
+  EXPECT_EQ(submesh.IndexPtr(), copy.IndexPtr());
+
+  // Modifying a copy only copies the modified buffer
+  copy.Scale(2.0);
+  EXPECT_NE(submesh.VertexPtr(), copy.VertexPtr());
+  EXPECT_EQ(submesh.IndexPtr(), copy.IndexPtr());
+  EXPECT_EQ(math::Vector3d(1, 0, 0), submesh.Vertex(1));
+  EXPECT_EQ(math::Vector3d(2, 0, 0), copy.Vertex(1));
+
+  // Once unshared, the buffer is modified in place
+  const math::Vector3d *vertices = copy.VertexPtr();
+  copy.SetVertex(0, math::Vector3d(-1, 0, 0));
+  EXPECT_EQ(vertices, copy.VertexPtr());
+
+  copy.SetIndex(0, 2);
+  EXPECT_EQ(0, submesh.Index(0));
+  EXPECT_EQ(2, copy.Index(0));
+
+  copy.SetTexCoord(0, math::Vector2d(5, 5));
+  EXPECT_EQ(math::Vector2d(0, 0), submesh.TexCoord(0));
+  EXPECT_EQ(math::Vector2d(5, 5), copy.TexCoord(0));
+
+  copy.RecalculateNormals();
+  copy.AddNormal(1, 0, 0);
+  EXPECT_EQ(3u, submesh.NormalCount());
+  EXPECT_EQ(4u, copy.NormalCount());
+
+  // Assignment shares again
+  copy = submesh;
+  EXPECT_EQ(submesh.VertexPtr(), copy.VertexPtr());
+  EXPECT_EQ(math::Vector3d(1, 0, 0), copy.Vertex(1));
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_COMMON_ASSETCACHE_HH_
+#define GZ_COMMON_ASSETCACHE_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <gz/common/Export.hh>
+
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz
+{
+  namespace common
+  {
+    /// \class AssetCache AssetCache.hh gz/common/AssetCache.hh
+    /// \brief A content-addressed cache of files on the local disk, for
+    /// downloaded or derived assets such as converted meshes or decoded
+    /// textures.
+    ///
+    /// Blobs are stored under a key, either the SHA1 of their content or a
+    /// hash chosen by the caller, e.g. the hash of the source asset and of
+    /// the conversion parameters. Blobs are written to a temporary file
+    /// which is then renamed, so a blob is either complete or absent.
+    ///
+    /// The cache directory can be shared by several processes. An index
+    /// of the blobs with their size and last access time is kept in the
+    /// directory and updated under a file lock. When the total size
+    /// exceeds the budget, the least recently used blobs are removed.
+    ///
+    /// ~~~
+    /// gz::common::AssetCache cache(cacheDir, 1024 * 1024 * 1024);
+    /// std::string key = gz::common::sha1(sourcePath + options);
+    /// std::string path = cache.Path(key);
+    /// if (path.empty())
+    /// {
+    ///   cache.Insert(key, convert(sourcePath, options));
+    ///   path = cache.Path(key);
+    /// }
+    /// ~~~
+    class GZ_COMMON_VISIBLE AssetCache
+    {
+      /// \brief Open or create a cache.
+      /// \param[in] _root Directory of the cache, created if needed.
+      /// \param[in] _maxBytes Size budget of the blobs, in bytes. Zero for
+      /// no limit.
+      public: explicit AssetCache(const std::string &_root,
+                                  uintmax_t _maxBytes = 0);
+
+      /// \brief Check whether the cache directory could be opened. A cache
+      /// whose index was written with an unknown version, e.g. by a newer
+      /// release, is left untouched and is not valid.
+      /// \return True if the cache can be used.
+      public: bool Valid() const;
+
+      /// \brief Get the directory of the cache.
+      /// \return Cache directory.
+      public: std::string Root() const;
+
+      /// \brief Get the size budget.
+      /// \return Budget in bytes, zero for no limit.
+      public: uintmax_t MaxBytes() const;
+
+      /// \brief Set the size budget. Blobs are evicted right away if the
+      /// cache is over the new budget.
+      /// \param[in] _maxBytes Budget in bytes, zero for no limit.
+      public: void SetMaxBytes(uintmax_t _maxBytes);
+
+      /// \brief Check whether a key is a valid cache key: 2 to 128 ASCII
+      /// letters, digits, '-' or '_'.
+      /// \param[in] _key Key to check.
+      /// \return True if the key is valid.
+      public: static bool ValidKey(const std::string &_key);
+
+      /// \brief Store a blob under the SHA1 of its content.
+      /// \param[in] _data Content of the blob.
+      /// \return Key of the blob, empty on failure.
+      public: std::string Insert(const std::string &_data);
+
+      /// \brief Store a blob under a key. An existing blob with the same
+      /// key is replaced.
+      /// \param[in] _key Key of the blob.
+      /// \param[in] _data Content of the blob.
+      /// \return True on success.
+      public: bool Insert(const std::string &_key, const std::string &_data);
+
+      /// \brief Store a copy of a file under a key. An existing blob with
+      /// the same key is replaced.
+      /// \param[in] _key Key of the blob.
+      /// \param[in] _path File to copy.
+      /// \return True on success.
+      public: bool InsertFile(const std::string &_key,
+                              const std::string &_path);
+
+      /// \brief Check whether a blob is in the cache, without updating its
+      /// access time.
+      /// \param[in] _key Key of the blob.
+      /// \return True if the blob is in the cache.
+      public: bool Contains(const std::string &_key) const;
+
+      /// \brief Get the path of a blob and mark it as recently used. The
+      /// file must not be modified. On POSIX systems a file opened before
+      /// its eviction stays readable.
+      /// \param[in] _key Key of the blob.
+      /// \return Path of the blob, empty if it is not in the cache.
+      public: std::string Path(const std::string &_key);
+
+      /// \brief Read a blob and mark it as recently used.
+      /// \param[in] _key Key of the blob.
+      /// \param[out] _data Content of the blob.
+      /// \return False if the blob is not in the cache or could not be
+      /// read.
+      public: bool Read(const std::string &_key, std::string &_data);
+
+      /// \brief Remove a blob.
+      /// \param[in] _key Key of the blob.
+      /// \return True if the blob was in the cache.
+      public: bool Remove(const std::string &_key);
+
+      /// \brief Remove all blobs.
+      public: void Clear();
+
+      /// \brief Remove the least recently used blobs until the cache is
+      /// within its budget. Called by the insert functions.
+      /// \return Number of bytes removed.
+      public: uintmax_t Evict();
+
+      /// \brief Get the number of blobs.
+      /// \return Number of blobs.
+      public: std::size_t Count() const;
+
+      /// \brief Get the total size of the blobs.
+      /// \return Size in bytes.
+      public: uintmax_t Size() const;
+
+      /// \brief Pointer to private data.
+      GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+    };
+  }
+}
+#endif
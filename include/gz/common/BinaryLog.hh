@@ -0,0 +1,309 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_COMMON_BINARYLOG_HH_
+#define GZ_COMMON_BINARYLOG_HH_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+#include <gz/common/Export.hh>
+
+#include <gz/utils/ImplPtr.hh>
+
+/// \brief Write a structured record to a BinaryLog.
+///
+/// The call site (file, line, level and format) is registered once, the
+/// first time the statement executes. Afterwards each execution only
+/// copies the raw argument values into a fixed-size record; no text
+/// formatting happens until the log is decoded offline.
+///
+/// The format uses "{}" as placeholder for each argument. Supported
+/// argument types are integers, floating point numbers, bool, char,
+/// C strings and std::string. Strings are truncated to fit in the record.
+///
+/// ~~~
+/// gzbinlog(myLog, 3, "step {} took {} ms", iteration, ms);
+/// ~~~
+///
+/// \param[in] _log BinaryLog to write into.
+/// \param[in] _level Verbosity level of the record (1: error, 2: warning,
+/// 3: message, 4: debug).
+/// \param[in] ... Format string literal followed by the arguments.
+#define gzbinlog(_log, _level, ...) \
+  do \
+  { \
+    static const uint32_t gzBinaryLogCallSite = \
+      gz::common::BinaryLog::RegisterCallSite(__FILE__, __LINE__, _level, \
+          gz::common::BinaryLog::FormatOf(__VA_ARGS__)); \
+    (_log).WriteArgs(_level, gzBinaryLogCallSite, __VA_ARGS__); \
+  } while (false)
+
+namespace gz
+{
+  namespace common
+  {
+    /// \brief A fixed-size record of a BinaryLog, as stored on disk.
+    struct BinaryLogRecord
+    {
+      /// \brief Size of a record in bytes.
+      static constexpr std::size_t kSize = 128;
+
+      /// \brief Size of the argument payload in bytes.
+      static constexpr std::size_t kPayloadSize = 96;
+
+      /// \brief Flag set on all but the last record of a text message that
+      /// spans several records.
+      static constexpr uint8_t kContinued = 0x01;
+
+      /// \brief Flag set when the arguments did not fit in the payload.
+      static constexpr uint8_t kTruncated = 0x02;
+
+      /// \brief Sequence number plus one. Zero while the record is being
+      /// written, so torn records can be detected by the decoder.
+      std::atomic<uint64_t> sequence;
+
+      /// \brief Wall time in nanoseconds since the epoch.
+      uint64_t timeNs;
+
+      /// \brief Identifier of the writing thread.
+      uint64_t threadId;
+
+      /// \brief Call site identifier, see BinaryLog::RegisterCallSite.
+      uint32_t callSite;
+
+      /// \brief Verbosity level.
+      uint8_t level;
+
+      /// \brief Combination of kContinued and kTruncated.
+      uint8_t flags;
+
+      /// \brief Number of bytes used in payload.
+      uint16_t payloadSize;
+
+      /// \brief Encoded arguments, or raw text for text records.
+      char payload[kPayloadSize];
+    };
+
+    /// \brief Output format of decodeBinaryLog.
+    enum class BinaryLogFormat
+    {
+      /// \brief One human readable line per record.
+      TEXT,
+
+      /// \brief One JSON object per line (JSON Lines).
+      JSON
+    };
+
+    /// \class BinaryLog BinaryLog.hh gz/common/BinaryLog.hh
+    /// \brief A structured, machine-parseable log sink.
+    ///
+    /// Records are written to a memory-mapped ring file: a header followed
+    /// by a fixed number of BinaryLogRecord slots. Writers reserve slots
+    /// with a single atomic increment, so logging costs a few copies and no
+    /// locks, formatting or system calls. When the ring is full, the oldest
+    /// records are overwritten.
+    ///
+    /// Call sites are described once in a sidecar text file, "<path>.sites",
+    /// which decodeBinaryLog uses to render the records.
+    ///
+    /// A BinaryLog can also be attached to Console with
+    /// Console::SetBinaryLog, in which case all gzerr/gzwarn/gzmsg/gzdbg
+    /// messages are stored as text records as well.
+    class GZ_COMMON_VISIBLE BinaryLog
+    {
+      /// \brief Call site identifier used for text records.
+      public: static constexpr uint32_t kTextCallSite = 0;
+
+      /// \brief Constructor.
+      public: BinaryLog();
+
+      /// \brief Destructor. Closes the log.
+      public: ~BinaryLog();
+
+      /// \brief Open a log file, creating or replacing it.
+      /// \param[in] _path Path of the ring file.
+      /// \param[in] _capacity Number of records kept in the ring.
+      /// \return True if the file was opened and mapped.
+      public: bool Open(const std::string &_path,
+                        const uint64_t _capacity = 65536u);
+
+      /// \brief Flush and close the log file.
+      public: void Close();
+
+      /// \brief Write mapped records to disk.
+      public: void Flush();
+
+      /// \brief Get whether the log is open.
+      /// \return True if records can be written.
+      public: bool Valid() const;
+
+      /// \brief Get the path of the ring file.
+      /// \return Path of the log, empty if not open.
+      public: std::string Path() const;
+
+      /// \brief Get the number of records written since the log was opened,
+      /// including overwritten ones.
+      /// \return Number of records written.
+      public: uint64_t RecordCount() const;
+
+      /// \brief Register a call site. Identifiers are process-wide and
+      /// the description is added to the sidecar file of every open log.
+      /// \param[in] _file Source file of the call site.
+      /// \param[in] _line Line of the call site.
+      /// \param[in] _level Verbosity level of the call site.
+      /// \param[in] _format Format string with "{}" placeholders.
+      /// \return Identifier of the call site.
+      public: static uint32_t RegisterCallSite(const char *_file,
+                  const int _line, const int _level, const char *_format);
+
+      /// \brief Write a text message, split over as many records as needed.
+      /// Messages that need more records than the log capacity are not
+      /// written.
+      /// \param[in] _level Verbosity level.
+      /// \param[in] _text Message text.
+      /// \return True if the message was written.
+      public: bool WriteText(const int _level, const std::string &_text);
+
+      /// \brief Write a record with the given arguments. Prefer the gzbinlog
+      /// macro, which registers the call site.
+      /// \param[in] _level Verbosity level.
+      /// \param[in] _callSite Call site identifier.
+      /// \param[in] _format Format string, only used at registration.
+      /// \param[in] _args Arguments to store in the record.
+      public: template<typename... Args>
+              void WriteArgs(const int _level, const uint32_t _callSite,
+                             const char *_format, const Args &... _args);
+
+      /// \brief Return the format string of a gzbinlog statement.
+      /// \param[in] _format Format string.
+      /// \return _format
+      public: template<typename... Args>
+              static constexpr const char *FormatOf(const char *_format,
+                                                    const Args &...)
+              {
+                return _format;
+              }
+
+      /// \brief Reserve a record slot and fill its header.
+      /// \param[in] _level Verbosity level.
+      /// \param[in] _callSite Call site identifier.
+      /// \param[out] _sequence Sequence number of the record.
+      /// \return Record to fill, nullptr if the log is not open.
+      /// Commit must be called once the payload is written.
+      private: BinaryLogRecord *Reserve(const int _level,
+                                        const uint32_t _callSite,
+                                        uint64_t &_sequence);
+
+      /// \brief Publish a record filled after Reserve.
+      /// \param[in] _record Record to publish.
+      /// \param[in] _sequence Sequence number returned by Reserve.
+      private: static void Commit(BinaryLogRecord *_record,
+                                  const uint64_t _sequence);
+
+      /// \brief Encode one argument into a payload.
+      /// \param[in,out] _record Record being filled.
+      /// \param[in] _tag Type tag of the argument.
+      /// \param[in] _data Pointer to the raw bytes.
+      /// \param[in] _size Number of raw bytes.
+      private: static void Encode(BinaryLogRecord &_record, const char _tag,
+                                  const void *_data, const std::size_t _size);
+
+      /// \brief Encode an argument of any supported type.
+      /// \param[in,out] _record Record being filled.
+      /// \param[in] _value Argument value.
+      private: template<typename T>
+               static void EncodeArg(BinaryLogRecord &_record,
+                                     const T &_value);
+
+      /// \brief Pointer to private data.
+      GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+    };
+
+    /// \brief Render a BinaryLog file as text.
+    /// \param[in] _path Path of the ring file. The call sites are read from
+    /// "<_path>.sites".
+    /// \param[out] _out Stream to write into.
+    /// \param[in] _format Output format.
+    /// \return True if the file could be decoded.
+    bool GZ_COMMON_VISIBLE decodeBinaryLog(const std::string &_path,
+        std::ostream &_out,
+        const BinaryLogFormat _format = BinaryLogFormat::TEXT);
+
+    //////////////////////////////////////////////////
+    template<typename... Args>
+    void BinaryLog::WriteArgs(const int _level, const uint32_t _callSite,
+                              const char *, const Args &... _args)
+    {
+      uint64_t sequence;
+      BinaryLogRecord *record = this->Reserve(_level, _callSite, sequence);
+      if (!record)
+        return;
+      (EncodeArg(*record, _args), ...);
+      Commit(record, sequence);
+    }
+
+    //////////////////////////////////////////////////
+    template<typename T>
+    void BinaryLog::EncodeArg(BinaryLogRecord &_record, const T &_value)
+    {
+      using U = std::decay_t<T>;
+      if constexpr (std::is_same_v<U, bool>)
+      {
+        const uint8_t v = _value ? 1 : 0;
+        Encode(_record, 'b', &v, sizeof(v));
+      }
+      else if constexpr (std::is_same_v<U, char>)
+      {
+        Encode(_record, 'c', &_value, sizeof(_value));
+      }
+      else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>)
+      {
+        const int64_t v = _value;
+        Encode(_record, 'i', &v, sizeof(v));
+      }
+      else if constexpr (std::is_integral_v<U> || std::is_enum_v<U>)
+      {
+        const uint64_t v = static_cast<uint64_t>(_value);
+        Encode(_record, 'u', &v, sizeof(v));
+      }
+      else if constexpr (std::is_floating_point_v<U>)
+      {
+        const double v = _value;
+        Encode(_record, 'd', &v, sizeof(v));
+      }
+      else if constexpr (std::is_same_v<U, std::string>)
+      {
+        Encode(_record, 's', _value.data(), _value.size());
+      }
+      else if constexpr (std::is_same_v<U, const char *> ||
+                         std::is_same_v<U, char *>)
+      {
+        Encode(_record, 's', _value, _value ? std::strlen(_value) : 0u);
+      }
+      else
+      {
+        static_assert(std::is_same_v<U, std::string>,
+            "gzbinlog only supports arithmetic and string arguments");
+      }
+    }
+  }
+}
+#endif
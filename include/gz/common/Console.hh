@@ -17,6 +17,7 @@
 #ifndef GZ_COMMON_CONSOLE_HH_
 #define GZ_COMMON_CONSOLE_HH_
 
+#include <functional>
 #include <iostream>
 #include <fstream>
 #include <memory>
@@ -75,6 +76,9 @@ namespace gz
         (gz::common::Console::log.LogDirectory())
     #define ignLogDirectory() gzLogDirectory()
 
+    // Forward declarations.
+    class BinaryLog;
+
     /// \class FileLogger FileLogger.hh common/common.hh
     /// \brief A logger that outputs messages to a file.
     class GZ_COMMON_VISIBLE FileLogger : public std::ostream
@@ -278,6 +282,43 @@ namespace gz
       /// \sa void SetPrefix(const std::string &_customPrefix)
       public: static std::string Prefix();
 
+      /// \brief Function used to capture terminal output. The first
+      /// argument is the destination (STDOUT or STDERR) the text would
+      /// otherwise have been written to, the second is the uncolored text.
+      public: using CaptureCallback =
+          std::function<void(Logger::LogType, const std::string &)>;
+
+      /// \brief Capture the terminal output of gzerr, gzwarn, gzmsg and
+      /// gzdbg produced by the calling thread.
+      ///
+      /// While a capture callback is set, messages from this thread that
+      /// pass the verbosity check are handed to the callback instead of
+      /// being written to stdout/stderr. Other threads are not affected,
+      /// and messages are still written to the log file. This allows
+      /// several tests to inspect console output concurrently without
+      /// redirecting the process-wide file descriptors.
+      /// \param[in] _cb Capture callback. Pass an empty function to restore
+      /// terminal output for the calling thread.
+      /// \return The capture callback that was previously set on this thread.
+      public: static CaptureCallback SetThreadCapture(
+                  const CaptureCallback &_cb);
+
+      /// \brief Get whether a capture callback is set on the calling thread.
+      /// \return True if output of the calling thread is being captured.
+      /// \sa SetThreadCapture(const CaptureCallback &_cb)
+      public: static bool HasThreadCapture();
+
+      /// \brief Also store every message of the loggers (gzerr, gzwarn,
+      /// gzmsg, gzdbg) as text records in a binary log, regardless of the
+      /// verbosity level.
+      /// \param[in] _log Binary log to write into. Pass nullptr to stop.
+      /// \sa BinaryLog
+      public: static void SetBinaryLog(std::shared_ptr<BinaryLog> _log);
+
+      /// \brief Get the binary log set with SetBinaryLog.
+      /// \return The binary log, nullptr if not set.
+      public: static std::shared_ptr<BinaryLog> GetBinaryLog();
+
       /// \brief Global instance of the message logger.
       public: static Logger msg;
 
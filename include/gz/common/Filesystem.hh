@@ -18,6 +18,8 @@
 #ifndef GZ_COMMON_FILESYSTEM_HH_
 #define GZ_COMMON_FILESYSTEM_HH_
 
+#include <cstdint>
+#include <functional>
 #include <string>
 
 #include <gz/common/Export.hh>
@@ -199,6 +201,98 @@ namespace gz
         const std::string &_newDirname,
         const FilesystemWarningOp _warningOp = FSWO_LOG_WARNINGS);
 
+    /// \brief Progress of a copy, see CopyOptions::SetProgressCallback.
+    struct CopyProgress
+    {
+      /// \brief Number of files copied or linked so far.
+      std::uintmax_t files{0};
+
+      /// \brief Total number of files to copy or link.
+      std::uintmax_t totalFiles{0};
+
+      /// \brief Number of bytes copied so far. Linked files are not
+      /// counted.
+      std::uintmax_t bytes{0};
+
+      /// \brief Total number of bytes to copy.
+      std::uintmax_t totalBytes{0};
+
+      /// \brief Average copy speed since the start of the copy, in bytes
+      /// per second.
+      double bytesPerSecond{0.0};
+    };
+
+    /// \class CopyOptions Filesystem.hh
+    /// \brief Options of the accelerated copyFile and copyDirectory.
+    ///
+    /// Files are cloned with reflinks when the filesystem supports it,
+    /// then copied in the kernel with copy_file_range, and otherwise
+    /// copied with large buffers. copyDirectory copies several files in
+    /// parallel.
+    class GZ_COMMON_VISIBLE CopyOptions
+    {
+      /// \brief Constructor, files are copied and progress is not
+      /// reported.
+      public: CopyOptions();
+
+      /// \brief Hard link files instead of copying them. Linked files
+      /// share their content with the source, so this should only be used
+      /// for files which are never modified. Files which can not be
+      /// linked, e.g. because they are on another filesystem, are copied.
+      /// \param[in] _filter Called on the calling thread with the path of
+      /// each source file, returns true to link the file. An empty
+      /// function links no file.
+      public: void SetHardLinkFilter(
+                  std::function<bool(const std::string &)> _filter);
+
+      /// \brief Get the hard link filter.
+      /// \return The filter, empty if no file is linked.
+      public: const std::function<bool(const std::string &)> &
+                  HardLinkFilter() const;
+
+      /// \brief Report the progress of copyDirectory. The callback is
+      /// called on the calling thread, periodically and once at the end.
+      /// \param[in] _callback Called with the progress so far.
+      public: void SetProgressCallback(
+                  std::function<void(const CopyProgress &)> _callback);
+
+      /// \brief Get the progress callback.
+      /// \return The callback, empty if progress is not reported.
+      public: const std::function<void(const CopyProgress &)> &
+                  ProgressCallback() const;
+
+      /// \brief Private data pointer.
+      GZ_UTILS_IMPL_PTR(dataPtr)
+    };
+
+    /// \brief Copy a file, using the fastest method available.
+    /// \param[in] _existingFilename Path to an existing file.
+    /// \param[in] _newFilename Path of the new file, overwritten if it
+    /// exists.
+    /// \param[in] _options Copy options.
+    /// \param[in] _warningOp Log or suppress warnings that may occur.
+    /// \return True on success.
+    bool GZ_COMMON_VISIBLE copyFile(
+        const std::string &_existingFilename,
+        const std::string &_newFilename,
+        const CopyOptions &_options,
+        const FilesystemWarningOp _warningOp = FSWO_LOG_WARNINGS);
+
+    /// \brief Copy a directory recursively, copying files in parallel and
+    /// using the fastest method available for each file. Existing files
+    /// in the destination are overwritten.
+    /// \param[in] _existingDirname Path to an existing directory.
+    /// \param[in] _newDirname Path to the destination directory, created
+    /// with its parents if needed.
+    /// \param[in] _options Copy options.
+    /// \param[in] _warningOp Log or suppress warnings that may occur.
+    /// \return True if all files were copied.
+    bool GZ_COMMON_VISIBLE copyDirectory(
+        const std::string &_existingDirname,
+        const std::string &_newDirname,
+        const CopyOptions &_options,
+        const FilesystemWarningOp _warningOp = FSWO_LOG_WARNINGS);
+
     /// \brief Move a file.
     /// \param[in] _existingFilename Full path to an existing file.
     /// \param[in] _newFilename Full path of the new file.
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_COMMON_MAPPEDFILE_HH_
+#define GZ_COMMON_MAPPEDFILE_HH_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <gz/common/Export.hh>
+
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz
+{
+  namespace common
+  {
+    /// \class MappedFile MappedFile.hh gz/common/MappedFile.hh
+    /// \brief Read-only view of the content of a file, without copying it.
+    ///
+    /// Regular files are memory mapped and unmapped on destruction. Files
+    /// that cannot be mapped, e.g. pipes or files of /proc, are read into
+    /// a buffer instead, which gives loaders a single interface.
+    ///
+    /// The view is not null terminated. It stays valid until the file is
+    /// closed. A mapped file must not be modified or truncated meanwhile.
+    ///
+    /// ~~~
+    /// gz::common::MappedFile file(path);
+    /// if (file.Valid())
+    ///   parse(file.View());
+    /// ~~~
+    class GZ_COMMON_VISIBLE MappedFile
+    {
+      /// \brief Expected access pattern of a mapped file, forwarded to the
+      /// kernel with madvise.
+      public: enum class Advice
+      {
+        /// \brief Default read-ahead.
+        NORMAL,
+
+        /// \brief Pages are read in order, read ahead aggressively and
+        /// free pages soon after they were read.
+        SEQUENTIAL,
+
+        /// \brief Pages are read in random order, do not read ahead.
+        RANDOM,
+
+        /// \brief Pages will be needed soon, start reading them now.
+        WILL_NEED,
+
+        /// \brief Pages will not be needed soon. They are read again from
+        /// the file if accessed.
+        DONT_NEED,
+
+        /// \brief Back the mapping with huge pages where the system
+        /// supports it for files, which reduces TLB misses on large files.
+        HUGE_PAGES
+      };
+
+      /// \brief Constructor of a closed file.
+      public: MappedFile();
+
+      /// \brief Open a file, see Open.
+      /// \param[in] _path File to open.
+      /// \param[in] _advice Expected access pattern.
+      public: explicit MappedFile(const std::string &_path,
+                                  Advice _advice = Advice::SEQUENTIAL);
+
+      /// \brief Move constructor. The other file is left closed.
+      /// \param[in] _other File to move.
+      public: MappedFile(MappedFile &&_other) noexcept;
+
+      /// \brief Move assignment. This file is closed first and the other
+      /// file is left closed.
+      /// \param[in] _other File to move.
+      /// \return This file.
+      public: MappedFile &operator=(MappedFile &&_other) noexcept;
+
+      /// \brief Destructor, closes the file.
+      public: ~MappedFile();
+
+      /// \brief Open a file, closing the current one. The file descriptor
+      /// is closed before this returns. The file itself must not be
+      /// modified or truncated while it is mapped: writes by other
+      /// processes show through the view, and reading pages past the end
+      /// of a truncated file raises SIGBUS.
+      /// \param[in] _path File to open.
+      /// \param[in] _advice Expected access pattern, ignored if the file is
+      /// read into a buffer.
+      /// \return True if the file could be mapped or read.
+      public: bool Open(const std::string &_path,
+                        Advice _advice = Advice::SEQUENTIAL);
+
+      /// \brief Unmap the file or free its buffer.
+      public: void Close();
+
+      /// \brief Check whether a file is open. An empty file is valid.
+      /// \return True if a file is open.
+      public: bool Valid() const;
+
+      /// \brief Check whether the file is memory mapped, rather than read
+      /// into a buffer.
+      /// \return True if the file is mapped.
+      public: bool Mapped() const;
+
+      /// \brief Get the path of the open file.
+      /// \return Path given to Open, empty if no file is open.
+      public: std::string Path() const;
+
+      /// \brief Get the content of the file.
+      /// \return Pointer to the first byte, nullptr if the file is closed
+      /// or empty.
+      public: const char *Data() const;
+
+      /// \brief Get the size of the file.
+      /// \return Size in bytes.
+      public: std::size_t Size() const;
+
+      /// \brief Get the content of the file.
+      /// \return View of the whole file, empty if no file is open.
+      public: std::string_view View() const;
+
+      /// \brief Give a hint about how the whole file will be accessed.
+      /// \param[in] _advice Expected access pattern.
+      /// \return False if the hint was not applied, e.g. the file is not
+      /// mapped or the system does not support it.
+      public: bool Advise(Advice _advice);
+
+      /// \brief Give a hint about how part of the file will be accessed,
+      /// e.g. WILL_NEED for the next chunk a parser will read.
+      /// \param[in] _advice Expected access pattern.
+      /// \param[in] _offset Offset of the first byte.
+      /// \param[in] _length Number of bytes, clamped to the end of the file.
+      /// \return False if the hint was not applied.
+      public: bool Advise(Advice _advice, std::size_t _offset,
+                          std::size_t _length);
+
+      /// \brief Pointer to private data.
+      GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+    };
+  }
+}
+#endif
@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_COMMON_POOL_HH_
+#define GZ_COMMON_POOL_HH_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <gz/common/Export.hh>
+
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz
+{
+  namespace common
+  {
+    /// \class ObjectPool Pool.hh gz/common/Pool.hh
+    /// \brief A thread-safe pool of fixed-size storage blocks for objects of
+    /// type T.
+    ///
+    /// Acquire constructs an object in a recycled block when one is
+    /// available. The returned pointer destroys the object and hands the
+    /// block back to the pool when it goes out of scope. At most
+    /// MaxRetained() blocks are kept; extra blocks are freed.
+    ///
+    /// The pool must outlive all the pointers it hands out.
+    ///
+    /// ~~~
+    /// gz::common::ObjectPool<std::vector<int>> pool;
+    /// auto values = pool.Acquire(16u, 0);
+    /// ~~~
+    template<typename T>
+    class ObjectPool
+    {
+      /// \brief Deleter used by ObjectPool::Ptr.
+      public: struct Deleter
+      {
+        /// \brief Pool that owns the storage.
+        ObjectPool<T> *pool{nullptr};
+
+        /// \brief Destroy an object and return its storage to the pool.
+        /// \param[in] _obj Object to release.
+        void operator()(T *_obj) const
+        {
+          if (this->pool)
+            this->pool->Release(_obj);
+        }
+      };
+
+      /// \brief Owning pointer to a pooled object.
+      public: using Ptr = std::unique_ptr<T, Deleter>;
+
+      /// \brief Constructor.
+      /// \param[in] _maxRetained Maximum number of free blocks kept for
+      /// reuse.
+      public: explicit ObjectPool(const std::size_t _maxRetained = 64u)
+        : maxRetained(_maxRetained)
+      {
+      }
+
+      /// \brief Destructor. Frees all retained blocks.
+      public: ~ObjectPool()
+      {
+        this->Clear();
+      }
+
+      /// \brief Not copyable.
+      public: ObjectPool(const ObjectPool &) = delete;
+
+      /// \brief Not copyable.
+      public: ObjectPool &operator=(const ObjectPool &) = delete;
+
+      /// \brief Construct an object, reusing a free block if possible.
+      /// \param[in] _args Constructor arguments.
+      /// \return Pointer to the new object.
+      public: template<typename... Args>
+              Ptr Acquire(Args &&... _args)
+      {
+        void *block = nullptr;
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+          if (!this->freeBlocks.empty())
+          {
+            block = this->freeBlocks.back();
+            this->freeBlocks.pop_back();
+          }
+        }
+
+        if (!block)
+        {
+          block = ::operator new(sizeof(T), std::align_val_t(alignof(T)));
+          this->allocations.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        try
+        {
+          return Ptr(new (block) T(std::forward<Args>(_args)...),
+                     Deleter{this});
+        }
+        catch (...)
+        {
+          this->Recycle(block);
+          throw;
+        }
+      }
+
+      /// \brief Get the number of free blocks currently kept for reuse.
+      /// \return Number of retained blocks.
+      public: std::size_t Retained() const
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->freeBlocks.size();
+      }
+
+      /// \brief Get the maximum number of free blocks kept for reuse.
+      /// \return Retention limit.
+      public: std::size_t MaxRetained() const
+      {
+        return this->maxRetained;
+      }
+
+      /// \brief Get the number of blocks allocated from the heap since the
+      /// pool was created. Useful to measure reuse.
+      /// \return Number of heap allocations.
+      public: uint64_t Allocations() const
+      {
+        return this->allocations.load(std::memory_order_relaxed);
+      }
+
+      /// \brief Free all retained blocks. Objects still in use are not
+      /// affected.
+      public: void Clear()
+      {
+        std::vector<void *> blocks;
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+          blocks.swap(this->freeBlocks);
+        }
+        for (void *block : blocks)
+          ::operator delete(block, std::align_val_t(alignof(T)));
+      }
+
+      /// \brief Destroy an object and recycle its block.
+      /// \param[in] _obj Object to release.
+      private: void Release(T *_obj)
+      {
+        _obj->~T();
+        this->Recycle(_obj);
+      }
+
+      /// \brief Keep a block for reuse, or free it if the pool is full.
+      /// \param[in] _block Storage block.
+      private: void Recycle(void *_block)
+      {
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+          if (this->freeBlocks.size() < this->maxRetained)
+          {
+            this->freeBlocks.push_back(_block);
+            return;
+          }
+        }
+        ::operator delete(_block, std::align_val_t(alignof(T)));
+      }
+
+      /// \brief Maximum number of retained blocks.
+      private: const std::size_t maxRetained;
+
+      /// \brief Protects freeBlocks.
+      private: mutable std::mutex mutex;
+
+      /// \brief Blocks available for reuse.
+      private: std::vector<void *> freeBlocks;
+
+      /// \brief Number of heap allocations.
+      private: std::atomic<uint64_t> allocations{0};
+    };
+
+    /// \class BufferPool Pool.hh gz/common/Pool.hh
+    /// \brief A pool of byte buffers grouped in power-of-two size classes.
+    ///
+    /// Acquire returns a buffer whose capacity is at least the size class
+    /// of the request, reusing a released buffer when possible. Released
+    /// buffers first go to a small cache local to the calling thread, whose
+    /// lock is uncontended, then to a shared list per size class. Both are
+    /// bounded, and buffers beyond the limits are freed. Destroying a pool
+    /// frees its buffers from the caches of all threads.
+    ///
+    /// ~~~
+    /// auto &pool = gz::common::BufferPool::Default();
+    /// auto buffer = pool.Acquire(width * height * 3);
+    /// image.RGBData(buffer);
+    /// // use buffer
+    /// pool.Release(std::move(buffer));
+    /// ~~~
+    class GZ_COMMON_VISIBLE BufferPool
+    {
+      /// \brief Buffer type handed out by the pool.
+      public: using Buffer = std::vector<unsigned char>;
+
+      /// \brief Smallest size class, in bytes.
+      public: static constexpr std::size_t kMinClassSize = 256u;
+
+      /// \brief Constructor.
+      /// \param[in] _maxRetainedPerClass Maximum number of buffers kept in
+      /// the shared list of each size class.
+      /// \param[in] _threadCacheSize Maximum number of buffers of this pool
+      /// kept in the cache of each thread. Zero disables thread caches.
+      /// \param[in] _maxBufferSize Released buffers with a larger capacity
+      /// are freed instead of being retained.
+      public: explicit BufferPool(const std::size_t _maxRetainedPerClass = 8u,
+                  const std::size_t _threadCacheSize = 2u,
+                  const std::size_t _maxBufferSize = 64u * 1024u * 1024u);
+
+      /// \brief Destructor.
+      public: ~BufferPool();
+
+      /// \brief Get a buffer of _size bytes. The contents are unspecified.
+      /// \param[in] _size Number of bytes.
+      /// \return A buffer with size() == _size.
+      public: Buffer Acquire(const std::size_t _size);
+
+      /// \brief Give a buffer back to the pool.
+      /// \param[in] _buffer Buffer to recycle.
+      public: void Release(Buffer &&_buffer);
+
+      /// \brief Get the number of buffers in the shared lists. Buffers
+      /// cached by threads are not counted.
+      /// \return Number of retained buffers.
+      public: std::size_t Retained() const;
+
+      /// \brief Get the number of buffers allocated from the heap since the
+      /// pool was created. Useful to measure reuse.
+      /// \return Number of heap allocations.
+      public: uint64_t Allocations() const;
+
+      /// \brief Free all buffers in the shared lists and in the cache of the
+      /// calling thread.
+      public: void Trim();
+
+      /// \brief Get the size class of a request.
+      /// \param[in] _size Requested size in bytes.
+      /// \return The smallest power of two, at least kMinClassSize, that is
+      /// greater than or equal to _size.
+      public: static std::size_t SizeClass(const std::size_t _size);
+
+      /// \brief Get a process-wide pool.
+      /// \return Shared pool with the default limits.
+      public: static BufferPool &Default();
+
+      /// \brief Private data pointer.
+      GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+    };
+  }
+}
+#endif
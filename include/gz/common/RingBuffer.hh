@@ -0,0 +1,549 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_COMMON_RINGBUFFER_HH_
+#define GZ_COMMON_RINGBUFFER_HH_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <gz/common/detail/RingBuffer.hh>
+
+namespace gz
+{
+  namespace common
+  {
+    /// \class SpscRingBuffer RingBuffer.hh gz/common/RingBuffer.hh
+    /// \brief A bounded, lock-free queue for exactly one producer thread and
+    /// one consumer thread.
+    ///
+    /// The capacity is rounded up to a power of two. Producer and consumer
+    /// indices live on separate cache lines, and each side keeps a cached
+    /// copy of the other side's index so that most operations touch only
+    /// their own cache line.
+    ///
+    /// Try* functions never wait. Push and Pop wait according to a
+    /// RingBufferWait strategy. Close wakes all waiters; afterwards Push
+    /// fails and Pop drains the remaining items.
+    ///
+    /// T must be default constructible and move assignable.
+    template<typename T>
+    class SpscRingBuffer
+    {
+      /// \brief Constructor.
+      /// \param[in] _capacity Minimum number of items the buffer can hold.
+      public: explicit SpscRingBuffer(const std::size_t _capacity)
+        : slots(detail::RingBufferCapacity(_capacity)),
+          mask(slots.size() - 1)
+      {
+      }
+
+      /// \brief Get the number of items the buffer can hold.
+      /// \return Capacity, a power of two.
+      public: std::size_t Capacity() const
+      {
+        return this->slots.size();
+      }
+
+      /// \brief Get the number of items in the buffer. Only exact when
+      /// neither side is running.
+      /// \return Number of items.
+      public: std::size_t Size() const
+      {
+        // Read head first so that the result never underflows
+        const std::size_t popped = this->head.load(std::memory_order_acquire);
+        return this->tail.load(std::memory_order_acquire) - popped;
+      }
+
+      /// \brief Get whether the buffer is empty.
+      /// \return True if there is nothing to pop.
+      public: bool Empty() const
+      {
+        return this->Size() == 0;
+      }
+
+      /// \brief Add an item if there is room. Producer only.
+      /// \param[in] _item Item to add.
+      /// \return True if the item was added.
+      public: bool TryPush(const T &_item)
+      {
+        return this->Notify(this->notEmpty, this->PushOne(_item));
+      }
+
+      /// \brief Add an item if there is room. Producer only. _item is left
+      /// untouched when the buffer is full.
+      /// \param[in] _item Item to add.
+      /// \return True if the item was added.
+      public: bool TryPush(T &&_item)
+      {
+        return this->Notify(this->notEmpty, this->PushOne(std::move(_item)));
+      }
+
+      /// \brief Add as many items as there is room for, publishing them at
+      /// once. Producer only.
+      /// \param[in] _items Items to add.
+      /// \param[in] _count Number of items.
+      /// \return Number of items added, from the front of _items.
+      public: std::size_t TryPushBatch(const T *_items,
+                                       const std::size_t _count)
+      {
+        const std::size_t pos = this->tail.load(std::memory_order_relaxed);
+        std::size_t room = this->slots.size() - (pos - this->headCache);
+        if (room < _count)
+        {
+          this->headCache = this->head.load(std::memory_order_acquire);
+          room = this->slots.size() - (pos - this->headCache);
+        }
+
+        const std::size_t count = room < _count ? room : _count;
+        for (std::size_t i = 0; i < count; ++i)
+          this->slots[(pos + i) & this->mask] = _items[i];
+        this->tail.store(pos + count, std::memory_order_release);
+        return this->Notify(this->notEmpty, count);
+      }
+
+      /// \brief Remove the oldest item if any. Consumer only.
+      /// \param[out] _item Receives the item.
+      /// \return True if an item was removed.
+      public: bool TryPop(T &_item)
+      {
+        return this->TryPopBatch(&_item, 1) == 1;
+      }
+
+      /// \brief Remove up to _max items at once. Consumer only.
+      /// \param[out] _items Receives the items, oldest first.
+      /// \param[in] _max Maximum number of items to remove.
+      /// \return Number of items removed.
+      public: std::size_t TryPopBatch(T *_items, const std::size_t _max)
+      {
+        const std::size_t pos = this->head.load(std::memory_order_relaxed);
+        std::size_t available = this->tailCache - pos;
+        if (available < _max)
+        {
+          this->tailCache = this->tail.load(std::memory_order_acquire);
+          available = this->tailCache - pos;
+        }
+
+        const std::size_t count = available < _max ? available : _max;
+        for (std::size_t i = 0; i < count; ++i)
+          _items[i] = std::move(this->slots[(pos + i) & this->mask]);
+        this->head.store(pos + count, std::memory_order_release);
+        return this->Notify(this->notFull, count);
+      }
+
+      /// \brief Add an item, waiting for room. Producer only.
+      /// \param[in] _item Item to add.
+      /// \param[in] _mode Wait strategy.
+      /// \param[in] _timeout Maximum time to wait, zero waits forever.
+      /// \return True if the item was added, false on timeout or if the
+      /// buffer is closed.
+      public: bool Push(T _item,
+                  const RingBufferWait _mode = RingBufferWait::BLOCK,
+                  const std::chrono::steady_clock::duration &_timeout =
+                      std::chrono::steady_clock::duration::zero())
+      {
+        if (this->Closed())
+          return false;
+        return detail::RingBufferRetry(this->notFull, _mode, _timeout,
+            [&] { return this->TryPush(std::move(_item)); },
+            [this]
+            {
+              return this->Closed() || this->Size() < this->Capacity();
+            },
+            [this] { return this->Closed(); });
+      }
+
+      /// \brief Remove the oldest item, waiting for one. Consumer only.
+      /// \param[out] _item Receives the item.
+      /// \param[in] _mode Wait strategy.
+      /// \param[in] _timeout Maximum time to wait, zero waits forever.
+      /// \return True if an item was removed, false on timeout or if the
+      /// buffer is closed and empty.
+      public: bool Pop(T &_item,
+                  const RingBufferWait _mode = RingBufferWait::BLOCK,
+                  const std::chrono::steady_clock::duration &_timeout =
+                      std::chrono::steady_clock::duration::zero())
+      {
+        return detail::RingBufferRetry(this->notEmpty, _mode, _timeout,
+            [&] { return this->TryPop(_item); },
+            [this] { return this->Closed() || !this->Empty(); },
+            [this] { return this->Closed(); });
+      }
+
+      /// \brief Close the buffer and wake all waiting threads.
+      public: void Close()
+      {
+        this->closed.store(true);
+        this->notEmpty.Notify();
+        this->notFull.Notify();
+      }
+
+      /// \brief Get whether Close was called.
+      /// \return True if the buffer is closed.
+      public: bool Closed() const
+      {
+        return this->closed.load(std::memory_order_acquire);
+      }
+
+      /// \brief Store one item if there is room.
+      /// \param[in] _item Item to store.
+      /// \return Number of items stored, 0 or 1.
+      private: template<typename U>
+               std::size_t PushOne(U &&_item)
+      {
+        const std::size_t pos = this->tail.load(std::memory_order_relaxed);
+        if (pos - this->headCache == this->slots.size())
+        {
+          this->headCache = this->head.load(std::memory_order_acquire);
+          if (pos - this->headCache == this->slots.size())
+            return 0;
+        }
+        this->slots[pos & this->mask] = std::forward<U>(_item);
+        this->tail.store(pos + 1, std::memory_order_release);
+        return 1;
+      }
+
+      /// \brief Wake the other side if items moved.
+      /// \param[in] _signal Signal to notify.
+      /// \param[in] _count Number of items moved.
+      /// \return _count
+      private: static std::size_t Notify(detail::RingBufferSignal &_signal,
+                                         const std::size_t _count)
+      {
+        if (_count > 0)
+          _signal.Notify();
+        return _count;
+      }
+
+      /// \brief Item storage.
+      private: std::vector<T> slots;
+
+      /// \brief Capacity minus one.
+      private: const std::size_t mask;
+
+      /// \brief Next position to pop, written by the consumer.
+      private: alignas(detail::kCacheLineSize)
+               std::atomic<std::size_t> head{0};
+
+      /// \brief Consumer's copy of tail.
+      private: std::size_t tailCache{0};
+
+      /// \brief Next position to push, written by the producer.
+      private: alignas(detail::kCacheLineSize)
+               std::atomic<std::size_t> tail{0};
+
+      /// \brief Producer's copy of head.
+      private: std::size_t headCache{0};
+
+      /// \brief Signaled when items are pushed.
+      private: alignas(detail::kCacheLineSize)
+               detail::RingBufferSignal notEmpty;
+
+      /// \brief Signaled when items are popped.
+      private: detail::RingBufferSignal notFull;
+
+      /// \brief Set by Close.
+      private: std::atomic<bool> closed{false};
+    };
+
+    /// \class MpmcRingBuffer RingBuffer.hh gz/common/RingBuffer.hh
+    /// \brief A bounded, lock-free queue for any number of producer and
+    /// consumer threads.
+    ///
+    /// Each slot carries a sequence number that tells whether it is ready
+    /// to be written or read, so producers and consumers only contend on
+    /// their own index. The capacity is rounded up to a power of two.
+    ///
+    /// The interface matches SpscRingBuffer. Batch operations are provided
+    /// for symmetry; unlike SpscRingBuffer they claim slots one by one and
+    /// only save the wake-up notifications.
+    ///
+    /// T must be default constructible and move assignable.
+    template<typename T>
+    class MpmcRingBuffer
+    {
+      /// \brief Constructor.
+      /// \param[in] _capacity Minimum number of items the buffer can hold.
+      public: explicit MpmcRingBuffer(const std::size_t _capacity)
+        : capacity(detail::RingBufferCapacity(_capacity)),
+          mask(capacity - 1),
+          cells(new Cell[capacity])
+      {
+        for (std::size_t i = 0; i < this->capacity; ++i)
+          this->cells[i].sequence.store(i, std::memory_order_relaxed);
+      }
+
+      /// \brief Get the number of items the buffer can hold.
+      /// \return Capacity, a power of two.
+      public: std::size_t Capacity() const
+      {
+        return this->capacity;
+      }
+
+      /// \brief Get the number of items in the buffer. Only exact when no
+      /// thread is pushing or popping.
+      /// \return Number of items.
+      public: std::size_t Size() const
+      {
+        const std::size_t pushed =
+          this->enqueuePos.load(std::memory_order_acquire);
+        const std::size_t popped =
+          this->dequeuePos.load(std::memory_order_acquire);
+        return pushed > popped ? pushed - popped : 0;
+      }
+
+      /// \brief Get whether the buffer is empty.
+      /// \return True if there is nothing to pop.
+      public: bool Empty() const
+      {
+        return this->Size() == 0;
+      }
+
+      /// \brief Add an item if there is room.
+      /// \param[in] _item Item to add.
+      /// \return True if the item was added.
+      public: bool TryPush(const T &_item)
+      {
+        return this->Notify(this->notEmpty, this->PushOne(_item));
+      }
+
+      /// \brief Add an item if there is room. _item is left untouched when
+      /// the buffer is full.
+      /// \param[in] _item Item to add.
+      /// \return True if the item was added.
+      public: bool TryPush(T &&_item)
+      {
+        return this->Notify(this->notEmpty, this->PushOne(std::move(_item)));
+      }
+
+      /// \brief Add as many items as there is room for.
+      /// \param[in] _items Items to add.
+      /// \param[in] _count Number of items.
+      /// \return Number of items added, from the front of _items.
+      public: std::size_t TryPushBatch(const T *_items,
+                                       const std::size_t _count)
+      {
+        std::size_t count = 0;
+        while (count < _count && this->PushOne(_items[count]))
+          ++count;
+        return this->Notify(this->notEmpty, count);
+      }
+
+      /// \brief Remove the oldest item if any.
+      /// \param[out] _item Receives the item.
+      /// \return True if an item was removed.
+      public: bool TryPop(T &_item)
+      {
+        return this->Notify(this->notFull, this->PopOne(_item));
+      }
+
+      /// \brief Remove up to _max items.
+      /// \param[out] _items Receives the items.
+      /// \param[in] _max Maximum number of items to remove.
+      /// \return Number of items removed.
+      public: std::size_t TryPopBatch(T *_items, const std::size_t _max)
+      {
+        std::size_t count = 0;
+        while (count < _max && this->PopOne(_items[count]))
+          ++count;
+        return this->Notify(this->notFull, count);
+      }
+
+      /// \brief Add an item, waiting for room.
+      /// \param[in] _item Item to add.
+      /// \param[in] _mode Wait strategy.
+      /// \param[in] _timeout Maximum time to wait, zero waits forever.
+      /// \return True if the item was added, false on timeout or if the
+      /// buffer is closed.
+      public: bool Push(T _item,
+                  const RingBufferWait _mode = RingBufferWait::BLOCK,
+                  const std::chrono::steady_clock::duration &_timeout =
+                      std::chrono::steady_clock::duration::zero())
+      {
+        if (this->Closed())
+          return false;
+        return detail::RingBufferRetry(this->notFull, _mode, _timeout,
+            [&] { return this->TryPush(std::move(_item)); },
+            [this]
+            {
+              return this->Closed() || this->Size() < this->Capacity();
+            },
+            [this] { return this->Closed(); });
+      }
+
+      /// \brief Remove the oldest item, waiting for one.
+      /// \param[out] _item Receives the item.
+      /// \param[in] _mode Wait strategy.
+      /// \param[in] _timeout Maximum time to wait, zero waits forever.
+      /// \return True if an item was removed, false on timeout or if the
+      /// buffer is closed and empty.
+      public: bool Pop(T &_item,
+                  const RingBufferWait _mode = RingBufferWait::BLOCK,
+                  const std::chrono::steady_clock::duration &_timeout =
+                      std::chrono::steady_clock::duration::zero())
+      {
+        return detail::RingBufferRetry(this->notEmpty, _mode, _timeout,
+            [&] { return this->TryPop(_item); },
+            [this] { return this->Closed() || !this->Empty(); },
+            [this] { return this->Closed(); });
+      }
+
+      /// \brief Close the buffer and wake all waiting threads.
+      public: void Close()
+      {
+        this->closed.store(true);
+        this->notEmpty.Notify();
+        this->notFull.Notify();
+      }
+
+      /// \brief Get whether Close was called.
+      /// \return True if the buffer is closed.
+      public: bool Closed() const
+      {
+        return this->closed.load(std::memory_order_acquire);
+      }
+
+      /// \brief A slot and its sequence number.
+      private: struct Cell
+      {
+        /// \brief Position that may write this cell when equal to it, or
+        /// position + 1 that may read it.
+        std::atomic<std::size_t> sequence;
+
+        /// \brief Stored item.
+        T data;
+      };
+
+      /// \brief Claim a slot and store one item if there is room.
+      /// \param[in] _item Item to store.
+      /// \return Number of items stored, 0 or 1.
+      private: template<typename U>
+               std::size_t PushOne(U &&_item)
+      {
+        std::size_t pos = this->enqueuePos.load(std::memory_order_relaxed);
+        Cell *cell;
+        while (true)
+        {
+          cell = &this->cells[pos & this->mask];
+          const std::size_t seq =
+            cell->sequence.load(std::memory_order_acquire);
+          const auto diff =
+            static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+          if (diff == 0)
+          {
+            if (this->enqueuePos.compare_exchange_weak(pos, pos + 1,
+                  std::memory_order_relaxed))
+            {
+              break;
+            }
+          }
+          else if (diff < 0)
+          {
+            return 0;
+          }
+          else
+          {
+            pos = this->enqueuePos.load(std::memory_order_relaxed);
+          }
+        }
+        cell->data = std::forward<U>(_item);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return 1;
+      }
+
+      /// \brief Claim and read one item if there is one.
+      /// \param[out] _item Receives the item.
+      /// \return Number of items read, 0 or 1.
+      private: std::size_t PopOne(T &_item)
+      {
+        std::size_t pos = this->dequeuePos.load(std::memory_order_relaxed);
+        Cell *cell;
+        while (true)
+        {
+          cell = &this->cells[pos & this->mask];
+          const std::size_t seq =
+            cell->sequence.load(std::memory_order_acquire);
+          const auto diff = static_cast<std::intptr_t>(seq) -
+                            static_cast<std::intptr_t>(pos + 1);
+          if (diff == 0)
+          {
+            if (this->dequeuePos.compare_exchange_weak(pos, pos + 1,
+                  std::memory_order_relaxed))
+            {
+              break;
+            }
+          }
+          else if (diff < 0)
+          {
+            return 0;
+          }
+          else
+          {
+            pos = this->dequeuePos.load(std::memory_order_relaxed);
+          }
+        }
+        _item = std::move(cell->data);
+        cell->sequence.store(pos + this->capacity, std::memory_order_release);
+        return 1;
+      }
+
+      /// \brief Wake the other side if items moved.
+      /// \param[in] _signal Signal to notify.
+      /// \param[in] _count Number of items moved.
+      /// \return _count
+      private: static std::size_t Notify(detail::RingBufferSignal &_signal,
+                                         const std::size_t _count)
+      {
+        if (_count > 0)
+          _signal.Notify();
+        return _count;
+      }
+
+      /// \brief Number of cells.
+      private: const std::size_t capacity;
+
+      /// \brief Capacity minus one.
+      private: const std::size_t mask;
+
+      /// \brief Cell storage.
+      private: std::unique_ptr<Cell[]> cells;
+
+      /// \brief Next position to push.
+      private: alignas(detail::kCacheLineSize)
+               std::atomic<std::size_t> enqueuePos{0};
+
+      /// \brief Next position to pop.
+      private: alignas(detail::kCacheLineSize)
+               std::atomic<std::size_t> dequeuePos{0};
+
+      /// \brief Signaled when items are pushed.
+      private: alignas(detail::kCacheLineSize)
+               detail::RingBufferSignal notEmpty;
+
+      /// \brief Signaled when items are popped.
+      private: detail::RingBufferSignal notFull;
+
+      /// \brief Set by Close.
+      private: std::atomic<bool> closed{false};
+    };
+  }
+}
+#endif
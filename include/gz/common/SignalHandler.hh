@@ -17,7 +17,9 @@
 #ifndef GZ_COMMON_SIGNALHANDLER_HH_
 #define GZ_COMMON_SIGNALHANDLER_HH_
 
+#include <chrono>
 #include <functional>
+#include <string>
 
 #include <gz/common/Export.hh>
 
@@ -45,11 +47,49 @@ namespace gz
     /// });
     /// ~~~
     ///
+    /// By default callbacks run from inside the process signal handler,
+    /// which restricts them to async-signal-safe operations. Construct the
+    /// handler with DeliveryMode::DEDICATED_THREAD to have signals received
+    /// by a dedicated thread instead, so that callbacks run in normal thread
+    /// context and may lock mutexes, flush logs or join threads. In that
+    /// mode an ordered sequence of time-bounded shutdown steps can be
+    /// registered with AddShutdownStep:
+    ///
+    /// ~~~
+    /// gz::common::SignalHandler handler(
+    ///     gz::common::SignalHandler::DeliveryMode::DEDICATED_THREAD);
+    /// handler.AddShutdownStep("flush video", [&](int) { encoder.Stop(); },
+    ///     std::chrono::seconds(2), 0);
+    /// handler.AddShutdownStep("close log", [](int) { gzLogClose(); },
+    ///     std::chrono::milliseconds(500), 1);
+    /// ~~~
+    ///
     class GZ_COMMON_VISIBLE SignalHandler
     {
+      /// \brief How received signals are delivered to callbacks.
+      public: enum class DeliveryMode
+              {
+                /// \brief Callbacks run inside the process signal handler.
+                SIGNAL_CONTEXT,
+
+                /// \brief Signals are received by a dedicated thread, which
+                /// runs the callbacks in normal thread context. The signal
+                /// handler itself only forwards the signal to that thread.
+                /// The thread is shared by all SignalHandlers using this mode
+                /// and exits when the last of them is destroyed. While it
+                /// runs, callbacks of SIGNAL_CONTEXT handlers are delivered
+                /// from it as well. On Windows this falls back to
+                /// SIGNAL_CONTEXT.
+                DEDICATED_THREAD
+              };
+
       /// \brief Constructor
       public: SignalHandler();
 
+      /// \brief Constructor
+      /// \param[in] _mode How signals are delivered to callbacks.
+      public: explicit SignalHandler(const DeliveryMode _mode);
+
       /// \brief Destructor.
       public: virtual ~SignalHandler();
 
@@ -60,6 +100,34 @@ namespace gz
       /// \sa bool Initialized() const
       public: bool AddCallback(std::function<void(int)> _cb);
 
+      /// \brief Add a step to the shutdown sequence executed when a signal
+      /// is received. Steps run after all callbacks added with AddCallback,
+      /// in ascending order of _order; steps with the same order run in the
+      /// order they were added. Each step is given at most _timeout to
+      /// complete. A step that exceeds its timeout is left running in the
+      /// background and the sequence continues with the next step, so one
+      /// stuck step cannot prevent the others (e.g. flushing logs) from
+      /// running.
+      ///
+      /// Shutdown steps require DeliveryMode::DEDICATED_THREAD.
+      /// \param[in] _name Name of the step, used in diagnostics.
+      /// \param[in] _step Function to execute, receives the signal number.
+      /// \param[in] _timeout Maximum time to wait for the step. A value of
+      /// zero waits until the step completes.
+      /// \param[in] _order Position of the step in the sequence.
+      /// \return True if the step was added.
+      /// \sa DeliveryMode Mode() const
+      public: bool AddShutdownStep(const std::string &_name,
+                  std::function<void(int)> _step,
+                  const std::chrono::steady_clock::duration &_timeout =
+                    std::chrono::steady_clock::duration::zero(),
+                  const int _order = 0);
+
+      /// \brief Get how signals are delivered to the callbacks of this
+      /// handler.
+      /// \return The delivery mode in effect.
+      public: DeliveryMode Mode() const;
+
       /// \brief Get whether the signal handlers were successfully
       /// initialized.
       /// \return True if the signal handlers were successfully created.
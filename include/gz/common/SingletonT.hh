@@ -22,7 +22,8 @@ namespace gz
   namespace common
   {
     /// \class SingletonT SingletonT.hh common/common.hh
-    /// \brief Singleton template class
+    /// \brief Singleton template class. The instance is created on the
+    /// first call to Instance(), not during static initialization.
     template <class T>
     class SingletonT
     {
@@ -44,14 +45,7 @@ namespace gz
         static T t;
         return static_cast<T &>(t);
       }
-
-      /// \brief A reference to the unique instance
-      private: static T &myself;
     };
-
-    /// \brief Initialization of the singleton instance.
-    template <class T>
-    T &SingletonT<T>::myself = SingletonT<T>::GetInstance();
   }
 }
 #endif
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GZ_COMMON_DETAIL_RINGBUFFER_HH_
+#define GZ_COMMON_DETAIL_RINGBUFFER_HH_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+namespace gz
+{
+  namespace common
+  {
+    /// \brief How a blocking ring buffer operation waits for its condition.
+    enum class RingBufferWait
+    {
+      /// \brief Busy-wait. Lowest latency, burns a core while waiting.
+      SPIN,
+
+      /// \brief Call std::this_thread::yield between attempts.
+      YIELD,
+
+      /// \brief Spin briefly, then sleep on a condition variable until
+      /// woken by the other side.
+      BLOCK
+    };
+
+    namespace detail
+    {
+      /// \brief Assumed size of a cache line, used to keep the producer and
+      /// consumer indices of ring buffers apart.
+      constexpr std::size_t kCacheLineSize = 64;
+
+      /// \brief Round up to a power of two, at least 2.
+      /// \param[in] _value Value to round.
+      /// \return Smallest power of two >= _value.
+      inline std::size_t RingBufferCapacity(const std::size_t _value)
+      {
+        std::size_t capacity = 2;
+        while (capacity < _value)
+          capacity <<= 1;
+        return capacity;
+      }
+
+      /// \brief Wakes threads waiting in RingBufferWait::BLOCK mode. The
+      /// notifying side only touches the mutex when someone is sleeping.
+      class RingBufferSignal
+      {
+        /// \brief Wait until _ready returns true or the timeout expires.
+        /// \param[in] _mode Wait strategy.
+        /// \param[in] _timeout Maximum time to wait, zero waits forever.
+        /// \param[in] _ready Condition to wait for.
+        /// \return The last value returned by _ready.
+        public: template<typename Ready>
+                bool Wait(const RingBufferWait _mode,
+                          const std::chrono::steady_clock::duration &_timeout,
+                          Ready &&_ready)
+        {
+          using Clock = std::chrono::steady_clock;
+          const bool forever = _timeout == Clock::duration::zero();
+          const auto deadline = Clock::now() + _timeout;
+
+          // Spin a bit first, most waits are short. Zero spins forever.
+          const unsigned int spins = _mode == RingBufferWait::BLOCK ? 64u : 0u;
+          for (unsigned int i = 0; spins == 0 || i < spins; ++i)
+          {
+            if (_ready())
+              return true;
+            if (!forever && (i & 0xffu) == 0xffu && Clock::now() >= deadline)
+              return false;
+            if (_mode == RingBufferWait::YIELD)
+              std::this_thread::yield();
+          }
+
+          this->waiters.fetch_add(1);
+          bool result = true;
+          {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            while (true)
+            {
+              // Clear the flag before checking, so that a notification
+              // racing with the check is not skipped.
+              this->wakePending.store(false);
+              std::atomic_thread_fence(std::memory_order_seq_cst);
+              if (_ready())
+                break;
+
+              if (forever)
+              {
+                this->cv.wait(lock);
+              }
+              else if (this->cv.wait_until(lock, deadline) ==
+                       std::cv_status::timeout)
+              {
+                result = _ready();
+                break;
+              }
+            }
+          }
+          this->waiters.fetch_sub(1);
+          return result;
+        }
+
+        /// \brief Wake all waiting threads, if any.
+        public: void Notify()
+        {
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+          // One wake-up per sleep is enough: the flag is cleared again by
+          // waiters before they check their condition.
+          if (this->waiters.load(std::memory_order_relaxed) > 0 &&
+              !this->wakePending.exchange(true))
+          {
+            // Taking the lock orders this with a waiter that checked the
+            // condition but did not sleep yet.
+            { std::lock_guard<std::mutex> lock(this->mutex); }
+            this->cv.notify_all();
+          }
+        }
+
+        /// \brief Protects the sleep of waiters.
+        private: std::mutex mutex;
+
+        /// \brief Sleeping waiters.
+        private: std::condition_variable cv;
+
+        /// \brief Number of threads sleeping, or about to.
+        private: std::atomic<int> waiters{0};
+
+        /// \brief Set when sleeping threads were woken and did not go back
+        /// to sleep yet.
+        private: std::atomic<bool> wakePending{false};
+      };
+
+      /// \brief Retry an operation, waiting with _signal between attempts.
+      /// \param[in] _signal Signal notified when the operation may succeed.
+      /// \param[in] _mode Wait strategy.
+      /// \param[in] _timeout Maximum time to wait, zero waits forever.
+      /// \param[in] _attempt Operation, returns true on success.
+      /// \param[in] _ready Returns true when _attempt may succeed or when
+      /// the buffer is closed.
+      /// \param[in] _closed Returns true when the buffer is closed.
+      /// \return True if _attempt succeeded.
+      template<typename Attempt, typename Ready, typename Closed>
+      bool RingBufferRetry(RingBufferSignal &_signal,
+          const RingBufferWait _mode,
+          const std::chrono::steady_clock::duration &_timeout,
+          Attempt &&_attempt, Ready &&_ready, Closed &&_closed)
+      {
+        using Clock = std::chrono::steady_clock;
+        const bool forever = _timeout == Clock::duration::zero();
+        const auto deadline = Clock::now() + _timeout;
+        while (true)
+        {
+          if (_attempt())
+            return true;
+          if (_closed())
+            return false;
+
+          Clock::duration remaining = Clock::duration::zero();
+          if (!forever)
+          {
+            remaining = deadline - Clock::now();
+            if (remaining <= Clock::duration::zero())
+              return false;
+          }
+          if (!_signal.Wait(_mode, remaining, _ready))
+            return _attempt();
+        }
+      }
+    }
+  }
+}
+
+#endif
@@ -17,7 +17,7 @@
 
 #include "gz/common/CSVStreams.hh"
 
-#include <sstream>
+#include <string>
 
 namespace gz
 {
@@ -81,7 +81,19 @@ std::istream &ParseCSVRow(
     std::vector<std::string> &_row,
     const CSVDialect &_dialect)
 {
-  std::stringstream text;
+  // Fields are assigned into the strings already in _row, so parsing rows
+  // of similar shape into the same vector reuses their storage.
+  std::size_t fieldCount = 0;
+  auto storeField = [&_row, &fieldCount](const std::string &_text)
+  {
+    if (fieldCount < _row.size())
+      _row[fieldCount].assign(_text);
+    else
+      _row.push_back(_text);
+    ++fieldCount;
+  };
+
+  std::string text;
   enum {
     FIELD_START = 0,
     ESCAPED_FIELD,
@@ -90,8 +102,6 @@ std::istream &ParseCSVRow(
     RECORD_END
   } state = FIELD_START;
 
-  _row.clear();
-
   CSVToken token;
   while (state != RECORD_END && ExtractCSVToken(_stream, token, _dialect))
   {
@@ -108,7 +118,7 @@ std::istream &ParseCSVRow(
       case NONESCAPED_FIELD:
         if (token.type == CSVToken::TEXT)
         {
-          text << token.character;
+          text.push_back(token.character);
           break;
         }
         state = FIELD_END;
@@ -117,14 +127,14 @@ std::istream &ParseCSVRow(
         switch (token.type)
         {
           case CSVToken::DELIMITER:
-            _row.push_back(text.str());
+            storeField(text);
             state = FIELD_START;
             break;
           case CSVToken::TERMINATOR:
-            if (token.character != static_cast<char>(EOF) || !_row.empty() ||
-                text.tellp() > 0)
+            if (token.character != static_cast<char>(EOF) || fieldCount > 0 ||
+                !text.empty())
             {
-              _row.push_back(text.str());
+              storeField(text);
               state = RECORD_END;
               break;
             }
@@ -133,7 +143,7 @@ std::istream &ParseCSVRow(
             _stream.setstate(std::istream::failbit);
             break;
         }
-        text.str(""), text.clear();
+        text.clear();
         break;
       case ESCAPED_FIELD:
         if (token.type == CSVToken::QUOTE)
@@ -144,7 +154,7 @@ std::istream &ParseCSVRow(
         if (token.type != CSVToken::TERMINATOR ||
             token.character != static_cast<char>(EOF))
         {
-          text << token.character;
+          text.push_back(token.character);
           break;
         }
         [[fallthrough]];
@@ -153,6 +163,7 @@ std::istream &ParseCSVRow(
         break;
     }
   }
+  _row.resize(fieldCount);
   return _stream;
 }
 
@@ -103,6 +103,21 @@ TEST(CSVStreams, CanParseCSVRows)
     const std::vector<std::string> expectedRow{"", "foo,bar\nbaz", ""};
     EXPECT_EQ(row, expectedRow);
   }
+
+  {
+    // Rows parsed into the same vector reuse its strings
+    std::stringstream sstream;
+    sstream << "a long first field,b,c\nd,e\n";
+    std::vector<std::string> row;
+    EXPECT_TRUE(ParseCSVRow(sstream, row, CSVDialect::Unix));
+    const std::vector<std::string> firstRow{"a long first field", "b", "c"};
+    EXPECT_EQ(row, firstRow);
+    const char *storage = row[0].data();
+    EXPECT_TRUE(ParseCSVRow(sstream, row, CSVDialect::Unix));
+    const std::vector<std::string> secondRow{"d", "e"};
+    EXPECT_EQ(row, secondRow);
+    EXPECT_EQ(storage, row[0].data());
+  }
 }
 
 /////////////////////////////////////////////////
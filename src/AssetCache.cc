@@ -0,0 +1,828 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "gz/common/AssetCache.hh"
+#include "gz/common/Console.hh"
+#include "gz/common/Filesystem.hh"
+#include "gz/common/Util.hh"
+#include "gz/common/Uuid.hh"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace fs = std::filesystem;
+
+using namespace gz;
+using namespace common;
+
+namespace
+{
+/// \brief First word of the index file, followed by the version and the
+/// generation of the file.
+constexpr char kIndexMagic[] = "gz-asset-cache";
+
+/// \brief Version of the index layout.
+constexpr int kIndexVersion = 1;
+
+/// \brief Age after which a temporary file is considered abandoned.
+constexpr std::chrono::hours kStaleTemporary{24};
+
+/// \brief Index entry of a blob.
+struct Entry
+{
+  /// \brief Size of the blob in bytes.
+  uintmax_t size{0};
+
+  /// \brief Last access stamp, used for LRU eviction.
+  int64_t lastAccess{0};
+};
+
+/////////////////////////////////////////////////
+/// \brief Exclusive lock on a file, shared between processes. Satisfies
+/// BasicLockable.
+class ProcessLock
+{
+  /// \brief Open the lock file.
+  /// \param[in] _path Path of the lock file, created if needed.
+  /// \return True on success.
+  public: bool Open(const std::string &_path)
+  {
+#ifdef _WIN32
+    this->handle = CreateFileA(_path.c_str(), GENERIC_READ | GENERIC_WRITE,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+        OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    return this->handle != INVALID_HANDLE_VALUE;
+#else
+    this->fd = ::open(_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    return this->fd >= 0;
+#endif
+  }
+
+  /// \brief Close the lock file.
+  public: ~ProcessLock()
+  {
+#ifdef _WIN32
+    if (this->handle != INVALID_HANDLE_VALUE)
+      CloseHandle(this->handle);
+#else
+    if (this->fd >= 0)
+      ::close(this->fd);
+#endif
+  }
+
+  /// \brief Block until the lock is acquired.
+  public: void lock()
+  {
+#ifdef _WIN32
+    OVERLAPPED overlapped{};
+    LockFileEx(this->handle, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD,
+        &overlapped);
+#else
+    while (::flock(this->fd, LOCK_EX) != 0 && errno == EINTR)
+    {
+    }
+#endif
+  }
+
+  /// \brief Release the lock.
+  public: void unlock()
+  {
+#ifdef _WIN32
+    OVERLAPPED overlapped{};
+    UnlockFileEx(this->handle, 0, MAXDWORD, MAXDWORD, &overlapped);
+#else
+    ::flock(this->fd, LOCK_UN);
+#endif
+  }
+
+#ifdef _WIN32
+  /// \brief Handle of the lock file.
+  private: HANDLE handle{INVALID_HANDLE_VALUE};
+#else
+  /// \brief Descriptor of the lock file.
+  private: int fd{-1};
+#endif
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the current wall clock time, comparable across processes.
+/// \return Nanoseconds since the epoch.
+int64_t now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+}
+}
+
+/////////////////////////////////////////////////
+/// \brief Private data for AssetCache.
+///
+/// The index file is a journal: a header line, then one line per change,
+/// "+ key size stamp" for an insertion, "a key stamp" for an access and
+/// "- key" for a removal. Each instance replays the lines appended by
+/// other instances since its last sync. The journal is rewritten with a
+/// new generation when it grows much longer than the number of blobs.
+/// All index functions must be called with both locks held. The index is
+/// mutable so that const queries can sync it.
+class AssetCache::Implementation
+{
+  /// \brief Read the index lines appended since the last sync, or the
+  /// whole index if it was rewritten.
+  /// \return False if the index has an unknown version, the cache is
+  /// then no longer used.
+  public: bool Sync() const;
+
+  /// \brief Append a line to the index.
+  /// \param[in] _line Line without the end of line.
+  public: void Append(const std::string &_line) const;
+
+  /// \brief Rewrite the index with one line per blob.
+  public: void Compact() const;
+
+  /// \brief Rewrite the index if it is much longer than needed.
+  public: void CompactIfNeeded();
+
+  /// \brief Apply one index line to the in-memory index.
+  /// \param[in] _line Line without the end of line.
+  public: void Apply(const std::string &_line) const;
+
+  /// \brief Get a stamp later than all the stamps in the index.
+  /// \return Access stamp.
+  public: int64_t Stamp();
+
+  /// \brief Remove a blob file and its index entry.
+  /// \param[in] _key Key of the blob.
+  /// \return False if the file exists but could not be removed.
+  public: bool RemoveBlob(const std::string &_key);
+
+  /// \brief Remove the least recently used blobs until the cache is within
+  /// its budget.
+  /// \param[in] _keep Key that must not be evicted, may be empty.
+  /// \return Number of bytes removed.
+  public: uintmax_t EvictLocked(const std::string &_keep);
+
+  /// \brief Move a complete temporary file to its blob path and index it.
+  /// \param[in] _key Key of the blob.
+  /// \param[in] _temp Temporary file, removed on failure.
+  /// \return True on success.
+  public: bool Commit(const std::string &_key, const fs::path &_temp);
+
+  /// \brief Get a path for a new temporary file.
+  /// \return Temporary file path.
+  public: fs::path TemporaryPath() const;
+
+  /// \brief Get the path of a blob.
+  /// \param[in] _key Key of the blob.
+  /// \return Path of the blob.
+  public: fs::path BlobPath(const std::string &_key) const;
+
+  /// \brief Cache directory.
+  public: fs::path root;
+
+  /// \brief Index file.
+  public: fs::path indexPath;
+
+  /// \brief Size budget, zero for no limit.
+  public: uintmax_t maxBytes{0};
+
+  /// \brief True if the cache directory and lock file could be opened
+  /// and the index has a known version.
+  public: mutable std::atomic<bool> valid{false};
+
+  /// \brief Serializes the threads of this process.
+  public: mutable std::mutex mutex;
+
+  /// \brief Serializes the processes sharing the cache.
+  public: mutable ProcessLock fileLock;
+
+  /// \brief Blobs by key.
+  public: mutable std::unordered_map<std::string, Entry> entries;
+
+  /// \brief Total size of the blobs.
+  public: mutable uintmax_t totalBytes{0};
+
+  /// \brief Latest stamp in the index.
+  public: mutable int64_t latest{0};
+
+  /// \brief Generation of the index that was last read.
+  public: mutable std::string generation;
+
+  /// \brief Number of bytes of the index that were read.
+  public: mutable std::streamoff offset{0};
+
+  /// \brief Number of lines in the index, excluding the header.
+  public: mutable std::size_t lines{0};
+};
+
+/////////////////////////////////////////////////
+bool AssetCache::Implementation::Sync() const
+{
+  std::ifstream file(this->indexPath, std::ios::binary);
+  std::string header;
+  if (!file || !std::getline(file, header))
+  {
+    this->entries.clear();
+    this->totalBytes = 0;
+    this->Compact();
+    return true;
+  }
+
+  std::istringstream headerStream(header);
+  std::string magic, generationStr;
+  int version = 0;
+  headerStream >> magic >> version >> generationStr;
+
+  // The index may have been written by another version sharing the cache,
+  // leave its blobs and index alone
+  if (magic == kIndexMagic && version != kIndexVersion)
+  {
+    gzerr << "Unknown version of asset cache index ["
+          << this->indexPath.string() << "], the cache is not used.\n";
+    this->entries.clear();
+    this->totalBytes = 0;
+    this->valid = false;
+    return false;
+  }
+
+  if (magic != kIndexMagic)
+  {
+    gzwarn << "Unknown asset cache index [" << this->indexPath.string()
+           << "], the cache is reset.\n";
+    for (const auto &entry : this->entries)
+    {
+      std::error_code ec;
+      fs::remove(this->BlobPath(entry.first), ec);
+    }
+    this->entries.clear();
+    this->totalBytes = 0;
+    this->Compact();
+    return true;
+  }
+
+  if (generationStr != this->generation)
+  {
+    this->entries.clear();
+    this->totalBytes = 0;
+    this->lines = 0;
+    this->generation = generationStr;
+    this->offset = static_cast<std::streamoff>(header.size() + 1);
+  }
+
+  file.seekg(this->offset);
+  std::string rest((std::istreambuf_iterator<char>(file)),
+      std::istreambuf_iterator<char>());
+
+  // Only complete lines are replayed
+  std::size_t start = 0;
+  for (std::size_t end = rest.find('\n'); end != std::string::npos;
+       end = rest.find('\n', start))
+  {
+    this->Apply(rest.substr(start, end - start));
+    ++this->lines;
+    start = end + 1;
+  }
+  this->offset += static_cast<std::streamoff>(start);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void AssetCache::Implementation::Apply(const std::string &_line) const
+{
+  std::istringstream stream(_line);
+  char op = 0;
+  std::string key;
+  stream >> op >> key;
+
+  // Keys are file names, a corrupt line must not point outside the cache
+  if (!AssetCache::ValidKey(key))
+    return;
+  auto it = this->entries.find(key);
+
+  if (op == '+')
+  {
+    Entry entry;
+    if (!(stream >> entry.size >> entry.lastAccess))
+      return;
+    if (it != this->entries.end())
+      this->totalBytes -= it->second.size;
+    this->entries[key] = entry;
+    this->totalBytes += entry.size;
+    this->latest = std::max(this->latest, entry.lastAccess);
+  }
+  else if (op == 'a' && it != this->entries.end())
+  {
+    int64_t stamp = 0;
+    if (stream >> stamp)
+    {
+      it->second.lastAccess = stamp;
+      this->latest = std::max(this->latest, stamp);
+    }
+  }
+  else if (op == '-' && it != this->entries.end())
+  {
+    this->totalBytes -= it->second.size;
+    this->entries.erase(it);
+  }
+}
+
+/////////////////////////////////////////////////
+void AssetCache::Implementation::Append(const std::string &_line) const
+{
+  std::ofstream file(this->indexPath, std::ios::binary | std::ios::app);
+  file << _line << '\n';
+  file.flush();
+  if (!file)
+  {
+    gzerr << "Unable to write asset cache index ["
+          << this->indexPath.string() << "].\n";
+    return;
+  }
+  this->offset += static_cast<std::streamoff>(_line.size() + 1);
+  ++this->lines;
+}
+
+/////////////////////////////////////////////////
+void AssetCache::Implementation::Compact() const
+{
+  const std::string newGeneration = Uuid().String();
+  std::ostringstream stream;
+  stream << kIndexMagic << ' ' << kIndexVersion << ' ' << newGeneration
+         << '\n';
+  for (const auto &entry : this->entries)
+  {
+    stream << "+ " << entry.first << ' ' << entry.second.size << ' '
+           << entry.second.lastAccess << '\n';
+  }
+  const std::string content = stream.str();
+
+  const fs::path temp = this->TemporaryPath();
+  {
+    std::ofstream file(temp, std::ios::binary);
+    file << content;
+    file.flush();
+    if (!file)
+    {
+      gzerr << "Unable to write asset cache index ["
+            << temp.string() << "].\n";
+      return;
+    }
+  }
+
+  std::error_code ec;
+  fs::rename(temp, this->indexPath, ec);
+  if (ec)
+  {
+    gzerr << "Unable to replace asset cache index ["
+          << this->indexPath.string() << "]: " << ec.message() << "\n";
+    fs::remove(temp, ec);
+    return;
+  }
+
+  this->generation = newGeneration;
+  this->offset = static_cast<std::streamoff>(content.size());
+  this->lines = this->entries.size();
+}
+
+/////////////////////////////////////////////////
+void AssetCache::Implementation::CompactIfNeeded()
+{
+  if (this->lines > 2 * this->entries.size() + 256)
+    this->Compact();
+}
+
+/////////////////////////////////////////////////
+int64_t AssetCache::Implementation::Stamp()
+{
+  this->latest = std::max(now(), this->latest + 1);
+  return this->latest;
+}
+
+/////////////////////////////////////////////////
+bool AssetCache::Implementation::RemoveBlob(const std::string &_key)
+{
+  auto it = this->entries.find(_key);
+  if (it == this->entries.end())
+    return true;
+
+  std::error_code ec;
+  fs::remove(this->BlobPath(_key), ec);
+  if (ec)
+    return false;
+
+  this->totalBytes -= it->second.size;
+  this->entries.erase(it);
+  this->Append("- " + _key);
+  return true;
+}
+
+/////////////////////////////////////////////////
+uintmax_t AssetCache::Implementation::EvictLocked(const std::string &_keep)
+{
+  if (this->maxBytes == 0 || this->totalBytes <= this->maxBytes)
+    return 0;
+
+  std::vector<std::pair<int64_t, std::string>> order;
+  order.reserve(this->entries.size());
+  for (const auto &entry : this->entries)
+  {
+    if (entry.first != _keep)
+      order.emplace_back(entry.second.lastAccess, entry.first);
+  }
+  std::sort(order.begin(), order.end());
+
+  uintmax_t removed = 0;
+  for (const auto &item : order)
+  {
+    if (this->totalBytes <= this->maxBytes)
+      break;
+    const uintmax_t size = this->entries[item.second].size;
+    if (this->RemoveBlob(item.second))
+      removed += size;
+  }
+  this->CompactIfNeeded();
+  return removed;
+}
+
+/////////////////////////////////////////////////
+bool AssetCache::Implementation::Commit(const std::string &_key,
+    const fs::path &_temp)
+{
+  std::error_code ec;
+  const uintmax_t size = fs::file_size(_temp, ec);
+  const fs::path blob = this->BlobPath(_key);
+  if (!ec)
+    fs::create_directories(blob.parent_path(), ec);
+  if (!ec)
+    fs::rename(_temp, blob, ec);
+  if (ec)
+  {
+    gzerr << "Unable to store asset cache blob [" << blob.string()
+          << "]: " << ec.message() << "\n";
+    fs::remove(_temp, ec);
+    return false;
+  }
+
+  auto it = this->entries.find(_key);
+  if (it != this->entries.end())
+    this->totalBytes -= it->second.size;
+  Entry &entry = this->entries[_key];
+  entry.size = size;
+  entry.lastAccess = this->Stamp();
+  this->totalBytes += size;
+  this->Append("+ " + _key + " " + std::to_string(size) + " " +
+      std::to_string(entry.lastAccess));
+
+  this->EvictLocked(_key);
+  this->CompactIfNeeded();
+  return true;
+}
+
+/////////////////////////////////////////////////
+fs::path AssetCache::Implementation::TemporaryPath() const
+{
+  return this->root / "tmp" / (Uuid().String() + ".tmp");
+}
+
+/////////////////////////////////////////////////
+fs::path AssetCache::Implementation::BlobPath(const std::string &_key) const
+{
+  return this->root / "blobs" / _key.substr(0, 2) / _key;
+}
+
+/////////////////////////////////////////////////
+AssetCache::AssetCache(const std::string &_root, uintmax_t _maxBytes)
+  : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
+{
+  this->dataPtr->root = fs::path(_root);
+  this->dataPtr->indexPath = this->dataPtr->root / "index";
+  this->dataPtr->maxBytes = _maxBytes;
+
+  std::error_code ec;
+  fs::create_directories(this->dataPtr->root / "blobs", ec);
+  if (!ec)
+    fs::create_directories(this->dataPtr->root / "tmp", ec);
+  if (ec || !this->dataPtr->fileLock.Open(
+        (this->dataPtr->root / "lock").string()))
+  {
+    gzerr << "Unable to open asset cache [" << _root << "].\n";
+    return;
+  }
+  this->dataPtr->valid = true;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::lock_guard<ProcessLock> fileLock(this->dataPtr->fileLock);
+
+  // Remove the temporary files of processes that stopped while writing
+  const auto staleTime = fs::file_time_type::clock::now() - kStaleTemporary;
+  for (fs::directory_iterator it(this->dataPtr->root / "tmp", ec), end;
+       !ec && it != end; it.increment(ec))
+  {
+    std::error_code entryEc;
+    if (it->last_write_time(entryEc) < staleTime && !entryEc)
+      fs::remove(it->path(), entryEc);
+  }
+
+  if (this->dataPtr->Sync())
+    this->dataPtr->EvictLocked("");
+}
+
+/////////////////////////////////////////////////
+bool AssetCache::Valid() const
+{
+  return this->dataPtr->valid;
+}
+
+/////////////////////////////////////////////////
+std::string AssetCache::Root() const
+{
+  return this->dataPtr->root.string();
+}
+
+/////////////////////////////////////////////////
+uintmax_t AssetCache::MaxBytes() const
+{
+  return this->dataPtr->maxBytes;
+}
+
+/////////////////////////////////////////////////
+void AssetCache::SetMaxBytes(uintmax_t _maxBytes)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->maxBytes = _maxBytes;
+  }
+  this->Evict();
+}
+
+/////////////////////////////////////////////////
+bool AssetCache::ValidKey(const std::string &_key)
+{
+  if (_key.size() < 2 || _key.size() > 128)
+    return false;
+  return std::all_of(_key.begin(), _key.end(), [](char _c)
+  {
+    return (_c >= '0' && _c <= '9') || (_c >= 'a' && _c <= 'z') ||
+           (_c >= 'A' && _c <= 'Z') || _c == '-' || _c == '_';
+  });
+}
+
+/////////////////////////////////////////////////
+std::string AssetCache::Insert(const std::string &_data)
+{
+  const std::string key = sha1(_data);
+  if (!this->dataPtr->valid)
+    return "";
+
+  // Same key, same content
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    std::lock_guard<ProcessLock> fileLock(this->dataPtr->fileLock);
+    if (!this->dataPtr->Sync())
+      return "";
+    auto it = this->dataPtr->entries.find(key);
+    std::error_code ec;
+    if (it != this->dataPtr->entries.end() &&
+        fs::exists(this->dataPtr->BlobPath(key), ec))
+    {
+      it->second.lastAccess = this->dataPtr->Stamp();
+      this->dataPtr->Append(
+          "a " + key + " " + std::to_string(it->second.lastAccess));
+      return key;
+    }
+  }
+
+  return this->Insert(key, _data) ? key : "";
+}
+
+/////////////////////////////////////////////////
+bool AssetCache::Insert(const std::string &_key, const std::string &_data)
+{
+  if (!this->dataPtr->valid)
+    return false;
+  if (!ValidKey(_key))
+  {
+    gzerr << "Invalid asset cache key [" << _key << "].\n";
+    return false;
+  }
+
+  // Write outside of the locks, the rename makes the blob visible
+  const fs::path temp = this->dataPtr->TemporaryPath();
+  {
+    std::ofstream file(temp, std::ios::binary);
+    file.write(_data.data(), static_cast<std::streamsize>(_data.size()));
+    file.flush();
+    if (!file)
+    {
+      gzerr << "Unable to write asset cache file [" << temp.string()
+            << "].\n";
+      std::error_code ec;
+      fs::remove(temp, ec);
+      return false;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::lock_guard<ProcessLock> fileLock(this->dataPtr->fileLock);
+  if (!this->dataPtr->Sync())
+  {
+    std::error_code ec;
+    fs::remove(temp, ec);
+    return false;
+  }
+  return this->dataPtr->Commit(_key, temp);
+}
+
+/////////////////////////////////////////////////
+bool AssetCache::InsertFile(const std::string &_key,
+    const std::string &_path)
+{
+  if (!this->dataPtr->valid)
+    return false;
+  if (!ValidKey(_key))
+  {
+    gzerr << "Invalid asset cache key [" << _key << "].\n";
+    return false;
+  }
+
+  const fs::path temp = this->dataPtr->TemporaryPath();
+  if (!isFile(_path) || !copyFile(_path, temp.string()))
+  {
+    gzerr << "Unable to copy [" << _path << "] to the asset cache.\n";
+    std::error_code ec;
+    fs::remove(temp, ec);
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::lock_guard<ProcessLock> fileLock(this->dataPtr->fileLock);
+  if (!this->dataPtr->Sync())
+  {
+    std::error_code ec;
+    fs::remove(temp, ec);
+    return false;
+  }
+  return this->dataPtr->Commit(_key, temp);
+}
+
+/////////////////////////////////////////////////
+bool AssetCache::Contains(const std::string &_key) const
+{
+  if (!this->dataPtr->valid)
+    return false;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::lock_guard<ProcessLock> fileLock(this->dataPtr->fileLock);
+  return this->dataPtr->Sync() &&
+      this->dataPtr->entries.count(_key) > 0;
+}
+
+/////////////////////////////////////////////////
+std::string AssetCache::Path(const std::string &_key)
+{
+  if (!this->dataPtr->valid || !ValidKey(_key))
+    return "";
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::lock_guard<ProcessLock> fileLock(this->dataPtr->fileLock);
+  if (!this->dataPtr->Sync())
+    return "";
+  auto it = this->dataPtr->entries.find(_key);
+  if (it == this->dataPtr->entries.end())
+    return "";
+
+  // The blob was deleted behind the cache's back
+  const fs::path blob = this->dataPtr->BlobPath(_key);
+  std::error_code ec;
+  if (!fs::exists(blob, ec))
+  {
+    this->dataPtr->RemoveBlob(_key);
+    return "";
+  }
+
+  it->second.lastAccess = this->dataPtr->Stamp();
+  this->dataPtr->Append(
+      "a " + _key + " " + std::to_string(it->second.lastAccess));
+  this->dataPtr->CompactIfNeeded();
+  return blob.string();
+}
+
+/////////////////////////////////////////////////
+bool AssetCache::Read(const std::string &_key, std::string &_data)
+{
+  const std::string path = this->Path(_key);
+  if (path.empty())
+    return false;
+
+  std::ifstream file(path, std::ios::binary);
+  if (!file)
+    return false;
+  _data.assign(std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>());
+  return !file.bad();
+}
+
+/////////////////////////////////////////////////
+bool AssetCache::Remove(const std::string &_key)
+{
+  if (!this->dataPtr->valid)
+    return false;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::lock_guard<ProcessLock> fileLock(this->dataPtr->fileLock);
+  if (!this->dataPtr->Sync() || this->dataPtr->entries.count(_key) == 0)
+    return false;
+  const bool result = this->dataPtr->RemoveBlob(_key);
+  this->dataPtr->CompactIfNeeded();
+  return result;
+}
+
+/////////////////////////////////////////////////
+void AssetCache::Clear()
+{
+  if (!this->dataPtr->valid)
+    return;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::lock_guard<ProcessLock> fileLock(this->dataPtr->fileLock);
+  if (!this->dataPtr->Sync())
+    return;
+  std::vector<std::string> keys;
+  keys.reserve(this->dataPtr->entries.size());
+  for (const auto &entry : this->dataPtr->entries)
+    keys.push_back(entry.first);
+  for (const auto &key : keys)
+    this->dataPtr->RemoveBlob(key);
+  this->dataPtr->Compact();
+}
+
+/////////////////////////////////////////////////
+uintmax_t AssetCache::Evict()
+{
+  if (!this->dataPtr->valid)
+    return 0;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::lock_guard<ProcessLock> fileLock(this->dataPtr->fileLock);
+  if (!this->dataPtr->Sync())
+    return 0;
+  return this->dataPtr->EvictLocked("");
+}
+
+/////////////////////////////////////////////////
+std::size_t AssetCache::Count() const
+{
+  if (!this->dataPtr->valid)
+    return 0;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::lock_guard<ProcessLock> fileLock(this->dataPtr->fileLock);
+  if (!this->dataPtr->Sync())
+    return 0;
+  return this->dataPtr->entries.size();
+}
+
+/////////////////////////////////////////////////
+uintmax_t AssetCache::Size() const
+{
+  if (!this->dataPtr->valid)
+    return 0;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::lock_guard<ProcessLock> fileLock(this->dataPtr->fileLock);
+  if (!this->dataPtr->Sync())
+    return 0;
+  return this->dataPtr->totalBytes;
+}
@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gz/common/AssetCache.hh"
+#include "gz/common/Filesystem.hh"
+#include "gz/common/Util.hh"
+#include "gz/common/testing/TestPaths.hh"
+
+using namespace gz;
+using namespace common;
+
+/////////////////////////////////////////////////
+TEST(AssetCache, InsertRead)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+  const std::string root = joinPaths(tempDir->Path(), "cache");
+
+  AssetCache cache(root);
+  ASSERT_TRUE(cache.Valid());
+  EXPECT_EQ(root, cache.Root());
+  EXPECT_EQ(0u, cache.Count());
+  EXPECT_EQ(0u, cache.Size());
+
+  // Content addressed
+  const std::string key = cache.Insert("mesh data");
+  EXPECT_EQ(sha1(std::string("mesh data")), key);
+  EXPECT_TRUE(cache.Contains(key));
+  std::string data;
+  EXPECT_TRUE(cache.Read(key, data));
+  EXPECT_EQ("mesh data", data);
+  EXPECT_TRUE(isFile(cache.Path(key)));
+  EXPECT_EQ(key, cache.Insert("mesh data"));
+  EXPECT_EQ(1u, cache.Count());
+  EXPECT_EQ(9u, cache.Size());
+
+  // Caller keys, replaced on insertion
+  EXPECT_TRUE(cache.Insert("lod_1", "12345"));
+  EXPECT_TRUE(cache.Insert("lod_1", "123"));
+  EXPECT_TRUE(cache.Read("lod_1", data));
+  EXPECT_EQ("123", data);
+  EXPECT_EQ(2u, cache.Count());
+  EXPECT_EQ(12u, cache.Size());
+
+  // Files
+  const std::string source = joinPaths(tempDir->Path(), "source.txt");
+  {
+    std::ofstream file(source, std::ios::binary);
+    file << "texture";
+  }
+  EXPECT_TRUE(cache.InsertFile("texture", source));
+  EXPECT_TRUE(cache.Read("texture", data));
+  EXPECT_EQ("texture", data);
+  EXPECT_FALSE(cache.InsertFile("missing", source + ".missing"));
+
+  // Invalid keys
+  EXPECT_TRUE(AssetCache::ValidKey("ab"));
+  EXPECT_FALSE(AssetCache::ValidKey("a"));
+  EXPECT_FALSE(AssetCache::ValidKey("../escape"));
+  EXPECT_FALSE(AssetCache::ValidKey(std::string(129, 'a')));
+  EXPECT_FALSE(cache.Insert("../escape", "data"));
+  EXPECT_TRUE(cache.Path("../escape").empty());
+
+  // Removal
+  EXPECT_TRUE(cache.Remove("lod_1"));
+  EXPECT_FALSE(cache.Remove("lod_1"));
+  EXPECT_FALSE(cache.Contains("lod_1"));
+  EXPECT_FALSE(cache.Read("lod_1", data));
+  EXPECT_TRUE(cache.Path("lod_1").empty());
+
+  // A blob deleted behind the cache's back is dropped
+  EXPECT_TRUE(removeFile(cache.Path("texture")));
+  EXPECT_TRUE(cache.Path("texture").empty());
+  EXPECT_FALSE(cache.Contains("texture"));
+
+  cache.Clear();
+  EXPECT_EQ(0u, cache.Count());
+  EXPECT_EQ(0u, cache.Size());
+  EXPECT_FALSE(cache.Contains(key));
+}
+
+/////////////////////////////////////////////////
+TEST(AssetCache, Evict)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+
+  AssetCache cache(tempDir->Path(), 100);
+  EXPECT_EQ(100u, cache.MaxBytes());
+  EXPECT_TRUE(cache.Insert("k0", std::string(40, '0')));
+  EXPECT_TRUE(cache.Insert("k1", std::string(40, '1')));
+
+  // Use the first blob, the second one is now the least recently used
+  EXPECT_FALSE(cache.Path("k0").empty());
+  EXPECT_TRUE(cache.Insert("k2", std::string(40, '2')));
+  EXPECT_TRUE(cache.Contains("k0"));
+  EXPECT_FALSE(cache.Contains("k1"));
+  EXPECT_TRUE(cache.Contains("k2"));
+  EXPECT_EQ(80u, cache.Size());
+
+  // A blob larger than the budget evicts all others but is kept
+  EXPECT_TRUE(cache.Insert("big", std::string(150, 'b')));
+  EXPECT_EQ(1u, cache.Count());
+  EXPECT_TRUE(cache.Contains("big"));
+
+  cache.SetMaxBytes(0);
+  EXPECT_TRUE(cache.Insert("k3", std::string(40, '3')));
+  EXPECT_EQ(2u, cache.Count());
+  EXPECT_EQ(0u, cache.Evict());
+
+  cache.SetMaxBytes(50);
+  EXPECT_EQ(1u, cache.Count());
+  EXPECT_TRUE(cache.Contains("k3"));
+}
+
+/////////////////////////////////////////////////
+TEST(AssetCache, SharedIndex)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+
+  AssetCache first(tempDir->Path());
+  AssetCache second(tempDir->Path());
+  EXPECT_TRUE(first.Insert("shared", "abc"));
+  EXPECT_TRUE(second.Contains("shared"));
+  EXPECT_TRUE(second.Remove("shared"));
+  EXPECT_FALSE(first.Contains("shared"));
+
+  // Enough accesses to rewrite the index
+  EXPECT_TRUE(first.Insert("hot", "hot"));
+  EXPECT_TRUE(second.Insert("cold", "cold"));
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_FALSE(first.Path("hot").empty());
+  EXPECT_EQ(2u, second.Count());
+  EXPECT_EQ(7u, second.Size());
+
+  // Access times are shared: "cold" is evicted first
+  second.SetMaxBytes(5);
+  EXPECT_TRUE(first.Contains("hot"));
+  EXPECT_FALSE(first.Contains("cold"));
+
+  // Reopened from disk
+  AssetCache reopened(tempDir->Path());
+  EXPECT_EQ(1u, reopened.Count());
+  EXPECT_EQ(3u, reopened.Size());
+  std::string data;
+  EXPECT_TRUE(reopened.Read("hot", data));
+  EXPECT_EQ("hot", data);
+}
+
+/////////////////////////////////////////////////
+TEST(AssetCache, Threads)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+
+  AssetCache first(tempDir->Path());
+  AssetCache second(tempDir->Path());
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t)
+  {
+    threads.emplace_back([&, t]()
+    {
+      AssetCache &cache = (t % 2) ? first : second;
+      for (int i = 0; i < 50; ++i)
+      {
+        const std::string key = "t" + std::to_string(t) + "_" +
+            std::to_string(i);
+        EXPECT_TRUE(cache.Insert(key, key));
+        std::string data;
+        EXPECT_TRUE(cache.Read(key, data));
+        EXPECT_EQ(key, data);
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_EQ(400u, first.Count());
+  EXPECT_EQ(400u, second.Count());
+  EXPECT_EQ(first.Size(), second.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(AssetCache, Invalid)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+  const std::string file = joinPaths(tempDir->Path(), "file");
+  {
+    std::ofstream stream(file);
+    stream << "not a directory";
+  }
+
+  AssetCache cache(file);
+  EXPECT_FALSE(cache.Valid());
+  EXPECT_TRUE(cache.Insert("data").empty());
+  EXPECT_FALSE(cache.Contains(sha1(std::string("data"))));
+  EXPECT_EQ(0u, cache.Count());
+}
+
+/////////////////////////////////////////////////
+TEST(AssetCache, CorruptIndex)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+  const std::string root = joinPaths(tempDir->Path(), "cache");
+  const std::string victim = joinPaths(tempDir->Path(), "victim");
+  {
+    std::ofstream stream(victim);
+    stream << "not in the cache";
+  }
+
+  AssetCache cache(root);
+  EXPECT_TRUE(cache.Insert("keep", "keep"));
+
+  // Keys pointing outside the cache are ignored
+  {
+    std::ofstream stream(joinPaths(root, "index"), std::ios::app);
+    stream << "+ ../victim 16 1\n";
+  }
+  EXPECT_EQ(1u, cache.Count());
+  cache.Clear();
+  EXPECT_TRUE(exists(victim));
+  EXPECT_EQ(0u, cache.Count());
+}
+
+/////////////////////////////////////////////////
+TEST(AssetCache, UnknownVersion)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+  const std::string root = joinPaths(tempDir->Path(), "cache");
+
+  AssetCache cache(root);
+  EXPECT_TRUE(cache.Insert("keep", "keep"));
+  const std::string blob = cache.Path("keep");
+  ASSERT_FALSE(blob.empty());
+
+  // An index written by a newer version
+  const std::string index = joinPaths(root, "index");
+  const std::string content = "gz-asset-cache 99 generation\n+ keep 4 1\n";
+  {
+    std::ofstream stream(index, std::ios::trunc);
+    stream << content;
+  }
+
+  // The cache is not used and is left as is
+  AssetCache reopened(root);
+  EXPECT_FALSE(reopened.Valid());
+  EXPECT_FALSE(reopened.Contains("keep"));
+  EXPECT_EQ(0u, reopened.Evict());
+
+  EXPECT_FALSE(cache.Contains("keep"));
+  EXPECT_FALSE(cache.Valid());
+  EXPECT_FALSE(cache.Insert("other", "other"));
+  cache.Clear();
+
+  EXPECT_TRUE(exists(blob));
+  std::ifstream stream(index);
+  const std::string read((std::istreambuf_iterator<char>(stream)),
+      std::istreambuf_iterator<char>());
+  EXPECT_EQ(content, read);
+}
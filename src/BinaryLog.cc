@@ -0,0 +1,879 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <new>
+#include <set>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <gz/utils/NeverDestroyed.hh>
+
+#include "gz/common/BinaryLog.hh"
+#include "gz/common/Console.hh"
+#include "gz/common/Util.hh"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace gz;
+using namespace common;
+
+static_assert(sizeof(BinaryLogRecord) == BinaryLogRecord::kSize,
+    "BinaryLogRecord must have a fixed on-disk size");
+
+namespace
+{
+/// \brief Magic bytes at the start of a BinaryLog file.
+constexpr char kMagic[8] = {'G', 'Z', 'B', 'L', 'O', 'G', '\0', '\1'};
+
+/// \brief Version of the file layout.
+constexpr uint32_t kVersion = 1;
+
+/// \brief Size reserved for the file header, records start after it.
+constexpr std::size_t kHeaderSize = 4096;
+
+/// \brief Header of a BinaryLog file.
+struct BinaryLogHeader
+{
+  /// \brief Magic bytes, see kMagic.
+  char magic[8];
+
+  /// \brief File layout version.
+  uint32_t version;
+
+  /// \brief Size of a record in bytes.
+  uint32_t recordSize;
+
+  /// \brief Number of record slots in the ring.
+  uint64_t capacity;
+
+  /// \brief Sequence number of the next record to write.
+  std::atomic<uint64_t> next;
+};
+
+/// \brief Description of a call site.
+struct CallSite
+{
+  /// \brief Source file.
+  std::string file;
+
+  /// \brief Source line.
+  int line = 0;
+
+  /// \brief Verbosity level.
+  int level = 0;
+
+  /// \brief Format string.
+  std::string format;
+};
+
+/// \brief Process-wide call site registry.
+struct CallSiteRegistry
+{
+  /// \brief Constructor, registers the text call site.
+  CallSiteRegistry()
+  {
+    this->sites.push_back(CallSite{"", 0, 0, "{}"});
+  }
+
+  /// \brief Protects all members.
+  std::mutex mutex;
+
+  /// \brief Registered call sites, indexed by identifier.
+  std::vector<CallSite> sites;
+
+  /// \brief Sidecar streams of all open logs.
+  std::set<std::ofstream *> openLogs;
+};
+
+/////////////////////////////////////////////////
+CallSiteRegistry &registry()
+{
+  static gz::utils::NeverDestroyed<CallSiteRegistry> reg;
+  return reg.Access();
+}
+
+/////////////////////////////////////////////////
+/// \brief Escape tabs, newlines and backslashes for the sidecar file.
+std::string escapeField(const std::string &_str)
+{
+  std::string out;
+  out.reserve(_str.size());
+  for (char c : _str)
+  {
+    if (c == '\\')
+      out += "\\\\";
+    else if (c == '\t')
+      out += "\\t";
+    else if (c == '\n')
+      out += "\\n";
+    else
+      out += c;
+  }
+  return out;
+}
+
+/////////////////////////////////////////////////
+/// \brief Reverse escapeField.
+std::string unescapeField(const std::string &_str)
+{
+  std::string out;
+  out.reserve(_str.size());
+  for (std::size_t i = 0; i < _str.size(); ++i)
+  {
+    if (_str[i] == '\\' && i + 1 < _str.size())
+    {
+      ++i;
+      out += _str[i] == 't' ? '\t' : (_str[i] == 'n' ? '\n' : _str[i]);
+    }
+    else
+    {
+      out += _str[i];
+    }
+  }
+  return out;
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse a whole field of the sidecar file as a number.
+/// \param[in] _str Field to parse.
+/// \param[out] _value Parsed value.
+/// \return False if the field is not a number of the type of _value.
+template<typename T>
+bool parseNumber(const std::string &_str, T &_value)
+{
+  const char *end = _str.data() + _str.size();
+  auto result = std::from_chars(_str.data(), end, _value);
+  return result.ec == std::errc() && result.ptr == end;
+}
+
+/////////////////////////////////////////////////
+/// \brief Write a call site description line to a sidecar stream.
+void writeCallSite(std::ofstream &_out, const std::size_t _id,
+    const CallSite &_site)
+{
+  _out << _id << '\t' << _site.level << '\t' << _site.line << '\t'
+       << escapeField(_site.file) << '\t' << escapeField(_site.format)
+       << '\n';
+  _out.flush();
+}
+
+/////////////////////////////////////////////////
+/// \brief Identifier of the calling thread.
+uint64_t threadId()
+{
+  thread_local const uint64_t id =
+    std::hash<std::thread::id>()(std::this_thread::get_id());
+  return id;
+}
+
+/////////////////////////////////////////////////
+/// \brief Current wall time in nanoseconds since the epoch.
+uint64_t nowNs()
+{
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+}
+
+/////////////////////////////////////////////////
+class gz::common::BinaryLog::Implementation
+{
+  /// \brief Path of the ring file.
+  public: std::string path;
+
+  /// \brief Sidecar file with call site descriptions.
+  public: std::ofstream sites;
+
+  /// \brief Start of the file image.
+  public: char *base = nullptr;
+
+  /// \brief Size of the file image.
+  public: std::size_t size = 0;
+
+  /// \brief File header, inside the image.
+  public: BinaryLogHeader *header = nullptr;
+
+  /// \brief First record slot, inside the image.
+  public: BinaryLogRecord *records = nullptr;
+
+  /// \brief Number of record slots.
+  public: uint64_t capacity = 0;
+
+#ifndef _WIN32
+  /// \brief File descriptor of the mapped file.
+  public: int fd = -1;
+#else
+  /// \brief Without mmap, the image is kept in memory and written to disk
+  /// on Flush and Close.
+  public: std::vector<char> buffer;
+#endif
+};
+
+/////////////////////////////////////////////////
+BinaryLog::BinaryLog()
+  : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+BinaryLog::~BinaryLog()
+{
+  this->Close();
+}
+
+/////////////////////////////////////////////////
+bool BinaryLog::Open(const std::string &_path, const uint64_t _capacity)
+{
+  this->Close();
+
+  if (_path.empty() || _capacity == 0)
+  {
+    gzerr << "Unable to open binary log: invalid path or capacity.\n";
+    return false;
+  }
+
+  const std::size_t size = kHeaderSize +
+    static_cast<std::size_t>(_capacity) * BinaryLogRecord::kSize;
+
+#ifndef _WIN32
+  int fd = ::open(_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+  {
+    gzerr << "Unable to open binary log [" << _path << "].\n";
+    return false;
+  }
+
+  if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+  {
+    gzerr << "Unable to size binary log [" << _path << "].\n";
+    ::close(fd);
+    return false;
+  }
+
+  void *base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+      fd, 0);
+  if (base == MAP_FAILED)
+  {
+    gzerr << "Unable to map binary log [" << _path << "].\n";
+    ::close(fd);
+    return false;
+  }
+  this->dataPtr->fd = fd;
+  this->dataPtr->base = static_cast<char *>(base);
+#else
+  this->dataPtr->buffer.assign(size, 0);
+  this->dataPtr->base = this->dataPtr->buffer.data();
+#endif
+
+  this->dataPtr->path = _path;
+  this->dataPtr->size = size;
+  this->dataPtr->capacity = _capacity;
+  this->dataPtr->header =
+    new (this->dataPtr->base) BinaryLogHeader;
+  std::memcpy(this->dataPtr->header->magic, kMagic, sizeof(kMagic));
+  this->dataPtr->header->version = kVersion;
+  this->dataPtr->header->recordSize = BinaryLogRecord::kSize;
+  this->dataPtr->header->capacity = _capacity;
+  this->dataPtr->header->next.store(0);
+
+  // A freshly sized file is zero filled, so all sequences read as unwritten
+  this->dataPtr->records = reinterpret_cast<BinaryLogRecord *>(
+      this->dataPtr->base + kHeaderSize);
+
+  // Describe all call sites registered so far, and follow new ones
+  auto &reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  this->dataPtr->sites.open(_path + ".sites",
+      std::ios::out | std::ios::trunc);
+  for (std::size_t i = 0; i < reg.sites.size(); ++i)
+    writeCallSite(this->dataPtr->sites, i, reg.sites[i]);
+  reg.openLogs.insert(&this->dataPtr->sites);
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void BinaryLog::Close()
+{
+  if (!this->dataPtr->base)
+    return;
+
+  {
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.openLogs.erase(&this->dataPtr->sites);
+    this->dataPtr->sites.close();
+  }
+
+  this->Flush();
+
+#ifndef _WIN32
+  ::munmap(this->dataPtr->base, this->dataPtr->size);
+  ::close(this->dataPtr->fd);
+  this->dataPtr->fd = -1;
+#else
+  this->dataPtr->buffer.clear();
+  this->dataPtr->buffer.shrink_to_fit();
+#endif
+
+  this->dataPtr->base = nullptr;
+  this->dataPtr->header = nullptr;
+  this->dataPtr->records = nullptr;
+  this->dataPtr->size = 0;
+  this->dataPtr->capacity = 0;
+  this->dataPtr->path.clear();
+}
+
+/////////////////////////////////////////////////
+void BinaryLog::Flush()
+{
+  if (!this->dataPtr->base)
+    return;
+
+#ifndef _WIN32
+  ::msync(this->dataPtr->base, this->dataPtr->size, MS_ASYNC);
+#else
+  std::ofstream out(this->dataPtr->path,
+      std::ios::out | std::ios::binary | std::ios::trunc);
+  out.write(this->dataPtr->base,
+      static_cast<std::streamsize>(this->dataPtr->size));
+#endif
+}
+
+/////////////////////////////////////////////////
+bool BinaryLog::Valid() const
+{
+  return this->dataPtr->base != nullptr;
+}
+
+/////////////////////////////////////////////////
+std::string BinaryLog::Path() const
+{
+  return this->dataPtr->path;
+}
+
+/////////////////////////////////////////////////
+uint64_t BinaryLog::RecordCount() const
+{
+  if (!this->dataPtr->header)
+    return 0;
+  return this->dataPtr->header->next.load(std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+uint32_t BinaryLog::RegisterCallSite(const char *_file, const int _line,
+    const int _level, const char *_format)
+{
+  auto &reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+
+  CallSite site;
+  site.file = _file ? _file : "";
+  site.line = _line;
+  site.level = _level;
+  site.format = _format ? _format : "";
+
+  const std::size_t id = reg.sites.size();
+  for (auto *out : reg.openLogs)
+    writeCallSite(*out, id, site);
+  reg.sites.push_back(std::move(site));
+
+  return static_cast<uint32_t>(id);
+}
+
+/////////////////////////////////////////////////
+BinaryLogRecord *BinaryLog::Reserve(const int _level,
+    const uint32_t _callSite, uint64_t &_sequence)
+{
+  if (!this->dataPtr->records)
+    return nullptr;
+
+  _sequence =
+    this->dataPtr->header->next.fetch_add(1, std::memory_order_relaxed);
+
+  BinaryLogRecord *record =
+    &this->dataPtr->records[_sequence % this->dataPtr->capacity];
+  record->sequence.store(0, std::memory_order_relaxed);
+  // Readers must see the slot as unwritten before any of the new fields
+  std::atomic_thread_fence(std::memory_order_release);
+  record->timeNs = nowNs();
+  record->threadId = threadId();
+  record->callSite = _callSite;
+  record->level = static_cast<uint8_t>(_level);
+  record->flags = 0;
+  record->payloadSize = 0;
+  return record;
+}
+
+/////////////////////////////////////////////////
+void BinaryLog::Commit(BinaryLogRecord *_record, const uint64_t _sequence)
+{
+  _record->sequence.store(_sequence + 1, std::memory_order_release);
+}
+
+/////////////////////////////////////////////////
+void BinaryLog::Encode(BinaryLogRecord &_record, const char _tag,
+    const void *_data, const std::size_t _size)
+{
+  const std::size_t used = _record.payloadSize;
+  const std::size_t available = BinaryLogRecord::kPayloadSize - used;
+  const bool isString = _tag == 's';
+
+  // Tag, optional string length, then the raw bytes
+  const std::size_t overhead = isString ? 2u : 1u;
+  if (available < overhead || (!isString && available < overhead + _size))
+  {
+    _record.flags |= BinaryLogRecord::kTruncated;
+    return;
+  }
+
+  std::size_t size = std::min(_size, available - overhead);
+  size = std::min<std::size_t>(size, std::numeric_limits<uint8_t>::max());
+  if (size < _size)
+    _record.flags |= BinaryLogRecord::kTruncated;
+
+  char *out = _record.payload + used;
+  *out++ = _tag;
+  if (isString)
+    *out++ = static_cast<char>(static_cast<uint8_t>(size));
+  if (size > 0)
+    std::memcpy(out, _data, size);
+
+  _record.payloadSize = static_cast<uint16_t>(used + overhead + size);
+}
+
+/////////////////////////////////////////////////
+bool BinaryLog::WriteText(const int _level, const std::string &_text)
+{
+  if (!this->dataPtr->records)
+    return false;
+
+  const std::size_t chunk = BinaryLogRecord::kPayloadSize;
+  const uint64_t count = std::max<uint64_t>(1u,
+      (_text.size() + chunk - 1) / chunk);
+
+  // The parts of a longer message would overwrite each other
+  if (count > this->dataPtr->capacity)
+    return false;
+
+  // Reserve consecutive sequence numbers so the parts stay together
+  const uint64_t first =
+    this->dataPtr->header->next.fetch_add(count, std::memory_order_relaxed);
+  const uint64_t time = nowNs();
+
+  for (uint64_t i = 0; i < count; ++i)
+  {
+    const uint64_t sequence = first + i;
+    BinaryLogRecord &record =
+      this->dataPtr->records[sequence % this->dataPtr->capacity];
+    record.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    record.timeNs = time;
+    record.threadId = threadId();
+    record.callSite = kTextCallSite;
+    record.level = static_cast<uint8_t>(_level);
+    record.flags = i + 1 < count ? BinaryLogRecord::kContinued : 0;
+
+    const std::size_t offset = static_cast<std::size_t>(i) * chunk;
+    const std::size_t size = std::min(chunk, _text.size() - offset);
+    record.payloadSize = static_cast<uint16_t>(size);
+    if (size > 0)
+      std::memcpy(record.payload, _text.data() + offset, size);
+
+    Commit(&record, sequence);
+  }
+  return true;
+}
+
+namespace
+{
+/// \brief A decoded argument.
+struct DecodedArg
+{
+  /// \brief Text representation.
+  std::string text;
+
+  /// \brief True if the argument is a string, to quote it in JSON.
+  bool isString = false;
+};
+
+/////////////////////////////////////////////////
+/// \brief Decode the arguments of a record payload.
+std::vector<DecodedArg> decodeArgs(const BinaryLogRecord &_record)
+{
+  std::vector<DecodedArg> args;
+  const char *p = _record.payload;
+  const char *end = _record.payload +
+    std::min<std::size_t>(_record.payloadSize, BinaryLogRecord::kPayloadSize);
+
+  while (p < end)
+  {
+    const char tag = *p++;
+    DecodedArg arg;
+    std::ostringstream ss;
+    switch (tag)
+    {
+      case 'b':
+        if (end - p < 1)
+          return args;
+        ss << (*p ? "true" : "false");
+        p += 1;
+        break;
+      case 'c':
+        if (end - p < 1)
+          return args;
+        arg.isString = true;
+        ss << *p;
+        p += 1;
+        break;
+      case 'i':
+      {
+        int64_t v;
+        if (end - p < static_cast<std::ptrdiff_t>(sizeof(v)))
+          return args;
+        std::memcpy(&v, p, sizeof(v));
+        ss << v;
+        p += sizeof(v);
+        break;
+      }
+      case 'u':
+      {
+        uint64_t v;
+        if (end - p < static_cast<std::ptrdiff_t>(sizeof(v)))
+          return args;
+        std::memcpy(&v, p, sizeof(v));
+        ss << v;
+        p += sizeof(v);
+        break;
+      }
+      case 'd':
+      {
+        double v;
+        if (end - p < static_cast<std::ptrdiff_t>(sizeof(v)))
+          return args;
+        std::memcpy(&v, p, sizeof(v));
+        if (!std::isfinite(v))
+          arg.isString = true;
+        ss << std::setprecision(std::numeric_limits<double>::max_digits10)
+           << v;
+        p += sizeof(v);
+        break;
+      }
+      case 's':
+      {
+        if (end - p < 1)
+          return args;
+        const std::size_t size = static_cast<uint8_t>(*p++);
+        if (end - p < static_cast<std::ptrdiff_t>(size))
+          return args;
+        arg.isString = true;
+        ss << std::string(p, size);
+        p += size;
+        break;
+      }
+      default:
+        return args;
+    }
+    arg.text = ss.str();
+    args.push_back(std::move(arg));
+  }
+  return args;
+}
+
+/////////////////////////////////////////////////
+/// \brief Substitute "{}" placeholders with arguments. Arguments without a
+/// placeholder are appended.
+std::string formatMessage(const std::string &_format,
+    const std::vector<DecodedArg> &_args)
+{
+  std::string out;
+  std::size_t argIndex = 0;
+  std::size_t pos = 0;
+  while (pos < _format.size())
+  {
+    auto found = _format.find("{}", pos);
+    if (found == std::string::npos || argIndex >= _args.size())
+    {
+      out += _format.substr(pos);
+      break;
+    }
+    out += _format.substr(pos, found - pos);
+    out += _args[argIndex++].text;
+    pos = found + 2;
+  }
+  for (; argIndex < _args.size(); ++argIndex)
+    out += " " + _args[argIndex].text;
+  return out;
+}
+
+/////////////////////////////////////////////////
+/// \brief Escape a string for JSON output.
+std::string jsonEscape(const std::string &_str)
+{
+  std::ostringstream out;
+  for (unsigned char c : _str)
+  {
+    switch (c)
+    {
+      case '"': out << "\\\""; break;
+      case '\\': out << "\\\\"; break;
+      case '\n': out << "\\n"; break;
+      case '\r': out << "\\r"; break;
+      case '\t': out << "\\t"; break;
+      default:
+        if (c < 0x20)
+        {
+          out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+              << static_cast<int>(c) << std::dec;
+        }
+        else
+        {
+          out << c;
+        }
+    }
+  }
+  return out.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Name of a verbosity level, matching the Console prefixes.
+std::string levelName(const int _level)
+{
+  switch (_level)
+  {
+    case 1: return "Err";
+    case 2: return "Wrn";
+    case 3: return "Msg";
+    case 4: return "Dbg";
+    default: return "Log";
+  }
+}
+}
+
+/////////////////////////////////////////////////
+bool common::decodeBinaryLog(const std::string &_path, std::ostream &_out,
+    const BinaryLogFormat _format)
+{
+  std::ifstream in(_path, std::ios::in | std::ios::binary);
+  if (!in)
+  {
+    gzerr << "Unable to open binary log [" << _path << "].\n";
+    return false;
+  }
+
+  alignas(BinaryLogHeader) char headerBytes[kHeaderSize];
+  if (!in.read(headerBytes, sizeof(headerBytes)) ||
+      std::memcmp(headerBytes, kMagic, sizeof(kMagic)) != 0)
+  {
+    gzerr << "[" << _path << "] is not a binary log.\n";
+    return false;
+  }
+
+  const auto *header = reinterpret_cast<const BinaryLogHeader *>(headerBytes);
+  if (header->version != kVersion ||
+      header->recordSize != BinaryLogRecord::kSize)
+  {
+    gzerr << "Unsupported binary log version [" << header->version << "].\n";
+    return false;
+  }
+
+  // Operator new storage is suitably aligned for records
+  std::vector<char> raw(
+      static_cast<std::size_t>(header->capacity) * BinaryLogRecord::kSize);
+  in.read(raw.data(), static_cast<std::streamsize>(raw.size()));
+  const std::size_t recordCount =
+    static_cast<std::size_t>(in.gcount()) / BinaryLogRecord::kSize;
+  const auto *records = reinterpret_cast<const BinaryLogRecord *>(raw.data());
+
+  // A live log may reuse a slot while it is being copied. Read the records
+  // again and drop any whose sequence changed in between.
+  std::vector<char> check(raw.size());
+  in.clear();
+  in.seekg(kHeaderSize);
+  in.read(check.data(), static_cast<std::streamsize>(check.size()));
+  const std::size_t checkCount = std::min(recordCount,
+      static_cast<std::size_t>(in.gcount()) / BinaryLogRecord::kSize);
+  const auto *checkRecords =
+    reinterpret_cast<const BinaryLogRecord *>(check.data());
+
+  // Load call sites
+  std::map<uint32_t, CallSite> sites;
+  std::ifstream sitesIn(_path + ".sites");
+  std::string line;
+  while (std::getline(sitesIn, line))
+  {
+    std::vector<std::string> fields;
+    std::size_t start = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+      auto tab = line.find('\t', start);
+      if (tab == std::string::npos)
+        break;
+      fields.push_back(line.substr(start, tab - start));
+      start = tab + 1;
+    }
+    if (fields.size() != 4)
+      continue;
+    fields.push_back(line.substr(start));
+
+    uint32_t id = 0;
+    CallSite site;
+    if (!parseNumber(fields[0], id) || !parseNumber(fields[1], site.level) ||
+        !parseNumber(fields[2], site.line))
+    {
+      gzerr << "Invalid call site [" << line << "] in [" << _path
+            << ".sites].\n";
+      return false;
+    }
+    site.file = unescapeField(fields[3]);
+    site.format = unescapeField(fields[4]);
+    sites[id] = site;
+  }
+
+  // Order the valid records
+  std::vector<const BinaryLogRecord *> ordered;
+  ordered.reserve(recordCount);
+  for (std::size_t i = 0; i < checkCount; ++i)
+  {
+    const uint64_t sequence =
+      records[i].sequence.load(std::memory_order_relaxed);
+    if (sequence != 0 &&
+        sequence == checkRecords[i].sequence.load(std::memory_order_relaxed))
+    {
+      ordered.push_back(&records[i]);
+    }
+  }
+  std::sort(ordered.begin(), ordered.end(),
+      [](const BinaryLogRecord *_a, const BinaryLogRecord *_b)
+      {
+        return _a->sequence.load(std::memory_order_relaxed) <
+               _b->sequence.load(std::memory_order_relaxed);
+      });
+
+  for (std::size_t i = 0; i < ordered.size(); ++i)
+  {
+    const BinaryLogRecord &record = *ordered[i];
+    std::string message;
+    std::vector<DecodedArg> args;
+    CallSite site;
+    bool truncated = (record.flags & BinaryLogRecord::kTruncated) != 0;
+
+    if (record.callSite == BinaryLog::kTextCallSite)
+    {
+      // Join the parts of a split text message
+      message.assign(record.payload, std::min<std::size_t>(
+            record.payloadSize, BinaryLogRecord::kPayloadSize));
+      uint64_t expected = record.sequence.load(std::memory_order_relaxed);
+      const BinaryLogRecord *part = &record;
+      while ((part->flags & BinaryLogRecord::kContinued) &&
+             i + 1 < ordered.size() &&
+             ordered[i + 1]->sequence.load(std::memory_order_relaxed) ==
+               ++expected)
+      {
+        part = ordered[++i];
+        message.append(part->payload, std::min<std::size_t>(
+              part->payloadSize, BinaryLogRecord::kPayloadSize));
+      }
+      truncated = truncated || (part->flags & BinaryLogRecord::kContinued);
+    }
+    else
+    {
+      auto it = sites.find(record.callSite);
+      if (it != sites.end())
+        site = it->second;
+      else
+        site.format = "<unknown call site " +
+          std::to_string(record.callSite) + ">";
+      args = decodeArgs(record);
+      message = formatMessage(site.format, args);
+    }
+
+    const auto time = std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          std::chrono::nanoseconds(record.timeNs)));
+    const std::size_t fileIndex = site.file.find_last_of("/\\");
+    const std::string file = fileIndex == std::string::npos ?
+      site.file : site.file.substr(fileIndex + 1);
+
+    if (_format == BinaryLogFormat::JSON)
+    {
+      _out << "{\"seq\":" << record.sequence.load() - 1
+           << ",\"time_ns\":" << record.timeNs
+           << ",\"time\":\"" << timeToIso(time) << "\""
+           << ",\"thread\":" << record.threadId
+           << ",\"level\":" << static_cast<int>(record.level)
+           << ",\"call_site\":" << record.callSite;
+      if (!site.file.empty())
+      {
+        _out << ",\"file\":\"" << jsonEscape(site.file) << "\""
+             << ",\"line\":" << site.line;
+      }
+      _out << ",\"message\":\"" << jsonEscape(message) << "\"";
+      if (!args.empty())
+      {
+        _out << ",\"args\":[";
+        for (std::size_t a = 0; a < args.size(); ++a)
+        {
+          if (a > 0)
+            _out << ",";
+          if (args[a].isString)
+            _out << "\"" << jsonEscape(args[a].text) << "\"";
+          else
+            _out << args[a].text;
+        }
+        _out << "]";
+      }
+      if (truncated)
+        _out << ",\"truncated\":true";
+      _out << "}\n";
+    }
+    else
+    {
+      _out << "(" << timeToIso(time) << ") [" << std::hex << record.threadId
+           << std::dec << "] ";
+      // Text records written by Console already carry their level prefix
+      if (record.callSite != BinaryLog::kTextCallSite)
+        _out << "[" << levelName(record.level) << "] ";
+      if (!file.empty())
+        _out << "[" << file << ":" << site.line << "] ";
+      _out << message;
+      if (truncated)
+        _out << " [truncated]";
+      _out << "\n";
+    }
+  }
+
+  return true;
+}
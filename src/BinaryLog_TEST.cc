@@ -0,0 +1,385 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gz/common/BinaryLog.hh"
+#include "gz/common/Console.hh"
+#include "gz/common/Filesystem.hh"
+#include "gz/common/testing/TestPaths.hh"
+
+using namespace gz;
+using namespace common;
+
+/////////////////////////////////////////////////
+/// \brief Count the lines of a string
+std::size_t lineCount(const std::string &_str)
+{
+  return static_cast<std::size_t>(
+      std::count(_str.begin(), _str.end(), '\n'));
+}
+
+/////////////////////////////////////////////////
+TEST(BinaryLog, OpenClose)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+  auto path = joinPaths(tempDir->Path(), "test.gzblog");
+
+  BinaryLog log;
+  EXPECT_FALSE(log.Valid());
+  EXPECT_FALSE(log.Open("", 16));
+  EXPECT_FALSE(log.Open(path, 0));
+
+  EXPECT_TRUE(log.Open(path, 16));
+  EXPECT_TRUE(log.Valid());
+  EXPECT_EQ(path, log.Path());
+  EXPECT_TRUE(exists(path));
+  EXPECT_TRUE(exists(path + ".sites"));
+  EXPECT_EQ(0u, log.RecordCount());
+
+  log.Close();
+  EXPECT_FALSE(log.Valid());
+  EXPECT_TRUE(log.Path().empty());
+
+  // Writing to a closed log does nothing
+  gzbinlog(log, 3, "ignored {}", 1);
+  EXPECT_EQ(0u, log.RecordCount());
+
+  // Not a binary log
+  std::ostringstream out;
+  EXPECT_FALSE(decodeBinaryLog(path + ".sites", out));
+}
+
+/////////////////////////////////////////////////
+TEST(BinaryLog, Args)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+  auto path = joinPaths(tempDir->Path(), "test.gzblog");
+
+  BinaryLog log;
+  ASSERT_TRUE(log.Open(path, 64));
+
+  std::string name = "box";
+  gzbinlog(log, 3, "loaded {} with {} vertices in {} ms", name, 24, 1.5);
+  gzbinlog(log, 1, "flags {} {} {}", true, 'x', -7);
+  gzbinlog(log, 4, "no arguments");
+  gzbinlog(log, 2, "quote \"{}\"", "tab\there");
+  EXPECT_EQ(4u, log.RecordCount());
+  log.Flush();
+
+  std::ostringstream text;
+  ASSERT_TRUE(decodeBinaryLog(path, text, BinaryLogFormat::TEXT));
+  auto str = text.str();
+  EXPECT_EQ(4u, lineCount(str)) << str;
+  EXPECT_NE(std::string::npos,
+      str.find("[Msg] [BinaryLog_TEST.cc:"));
+  EXPECT_NE(std::string::npos,
+      str.find("loaded box with 24 vertices in 1.5 ms"));
+  EXPECT_NE(std::string::npos, str.find("[Err] "));
+  EXPECT_NE(std::string::npos, str.find("flags true x -7"));
+  EXPECT_NE(std::string::npos, str.find("no arguments"));
+
+  std::ostringstream json;
+  ASSERT_TRUE(decodeBinaryLog(path, json, BinaryLogFormat::JSON));
+  str = json.str();
+  EXPECT_EQ(4u, lineCount(str)) << str;
+  EXPECT_NE(std::string::npos, str.find("\"seq\":0,"));
+  EXPECT_NE(std::string::npos, str.find("\"level\":3"));
+  EXPECT_NE(std::string::npos, str.find("\"args\":[\"box\",24,1.5]"));
+  EXPECT_NE(std::string::npos,
+      str.find("\"message\":\"quote \\\"tab\\there\\\"\""));
+}
+
+/////////////////////////////////////////////////
+TEST(BinaryLog, TruncatedArgs)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+  auto path = joinPaths(tempDir->Path(), "test.gzblog");
+
+  BinaryLog log;
+  ASSERT_TRUE(log.Open(path, 8));
+
+  std::string longString(200, 'a');
+  gzbinlog(log, 3, "{} {}", longString, 42);
+
+  std::ostringstream json;
+  ASSERT_TRUE(decodeBinaryLog(path, json, BinaryLogFormat::JSON));
+  EXPECT_NE(std::string::npos, json.str().find("\"truncated\":true"));
+  EXPECT_EQ(std::string::npos, json.str().find(longString));
+}
+
+/////////////////////////////////////////////////
+TEST(BinaryLog, Ring)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+  auto path = joinPaths(tempDir->Path(), "test.gzblog");
+
+  BinaryLog log;
+  ASSERT_TRUE(log.Open(path, 8));
+
+  for (int i = 0; i < 20; ++i)
+    gzbinlog(log, 3, "iteration {}", i);
+  EXPECT_EQ(20u, log.RecordCount());
+
+  // Only the newest records remain, in order
+  std::ostringstream text;
+  ASSERT_TRUE(decodeBinaryLog(path, text));
+  auto str = text.str();
+  EXPECT_EQ(8u, lineCount(str)) << str;
+  EXPECT_EQ(std::string::npos, str.find("iteration 11\n"));
+  EXPECT_NE(std::string::npos, str.find("iteration 12\n"));
+  EXPECT_LT(str.find("iteration 12\n"), str.find("iteration 19\n"));
+}
+
+/////////////////////////////////////////////////
+TEST(BinaryLog, Text)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+  auto path = joinPaths(tempDir->Path(), "test.gzblog");
+
+  BinaryLog log;
+  ASSERT_TRUE(log.Open(path, 32));
+
+  // Longer than a single record payload
+  std::string longText;
+  for (int i = 0; i < 50; ++i)
+    longText += std::to_string(i) + ",";
+  ASSERT_GT(longText.size(), BinaryLogRecord::kPayloadSize);
+
+  EXPECT_TRUE(log.WriteText(2, longText));
+  EXPECT_TRUE(log.WriteText(3, ""));
+  EXPECT_LT(2u, log.RecordCount());
+
+  std::ostringstream text;
+  ASSERT_TRUE(decodeBinaryLog(path, text));
+  auto str = text.str();
+  EXPECT_EQ(2u, lineCount(str)) << str;
+  EXPECT_NE(std::string::npos, str.find("] " + longText + "\n"));
+}
+
+/////////////////////////////////////////////////
+TEST(BinaryLog, TextLargerThanRing)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+  auto path = joinPaths(tempDir->Path(), "test.gzblog");
+
+  BinaryLog log;
+  ASSERT_TRUE(log.Open(path, 4));
+
+  // Fills the ring exactly
+  const std::string fits(4 * BinaryLogRecord::kPayloadSize, 'a');
+  EXPECT_TRUE(log.WriteText(2, fits));
+  EXPECT_EQ(4u, log.RecordCount());
+
+  // One byte more would overwrite its own first part
+  EXPECT_FALSE(log.WriteText(2, fits + "b"));
+  EXPECT_EQ(4u, log.RecordCount());
+
+  std::ostringstream text;
+  ASSERT_TRUE(decodeBinaryLog(path, text));
+  auto str = text.str();
+  EXPECT_EQ(1u, lineCount(str)) << str;
+  EXPECT_NE(std::string::npos, str.find("] " + fits + "\n"));
+  EXPECT_EQ(std::string::npos, str.find("truncated"));
+}
+
+/////////////////////////////////////////////////
+TEST(BinaryLog, Threads)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+  auto path = joinPaths(tempDir->Path(), "test.gzblog");
+
+  BinaryLog log;
+  ASSERT_TRUE(log.Open(path, 4096));
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&log, t]
+        {
+          for (int i = 0; i < 100; ++i)
+            gzbinlog(log, 4, "thread {} value {}", t, i);
+        });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_EQ(400u, log.RecordCount());
+  std::ostringstream text;
+  ASSERT_TRUE(decodeBinaryLog(path, text));
+  EXPECT_EQ(400u, lineCount(text.str()));
+}
+
+/////////////////////////////////////////////////
+TEST(BinaryLog, DecodeWhileWriting)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+  auto path = joinPaths(tempDir->Path(), "test.gzblog");
+
+  BinaryLog log;
+  ASSERT_TRUE(log.Open(path, 4));
+
+  // Each message repeats a single character, so a record mixing two
+  // writes is easy to spot
+  std::atomic<bool> done{false};
+  std::thread writer([&log, &done]
+      {
+        for (int i = 0; !done; ++i)
+        {
+          log.WriteText(3, std::string(BinaryLogRecord::kPayloadSize,
+                static_cast<char>('a' + i % 26)));
+        }
+      });
+
+  for (int i = 0; i < 200; ++i)
+  {
+    std::ostringstream text;
+    ASSERT_TRUE(decodeBinaryLog(path, text));
+    std::istringstream lines(text.str());
+    std::string line;
+    while (std::getline(lines, line))
+    {
+      auto start = line.find("] ");
+      ASSERT_NE(std::string::npos, start) << line;
+      const std::string message = line.substr(start + 2);
+      ASSERT_EQ(BinaryLogRecord::kPayloadSize, message.size()) << line;
+      EXPECT_EQ(std::string::npos,
+          message.find_first_not_of(message[0])) << line;
+    }
+  }
+
+  done = true;
+  writer.join();
+}
+
+/////////////////////////////////////////////////
+TEST(BinaryLog, Console)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+  auto path = joinPaths(tempDir->Path(), "console.gzblog");
+
+  auto log = std::make_shared<BinaryLog>();
+  ASSERT_TRUE(log->Open(path, 64));
+
+  Console::SetVerbosity(0);
+  Console::SetBinaryLog(log);
+  EXPECT_EQ(log, Console::GetBinaryLog());
+
+  gzerr << "binary error " << 5 << std::endl;
+  gzdbg << "binary debug" << std::endl;
+
+  Console::SetBinaryLog(nullptr);
+  EXPECT_EQ(nullptr, Console::GetBinaryLog());
+  gzerr << "not recorded" << std::endl;
+
+  std::ostringstream text;
+  ASSERT_TRUE(decodeBinaryLog(path, text));
+  auto str = text.str();
+  EXPECT_EQ(2u, lineCount(str)) << str;
+  EXPECT_NE(std::string::npos, str.find("binary error 5"));
+  EXPECT_NE(std::string::npos, str.find("binary debug"));
+  EXPECT_EQ(std::string::npos, str.find("not recorded"));
+}
+
+/////////////////////////////////////////////////
+TEST(BinaryLog, ConsolePartialLines)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+  auto path = joinPaths(tempDir->Path(), "console.gzblog");
+
+  auto log = std::make_shared<BinaryLog>();
+  ASSERT_TRUE(log->Open(path, 64));
+
+  Console::SetVerbosity(0);
+  Console::SetBinaryLog(log);
+
+  // Lines of different loggers are collected separately
+  gzmsg << "message start ";
+  gzerr << "whole error" << std::endl;
+  gzmsg << "message end" << std::endl;
+  Console::SetBinaryLog(nullptr);
+
+  std::ostringstream text;
+  ASSERT_TRUE(decodeBinaryLog(path, text));
+  auto str = text.str();
+  EXPECT_EQ(2u, lineCount(str)) << str;
+  std::istringstream lines(str);
+  std::string line;
+  while (std::getline(lines, line))
+  {
+    if (line.find("[Err]") != std::string::npos)
+    {
+      EXPECT_NE(std::string::npos, line.find("whole error")) << line;
+      EXPECT_EQ(std::string::npos, line.find("message")) << line;
+    }
+    else
+    {
+      EXPECT_NE(std::string::npos, line.find("[Msg]")) << line;
+      EXPECT_NE(std::string::npos, line.find("message start")) << line;
+      EXPECT_NE(std::string::npos, line.find("message end")) << line;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(BinaryLog, InvalidSites)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+  auto path = joinPaths(tempDir->Path(), "test.gzblog");
+
+  {
+    BinaryLog log;
+    ASSERT_TRUE(log.Open(path, 16));
+    gzbinlog(log, 3, "value {}", 1);
+  }
+
+  std::ostringstream text;
+  EXPECT_TRUE(decodeBinaryLog(path, text));
+
+  // A malformed call site fails the decoding instead of throwing
+  {
+    std::ofstream sites(path + ".sites", std::ios::app);
+    sites << "x1\t3\t10\tfile.cc\tvalue {}\n";
+  }
+  EXPECT_FALSE(decodeBinaryLog(path, text));
+
+  {
+    std::ofstream sites(path + ".sites", std::ios::trunc);
+    sites << "99999999999999\t3\t10\tfile.cc\tvalue {}\n";
+  }
+  EXPECT_FALSE(decodeBinaryLog(path, text));
+}
@@ -16,7 +16,9 @@
  */
 #include <string>
 #include <sstream>
+#include <unordered_map>
 
+#include <gz/common/BinaryLog.hh>
 #include <gz/common/Console.hh>
 #include <gz/common/config.hh>
 #include <gz/common/Util.hh>
@@ -48,6 +50,15 @@ Logger Console::dbg("[Dbg] ", blue, Logger::STDOUT, 4);
 int Console::verbosity = 1;
 std::string Console::customPrefix = ""; // NOLINT(*)
 
+//////////////////////////////////////////////////
+/// \brief Per-thread console capture callback.
+/// \return Reference to the capture callback of the calling thread.
+static Console::CaptureCallback &threadCapture()
+{
+  thread_local Console::CaptureCallback capture;
+  return capture;
+}
+
 //////////////////////////////////////////////////
 void Console::SetVerbosity(const int _level)
 {
@@ -72,6 +83,73 @@ std::string Console::Prefix()
   return customPrefix;
 }
 
+//////////////////////////////////////////////////
+/// \brief Binary log receiving all logger messages, see SetBinaryLog.
+static std::shared_ptr<BinaryLog> &binaryLog()
+{
+  static std::shared_ptr<BinaryLog> log;
+  return log;
+}
+
+//////////////////////////////////////////////////
+/// \brief Write logger output to the binary log, if one is set. Loggers
+/// flush after every insertion, so the parts of a message are collected
+/// per thread and logger, and written as one record once the line is
+/// complete.
+/// \param[in] _logger Buffer of the logger.
+/// \param[in] _level Verbosity level of the logger.
+/// \param[in] _text Flushed text.
+static void writeBinaryLog(const void *_logger, const int _level,
+    const std::string &_text)
+{
+  auto log = std::atomic_load(&binaryLog());
+  if (!log)
+    return;
+
+  thread_local std::unordered_map<const void *, std::string> pendingLines;
+  if (_text.empty() || _text.back() != '\n')
+  {
+    pendingLines[_logger] += _text;
+    return;
+  }
+
+  std::string line;
+  auto pending = pendingLines.find(_logger);
+  if (pending != pendingLines.end())
+  {
+    line = std::move(pending->second);
+    pendingLines.erase(pending);
+  }
+  line.append(_text, 0, _text.size() - 1);
+  log->WriteText(_level, line);
+}
+
+//////////////////////////////////////////////////
+void Console::SetBinaryLog(std::shared_ptr<BinaryLog> _log)
+{
+  std::atomic_store(&binaryLog(), std::move(_log));
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<BinaryLog> Console::GetBinaryLog()
+{
+  return std::atomic_load(&binaryLog());
+}
+
+//////////////////////////////////////////////////
+Console::CaptureCallback Console::SetThreadCapture(const CaptureCallback &_cb)
+{
+  CaptureCallback previous = threadCapture();
+  threadCapture() = _cb;
+  return previous;
+}
+
+//////////////////////////////////////////////////
+bool Console::HasThreadCapture()
+{
+  return static_cast<bool>(threadCapture());
+}
+
 /////////////////////////////////////////////////
 Logger::Logger(const std::string &_prefix, const int _color,
                const LogType _type, const int _verbosity)
@@ -145,8 +223,16 @@ int Logger::Buffer::sync()
     Console::log.flush();
   }
 
+  writeBinaryLog(this, this->verbosity, outstr);
+
+  // Output to the capture callback of this thread, if any
+  if (Console::Verbosity() >= this->verbosity && !outstr.empty() &&
+      Console::HasThreadCapture())
+  {
+    threadCapture()(this->type, outstr);
+  }
   // Output to terminal
-  if (Console::Verbosity() >= this->verbosity && !outstr.empty())
+  else if (Console::Verbosity() >= this->verbosity && !outstr.empty())
   {
 #ifndef _WIN32
     bool lastNewLine = outstr.back() == '\n';
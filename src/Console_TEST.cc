@@ -18,6 +18,9 @@
 #include <gtest/gtest.h>
 #include <stdlib.h>
 
+#include <string>
+#include <thread>
+
 #include "gz/common/Console.hh"
 #include "gz/common/Filesystem.hh"
 #include "gz/common/TempDirectory.hh"
@@ -519,6 +522,51 @@ TEST_F(Console_TEST, Prefix)
   EXPECT_EQ(common::Console::Prefix(), "");
 }
 
+/////////////////////////////////////////////////
+/// \brief Test Console::SetThreadCapture
+TEST_F(Console_TEST, ThreadCapture)
+{
+  common::Console::SetVerbosity(4);
+  EXPECT_FALSE(common::Console::HasThreadCapture());
+
+  std::string out;
+  std::string err;
+  auto previous = common::Console::SetThreadCapture(
+      [&](Logger::LogType _type, const std::string &_text)
+      {
+        if (_type == Logger::STDOUT)
+          out += _text;
+        else
+          err += _text;
+      });
+  EXPECT_FALSE(previous);
+  EXPECT_TRUE(common::Console::HasThreadCapture());
+
+  gzmsg << "captured message" << std::endl;
+  gzerr << "captured error" << std::endl;
+
+  // Output from another thread is not captured
+  std::thread other([]
+      {
+        EXPECT_FALSE(common::Console::HasThreadCapture());
+        gzmsg << "other thread" << std::endl;
+      });
+  other.join();
+
+  previous = common::Console::SetThreadCapture(nullptr);
+  EXPECT_TRUE(previous);
+  EXPECT_FALSE(common::Console::HasThreadCapture());
+
+  gzmsg << "not captured" << std::endl;
+
+  EXPECT_NE(out.find("captured message"), std::string::npos);
+  EXPECT_EQ(out.find("captured error"), std::string::npos);
+  EXPECT_EQ(out.find("other thread"), std::string::npos);
+  EXPECT_EQ(out.find("not captured"), std::string::npos);
+  EXPECT_NE(err.find("captured error"), std::string::npos);
+  EXPECT_EQ(err.find("captured message"), std::string::npos);
+}
+
 /////////////////////////////////////////////////
 /// \brief Test Console::LogDirectory
 TEST_F(Console_TEST, LogDirectory)
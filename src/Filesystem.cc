@@ -17,21 +17,41 @@
 
 #include <array>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <sstream>
 #include <filesystem>
 #include <fstream>
 #include <cstdlib>
 #include <cstring>
 #include <cctype>
+#include <mutex>
 #include <regex>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
 
 #include <gz/common/config.hh>
 #include <gz/common/SystemPaths.hh>
 #include <gz/common/Util.hh>
 #include <gz/common/Uuid.hh>
 #include <gz/common/Console.hh>
+#include <gz/common/WorkerPool.hh>
 #include "gz/common/Filesystem.hh"
 
+#if defined(__linux__) && defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27))
+#define GZ_COMMON_HAVE_COPY_FILE_RANGE
+#endif
+
 namespace fs = std::filesystem;
 
 using namespace gz;
@@ -55,6 +75,199 @@ inline bool fsWarn(const std::string &_fcn,
   return true;
 }
 
+namespace
+{
+  /// \brief Interval between two progress reports of copyDirectory
+  constexpr std::chrono::milliseconds kCopyProgressInterval{100};
+
+#ifdef __linux__
+  /// \brief Size of the buffer of copies done in user space
+  constexpr std::size_t kCopyBufferSize = 1u << 20;
+
+  /////////////////////////////////////////////////
+  /// \brief Copy the content of a regular file, by cloning it if the
+  /// filesystem supports reflinks, else in the kernel, else with a large
+  /// buffer.
+  /// \param[in] _from Source file.
+  /// \param[in] _to Destination file, which must not exist.
+  /// \param[out] _ec Error code.
+  /// \return True on success.
+  bool copyContent(const fs::path &_from, const fs::path &_to,
+      std::error_code &_ec)
+  {
+    auto fail = [&_ec](int _in, int _out)
+    {
+      _ec.assign(errno, std::generic_category());
+      if (_in >= 0)
+        ::close(_in);
+      if (_out >= 0)
+        ::close(_out);
+      return false;
+    };
+
+    const int in = ::open(_from.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0)
+      return fail(in, -1);
+
+    struct stat st;
+    if (::fstat(in, &st) != 0)
+      return fail(in, -1);
+
+    const int out = ::open(_to.c_str(), O_WRONLY | O_CREAT | O_EXCL |
+        O_CLOEXEC, st.st_mode & 07777);
+    if (out < 0)
+      return fail(in, out);
+
+    bool done = false;
+#ifdef FICLONE
+    done = ::ioctl(out, FICLONE, in) == 0;
+#endif
+
+#ifdef GZ_COMMON_HAVE_COPY_FILE_RANGE
+    // Both file offsets advance, so a failure part way through continues
+    // with the buffered copy below
+    while (!done)
+    {
+      const ssize_t n = ::copy_file_range(in, nullptr, out, nullptr,
+          1u << 30, 0);
+      if (n > 0)
+        continue;
+      if (n == 0)
+        done = true;
+      else if (errno != EINTR)
+        break;
+    }
+#endif
+
+    if (!done)
+    {
+      std::vector<char> buffer(kCopyBufferSize);
+      while (true)
+      {
+        const ssize_t n = ::read(in, buffer.data(), buffer.size());
+        if (n == 0)
+          break;
+        if (n < 0)
+        {
+          if (errno == EINTR)
+            continue;
+          return fail(in, out);
+        }
+        ssize_t written = 0;
+        while (written < n)
+        {
+          const ssize_t w = ::write(out, buffer.data() + written,
+              static_cast<std::size_t>(n - written));
+          if (w < 0)
+          {
+            if (errno == EINTR)
+              continue;
+            return fail(in, out);
+          }
+          written += w;
+        }
+      }
+    }
+
+    // Match std::filesystem::copy_file, which copies the permissions
+    if (::fchmod(out, st.st_mode & 07777) != 0)
+      return fail(in, out);
+
+    ::close(in);
+    if (::close(out) != 0)
+      return fail(-1, -1);
+
+    _ec.clear();
+    return true;
+  }
+#else
+  /////////////////////////////////////////////////
+  /// \brief Copy the content of a regular file. The standard library uses
+  /// the native copy function of the platform.
+  /// \param[in] _from Source file.
+  /// \param[in] _to Destination file, which must not exist.
+  /// \param[out] _ec Error code.
+  /// \return True on success.
+  bool copyContent(const fs::path &_from, const fs::path &_to,
+      std::error_code &_ec)
+  {
+    return fs::copy_file(_from, _to, _ec);
+  }
+#endif
+
+  /////////////////////////////////////////////////
+  /// \brief Copy or link a regular file.
+  /// \param[in] _from Source file.
+  /// \param[in] _to Destination file, replaced if it exists.
+  /// \param[in,out] _link True to try to link the file, set to false if
+  /// the file was copied instead.
+  /// \param[out] _ec Error code.
+  /// \return True on success.
+  bool copyRegularFile(const fs::path &_from, const fs::path &_to,
+      bool &_link, std::error_code &_ec)
+  {
+    std::error_code ec;
+    if (fs::exists(_to, ec) && fs::equivalent(_from, _to, ec))
+    {
+      if (_link)
+      {
+        _ec.clear();
+        return true;
+      }
+
+      // Copying a file onto itself would remove it. A hard link to the
+      // source, e.g. made by an earlier copy, is replaced by a copy.
+      std::error_code fromEc;
+      std::error_code toEc;
+      if (fs::weakly_canonical(_from, fromEc) ==
+          fs::weakly_canonical(_to, toEc) || fromEc || toEc)
+      {
+        _ec = std::make_error_code(std::errc::file_exists);
+        return false;
+      }
+    }
+
+    // Copy next to the destination and rename the copy over it, so that a
+    // failed copy leaves the destination untouched. Replacing rather than
+    // writing into the destination also leaves the files linked to it.
+    const fs::path temp = _to.parent_path() /
+      ("." + _to.filename().string() + "." + common::Uuid().String() + ".tmp");
+
+    bool done = false;
+    if (_link)
+    {
+      fs::create_hard_link(_from, temp, ec);
+      done = !ec;
+      _link = done;
+    }
+    if (!done)
+      done = copyContent(_from, temp, ec);
+    if (done)
+      fs::rename(temp, _to, ec);
+
+    if (!done || ec)
+    {
+      std::error_code removeEc;
+      fs::remove(temp, removeEc);
+      _ec = ec;
+      return false;
+    }
+
+    _ec.clear();
+    return true;
+  }
+}
+
+/// \brief Private data for CopyOptions
+class common::CopyOptions::Implementation
+{
+  /// \brief Returns true for the files to hard link
+  public: std::function<bool(const std::string &)> hardLinkFilter;
+
+  /// \brief Progress callback
+  public: std::function<void(const CopyProgress &)> progressCallback;
+};
+
 /////////////////////////////////////////////////
 bool common::exists(const std::string &_path)
 {
@@ -260,6 +473,182 @@ bool common::copyDirectory(
   return fsWarn("copyDirectory", ec, _warningOp);
 }
 
+/////////////////////////////////////////////////
+common::CopyOptions::CopyOptions()
+: dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+void common::CopyOptions::SetHardLinkFilter(
+    std::function<bool(const std::string &)> _filter)
+{
+  this->dataPtr->hardLinkFilter = std::move(_filter);
+}
+
+/////////////////////////////////////////////////
+const std::function<bool(const std::string &)> &
+common::CopyOptions::HardLinkFilter() const
+{
+  return this->dataPtr->hardLinkFilter;
+}
+
+/////////////////////////////////////////////////
+void common::CopyOptions::SetProgressCallback(
+    std::function<void(const CopyProgress &)> _callback)
+{
+  this->dataPtr->progressCallback = std::move(_callback);
+}
+
+/////////////////////////////////////////////////
+const std::function<void(const common::CopyProgress &)> &
+common::CopyOptions::ProgressCallback() const
+{
+  return this->dataPtr->progressCallback;
+}
+
+/////////////////////////////////////////////////
+bool common::copyFile(
+    const std::string &_existingFilename,
+    const std::string &_newFilename,
+    const CopyOptions &_options,
+    const FilesystemWarningOp _warningOp)
+{
+  std::error_code ec;
+  if (!fs::is_regular_file(_existingFilename, ec))
+  {
+    // Let the standard library report the error
+    return copyFile(_existingFilename, _newFilename, _warningOp);
+  }
+
+  bool link = _options.HardLinkFilter() &&
+      _options.HardLinkFilter()(_existingFilename);
+  copyRegularFile(_existingFilename, _newFilename, link, ec);
+  return fsWarn("copyFile", ec, _warningOp);
+}
+
+/////////////////////////////////////////////////
+bool common::copyDirectory(
+    const std::string &_existingDirname,
+    const std::string &_newDirname,
+    const CopyOptions &_options,
+    const FilesystemWarningOp _warningOp)
+{
+  std::error_code ec;
+  if (!fs::is_directory(_existingDirname, ec))
+  {
+    if (!ec)
+      ec = std::make_error_code(std::errc::not_a_directory);
+    return fsWarn("copyDirectory", ec, _warningOp);
+  }
+
+  if (!common::createDirectories(_newDirname))
+    return false;
+
+  // Walk the tree on the calling thread, directories are created before
+  // the files in them are copied
+  const fs::path source(_existingDirname);
+  const fs::path destination(_newDirname);
+  std::vector<std::pair<fs::path, fs::path>> files;
+  std::vector<std::uintmax_t> sizes;
+  std::vector<char> links;
+  std::atomic<std::uintmax_t> totalBytes{0};
+  std::error_code firstError;
+  for (fs::recursive_directory_iterator iter(source,
+        fs::directory_options::follow_directory_symlink, ec), end;
+      !ec && iter != end; iter.increment(ec))
+  {
+    const fs::path target = destination / iter->path().lexically_relative(
+        source);
+    std::error_code entryEc;
+    if (iter->is_directory(entryEc))
+    {
+      fs::create_directories(target, entryEc);
+    }
+    else if (iter->is_regular_file(entryEc))
+    {
+      const std::uintmax_t size = iter->file_size(entryEc);
+      if (!entryEc)
+      {
+        const bool link = _options.HardLinkFilter() &&
+            _options.HardLinkFilter()(iter->path().string());
+        files.emplace_back(iter->path(), target);
+        sizes.push_back(size);
+        links.push_back(link);
+        if (!link)
+          totalBytes += size;
+      }
+    }
+    else if (!entryEc)
+    {
+      fs::copy(iter->path(), target, fs::copy_options::overwrite_existing,
+          entryEc);
+    }
+
+    if (entryEc && !firstError)
+      firstError = entryEc;
+  }
+  if (ec && !firstError)
+    firstError = ec;
+
+  std::atomic<std::uintmax_t> filesDone{0};
+  std::atomic<std::uintmax_t> bytesDone{0};
+  std::mutex errorMutex;
+  const auto start = std::chrono::steady_clock::now();
+
+  auto report = [&]()
+  {
+    if (!_options.ProgressCallback())
+      return;
+    CopyProgress progress;
+    progress.files = filesDone;
+    progress.totalFiles = files.size();
+    progress.bytes = bytesDone;
+    progress.totalBytes = totalBytes;
+    const double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    if (seconds > 0.0)
+      progress.bytesPerSecond = static_cast<double>(progress.bytes) / seconds;
+    _options.ProgressCallback()(progress);
+  };
+
+  {
+    WorkerPool pool;
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+      pool.AddWork([&, i]()
+      {
+        bool link = links[i];
+        std::error_code fileEc;
+        if (copyRegularFile(files[i].first, files[i].second, link, fileEc))
+        {
+          // Files which could not be linked were copied
+          if (!link)
+          {
+            if (links[i])
+              totalBytes += sizes[i];
+            bytesDone += sizes[i];
+          }
+          ++filesDone;
+        }
+        else
+        {
+          std::lock_guard<std::mutex> lock(errorMutex);
+          if (!firstError)
+            firstError = fileEc;
+        }
+      });
+    }
+
+    // Wait with a timeout, which also guards against spurious wake ups
+    while (!pool.WaitForResults(kCopyProgressInterval))
+      report();
+  }
+  report();
+
+  return fsWarn("copyDirectory", firstError, _warningOp);
+}
+
 /////////////////////////////////////////////////
 bool common::moveFile(
     const std::string &_existingFilename,
@@ -28,6 +28,9 @@
 
 #include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
 
 // The symlink tests should always work on UNIX systems
 #ifndef _WIN32
@@ -584,6 +587,137 @@ TEST_F(FilesystemTest, copyDirectories)
   EXPECT_FALSE(copyDirectory("fake_dir", dirCopied, FSWO_SUPPRESS_WARNINGS));
 }
 
+/////////////////////////////////////////////////
+/// \brief Read a whole file.
+std::string readFile(const std::string &_path)
+{
+  std::ifstream file(_path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>());
+}
+
+/////////////////////////////////////////////////
+TEST_F(FilesystemTest, copyDirectoriesOptions)
+{
+  // Files small and larger than the copy buffer
+  const std::string source = "options_source";
+  ASSERT_TRUE(createDirectories(joinPaths(source, "a", "b")));
+  ASSERT_TRUE(createDirectories(joinPaths(source, "empty")));
+  std::vector<std::string> names{"small.txt", joinPaths("a", "mesh.dae"),
+    joinPaths("a", "b", "large.bin")};
+  std::vector<std::string> contents{"small",
+    std::string(1000, 'm'), std::string((1u << 20) * 3 + 7, 'l')};
+  std::uintmax_t totalBytes = 0;
+  for (std::size_t i = 0; i < names.size(); ++i)
+  {
+    std::ofstream file(joinPaths(source, names[i]), std::ios::binary);
+    file << contents[i];
+    totalBytes += contents[i].size();
+  }
+
+  CopyOptions options;
+  std::vector<CopyProgress> reports;
+  options.SetProgressCallback([&](const CopyProgress &_progress)
+  {
+    reports.push_back(_progress);
+  });
+
+  const std::string destination = joinPaths("options_dest", "copy");
+  ASSERT_TRUE(copyDirectory(source, destination, options));
+  EXPECT_TRUE(isDirectory(joinPaths(destination, "empty")));
+  for (std::size_t i = 0; i < names.size(); ++i)
+    EXPECT_EQ(contents[i], readFile(joinPaths(destination, names[i])));
+
+  ASSERT_FALSE(reports.empty());
+  EXPECT_EQ(3u, reports.back().files);
+  EXPECT_EQ(3u, reports.back().totalFiles);
+  EXPECT_EQ(totalBytes, reports.back().bytes);
+  EXPECT_EQ(totalBytes, reports.back().totalBytes);
+  EXPECT_LE(0.0, reports.back().bytesPerSecond);
+
+  // Existing files are overwritten
+  {
+    std::ofstream file(joinPaths(source, "small.txt"), std::ios::binary);
+    file << "new";
+  }
+  reports.clear();
+  ASSERT_TRUE(copyDirectory(source, destination, options));
+  EXPECT_EQ("new", readFile(joinPaths(destination, "small.txt")));
+
+#ifndef _WIN32
+  // Link the meshes
+  options.SetHardLinkFilter([](const std::string &_path)
+  {
+    return _path.size() > 4 && _path.substr(_path.size() - 4) == ".dae";
+  });
+  reports.clear();
+  const std::string linked = "options_linked";
+  ASSERT_TRUE(copyDirectory(source, linked, options));
+  EXPECT_TRUE(fs::equivalent(joinPaths(source, names[1]),
+      joinPaths(linked, names[1])));
+  EXPECT_FALSE(fs::equivalent(joinPaths(source, names[2]),
+      joinPaths(linked, names[2])));
+  EXPECT_EQ(contents[2], readFile(joinPaths(linked, names[2])));
+  ASSERT_FALSE(reports.empty());
+  EXPECT_EQ(3u, reports.back().files);
+  EXPECT_EQ(totalBytes - contents[1].size() - 2,
+      reports.back().totalBytes);
+
+  // Linking again is a no-op
+  ASSERT_TRUE(copyDirectory(source, linked, options));
+
+  // Copying over links replaces them without changing the linked files
+  const std::string other = "options_other";
+  ASSERT_TRUE(createDirectories(joinPaths(other, "a")));
+  {
+    std::ofstream file(joinPaths(other, names[1]), std::ios::binary);
+    file << "other";
+  }
+  CopyOptions plainOptions;
+  ASSERT_TRUE(copyDirectory(other, linked, plainOptions));
+  EXPECT_EQ("other", readFile(joinPaths(linked, names[1])));
+  EXPECT_EQ(contents[1], readFile(joinPaths(source, names[1])));
+
+  ASSERT_TRUE(copyDirectory(source, linked, options));
+  ASSERT_TRUE(fs::equivalent(joinPaths(source, names[1]),
+      joinPaths(linked, names[1])));
+  ASSERT_TRUE(copyDirectory(source, linked, plainOptions));
+  EXPECT_FALSE(fs::equivalent(joinPaths(source, names[1]),
+      joinPaths(linked, names[1])));
+  EXPECT_EQ(contents[1], readFile(joinPaths(linked, names[1])));
+  EXPECT_EQ(contents[1], readFile(joinPaths(source, names[1])));
+#endif
+
+  // Single files
+  CopyOptions copyOptions;
+  EXPECT_TRUE(copyFile(joinPaths(source, names[2]), "large_copy.bin",
+      copyOptions));
+  EXPECT_EQ(contents[2], readFile("large_copy.bin"));
+  EXPECT_FALSE(copyFile("large_copy.bin", "./large_copy.bin", copyOptions,
+      FSWO_SUPPRESS_WARNINGS));
+  EXPECT_EQ(contents[2], readFile("large_copy.bin"));
+  EXPECT_FALSE(copyFile("__wrong__.tmp", "test2.tmp", copyOptions,
+      FSWO_SUPPRESS_WARNINGS));
+
+#ifdef __linux__
+  // A failed copy leaves the destination and no temporary file behind.
+  // Reading the start of the memory of a process fails.
+  ASSERT_TRUE(isFile("/proc/self/mem"));
+  EXPECT_FALSE(copyFile("/proc/self/mem", "large_copy.bin", copyOptions,
+      FSWO_SUPPRESS_WARNINGS));
+  EXPECT_EQ(contents[2], readFile("large_copy.bin"));
+  for (const auto &entry : fs::directory_iterator("."))
+  {
+    EXPECT_EQ(std::string::npos,
+        entry.path().filename().string().find(".large_copy.bin"));
+  }
+#endif
+
+  EXPECT_FALSE(copyDirectory("fake_dir", "fake_copy", copyOptions,
+      FSWO_SUPPRESS_WARNINGS));
+  EXPECT_FALSE(exists("fake_copy"));
+}
+
 /////////////////////////////////////////////////
 TEST_F(FilesystemTest, uniquePaths)
 {
@@ -0,0 +1,322 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include "gz/common/MappedFile.hh"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+using namespace gz;
+using namespace common;
+
+/////////////////////////////////////////////////
+/// \brief Private data for MappedFile.
+class MappedFile::Implementation
+{
+  /// \brief Map a regular file.
+  /// \return False if the file could not be mapped, it should then be
+  /// read into the buffer.
+  public: bool Map();
+
+  /// \brief Read the whole file into the buffer.
+  /// \return False if the file could not be read.
+  public: bool ReadBuffer();
+
+  /// \brief Unmap the file and free the buffer.
+  public: void Release();
+
+  /// \brief Path given to Open.
+  public: std::string path;
+
+  /// \brief Start of the mapping, nullptr if not mapped.
+  public: void *base{nullptr};
+
+  /// \brief Size of the mapping.
+  public: std::size_t mappedSize{0};
+
+  /// \brief Content of a file that could not be mapped.
+  public: std::string buffer;
+
+  /// \brief True if a file is open.
+  public: bool valid{false};
+};
+
+/////////////////////////////////////////////////
+bool MappedFile::Implementation::Map()
+{
+#ifdef _WIN32
+  HANDLE file = CreateFileA(this->path.c_str(), GENERIC_READ,
+      FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+      OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER size;
+  if (GetFileType(file) != FILE_TYPE_DISK || !GetFileSizeEx(file, &size) ||
+      size.QuadPart <= 0)
+  {
+    CloseHandle(file);
+    return false;
+  }
+
+  // The view keeps the mapping and the file open
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0,
+      nullptr);
+  CloseHandle(file);
+  if (!mapping)
+    return false;
+  void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (!view)
+    return false;
+
+  this->base = view;
+  this->mappedSize = static_cast<std::size_t>(size.QuadPart);
+  return true;
+#else
+  const int fd = ::open(this->path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return false;
+
+  // Pipes, devices and files of /proc report no usable size
+  struct stat info;
+  if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size <= 0)
+  {
+    ::close(fd);
+    return false;
+  }
+
+  const std::size_t size = static_cast<std::size_t>(info.st_size);
+  void *addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED)
+    return false;
+
+  this->base = addr;
+  this->mappedSize = size;
+  return true;
+#endif
+}
+
+/////////////////////////////////////////////////
+bool MappedFile::Implementation::ReadBuffer()
+{
+  // Directories can be opened as streams on some systems
+  std::error_code ec;
+  if (std::filesystem::is_directory(this->path, ec))
+    return false;
+
+  std::ifstream file(this->path, std::ios::binary);
+  if (!file.is_open())
+    return false;
+  this->buffer.assign(std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>());
+  return !file.bad();
+}
+
+/////////////////////////////////////////////////
+void MappedFile::Implementation::Release()
+{
+  if (this->base)
+  {
+#ifdef _WIN32
+    UnmapViewOfFile(this->base);
+#else
+    ::munmap(this->base, this->mappedSize);
+#endif
+  }
+  this->base = nullptr;
+  this->mappedSize = 0;
+  std::string().swap(this->buffer);
+  this->path.clear();
+  this->valid = false;
+}
+
+/////////////////////////////////////////////////
+MappedFile::MappedFile()
+  : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+MappedFile::MappedFile(const std::string &_path, Advice _advice)
+  : MappedFile()
+{
+  this->Open(_path, _advice);
+}
+
+/////////////////////////////////////////////////
+MappedFile::MappedFile(MappedFile &&_other) noexcept
+  : MappedFile()
+{
+  std::swap(*this->dataPtr, *_other.dataPtr);
+}
+
+/////////////////////////////////////////////////
+MappedFile &MappedFile::operator=(MappedFile &&_other) noexcept
+{
+  if (this != &_other)
+  {
+    this->Close();
+    std::swap(*this->dataPtr, *_other.dataPtr);
+  }
+  return *this;
+}
+
+/////////////////////////////////////////////////
+MappedFile::~MappedFile()
+{
+  this->Close();
+}
+
+/////////////////////////////////////////////////
+bool MappedFile::Open(const std::string &_path, Advice _advice)
+{
+  this->Close();
+  this->dataPtr->path = _path;
+
+  if (this->dataPtr->Map())
+  {
+    this->dataPtr->valid = true;
+    this->Advise(_advice);
+    return true;
+  }
+
+  if (this->dataPtr->ReadBuffer())
+  {
+    this->dataPtr->valid = true;
+    return true;
+  }
+
+  this->dataPtr->Release();
+  return false;
+}
+
+/////////////////////////////////////////////////
+void MappedFile::Close()
+{
+  this->dataPtr->Release();
+}
+
+/////////////////////////////////////////////////
+bool MappedFile::Valid() const
+{
+  return this->dataPtr->valid;
+}
+
+/////////////////////////////////////////////////
+bool MappedFile::Mapped() const
+{
+  return this->dataPtr->base != nullptr;
+}
+
+/////////////////////////////////////////////////
+std::string MappedFile::Path() const
+{
+  return this->dataPtr->path;
+}
+
+/////////////////////////////////////////////////
+const char *MappedFile::Data() const
+{
+  if (this->dataPtr->base)
+    return static_cast<const char *>(this->dataPtr->base);
+  return this->dataPtr->buffer.empty() ? nullptr :
+      this->dataPtr->buffer.data();
+}
+
+/////////////////////////////////////////////////
+std::size_t MappedFile::Size() const
+{
+  return this->dataPtr->base ? this->dataPtr->mappedSize :
+      this->dataPtr->buffer.size();
+}
+
+/////////////////////////////////////////////////
+std::string_view MappedFile::View() const
+{
+  return std::string_view(this->Data(), this->Size());
+}
+
+/////////////////////////////////////////////////
+bool MappedFile::Advise(Advice _advice)
+{
+  return this->Advise(_advice, 0, this->Size());
+}
+
+/////////////////////////////////////////////////
+bool MappedFile::Advise(Advice _advice, std::size_t _offset,
+    std::size_t _length)
+{
+  if (!this->dataPtr->base || _offset >= this->dataPtr->mappedSize)
+    return false;
+
+#ifdef _WIN32
+  (void)_advice;
+  (void)_length;
+  return false;
+#else
+  int advice = MADV_NORMAL;
+  switch (_advice)
+  {
+    case Advice::NORMAL:
+      advice = MADV_NORMAL;
+      break;
+    case Advice::SEQUENTIAL:
+      advice = MADV_SEQUENTIAL;
+      break;
+    case Advice::RANDOM:
+      advice = MADV_RANDOM;
+      break;
+    case Advice::WILL_NEED:
+      advice = MADV_WILLNEED;
+      break;
+    case Advice::DONT_NEED:
+      advice = MADV_DONTNEED;
+      break;
+    case Advice::HUGE_PAGES:
+#ifdef MADV_HUGEPAGE
+      advice = MADV_HUGEPAGE;
+      break;
+#else
+      return false;
+#endif
+  }
+
+  // madvise needs a page aligned start
+  static const std::size_t pageSize =
+      static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  const std::size_t start = _offset - _offset % pageSize;
+  const std::size_t end = _length > this->dataPtr->mappedSize - _offset ?
+      this->dataPtr->mappedSize : _offset + _length;
+  return ::madvise(static_cast<char *>(this->dataPtr->base) + start,
+      end - start, advice) == 0;
+#endif
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+#include <utility>
+
+#include "gz/common/Filesystem.hh"
+#include "gz/common/MappedFile.hh"
+#include "gz/common/testing/TestPaths.hh"
+
+using namespace gz;
+using namespace common;
+
+/////////////////////////////////////////////////
+/// \brief Write a file.
+void writeFile(const std::string &_path, const std::string &_content)
+{
+  std::ofstream file(_path, std::ios::binary);
+  file << _content;
+}
+
+/////////////////////////////////////////////////
+TEST(MappedFile, Regular)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+  const std::string path = joinPaths(tempDir->Path(), "data.bin");
+  std::string content(100000, 'x');
+  content[0] = '\0';
+  content.back() = 'e';
+  writeFile(path, content);
+
+  MappedFile file(path);
+  ASSERT_TRUE(file.Valid());
+  EXPECT_EQ(path, file.Path());
+  EXPECT_EQ(content.size(), file.Size());
+  EXPECT_EQ(content, file.View());
+  EXPECT_EQ(file.View().data(), file.Data());
+
+#ifndef _WIN32
+  EXPECT_TRUE(file.Mapped());
+  EXPECT_TRUE(file.Advise(MappedFile::Advice::RANDOM));
+  EXPECT_TRUE(file.Advise(MappedFile::Advice::WILL_NEED, 5000, 10000));
+  EXPECT_TRUE(file.Advise(MappedFile::Advice::NORMAL, 99999, 1000));
+  EXPECT_FALSE(file.Advise(MappedFile::Advice::NORMAL, content.size(), 1));
+
+  // The mapping outlives the file
+  EXPECT_TRUE(removeFile(path));
+  EXPECT_EQ('e', file.View().back());
+#endif
+
+  file.Close();
+  EXPECT_FALSE(file.Valid());
+  EXPECT_FALSE(file.Mapped());
+  EXPECT_TRUE(file.View().empty());
+  EXPECT_TRUE(file.Path().empty());
+  EXPECT_FALSE(file.Advise(MappedFile::Advice::NORMAL));
+}
+
+/////////////////////////////////////////////////
+TEST(MappedFile, Move)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+  const std::string first = joinPaths(tempDir->Path(), "first.txt");
+  const std::string second = joinPaths(tempDir->Path(), "second.txt");
+  writeFile(first, "first");
+  writeFile(second, "second");
+
+  MappedFile file(first);
+  MappedFile moved(std::move(file));
+  EXPECT_FALSE(file.Valid());
+  EXPECT_EQ("first", moved.View());
+
+  MappedFile other(second, MappedFile::Advice::WILL_NEED);
+  moved = std::move(other);
+  EXPECT_FALSE(other.Valid());
+  EXPECT_EQ("second", moved.View());
+
+  // Reopen
+  EXPECT_TRUE(moved.Open(first));
+  EXPECT_EQ("first", moved.View());
+}
+
+/////////////////////////////////////////////////
+TEST(MappedFile, Fallback)
+{
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+
+  // Empty files cannot be mapped
+  const std::string empty = joinPaths(tempDir->Path(), "empty.txt");
+  writeFile(empty, "");
+  MappedFile file(empty);
+  EXPECT_TRUE(file.Valid());
+  EXPECT_FALSE(file.Mapped());
+  EXPECT_EQ(0u, file.Size());
+  EXPECT_EQ(nullptr, file.Data());
+  EXPECT_TRUE(file.View().empty());
+
+  EXPECT_FALSE(file.Open(joinPaths(tempDir->Path(), "missing.txt")));
+  EXPECT_FALSE(file.Valid());
+  EXPECT_FALSE(file.Open(tempDir->Path()));
+  EXPECT_FALSE(file.Open(""));
+
+#ifdef __linux__
+  // Files of /proc report no size, they are read into a buffer
+  ASSERT_TRUE(file.Open("/proc/self/status"));
+  EXPECT_FALSE(file.Mapped());
+  EXPECT_NE(std::string_view::npos, file.View().find("Name:"));
+  EXPECT_FALSE(file.Advise(MappedFile::Advice::SEQUENTIAL));
+#endif
+}
@@ -0,0 +1,356 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <gz/utils/NeverDestroyed.hh>
+
+#include "gz/common/Pool.hh"
+
+using namespace gz;
+using namespace common;
+
+namespace
+{
+  /// \brief Maximum number of buffers, from all pools, cached by a thread.
+  constexpr std::size_t kThreadCacheLimit = 16u;
+
+  /// \brief A buffer cached by a thread.
+  struct CachedBuffer
+  {
+    /// \brief Identifier of the owning pool.
+    uint64_t pool;
+
+    /// \brief Size class index of the buffer.
+    std::size_t sizeClass;
+
+    /// \brief The buffer.
+    BufferPool::Buffer buffer;
+  };
+
+  class ThreadCache;
+
+  /// \brief All the thread caches, so that a pool can free its buffers
+  /// from every thread when it is destroyed.
+  struct ThreadCacheRegistry
+  {
+    /// \brief Protects caches. Locked before the mutex of a cache.
+    std::mutex mutex;
+
+    /// \brief Caches of the running threads.
+    std::set<ThreadCache *> caches;
+  };
+
+  /// \brief Get the registry of thread caches. It is never destroyed, as
+  /// threads may exit after static destruction.
+  /// \return The registry.
+  ThreadCacheRegistry &threadCacheRegistry()
+  {
+    static gz::utils::NeverDestroyed<ThreadCacheRegistry> registry;
+    return registry.Access();
+  }
+
+  /// \brief Buffers cached by a thread, oldest entries first.
+  class ThreadCache
+  {
+    /// \brief Constructor, registers the cache.
+    public: ThreadCache()
+    {
+      auto &registry = threadCacheRegistry();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      registry.caches.insert(this);
+    }
+
+    /// \brief Destructor, unregisters the cache.
+    public: ~ThreadCache()
+    {
+      auto &registry = threadCacheRegistry();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      registry.caches.erase(this);
+    }
+
+    /// \brief Remove all the entries of a pool.
+    /// \param[in] _pool Identifier of the pool.
+    /// \return Removed buffers, to be freed outside of the lock.
+    public: std::vector<CachedBuffer> Remove(const uint64_t _pool)
+    {
+      std::vector<CachedBuffer> removed;
+      std::lock_guard<std::mutex> lock(this->mutex);
+      auto it = std::stable_partition(this->entries.begin(),
+          this->entries.end(), [_pool](const CachedBuffer &_entry)
+          {
+            return _entry.pool != _pool;
+          });
+      std::move(it, this->entries.end(), std::back_inserter(removed));
+      this->entries.erase(it, this->entries.end());
+      return removed;
+    }
+
+    /// \brief Protects entries. Only contended while a pool is destroyed
+    /// by another thread.
+    public: std::mutex mutex;
+
+    /// \brief Cached buffers, oldest first.
+    public: std::vector<CachedBuffer> entries;
+  };
+
+  /// \brief Get the buffer cache of the calling thread.
+  /// \return The cache.
+  ThreadCache &threadCache()
+  {
+    static thread_local ThreadCache cache;
+    return cache;
+  }
+
+  /// \brief Source of pool identifiers. Identifiers are never reused.
+  std::atomic<uint64_t> gNextPoolId{1};
+
+  /// \brief Get the index of the size class that serves a request.
+  /// \param[in] _size Requested size.
+  /// \return Size class index.
+  std::size_t classIndexFor(const std::size_t _size)
+  {
+    std::size_t index = 0;
+    std::size_t classSize = BufferPool::kMinClassSize;
+    while (classSize < _size &&
+           classSize <= std::numeric_limits<std::size_t>::max() / 2)
+    {
+      classSize <<= 1;
+      ++index;
+    }
+    return index;
+  }
+
+  /// \brief Get the index of the largest size class a buffer can serve.
+  /// \param[in] _capacity Buffer capacity, at least kMinClassSize.
+  /// \return Size class index.
+  std::size_t classIndexOf(const std::size_t _capacity)
+  {
+    std::size_t index = 0;
+    std::size_t classSize = BufferPool::kMinClassSize;
+    while ((classSize << 1) <= _capacity)
+    {
+      classSize <<= 1;
+      ++index;
+    }
+    return index;
+  }
+}
+
+/// \brief Private data for BufferPool
+class gz::common::BufferPool::Implementation
+{
+  /// \brief Identifier used to tag buffers in thread caches.
+  public: uint64_t id{gNextPoolId.fetch_add(1)};
+
+  /// \brief Maximum number of buffers per shared list.
+  public: std::size_t maxRetainedPerClass;
+
+  /// \brief Maximum number of buffers per thread cache.
+  public: std::size_t threadCacheSize;
+
+  /// \brief Largest capacity that is retained.
+  public: std::size_t maxBufferSize;
+
+  /// \brief Protects shared.
+  public: mutable std::mutex mutex;
+
+  /// \brief Shared lists of free buffers, indexed by size class.
+  public: std::vector<std::vector<Buffer>> shared;
+
+  /// \brief Number of heap allocations.
+  public: std::atomic<uint64_t> allocations{0};
+};
+
+//////////////////////////////////////////////////
+BufferPool::BufferPool(const std::size_t _maxRetainedPerClass,
+    const std::size_t _threadCacheSize, const std::size_t _maxBufferSize)
+  : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
+{
+  this->dataPtr->maxRetainedPerClass = _maxRetainedPerClass;
+  this->dataPtr->threadCacheSize =
+    std::min(_threadCacheSize, kThreadCacheLimit);
+  this->dataPtr->maxBufferSize = _maxBufferSize;
+}
+
+//////////////////////////////////////////////////
+BufferPool::~BufferPool()
+{
+  this->Trim();
+
+  // Buffers of this pool cached by other threads would otherwise never be
+  // used again, nor freed until those threads exit
+  std::vector<CachedBuffer> removed;
+  auto &registry = threadCacheRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (ThreadCache *cache : registry.caches)
+  {
+    auto buffers = cache->Remove(this->dataPtr->id);
+    std::move(buffers.begin(), buffers.end(), std::back_inserter(removed));
+  }
+}
+
+//////////////////////////////////////////////////
+BufferPool::Buffer BufferPool::Acquire(const std::size_t _size)
+{
+  // Requests that would never be retained bypass the pool
+  if (_size > this->dataPtr->maxBufferSize)
+  {
+    this->dataPtr->allocations.fetch_add(1, std::memory_order_relaxed);
+    return Buffer(_size);
+  }
+
+  const std::size_t index = classIndexFor(_size);
+  Buffer buffer;
+  bool found = false;
+
+  // Thread cache first, newest entries are the most likely to be warm
+  {
+    auto &cache = threadCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto &entries = cache.entries;
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it)
+    {
+      if (it->pool == this->dataPtr->id && it->sizeClass == index)
+      {
+        buffer = std::move(it->buffer);
+        entries.erase(std::next(it).base());
+        found = true;
+        break;
+      }
+    }
+  }
+
+  if (!found)
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (index < this->dataPtr->shared.size() &&
+        !this->dataPtr->shared[index].empty())
+    {
+      buffer = std::move(this->dataPtr->shared[index].back());
+      this->dataPtr->shared[index].pop_back();
+      found = true;
+    }
+  }
+
+  if (!found)
+  {
+    buffer.reserve(kMinClassSize << index);
+    this->dataPtr->allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  buffer.resize(_size);
+  return buffer;
+}
+
+//////////////////////////////////////////////////
+void BufferPool::Release(Buffer &&_buffer)
+{
+  const std::size_t capacity = _buffer.capacity();
+  if (capacity < kMinClassSize || capacity > this->dataPtr->maxBufferSize)
+  {
+    Buffer().swap(_buffer);
+    return;
+  }
+
+  const std::size_t index = classIndexOf(capacity);
+
+  if (this->dataPtr->threadCacheSize > 0)
+  {
+    // Freed outside of the lock
+    Buffer evicted;
+    auto &cache = threadCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto &entries = cache.entries;
+    const auto cached = std::count_if(entries.begin(), entries.end(),
+        [this](const CachedBuffer &_entry)
+        {
+          return _entry.pool == this->dataPtr->id;
+        });
+    if (static_cast<std::size_t>(cached) < this->dataPtr->threadCacheSize)
+    {
+      if (entries.size() >= kThreadCacheLimit)
+      {
+        evicted = std::move(entries.front().buffer);
+        entries.erase(entries.begin());
+      }
+      entries.push_back({this->dataPtr->id, index, std::move(_buffer)});
+      return;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->shared.size() <= index)
+      this->dataPtr->shared.resize(index + 1);
+    auto &list = this->dataPtr->shared[index];
+    if (list.size() < this->dataPtr->maxRetainedPerClass)
+    {
+      list.push_back(std::move(_buffer));
+      return;
+    }
+  }
+
+  Buffer().swap(_buffer);
+}
+
+//////////////////////////////////////////////////
+std::size_t BufferPool::Retained() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::size_t count = 0;
+  for (const auto &list : this->dataPtr->shared)
+    count += list.size();
+  return count;
+}
+
+//////////////////////////////////////////////////
+uint64_t BufferPool::Allocations() const
+{
+  return this->dataPtr->allocations.load(std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////
+void BufferPool::Trim()
+{
+  threadCache().Remove(this->dataPtr->id);
+
+  std::vector<std::vector<Buffer>> shared;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    shared.swap(this->dataPtr->shared);
+  }
+}
+
+//////////////////////////////////////////////////
+std::size_t BufferPool::SizeClass(const std::size_t _size)
+{
+  return kMinClassSize << classIndexFor(_size);
+}
+
+//////////////////////////////////////////////////
+BufferPool &BufferPool::Default()
+{
+  static gz::utils::NeverDestroyed<BufferPool> pool;
+  return pool.Access();
+}
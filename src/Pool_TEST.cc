@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gz/common/Pool.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+/// \brief Counts live instances
+struct Tracked
+{
+  explicit Tracked(int _value) : value(_value) { ++live; }
+  ~Tracked() { --live; }
+  int value;
+  static int live;
+};
+int Tracked::live = 0;
+
+/////////////////////////////////////////////////
+TEST(ObjectPool, Reuse)
+{
+  common::ObjectPool<Tracked> pool(2);
+  EXPECT_EQ(2u, pool.MaxRetained());
+  {
+    auto a = pool.Acquire(1);
+    auto b = pool.Acquire(2);
+    auto c = pool.Acquire(3);
+    EXPECT_EQ(1, a->value);
+    EXPECT_EQ(3, c->value);
+    EXPECT_EQ(3, Tracked::live);
+    EXPECT_EQ(3u, pool.Allocations());
+  }
+  EXPECT_EQ(0, Tracked::live);
+
+  // Only two blocks are retained
+  EXPECT_EQ(2u, pool.Retained());
+
+  for (int i = 0; i < 100; ++i)
+  {
+    auto a = pool.Acquire(i);
+    auto b = pool.Acquire(i);
+    EXPECT_EQ(i, b->value);
+  }
+  EXPECT_EQ(3u, pool.Allocations());
+
+  pool.Clear();
+  EXPECT_EQ(0u, pool.Retained());
+}
+
+/////////////////////////////////////////////////
+TEST(ObjectPool, ThrowingConstructor)
+{
+  struct Throws
+  {
+    Throws() { throw std::runtime_error("fail"); }
+  };
+  common::ObjectPool<Throws> pool;
+  EXPECT_THROW(pool.Acquire(), std::runtime_error);
+  EXPECT_EQ(1u, pool.Retained());
+}
+
+/////////////////////////////////////////////////
+TEST(ObjectPool, Threads)
+{
+  common::ObjectPool<std::string> pool(64);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&pool]
+    {
+      for (int i = 0; i < 1000; ++i)
+      {
+        auto s = pool.Acquire("value");
+        EXPECT_EQ("value", *s);
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  EXPECT_LE(pool.Allocations(), 4u);
+}
+
+/////////////////////////////////////////////////
+TEST(BufferPool, SizeClass)
+{
+  EXPECT_EQ(256u, common::BufferPool::SizeClass(0));
+  EXPECT_EQ(256u, common::BufferPool::SizeClass(256));
+  EXPECT_EQ(512u, common::BufferPool::SizeClass(257));
+  EXPECT_EQ(1024u * 1024u, common::BufferPool::SizeClass(1000 * 1000));
+}
+
+/////////////////////////////////////////////////
+TEST(BufferPool, Reuse)
+{
+  common::BufferPool pool(1, 1);
+
+  auto a = pool.Acquire(1000);
+  EXPECT_EQ(1000u, a.size());
+  EXPECT_GE(a.capacity(), 1024u);
+  const unsigned char *data = a.data();
+  pool.Release(std::move(a));
+
+  // Served from the thread cache
+  auto b = pool.Acquire(900);
+  EXPECT_EQ(900u, b.size());
+  EXPECT_EQ(data, b.data());
+  EXPECT_EQ(1u, pool.Allocations());
+
+  // A different size class needs a new buffer
+  auto c = pool.Acquire(5000);
+  EXPECT_EQ(2u, pool.Allocations());
+
+  // One buffer goes to the thread cache, one to the shared list and the
+  // last one is freed
+  auto d = pool.Acquire(900);
+  auto e = pool.Acquire(900);
+  EXPECT_EQ(4u, pool.Allocations());
+  pool.Release(std::move(b));
+  pool.Release(std::move(d));
+  pool.Release(std::move(e));
+  EXPECT_EQ(1u, pool.Retained());
+
+  // Retention limits apply per size class
+  pool.Release(std::move(c));
+  EXPECT_EQ(2u, pool.Retained());
+
+  pool.Trim();
+  EXPECT_EQ(0u, pool.Retained());
+  auto f = pool.Acquire(900);
+  EXPECT_EQ(5u, pool.Allocations());
+}
+
+/////////////////////////////////////////////////
+TEST(BufferPool, Limits)
+{
+  common::BufferPool pool(4, 0, 4096);
+
+  // Too large to be retained
+  auto big = pool.Acquire(10000);
+  EXPECT_EQ(10000u, big.size());
+  pool.Release(std::move(big));
+  EXPECT_EQ(0u, pool.Retained());
+
+  // Too small to be useful
+  pool.Release(common::BufferPool::Buffer(10));
+  EXPECT_EQ(0u, pool.Retained());
+
+  // Without thread cache, buffers go to the shared list
+  pool.Release(pool.Acquire(100));
+  EXPECT_EQ(1u, pool.Retained());
+}
+
+/////////////////////////////////////////////////
+TEST(BufferPool, Threads)
+{
+  common::BufferPool pool(8, 2);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&pool]
+    {
+      for (int i = 0; i < 1000; ++i)
+      {
+        auto buffer = pool.Acquire(640 * 480 * 3);
+        buffer[0] = 1;
+        pool.Release(std::move(buffer));
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  // Each thread reuses its own cached buffer
+  EXPECT_LE(pool.Allocations(), 4u);
+}
+
+/////////////////////////////////////////////////
+TEST(BufferPool, DestroyWithCachedBuffers)
+{
+  std::mutex mutex;
+  std::condition_variable cv;
+  int step = 0;
+  auto pool = std::make_unique<common::BufferPool>(1, 2);
+
+  // A thread keeps buffers of the pool in its cache while the pool is
+  // destroyed, then uses a new pool
+  std::thread worker([&]
+  {
+    pool->Release(pool->Acquire(1000));
+    pool->Release(pool->Acquire(5000));
+    std::unique_lock<std::mutex> lock(mutex);
+    step = 1;
+    cv.notify_all();
+    cv.wait(lock, [&step] { return step == 2; });
+
+    common::BufferPool other(1, 2);
+    auto buffer = other.Acquire(1000);
+    other.Release(std::move(buffer));
+    EXPECT_EQ(1u, other.Allocations());
+    buffer = other.Acquire(1000);
+    EXPECT_EQ(1u, other.Allocations());
+    other.Release(std::move(buffer));
+  });
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&step] { return step == 1; });
+  }
+  EXPECT_EQ(2u, pool->Allocations());
+  pool.reset();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    step = 2;
+    cv.notify_all();
+  }
+  worker.join();
+}
+
+/////////////////////////////////////////////////
+TEST(BufferPool, Default)
+{
+  auto &pool = common::BufferPool::Default();
+  EXPECT_EQ(&pool, &common::BufferPool::Default());
+  auto buffer = pool.Acquire(10);
+  EXPECT_EQ(10u, buffer.size());
+  pool.Release(std::move(buffer));
+}
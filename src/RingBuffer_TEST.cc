@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gz/common/RingBuffer.hh"
+
+using namespace gz;
+using namespace std::chrono_literals;
+
+/// \brief Runs the same tests on both buffer types.
+template<typename Buffer>
+class RingBufferTest : public ::testing::Test
+{
+};
+
+using BufferTypes = ::testing::Types<
+  common::SpscRingBuffer<int>, common::MpmcRingBuffer<int>>;
+TYPED_TEST_SUITE(RingBufferTest, BufferTypes);
+
+/////////////////////////////////////////////////
+TYPED_TEST(RingBufferTest, PushPop)
+{
+  TypeParam buffer(3);
+  EXPECT_EQ(4u, buffer.Capacity());
+  EXPECT_TRUE(buffer.Empty());
+
+  int value = 0;
+  EXPECT_FALSE(buffer.TryPop(value));
+
+  for (int i = 0; i < 4; ++i)
+    EXPECT_TRUE(buffer.TryPush(i));
+  EXPECT_FALSE(buffer.TryPush(4));
+  EXPECT_EQ(4u, buffer.Size());
+
+  // Wrap around several times
+  for (int i = 0; i < 20; ++i)
+  {
+    ASSERT_TRUE(buffer.TryPop(value));
+    EXPECT_EQ(i, value);
+    ASSERT_TRUE(buffer.TryPush(i + 4));
+  }
+  EXPECT_EQ(4u, buffer.Size());
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(RingBufferTest, Batch)
+{
+  TypeParam buffer(8);
+  std::vector<int> in{0, 1, 2, 3, 4, 5};
+  EXPECT_EQ(6u, buffer.TryPushBatch(in.data(), in.size()));
+
+  // Only two more fit
+  EXPECT_EQ(2u, buffer.TryPushBatch(in.data(), in.size()));
+  EXPECT_EQ(8u, buffer.Size());
+
+  std::vector<int> out(10, -1);
+  EXPECT_EQ(5u, buffer.TryPopBatch(out.data(), 5));
+  EXPECT_EQ(3u, buffer.TryPopBatch(out.data() + 5, 5));
+  EXPECT_EQ(0u, buffer.TryPopBatch(out.data(), 5));
+  EXPECT_EQ((std::vector<int>{0, 1, 2, 3, 4, 5, 0, 1, -1, -1}), out);
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(RingBufferTest, Timeout)
+{
+  TypeParam buffer(2);
+  int value = 0;
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(buffer.Pop(value, common::RingBufferWait::BLOCK, 20ms));
+  EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+
+  EXPECT_FALSE(buffer.Pop(value, common::RingBufferWait::YIELD, 1ms));
+  EXPECT_FALSE(buffer.Pop(value, common::RingBufferWait::SPIN, 1ms));
+
+  EXPECT_TRUE(buffer.Push(1));
+  EXPECT_TRUE(buffer.Push(2));
+  EXPECT_FALSE(buffer.Push(3, common::RingBufferWait::BLOCK, 1ms));
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(RingBufferTest, Close)
+{
+  TypeParam buffer(4);
+  EXPECT_TRUE(buffer.Push(1));
+
+  std::atomic<int> popped{0};
+  std::thread consumer([&]
+  {
+    int value;
+    while (buffer.Pop(value))
+      popped += value;
+  });
+
+  std::this_thread::sleep_for(10ms);
+  buffer.Close();
+  consumer.join();
+
+  EXPECT_TRUE(buffer.Closed());
+  EXPECT_EQ(1, popped.load());
+  EXPECT_FALSE(buffer.Push(2));
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(RingBufferTest, ProducerConsumer)
+{
+  const int count = 10000;
+  std::vector<common::RingBufferWait> modes{
+    common::RingBufferWait::YIELD, common::RingBufferWait::BLOCK};
+
+  // Spinning only makes progress when both threads have a core
+  if (std::thread::hardware_concurrency() > 1)
+    modes.push_back(common::RingBufferWait::SPIN);
+
+  for (auto mode : modes)
+  {
+    TypeParam buffer(64);
+    std::thread producer([&]
+    {
+      for (int i = 0; i < count; ++i)
+        ASSERT_TRUE(buffer.Push(i, mode));
+    });
+
+    // Items arrive in order and none is lost
+    int value = -1;
+    for (int i = 0; i < count; ++i)
+    {
+      ASSERT_TRUE(buffer.Pop(value, mode));
+      ASSERT_EQ(i, value);
+    }
+    producer.join();
+    EXPECT_TRUE(buffer.Empty());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(MpmcRingBuffer, ManyProducersConsumers)
+{
+  const int producers = 4;
+  const int consumers = 4;
+  const int perProducer = 25000;
+  common::MpmcRingBuffer<int> buffer(128);
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p)
+  {
+    threads.emplace_back([&buffer, p]
+    {
+      for (int i = 0; i < perProducer; ++i)
+        buffer.Push(p * perProducer + i);
+    });
+  }
+
+  std::vector<std::atomic<int>> seen(producers * perProducer);
+  std::atomic<int> received{0};
+  for (int c = 0; c < consumers; ++c)
+  {
+    threads.emplace_back([&]
+    {
+      int value;
+      while (buffer.Pop(value))
+      {
+        ++seen[value];
+        if (++received == producers * perProducer)
+          buffer.Close();
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_EQ(producers * perProducer, received.load());
+  for (const auto &s : seen)
+    ASSERT_EQ(1, s.load());
+}
+
+/////////////////////////////////////////////////
+TEST(SpscRingBuffer, MoveOnly)
+{
+  common::SpscRingBuffer<std::unique_ptr<std::string>> buffer(2);
+  auto item = std::make_unique<std::string>("data");
+  EXPECT_TRUE(buffer.TryPush(std::move(item)));
+  EXPECT_EQ(nullptr, item);
+
+  // A failed push leaves the item untouched
+  EXPECT_TRUE(buffer.TryPush(std::make_unique<std::string>("data")));
+  item = std::make_unique<std::string>("kept");
+  EXPECT_FALSE(buffer.TryPush(std::move(item)));
+  ASSERT_NE(nullptr, item);
+  EXPECT_EQ("kept", *item);
+
+  std::unique_ptr<std::string> out;
+  EXPECT_TRUE(buffer.TryPop(out));
+  EXPECT_EQ("data", *out);
+}
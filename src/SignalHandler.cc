@@ -18,15 +18,26 @@
 // Suppressing cpplint.py because tools/cpplint.py is old. Remove the NOLINT
 // comments when upgrading to gz-cmake's "make codecheck"
 #include "gz/common/SignalHandler.hh" // NOLINT(*)
+#include <algorithm> // NOLINT(*)
 #include <atomic>
+#include <cerrno> // NOLINT(*)
+#include <condition_variable> // NOLINT(*)
 #include <csignal> // NOLINT(*)
 #include <functional> // NOLINT(*)
 #include <map> // NOLINT(*)
+#include <memory> // NOLINT(*)
 #include <mutex> // NOLINT(*)
+#include <string> // NOLINT(*)
+#include <thread> // NOLINT(*)
 #include <utility> // NOLINT(*)
 #include <vector> // NOLINT(*)
 #include "gz/common/Console.hh" // NOLINT(*)
 
+#ifndef _WIN32
+#include <pthread.h> // NOLINT(*)
+#include <signal.h> // NOLINT(*)
+#endif
+
 using namespace gz;
 using namespace common;
 
@@ -39,11 +50,223 @@ std::mutex gWrapperMutex;
 /// \param[in] _value Signal number.
 void onSignal(int _value)
 {
-  std::lock_guard<std::mutex> lock(gWrapperMutex);
+  // Run the wrappers without holding the lock, so that a callback may
+  // destroy its own SignalHandler
+  std::vector<std::function<void(int)>> wrappers;
+  {
+    std::lock_guard<std::mutex> lock(gWrapperMutex);
+    wrappers.reserve(gOnSignalWrappers.size());
+    for (const auto &func : gOnSignalWrappers)
+      wrappers.push_back(func.second);
+  }
+
   // Send the signal to each wrapper
-  for (std::pair<int, std::function<void(int)>> func : gOnSignalWrappers)
+  for (const auto &func : wrappers)
+    func(_value);
+}
+
+/////////////////////////////////////////////////
+/// \brief Install onSignal as the handler of SIGINT and SIGTERM.
+/// \return True on success.
+bool installSignalHandlers()
+{
+  if (std::signal(SIGINT, onSignal) == SIG_ERR)
+  {
+    gzerr << "Unable to catch SIGINT.\n"
+           << " Please visit http://community.gazebosim.org for help.\n";
+    return false;
+  }
+
+  if (std::signal(SIGTERM, onSignal) == SIG_ERR)
+  {
+    gzerr << "Unable to catch SIGTERM.\n"
+           << " Please visit http://community.gazebosim.org for help.\n";
+    return false;
+  }
+  return true;
+}
+
+#ifndef _WIN32
+// State of the dedicated signal thread shared by all SignalHandlers using
+// DeliveryMode::DEDICATED_THREAD. Guarded by gSignalThreadMutex, which must
+// never be locked while holding gWrapperMutex.
+std::mutex gSignalThreadMutex;
+std::thread gSignalThread;
+pthread_t gSignalThreadId;
+std::atomic<bool> gSignalThreadRunning = {false};
+std::atomic<unsigned int> gSignalThreadGeneration = {0};
+int gSignalThreadUsers = 0;
+
+/////////////////////////////////////////////////
+/// \brief Signal handler installed while the dedicated signal thread runs.
+/// Only async-signal-safe work is done here: the signal is forwarded to the
+/// dedicated thread, which is waiting for it in sigwait.
+/// \param[in] _value Signal number.
+void forwardSignal(int _value)
+{
+  int savedErrno = errno;
+  if (gSignalThreadRunning)
+    pthread_kill(gSignalThreadId, _value);
+  else
+    onSignal(_value);
+  errno = savedErrno;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the set of signals handled by SignalHandler.
+/// \return Set containing SIGINT and SIGTERM.
+sigset_t handledSignals()
+{
+  sigset_t set;
+  sigemptyset(&set);
+  sigaddset(&set, SIGINT);
+  sigaddset(&set, SIGTERM);
+  return set;
+}
+
+/////////////////////////////////////////////////
+/// \brief Body of the dedicated signal thread.
+/// \param[in] _generation Generation of the thread. The thread stops once
+/// gSignalThreadGeneration changes, even if a newer signal thread was
+/// started in the meantime.
+void signalThreadLoop(unsigned int _generation)
+{
+  sigset_t set = handledSignals();
+  while (true)
+  {
+    int sig = 0;
+    if (sigwait(&set, &sig) != 0)
+      continue;
+
+    if (gSignalThreadGeneration != _generation)
+      break;
+
+    onSignal(sig);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Start the dedicated signal thread, or add a user to it if it is
+/// already running. Must be called with gSignalThreadMutex locked.
+/// \return True if the thread is running.
+bool startSignalThread()
+{
+  if (gSignalThreadUsers > 0)
+  {
+    ++gSignalThreadUsers;
+    return true;
+  }
+
+  // Block the signals while spawning, so the new thread inherits a mask
+  // in which they can only be received through sigwait.
+  sigset_t set = handledSignals();
+  sigset_t previous;
+  if (pthread_sigmask(SIG_BLOCK, &set, &previous) != 0)
+    return false;
+
+  gSignalThread = std::thread(signalThreadLoop,
+      gSignalThreadGeneration.load());
+  gSignalThreadId = gSignalThread.native_handle();
+  pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+
+  gSignalThreadRunning = true;
+  if (std::signal(SIGINT, forwardSignal) == SIG_ERR ||
+      std::signal(SIGTERM, forwardSignal) == SIG_ERR)
+  {
+    gzerr << "Unable to forward signals to the signal thread.\n";
+  }
+
+  ++gSignalThreadUsers;
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Remove a user of the dedicated signal thread, stopping the thread
+/// when there are no users left. Must be called with gSignalThreadMutex
+/// locked, and without holding gWrapperMutex.
+void stopSignalThread()
+{
+  if (gSignalThreadUsers <= 0 || --gSignalThreadUsers > 0)
+    return;
+
+  // Restore direct delivery for any remaining SIGNAL_CONTEXT handlers
+  installSignalHandlers();
+
+  ++gSignalThreadGeneration;
+  gSignalThreadRunning = false;
+  pthread_kill(gSignalThreadId, SIGTERM);
+
+  // A callback may destroy the last handler from the signal thread itself
+  if (gSignalThread.get_id() == std::this_thread::get_id())
+    gSignalThread.detach();
+  else
+    gSignalThread.join();
+}
+#endif
+
+/////////////////////////////////////////////////
+/// \brief A step of the shutdown sequence of a SignalHandler.
+class ShutdownStep
+{
+  /// \brief Name of the step.
+  public: std::string name;
+
+  /// \brief Function to execute.
+  public: std::function<void(int)> step;
+
+  /// \brief Maximum time to wait for the step, zero to wait forever.
+  public: std::chrono::steady_clock::duration timeout;
+
+  /// \brief Position in the shutdown sequence.
+  public: int order = 0;
+};
+
+/////////////////////////////////////////////////
+/// \brief Run a shutdown step, waiting at most for its timeout.
+/// \param[in] _step Step to run.
+/// \param[in] _sig Signal number.
+void runShutdownStep(const ShutdownStep &_step, int _sig)
+{
+  if (_step.timeout == std::chrono::steady_clock::duration::zero())
   {
-    func.second(_value);
+    _step.step(_sig);
+    return;
+  }
+
+  // Shared with the worker, which may outlive this function on timeout
+  struct Completion
+  {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+  };
+  auto completion = std::make_shared<Completion>();
+
+  std::thread worker([completion, func = _step.step, _sig]
+  {
+    func(_sig);
+    std::lock_guard<std::mutex> lock(completion->mutex);
+    completion->done = true;
+    completion->cv.notify_all();
+  });
+
+  bool done;
+  {
+    std::unique_lock<std::mutex> lock(completion->mutex);
+    done = completion->cv.wait_for(lock, _step.timeout,
+        [&completion] { return completion->done; });
+  }
+
+  if (done)
+  {
+    worker.join();
+  }
+  else
+  {
+    gzwarn << "Shutdown step [" << _step.name << "] did not finish within "
+      << std::chrono::duration_cast<std::chrono::milliseconds>(
+          _step.timeout).count() << " ms, continuing shutdown.\n";
+    worker.detach();
   }
 }
 
@@ -57,6 +280,13 @@ class common::SignalHandlerPrivate
   /// \brief the callbacks to execute when a signal is received.
   public: std::vector<std::function<void(int)>> callbacks;
 
+  /// \brief Shutdown steps, sorted by order.
+  public: std::vector<ShutdownStep> shutdownSteps;
+
+  /// \brief How signals are delivered to this handler.
+  public: SignalHandler::DeliveryMode mode =
+          SignalHandler::DeliveryMode::SIGNAL_CONTEXT;
+
   /// \brief Callback mutex.
   public: std::mutex cbMutex;
 
@@ -69,27 +299,53 @@ class common::SignalHandlerPrivate
 
 /////////////////////////////////////////////////
 SignalHandler::SignalHandler()
+  : SignalHandler(DeliveryMode::SIGNAL_CONTEXT)
+{
+}
+
+/////////////////////////////////////////////////
+SignalHandler::SignalHandler(const DeliveryMode _mode)
   : dataPtr(new SignalHandlerPrivate)
 {
   static int counter = 0;
-  std::lock_guard<std::mutex> lock(gWrapperMutex);
 
-  if (std::signal(SIGINT, onSignal) == SIG_ERR)
+#ifndef _WIN32
   {
-    gzerr << "Unable to catch SIGINT.\n"
-           << " Please visit http://community.gazebosim.org for help.\n";
-    return;
+    std::lock_guard<std::mutex> threadLock(gSignalThreadMutex);
+    if (_mode == DeliveryMode::DEDICATED_THREAD)
+    {
+      if (!startSignalThread())
+      {
+        gzerr << "Unable to start the signal thread.\n"
+               << " Please visit http://community.gazebosim.org for help.\n";
+        return;
+      }
+      this->dataPtr->mode = DeliveryMode::DEDICATED_THREAD;
+    }
+    // While the signal thread runs it forwards to onSignal, so its
+    // handlers must not be replaced.
+    else if (!gSignalThreadRunning && !installSignalHandlers())
+    {
+      return;
+    }
   }
-
-  if (std::signal(SIGTERM, onSignal) == SIG_ERR)
+#else
+  if (_mode == DeliveryMode::DEDICATED_THREAD)
   {
-    gzerr << "Unable to catch SIGTERM.\n"
-           << " Please visit http://community.gazebosim.org for help.\n";
-    return;
+    gzwarn << "A dedicated signal thread is not supported on Windows, "
+           << "callbacks will run in signal context.\n";
   }
 
+  if (!installSignalHandlers())
+    return;
+#endif
+
+  // The wrapper shares ownership of the private data, which is kept alive
+  // while a signal is delivered even if this handler is destroyed
+  std::shared_ptr<SignalHandlerPrivate> data(this->dataPtr);
+  std::lock_guard<std::mutex> lock(gWrapperMutex);
   gOnSignalWrappers[counter] = std::bind(&SignalHandlerPrivate::OnSignal,
-      this->dataPtr, std::placeholders::_1);
+      data, std::placeholders::_1);
   this->dataPtr->wrapperIndex = counter;
 
   ++counter;
@@ -100,9 +356,34 @@ SignalHandler::SignalHandler()
 /////////////////////////////////////////////////
 SignalHandler::~SignalHandler()
 {
-  std::lock_guard<std::mutex> lock(gWrapperMutex);
-  gOnSignalWrappers.erase(this->dataPtr->wrapperIndex);
-  delete this->dataPtr;
+  const int wrapperIndex = this->dataPtr->wrapperIndex;
+  const DeliveryMode mode = this->dataPtr->mode;
+
+  // Released at the end of the destructor, outside of the lock
+  std::function<void(int)> wrapper;
+  {
+    std::lock_guard<std::mutex> lock(gWrapperMutex);
+    auto it = gOnSignalWrappers.find(wrapperIndex);
+    if (it != gOnSignalWrappers.end())
+    {
+      wrapper = std::move(it->second);
+      gOnSignalWrappers.erase(it);
+    }
+  }
+
+#ifndef _WIN32
+  if (mode == DeliveryMode::DEDICATED_THREAD)
+  {
+    std::lock_guard<std::mutex> threadLock(gSignalThreadMutex);
+    stopSignalThread();
+  }
+#else
+  (void)mode;
+#endif
+
+  // Otherwise the private data is owned by the wrapper
+  if (wrapperIndex < 0)
+    delete this->dataPtr;
   this->dataPtr = nullptr;
 }
 
@@ -135,11 +416,63 @@ bool SignalHandler::AddCallback(std::function<void(int)> _cb)
   return result;
 }
 
+//////////////////////////////////////////////////
+bool SignalHandler::AddShutdownStep(const std::string &_name,
+    std::function<void(int)> _step,
+    const std::chrono::steady_clock::duration &_timeout,
+    const int _order)
+{
+  if (!this->dataPtr->initialized)
+  {
+    gzerr << "The SignalHandler was not initialized. Adding a shutdown step "
+      << "will have no effect.\n";
+    return false;
+  }
+
+  if (this->dataPtr->mode != DeliveryMode::DEDICATED_THREAD)
+  {
+    gzerr << "Shutdown step [" << _name << "] requires a SignalHandler "
+      << "constructed with DeliveryMode::DEDICATED_THREAD.\n";
+    return false;
+  }
+
+  ShutdownStep step;
+  step.name = _name;
+  step.step = std::move(_step);
+  step.timeout = _timeout;
+  step.order = _order;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->cbMutex);
+  auto &steps = this->dataPtr->shutdownSteps;
+  auto it = std::upper_bound(steps.begin(), steps.end(), _order,
+      [](int _o, const ShutdownStep &_s) { return _o < _s.order; });
+  steps.insert(it, std::move(step));
+  return true;
+}
+
+//////////////////////////////////////////////////
+SignalHandler::DeliveryMode SignalHandler::Mode() const
+{
+  return this->dataPtr->mode;
+}
+
 //////////////////////////////////////////////////
 void SignalHandlerPrivate::OnSignal(int _sig)
 {
-  std::lock_guard<std::mutex> lock(this->cbMutex);
   gzdbg << "Received signal[" << _sig << "].\n";
-  for (std::function<void(int)> cb : this->callbacks)
+
+  // Callbacks and steps may add callbacks, they run without the lock
+  std::vector<std::function<void(int)>> cbs;
+  std::vector<ShutdownStep> steps;
+  {
+    std::lock_guard<std::mutex> lock(this->cbMutex);
+    cbs = this->callbacks;
+    steps = this->shutdownSteps;
+  }
+
+  for (const std::function<void(int)> &cb : cbs)
     cb(_sig);
+
+  for (const ShutdownStep &step : steps)
+    runShutdownStep(step, _sig);
 }
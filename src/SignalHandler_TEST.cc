@@ -19,11 +19,17 @@
 // comments when upgrading to gz-cmake's "make codecheck"
 #include "gz/common/SignalHandler.hh" // NOLINT(*)
 #include <gtest/gtest.h> // NOLINT(*)
+#include <algorithm> // NOLINT(*)
+#include <atomic> // NOLINT(*)
+#include <chrono> // NOLINT(*)
 #include <csignal> // NOLINT(*)
 #include <condition_variable> // NOLINT(*)
 #include <map> // NOLINT(*)
+#include <memory> // NOLINT(*)
 #include <mutex> // NOLINT(*)
+#include <string> // NOLINT(*)
 #include <thread> // NOLINT(*)
+#include <vector> // NOLINT(*)
 #include "gz/common/Util.hh" // NOLINT(*)
 
 using namespace gz;
@@ -287,3 +293,200 @@ TEST(SignalHandler, MultipleThreads)
   for (int i = 0; i < threadCount; ++i)
     EXPECT_EQ(SIGINT, results[i]);
 }
+
+#ifndef _WIN32
+/////////////////////////////////////////////////
+TEST(SignalHandler, DedicatedThread)
+{
+  std::mutex mutex;
+  std::condition_variable cv;
+  int received = -1;
+  std::thread::id callbackThread;
+
+  {
+    common::SignalHandler handler(
+        common::SignalHandler::DeliveryMode::DEDICATED_THREAD);
+    EXPECT_TRUE(handler.Initialized());
+    EXPECT_EQ(common::SignalHandler::DeliveryMode::DEDICATED_THREAD,
+        handler.Mode());
+
+    EXPECT_TRUE(handler.AddCallback([&] (int _sig)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      received = _sig;
+      callbackThread = std::this_thread::get_id();
+      cv.notify_all();
+    }));
+
+    std::unique_lock<std::mutex> lock(mutex);
+    std::raise(SIGTERM);
+    EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(5),
+        [&received] { return received != -1; }));
+  }
+
+  // The callback ran on the signal thread, not in this thread's handler
+  EXPECT_EQ(SIGTERM, received);
+  EXPECT_NE(std::this_thread::get_id(), callbackThread);
+
+  // Direct delivery is restored once the signal thread is gone
+  resetSignals();
+  common::SignalHandler handler1;
+  EXPECT_EQ(common::SignalHandler::DeliveryMode::SIGNAL_CONTEXT,
+      handler1.Mode());
+  EXPECT_TRUE(handler1.AddCallback(handler1Cb));
+  std::raise(SIGINT);
+  EXPECT_EQ(SIGINT, gHandler1Sig);
+}
+
+/////////////////////////////////////////////////
+TEST(SignalHandler, DestroyInCallback)
+{
+  std::mutex mutex;
+  std::condition_variable cv;
+  int received = -1;
+
+  auto handler = std::make_unique<common::SignalHandler>(
+      common::SignalHandler::DeliveryMode::DEDICATED_THREAD);
+  ASSERT_TRUE(handler->Initialized());
+
+  // The callback destroys its own handler, and with it the signal thread
+  EXPECT_TRUE(handler->AddCallback([&] (int _sig)
+  {
+    handler.reset();
+    std::lock_guard<std::mutex> lock(mutex);
+    received = _sig;
+    cv.notify_all();
+  }));
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    std::raise(SIGTERM);
+    EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(5),
+        [&received] { return received != -1; }));
+  }
+  EXPECT_EQ(SIGTERM, received);
+  EXPECT_EQ(nullptr, handler);
+
+  // A new signal thread can be started afterwards
+  received = -1;
+  {
+    common::SignalHandler other(
+        common::SignalHandler::DeliveryMode::DEDICATED_THREAD);
+    EXPECT_TRUE(other.AddCallback([&] (int _sig)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      received = _sig;
+      cv.notify_all();
+    }));
+
+    std::unique_lock<std::mutex> lock(mutex);
+    std::raise(SIGINT);
+    EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(5),
+        [&received] { return received != -1; }));
+  }
+  EXPECT_EQ(SIGINT, received);
+}
+
+/////////////////////////////////////////////////
+TEST(SignalHandler, ShutdownSteps)
+{
+  common::SignalHandler contextHandler;
+  EXPECT_FALSE(contextHandler.AddShutdownStep("step", [] (int) {}));
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<std::string> order;
+  // Shared with the stuck step, which outlives this test
+  auto release = std::make_shared<std::atomic<bool>>(false);
+
+  auto record = [&] (const std::string &_name)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    order.push_back(_name);
+    cv.notify_all();
+  };
+
+  {
+    common::SignalHandler handler(
+        common::SignalHandler::DeliveryMode::DEDICATED_THREAD);
+
+    EXPECT_TRUE(handler.AddShutdownStep("last",
+        [&] (int) { record("last"); }, std::chrono::seconds(5), 10));
+    EXPECT_TRUE(handler.AddShutdownStep("stuck",
+        [release] (int)
+        {
+          while (!*release)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }, std::chrono::milliseconds(50), 1));
+    EXPECT_TRUE(handler.AddShutdownStep("first",
+        [&] (int) { record("first"); }));
+    EXPECT_TRUE(handler.AddShutdownStep("second",
+        [&] (int) { record("second"); }, std::chrono::seconds(5)));
+    EXPECT_TRUE(handler.AddCallback([&] (int) { record("callback"); }));
+
+    std::unique_lock<std::mutex> lock(mutex);
+    std::raise(SIGINT);
+    EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(5),
+        [&order] { return order.size() == 4u; }));
+  }
+  *release = true;
+
+  // Callbacks first, then steps by order, and the stuck step was skipped
+  ASSERT_EQ(4u, order.size());
+  EXPECT_EQ("callback", order[0]);
+  EXPECT_EQ("first", order[1]);
+  EXPECT_EQ("second", order[2]);
+  EXPECT_EQ("last", order[3]);
+}
+
+/////////////////////////////////////////////////
+TEST(SignalHandler, AddCallbackWhileSignaled)
+{
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<std::string> order;
+  auto record = [&] (const std::string &_name)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    order.push_back(_name);
+    cv.notify_all();
+  };
+
+  common::SignalHandler handler(
+      common::SignalHandler::DeliveryMode::DEDICATED_THREAD);
+
+  // Callbacks and steps can register more callbacks without deadlocking
+  EXPECT_TRUE(handler.AddCallback([&] (int)
+  {
+    handler.AddCallback([&] (int) { record("added by callback"); });
+    record("callback");
+  }));
+  EXPECT_TRUE(handler.AddShutdownStep("step", [&] (int)
+  {
+    handler.AddCallback([&] (int) { record("added by step"); });
+    record("step");
+  }, std::chrono::seconds(10)));
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    std::raise(SIGINT);
+    EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(5),
+        [&order] { return order.size() == 2u; }));
+  }
+  ASSERT_EQ(2u, order.size());
+  EXPECT_EQ("callback", order[0]);
+  EXPECT_EQ("step", order[1]);
+
+  // The added callbacks run on the next signal
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    std::raise(SIGINT);
+    EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(5),
+        [&order] { return order.size() >= 6u; }));
+  }
+  EXPECT_NE(order.end(),
+      std::find(order.begin(), order.end(), "added by callback"));
+  EXPECT_NE(order.end(),
+      std::find(order.begin(), order.end(), "added by step"));
+}
+#endif
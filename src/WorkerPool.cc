@@ -36,9 +36,9 @@ namespace gz
       /// \brief Constructor used by std::deque::emplace.
       /// \param[in] _work Work function.
       /// \param[in] _cb Callback function.
-      public: WorkOrder(const std::function<void()> &_work,
-                 const std::function<void()> &_cb)
-        : work(_work), callback(_cb) {}
+      public: WorkOrder(std::function<void()> &&_work,
+                 std::function<void()> &&_cb)
+        : work(std::move(_work)), callback(std::move(_cb)) {}
 
       /// \brief method that does the work
       public: std::function<void()> work = std::function<void()>();
@@ -155,7 +155,8 @@ WorkerPool::~WorkerPool()
 void WorkerPool::AddWork(std::function<void()> _work, std::function<void()> _cb)
 {
   std::unique_lock<std::mutex> queueLock(this->dataPtr->queueMtx);
-  this->dataPtr->workOrders.emplace(_work, _cb);
+  // Move the functions so that their captured state is not copied again
+  this->dataPtr->workOrders.emplace(std::move(_work), std::move(_cb));
   this->dataPtr->signalNewWork.notify_one();
 }
 
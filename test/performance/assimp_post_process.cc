@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/common/AssimpLoader.hh>
+#include <gz/common/Mesh.hh>
+#include <gz/common/testing/TestPaths.hh>
+
+using namespace gz;
+
+namespace {
+const int g_iterations{20};
+}  // namespace
+
+/////////////////////////////////////////////////
+TEST(AssimpPostProcess, LoadTime)
+{
+  using Profile = common::AssimpLoader::PostProcessing;
+  const std::vector<std::pair<std::string, Profile>> profiles{
+    {"default", Profile::DEFAULT},
+    {"fast", Profile::FAST},
+    {"quality", Profile::QUALITY}};
+
+  const std::vector<std::string> files{
+    "box.glb",
+    "box_texture_jpg.glb",
+    "box_transmission.glb",
+    "fully_featured.glb",
+    "multiple_texture_coordinates_triangle.glb",
+    "box.fbx"};
+
+  for (const auto &file : files)
+  {
+    const std::string path = common::testing::TestFile("data", file);
+    for (const auto &[name, profile] : profiles)
+    {
+      common::AssimpLoader loader;
+      loader.SetPostProcessProfile(profile);
+
+      // Keep texture decoding out of the measurement
+      loader.SetEmbeddedTextureDecoding(
+          common::AssimpLoader::TextureDecoding::DEFERRED);
+
+      unsigned int vertices = 0;
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < g_iterations; ++i)
+      {
+        common::Mesh *mesh = loader.Load(path);
+        ASSERT_NE(nullptr, mesh);
+        vertices = mesh->VertexCount();
+        delete mesh;
+      }
+      auto elapsed = std::chrono::steady_clock::now() - start;
+
+      std::cout << file << " [" << name << "]: "
+                << std::chrono::duration_cast<std::chrono::microseconds>(
+                       elapsed).count() / g_iterations << " us/load, "
+                << vertices << " vertices" << std::endl;
+      EXPECT_LT(0u, vertices);
+    }
+  }
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <gz/common/BinaryLog.hh>
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/testing/TestPaths.hh>
+
+using namespace gz;
+
+namespace {
+const uint64_t g_iterations{100000};
+}  // namespace
+
+class BinaryLoggingTest:
+      public ::testing::TestWithParam<std::size_t>
+{
+};
+
+/////////////////////////////////////////////////
+TEST_P(BinaryLoggingTest, RunThreads)
+{
+  const std::size_t threadCount = GetParam();
+  auto tempDir = common::testing::MakeTestTempDirectory();
+  ASSERT_TRUE(tempDir->Valid());
+
+  common::BinaryLog log;
+  ASSERT_TRUE(log.Open(common::joinPaths(tempDir->Path(), "perf.gzblog"),
+      1u << 20));
+
+  std::vector<std::thread> threads;
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t t = 0; t < threadCount; ++t)
+  {
+    threads.emplace_back([&log, t, threadCount]
+    {
+      for (uint64_t i = t; i < g_iterations; i += threadCount)
+        gzbinlog(log, 3, "Some text to log for thread: {} iteration {}", t, i);
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  EXPECT_EQ(g_iterations, log.RecordCount());
+
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      elapsed).count();
+  std::cout << threadCount << " threads: " << g_iterations << " records in "
+            << ns / 1000 << " us, "
+            << static_cast<double>(ns) / static_cast<double>(g_iterations)
+            << " ns/record" << std::endl;
+
+  // Decoding happens offline and is not part of the hot path
+  std::ostringstream text;
+  EXPECT_TRUE(common::decodeBinaryLog(log.Path(), text));
+}
+
+INSTANTIATE_TEST_SUITE_P(BinaryLoggingTest, BinaryLoggingTest,
+                         ::testing::Values(1, 2, 4, 8));
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <gz/common/ColladaLoader.hh>
+#include <gz/common/Mesh.hh>
+#include <gz/common/Skeleton.hh>
+#include <gz/common/SkeletonAnimation.hh>
+#include <gz/common/testing/TestPaths.hh>
+
+using namespace gz;
+
+namespace {
+const int g_iterations{20};
+}  // namespace
+
+/////////////////////////////////////////////////
+TEST(ColladaAnimation, LoadTime)
+{
+  const std::string path = common::testing::TestFile("data", "walk.dae");
+
+  unsigned int nodes = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < g_iterations; ++i)
+  {
+    common::ColladaLoader loader;
+    common::Mesh *mesh = loader.Load(path);
+    ASSERT_NE(nullptr, mesh);
+    ASSERT_TRUE(mesh->HasSkeleton());
+    ASSERT_LT(0u, mesh->MeshSkeleton()->AnimationCount());
+    nodes = mesh->MeshSkeleton()->Animation(0)->NodeCount();
+    delete mesh;
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  std::cout << "walk.dae: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(
+                   elapsed).count() / g_iterations << " us/load, "
+            << nodes << " animated nodes" << std::endl;
+  EXPECT_LT(0u, nodes);
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include <gz/common/Event.hh>
+#include <gz/common/KeyedEvent.hh>
+
+using namespace gz;
+
+namespace {
+/// \brief Number of subscribers of a large world.
+const int g_subscribers{100000};
+
+/// \brief Print and return the duration of a function.
+template<typename F>
+double timeIt(const char *_label, F &&_func)
+{
+  auto start = std::chrono::steady_clock::now();
+  _func();
+  const double ms = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start).count();
+  std::cout << _label << ": " << ms << " ms" << std::endl;
+  return ms;
+}
+}  // namespace
+
+/////////////////////////////////////////////////
+TEST(EventConnections, Teardown)
+{
+  int count = 0;
+  common::EventT<void()> evt;
+
+  std::vector<common::ConnectionPtr> connections;
+  timeIt("Connect ConnectionPtr", [&]
+  {
+    connections.reserve(g_subscribers);
+    for (int i = 0; i < g_subscribers; ++i)
+      connections.push_back(evt.Connect([&count]() { ++count; }));
+  });
+  evt();
+  const double shared = timeIt("Disconnect ConnectionPtr", [&]
+  {
+    connections.clear();
+    evt();
+  });
+
+  std::vector<common::ConnectionToken> tokens;
+  timeIt("Connect ConnectionToken", [&]
+  {
+    tokens.reserve(g_subscribers);
+    for (int i = 0; i < g_subscribers; ++i)
+      tokens.push_back(evt.ConnectToken([&count]() { ++count; }));
+  });
+  timeIt("Disconnect ConnectionToken", [&]
+  {
+    for (auto &token : tokens)
+      evt.Disconnect(token);
+    evt();
+  });
+
+  common::ConnectionGroup group;
+  timeIt("Connect ConnectionGroup", [&]
+  {
+    for (int i = 0; i < g_subscribers; ++i)
+      evt.Connect(group, [&count]() { ++count; });
+  });
+  const double grouped = timeIt("Disconnect ConnectionGroup", [&]
+  {
+    group.Disconnect();
+    evt();
+  });
+
+  EXPECT_EQ(0u, evt.ConnectionCount());
+  EXPECT_EQ(g_subscribers, count);
+  EXPECT_LT(grouped, shared);
+}
+
+/////////////////////////////////////////////////
+TEST(EventConnections, KeyedSignal)
+{
+  // One update of a few entities, each subscriber only caring about its
+  // own entity
+  const int updates = 100;
+  int count = 0;
+
+  common::ConnectionGroup filteredGroup;
+  common::EventT<void(int)> filtered;
+  for (int i = 0; i < g_subscribers; ++i)
+  {
+    filtered.Connect(filteredGroup, [i, &count](int _entity)
+    {
+      if (_entity == i)
+        ++count;
+    });
+  }
+  const double filteredMs = timeIt("Signal filtered EventT", [&]
+  {
+    for (int i = 0; i < updates; ++i)
+      filtered(i);
+  });
+
+  common::ConnectionGroup keyedGroup;
+  common::KeyedEventT<void(int), int> keyed;
+  for (int i = 0; i < g_subscribers; ++i)
+    keyed.Connect(keyedGroup, i, [&count](int) { ++count; });
+  const double keyedMs = timeIt("Signal KeyedEventT", [&]
+  {
+    for (int i = 0; i < updates; ++i)
+      keyed(i, i);
+  });
+
+  EXPECT_EQ(2 * updates, count);
+  EXPECT_LT(keyedMs, filteredMs);
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#ifdef __linux__
+#include <spawn.h>
+#include <sys/wait.h>
+#endif
+
+#include <gz/common/Mesh.hh>
+#include <gz/common/MeshManager.hh>
+
+using namespace gz;
+
+namespace {
+const int g_iterations{20};
+
+/////////////////////////////////////////////////
+/// \brief Microseconds elapsed since _start.
+double elapsedUs(std::chrono::steady_clock::time_point _start)
+{
+  return std::chrono::duration<double, std::micro>(
+      std::chrono::steady_clock::now() - _start).count();
+}
+}  // namespace
+
+#ifdef __linux__
+extern char **environ;
+
+/////////////////////////////////////////////////
+/// \brief Time to launch this binary, which links the graphics library,
+/// and let it return from main without running any test.
+TEST(MeshManagerStartup, Launch)
+{
+  char exe[] = "/proc/self/exe";
+  char filter[] = "--gtest_filter=-*";
+  char *argv[] = {exe, filter, nullptr};
+
+  double total = 0;
+  for (int i = 0; i < g_iterations; ++i)
+  {
+    auto start = std::chrono::steady_clock::now();
+    pid_t pid;
+    ASSERT_EQ(0, posix_spawn(&pid, exe, nullptr, nullptr, argv, environ));
+    int status = 0;
+    ASSERT_EQ(pid, waitpid(pid, &status, 0));
+    total += elapsedUs(start);
+    EXPECT_TRUE(WIFEXITED(status));
+  }
+  std::cout << "Process launch to exit: " << total / g_iterations
+            << " us" << std::endl;
+}
+#endif
+
+/////////////////////////////////////////////////
+TEST(MeshManagerStartup, Builtins)
+{
+  auto start = std::chrono::steady_clock::now();
+  auto mgr = common::MeshManager::Instance();
+  std::cout << "First Instance(): " << elapsedUs(start) << " us"
+            << std::endl;
+
+  start = std::chrono::steady_clock::now();
+  const common::Mesh *sphere = mgr->MeshByName("unit_sphere");
+  std::cout << "First unit_sphere request: " << elapsedUs(start) << " us"
+            << std::endl;
+  ASSERT_NE(nullptr, sphere);
+
+  start = std::chrono::steady_clock::now();
+  for (const std::string name : {"unit_plane", "joint_anchor", "body_cg",
+      "unit_box", "unit_cylinder", "unit_cone", "unit_camera", "axis_shaft",
+      "axis_head", "selection_tube"})
+  {
+    EXPECT_TRUE(mgr->HasMesh(name)) << name;
+  }
+  std::cout << "Remaining built-in meshes: " << elapsedUs(start) << " us"
+            << std::endl;
+}
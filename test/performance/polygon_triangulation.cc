@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gz/common/MeshManager.hh>
+#include <gz/common/PolygonTriangulation.hh>
+#ifndef _WIN32
+#include <gz/common/GTSMeshUtils.hh>
+#include <gz/common/SubMesh.hh>
+#endif
+
+using namespace gz;
+
+namespace {
+const int g_iterations{5};
+
+/////////////////////////////////////////////////
+/// \brief Floor plan of _rooms x _rooms square rooms, each with a pillar.
+void floorPlan(int _rooms, std::vector<std::vector<math::Vector2d>> &_rings)
+{
+  _rings.clear();
+  for (int i = 0; i < _rooms; ++i)
+  {
+    for (int j = 0; j < _rooms; ++j)
+    {
+      for (double size : {4.0, 1.0})
+      {
+        const double x = i * 5.0 + (size < 4.0 ? 1.5 : 0.0);
+        const double y = j * 5.0 + (size < 4.0 ? 1.5 : 0.0);
+        _rings.push_back({
+          math::Vector2d(x, y), math::Vector2d(x + size, y),
+          math::Vector2d(x + size, y + size), math::Vector2d(x, y + size)});
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Flatten rings into a table of vertices and edges.
+void edgeTable(const std::vector<std::vector<math::Vector2d>> &_rings,
+    std::vector<math::Vector2d> &_vertices,
+    std::vector<math::Vector2i> &_edges)
+{
+  _vertices.clear();
+  _edges.clear();
+  for (const auto &ring : _rings)
+  {
+    const int first = static_cast<int>(_vertices.size());
+    const int n = static_cast<int>(ring.size());
+    for (int i = 0; i < n; ++i)
+    {
+      _vertices.push_back(ring[i]);
+      _edges.push_back(math::Vector2i(first + i, first + (i + 1) % n));
+    }
+  }
+}
+}  // namespace
+
+/////////////////////////////////////////////////
+TEST(PolygonTriangulation, Triangulate)
+{
+  std::vector<std::vector<math::Vector2d>> rings;
+  std::vector<math::Vector2d> vertices;
+  std::vector<math::Vector2i> edges;
+
+  for (int rooms : {10, 20, 40})
+  {
+    floorPlan(rooms, rings);
+    edgeTable(rings, vertices, edges);
+
+    std::vector<unsigned int> indices;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < g_iterations; ++i)
+    {
+      ASSERT_TRUE(common::PolygonTriangulation::Triangulate(vertices, edges,
+          indices));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << rooms * rooms << " rooms [native]: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(
+                     elapsed).count() / g_iterations << " us/triangulation, "
+              << indices.size() / 3 << " triangles" << std::endl;
+
+#ifndef _WIN32
+    common::SubMesh subMesh;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < g_iterations; ++i)
+    {
+      subMesh = common::SubMesh();
+      ASSERT_TRUE(common::GTSMeshUtils::DelaunayTriangulation(vertices, edges,
+          &subMesh));
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << rooms * rooms << " rooms [gts]: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(
+                     elapsed).count() / g_iterations << " us/triangulation, "
+              << subMesh.IndexCount() / 3 << " triangles" << std::endl;
+#endif
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PolygonTriangulation, CreateExtrudedPolyline)
+{
+  std::vector<std::vector<math::Vector2d>> rings;
+  floorPlan(20, rings);
+
+  auto mgr = common::MeshManager::Instance();
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < g_iterations; ++i)
+  {
+    const std::string name = "extruded_floor_plan_" + std::to_string(i);
+    mgr->CreateExtrudedPolyline(name, rings, 3.0);
+    EXPECT_TRUE(mgr->HasMesh(name));
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << rings.size() << " polylines: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(
+                   elapsed).count() / g_iterations << " us/extrusion"
+            << std::endl;
+}
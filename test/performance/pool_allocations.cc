@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <gz/common/Pool.hh>
+#include <gz/common/WorkerPool.hh>
+
+using namespace gz;
+
+namespace {
+/// \brief Number of global operator new calls in this process.
+std::atomic<uint64_t> g_allocations{0};
+
+const int g_iterations{10000};
+
+/// \brief Print and return the allocations made by a function.
+template<typename F>
+uint64_t countAllocations(const char *_label, F &&_func)
+{
+  const uint64_t before = g_allocations.load();
+  auto start = std::chrono::steady_clock::now();
+  _func();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  const uint64_t count = g_allocations.load() - before;
+  std::cout << _label << ": " << count << " allocations, "
+            << std::chrono::duration_cast<std::chrono::microseconds>(
+                   elapsed).count() << " us" << std::endl;
+  return count;
+}
+}  // namespace
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size)
+{
+  ++g_allocations;
+  if (void *ptr = std::malloc(_size ? _size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, std::size_t) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size, std::align_val_t _align)
+{
+  ++g_allocations;
+  // aligned_alloc needs a size that is a multiple of the alignment
+  const auto align = static_cast<std::size_t>(_align);
+  const std::size_t size = ((_size ? _size : 1) + align - 1) / align * align;
+  if (void *ptr = std::aligned_alloc(align, size))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, std::align_val_t) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, std::size_t, std::align_val_t) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+TEST(PoolAllocations, FrameBuffers)
+{
+  const std::size_t frameSize = 640 * 480 * 3;
+
+  // Only printed, the compiler may elide or merge these allocations
+  countAllocations("std::vector per frame", [&]
+  {
+    for (int i = 0; i < g_iterations; ++i)
+    {
+      std::vector<unsigned char> frame(frameSize);
+      frame[i % frameSize] = 1;
+    }
+  });
+
+  common::BufferPool pool;
+  auto pooled = countAllocations("BufferPool", [&]
+  {
+    for (int i = 0; i < g_iterations; ++i)
+    {
+      auto frame = pool.Acquire(frameSize);
+      frame[i % frameSize] = 1;
+      pool.Release(std::move(frame));
+    }
+  });
+
+  // One buffer, the first entry of the thread cache and its registration
+  EXPECT_LE(pooled, 3u);
+}
+
+/////////////////////////////////////////////////
+TEST(PoolAllocations, Objects)
+{
+  using Pose = std::array<double, 16>;
+
+  // Only printed, the compiler may elide or merge these allocations
+  countAllocations("std::make_unique", [&]
+  {
+    for (int i = 0; i < g_iterations; ++i)
+    {
+      auto a = std::make_unique<Pose>();
+      auto b = std::make_unique<Pose>();
+      (*a)[0] = (*b)[0] = i;
+    }
+  });
+
+  common::ObjectPool<Pose> pool;
+  auto pooled = countAllocations("ObjectPool", [&]
+  {
+    for (int i = 0; i < g_iterations; ++i)
+    {
+      auto a = pool.Acquire();
+      auto b = pool.Acquire();
+      (*a)[0] = (*b)[0] = i;
+    }
+  });
+
+  // The free list grows once, blocks are then reused
+  EXPECT_LE(pooled, 4u);
+}
+
+/////////////////////////////////////////////////
+TEST(PoolAllocations, WorkOrders)
+{
+  common::WorkerPool workers;
+  std::array<double, 8> payload{};
+  std::atomic<int> sum{0};
+
+  // The capture is larger than the small buffer of std::function, so each
+  // work item allocates its state. It is allocated once and then moved.
+  auto count = countAllocations("WorkerPool::AddWork", [&]
+  {
+    for (int i = 0; i < g_iterations; ++i)
+    {
+      workers.AddWork([payload, &sum]
+      {
+        sum += static_cast<int>(payload[0]) + 1;
+      });
+    }
+    workers.WaitForResults();
+  });
+
+  EXPECT_EQ(g_iterations, sum.load());
+  std::cout << static_cast<double>(count) / g_iterations
+            << " allocations per work item" << std::endl;
+  EXPECT_LT(count, 3u * g_iterations);
+}
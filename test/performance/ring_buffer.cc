@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/common/RingBuffer.hh>
+
+using namespace gz;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+const int g_itemsPerProducer{200000};
+
+/// \brief The usual alternative: a std::queue guarded by a mutex.
+class LockedQueue
+{
+  public: explicit LockedQueue(std::size_t _capacity) : capacity(_capacity) {}
+
+  public: bool Push(int64_t _item, common::RingBufferWait = {})
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->notFull.wait(lock,
+        [this] { return this->queue.size() < this->capacity; });
+    this->queue.push(_item);
+    this->notEmpty.notify_one();
+    return true;
+  }
+
+  public: bool Pop(int64_t &_item, common::RingBufferWait = {})
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->notEmpty.wait(lock,
+        [this] { return this->closed || !this->queue.empty(); });
+    if (this->queue.empty())
+      return false;
+    _item = this->queue.front();
+    this->queue.pop();
+    this->notFull.notify_one();
+    return true;
+  }
+
+  public: void Close()
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->closed = true;
+    this->notEmpty.notify_all();
+  }
+
+  private: std::size_t capacity;
+  private: std::mutex mutex;
+  private: std::condition_variable notEmpty;
+  private: std::condition_variable notFull;
+  private: std::queue<int64_t> queue;
+  private: bool closed{false};
+};
+
+/// \brief Push timestamps from producers, measure their age in consumers.
+template<typename Queue>
+void run(const std::string &_name, const int _producers,
+         const int _consumers, const common::RingBufferWait _mode)
+{
+  Queue queue(1024);
+  const int64_t total = static_cast<int64_t>(_producers) * g_itemsPerProducer;
+  std::atomic<int64_t> received{0};
+  std::vector<std::vector<int64_t>> latencies(_consumers);
+
+  auto start = Clock::now();
+  std::vector<std::thread> threads;
+  for (int p = 0; p < _producers; ++p)
+  {
+    threads.emplace_back([&]
+    {
+      for (int i = 0; i < g_itemsPerProducer; ++i)
+      {
+        queue.Push(Clock::now().time_since_epoch().count(), _mode);
+      }
+    });
+  }
+  for (int c = 0; c < _consumers; ++c)
+  {
+    threads.emplace_back([&, c]
+    {
+      auto &lat = latencies[c];
+      lat.reserve(g_itemsPerProducer);
+      int64_t sent;
+      while (queue.Pop(sent, _mode))
+      {
+        // Sample one item in 16 to keep the measurement cheap
+        const int64_t n = ++received;
+        if ((n & 0xf) == 0)
+          lat.push_back(Clock::now().time_since_epoch().count() - sent);
+        if (n == total)
+          queue.Close();
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+  std::vector<int64_t> all;
+  for (auto &lat : latencies)
+    all.insert(all.end(), lat.begin(), lat.end());
+  std::sort(all.begin(), all.end());
+  const auto p50 = all.empty() ? 0 : all[all.size() / 2];
+  const auto p99 = all.empty() ? 0 : all[all.size() * 99 / 100];
+
+  std::cout << _name << " " << _producers << "P/" << _consumers << "C: "
+            << static_cast<double>(total) / elapsed / 1e6 << " Mitems/s, "
+            << "latency p50 " << p50 << " ns, p99 " << p99 << " ns"
+            << std::endl;
+  EXPECT_EQ(total, received.load());
+}
+}  // namespace
+
+class RingBufferPerformance : public ::testing::TestWithParam<int>
+{
+};
+
+/////////////////////////////////////////////////
+TEST_P(RingBufferPerformance, Throughput)
+{
+  const int threads = GetParam();
+
+  // Spinning needs a core per thread to make progress
+  const auto mode =
+    std::thread::hardware_concurrency() >= 2u * static_cast<unsigned>(threads)
+    ? common::RingBufferWait::SPIN : common::RingBufferWait::BLOCK;
+
+  if (threads == 1)
+  {
+    run<common::SpscRingBuffer<int64_t>>("spsc", 1, 1, mode);
+    run<common::SpscRingBuffer<int64_t>>("spsc/block", 1, 1,
+        common::RingBufferWait::BLOCK);
+  }
+  run<common::MpmcRingBuffer<int64_t>>("mpmc", threads, threads, mode);
+  run<common::MpmcRingBuffer<int64_t>>("mpmc/block", threads, threads,
+      common::RingBufferWait::BLOCK);
+  run<LockedQueue>("mutex", threads, threads, common::RingBufferWait::BLOCK);
+}
+
+INSTANTIATE_TEST_SUITE_P(RingBufferPerformance, RingBufferPerformance,
+                         ::testing::Values(1, 2, 4));
@@ -0,0 +1,76 @@
+/*
+* Copyright (C) 2024 Open Source Robotics Foundation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+*/
+#ifndef GZ_COMMON_TESTING_CONSOLECAPTURE_HH_
+#define GZ_COMMON_TESTING_CONSOLECAPTURE_HH_
+
+#include <string>
+
+#include <gz/utils/ImplPtr.hh>
+
+#include "gz/common/testing/Export.hh"
+
+namespace gz::common::testing
+{
+
+/// \brief Capture the gz::common::Console output of the calling thread.
+///
+/// Unlike RedirectConsoleStream, this does not touch the process-wide
+/// stdout/stderr file descriptors. Instead it hooks the Console logger
+/// sinks for the thread that created it, so any number of threads (or
+/// tests running in parallel in one process) can capture their own
+/// gzerr/gzwarn/gzmsg/gzdbg output independently.
+///
+/// Output written directly to std::cout/std::cerr or printf is not
+/// captured; use RedirectConsoleStream for that.
+///
+/// The capture is installed on construction and removed on destruction,
+/// restoring any capture that was previously installed on the thread.
+/// The object must be destroyed on the thread that created it.
+class GZ_COMMON_TESTING_VISIBLE ConsoleCapture
+{
+  /// \brief Constructor. Starts capturing the calling thread.
+  public: ConsoleCapture();
+
+  /// \brief Destructor. Stops capturing the calling thread.
+  public: ~ConsoleCapture();
+
+  /// \brief Get the output that would have been written to stdout
+  /// (gzmsg and gzdbg).
+  /// \return Captured stdout text.
+  public: std::string Stdout() const;
+
+  /// \brief Get the output that would have been written to stderr
+  /// (gzerr and gzwarn).
+  /// \return Captured stderr text.
+  public: std::string Stderr() const;
+
+  /// \brief Discard all text captured so far.
+  public: void Clear();
+
+  /// \brief Stop capturing before destruction. Captured text remains
+  /// available.
+  public: void Stop();
+
+  /// \brief Get if the capture is installed on the calling thread.
+  /// \return True if output is being captured.
+  public: bool Active() const;
+
+  /// \brief Implementation pointer
+  GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+};
+}  // namespace gz::common::testing
+#endif  // GZ_COMMON_TESTING_CONSOLECAPTURE_HH_
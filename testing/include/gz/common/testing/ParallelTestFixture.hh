@@ -0,0 +1,94 @@
+/*
+* Copyright (C) 2024 Open Source Robotics Foundation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+*/
+#ifndef GZ_COMMON_TESTING_PARALLELTESTFIXTURE_HH_
+#define GZ_COMMON_TESTING_PARALLELTESTFIXTURE_HH_
+
+#include <memory>
+#include <string>
+
+/// Protect to guarantee that gtest is included before this header.
+#ifdef GTEST_API_
+
+#include <gz/utils/ImplPtr.hh>
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/testing/Utils.hh>
+
+namespace gz::common::testing
+{
+/// \brief A test fixture that isolates a test from other tests running at
+/// the same time, either in other shards/processes or on other threads of
+/// the same process.
+///
+/// Each test gets:
+/// * A temporary directory unique to the test, shard and process, which
+///   is removed after the test unless it failed. The current working
+///   directory is left untouched.
+/// * A ConsoleCapture of the test thread, so Console output can be
+///   inspected without redirecting the process-wide stdout/stderr.
+class ParallelTestFixture : public ::testing::Test
+{
+  /// \brief Constructor
+  public: ParallelTestFixture();
+
+  /// \brief Destructor
+  public: virtual ~ParallelTestFixture();
+
+  /// \brief Setup the test fixture. This gets called by gtest.
+  protected: virtual void SetUp() override;
+
+  /// \brief Tear down the test fixture. This gets called by gtest.
+  protected: virtual void TearDown() override;
+
+  /// \brief Get the temporary directory of this test.
+  /// \return Full path to the temporary directory.
+  protected: std::string TempRoot() const;
+
+  /// \brief Get the path to a file in the temporary directory of this test.
+  /// \param[in] _args Path to the file, relative to TempRoot()
+  /// \return Full path to the file.
+  protected: template <typename... Args>
+             std::string TestTempPath(Args const &... _args) const
+             {
+               return common::joinPaths(this->TempRoot(), _args...);
+             }
+
+  /// \brief Get the shard of the gtest run this test is part of.
+  /// \return The current shard.
+  protected: TestShard Shard() const;
+
+  /// \brief Get the Console stdout output (gzmsg, gzdbg) of the test thread.
+  /// \return Captured text.
+  protected: std::string Stdout() const;
+
+  /// \brief Get the Console stderr output (gzerr, gzwarn) of the test
+  /// thread.
+  /// \return Captured text.
+  protected: std::string Stderr() const;
+
+  /// \brief Pointer to private data.
+  GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+};
+}  // namespace gz::common::testing
+
+#include <gz/common/testing/detail/ParallelTestFixture.hh>
+
+#else
+#warning "ParallelTestFixture needs <gtest/gtest.h> to be included in order to work"
+#endif  // GTEST_API_
+
+#endif  // GZ_COMMON_TESTING_PARALLELTESTFIXTURE_HH_
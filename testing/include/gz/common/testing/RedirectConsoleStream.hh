@@ -42,6 +42,10 @@ class GZ_COMMON_TESTING_VISIBLE RedirectConsoleStream
   /// Upon destruction, the temporary file will be removed.
   /// Access contents before destruction using GetString
   ///
+  /// The redirection applies to the whole process, so it must not be used
+  /// by tests that run concurrently in one process. To inspect the output
+  /// of gz::common::Console from such tests, use ConsoleCapture instead.
+  ///
   /// \param[in] _source Console source to redirect (eg stdout or stderr)
   /// \param[in] _destination Destination filename
   public: RedirectConsoleStream(const StreamSource &_source,
@@ -128,6 +128,45 @@ MakeTestTempDirectory(const std::string &_prefix = "test",
                                    _cleanup);
 }
 
+//////////////////////////////////////////////////
+/// \brief Implementation of MakeUniqueTestTempPath
+///
+/// \param[in] _projectSourcePath Root of project source or empty
+/// \param[in] _testName Name of the test, used as directory prefix
+/// \param[in] _subDir Additional subdirectory for temporary directory
+/// \return Path to the newly-created directory, empty on failure
+std::string
+GZ_COMMON_TESTING_VISIBLE
+MakeUniqueTestTempPathImpl(const std::string &_projectSourcePath,
+                           const std::string &_testName,
+                           const std::string &_subDir = "gz");
+
+//////////////////////////////////////////////////
+/// \brief Create a directory for test output that is unique to a single
+///   test, shard and process.
+///
+/// The directory will have the form
+/// $TMPDIR/_subDir/shard_N/_testName_XXXXXX/, where N is the gtest shard
+/// index and characters of _testName that are not valid in a filename are
+/// replaced by underscores.
+///
+/// Unlike MakeTestTempDirectory, this does not change the current working
+/// directory, which is shared by all threads of the process, and does not
+/// remove the directory; the caller owns it. This makes it safe to use from
+/// tests running concurrently.
+///
+/// \param[in] _testName Name of the test, used as directory prefix
+/// \param[in] _subDir Additional subdirectory for temporary directory
+/// \return Path to the newly-created directory, empty on failure
+inline std::string
+MakeUniqueTestTempPath(const std::string &_testName,
+                       const std::string &_subDir = "gz")
+{
+  return MakeUniqueTestTempPathImpl(kTestingProjectSourceDir,
+                                    _testName,
+                                    _subDir);
+}
+
 //////////////////////////////////////////////////
 /// \brief Return the current build type
 ///
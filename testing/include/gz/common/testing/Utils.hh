@@ -35,6 +35,28 @@ bool
 GZ_COMMON_TESTING_VISIBLE
 createNewEmptyFile(const std::string &_filename);
 
+/////////////////////////////////////////////////
+/// \brief Position of the current process in a sharded gtest run
+struct TestShard
+{
+  /// \brief Zero-based index of this shard
+  unsigned int index {0};
+
+  /// \brief Total number of shards, at least 1
+  unsigned int total {1};
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the shard of the current gtest run, as set by the
+/// GTEST_SHARD_INDEX and GTEST_TOTAL_SHARDS environment variables.
+/// If the variables are missing or invalid, the run is considered to be
+/// a single shard.
+///
+/// \return The current shard
+TestShard
+GZ_COMMON_TESTING_VISIBLE
+currentTestShard();
+
 }  // namespace gz::common::testing
 
 #endif  // GZ_COMMON_TESTING_TESTPATHS_HH_
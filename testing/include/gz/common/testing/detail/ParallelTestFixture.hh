@@ -0,0 +1,120 @@
+/*
+* Copyright (C) 2024 Open Source Robotics Foundation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+*/
+#ifndef GZ_COMMON_TESTING_DETAIL_PARALLELTESTFIXTURE_HH_
+#define GZ_COMMON_TESTING_DETAIL_PARALLELTESTFIXTURE_HH_
+
+#include <memory>
+#include <string>
+
+/// Protect to guarantee that gtest is included before this header.
+///
+/// While downstream users should never directly include the detail
+/// header, this is to primarily protect the ABI checker, which does.
+#ifdef GTEST_API_
+
+#include "gz/common/testing/ParallelTestFixture.hh"
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/testing/ConsoleCapture.hh>
+#include <gz/common/testing/TestPaths.hh>
+#include <gz/common/testing/Utils.hh>
+
+namespace gz::common::testing
+{
+
+//////////////////////////////////////////////////
+class ParallelTestFixture::Implementation
+{
+  /// \brief Temporary directory of the test
+  public: std::string tempRoot;
+
+  /// \brief Shard of the current run
+  public: TestShard shard;
+
+  /// \brief Console capture of the test thread
+  public: std::unique_ptr<ConsoleCapture> capture;
+};
+
+//////////////////////////////////////////////////
+ParallelTestFixture::ParallelTestFixture():
+  dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+ParallelTestFixture::~ParallelTestFixture()
+{
+}
+
+//////////////////////////////////////////////////
+void ParallelTestFixture::SetUp()
+{
+  const ::testing::TestInfo *const testInfo =
+    ::testing::UnitTest::GetInstance()->current_test_info();
+
+  std::string testName = std::string(testInfo->test_case_name()) + "_" +
+    testInfo->name();
+
+  this->dataPtr->shard = currentTestShard();
+  this->dataPtr->capture = std::make_unique<ConsoleCapture>();
+
+  this->dataPtr->tempRoot = MakeUniqueTestTempPath(testName);
+  ASSERT_FALSE(this->dataPtr->tempRoot.empty());
+  ASSERT_TRUE(common::isDirectory(this->dataPtr->tempRoot));
+}
+
+//////////////////////////////////////////////////
+void ParallelTestFixture::TearDown()
+{
+  this->dataPtr->capture.reset();
+
+  // Keep the output of failed tests around for inspection
+  if (!this->dataPtr->tempRoot.empty() && !this->HasFailure())
+    common::removeAll(this->dataPtr->tempRoot);
+}
+
+//////////////////////////////////////////////////
+std::string ParallelTestFixture::TempRoot() const
+{
+  return this->dataPtr->tempRoot;
+}
+
+//////////////////////////////////////////////////
+TestShard ParallelTestFixture::Shard() const
+{
+  return this->dataPtr->shard;
+}
+
+//////////////////////////////////////////////////
+std::string ParallelTestFixture::Stdout() const
+{
+  return this->dataPtr->capture ? this->dataPtr->capture->Stdout() : "";
+}
+
+//////////////////////////////////////////////////
+std::string ParallelTestFixture::Stderr() const
+{
+  return this->dataPtr->capture ? this->dataPtr->capture->Stderr() : "";
+}
+
+}  // namespace gz::common::testing
+
+#else
+#warning "ParallelTestFixture needs <gtest/gtest.h> to be included in order to work"
+#endif  // GTEST_API_
+
+#endif  // GZ_COMMON_TESTING_DETAIL_PARALLELTESTFIXTURE_HH_
@@ -0,0 +1,131 @@
+/*
+* Copyright (C) 2024 Open Source Robotics Foundation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*
+*/
+
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <gz/common/Console.hh>
+#include <gz/common/testing/ConsoleCapture.hh>
+
+namespace gz::common::testing
+{
+
+class ConsoleCapture::Implementation
+{
+  /// \brief Append captured text to the matching buffer
+  /// \param[in] _type Destination the text was intended for
+  /// \param[in] _text Text to append
+  public: void Append(Logger::LogType _type, const std::string &_text);
+
+  /// \brief Text intended for stdout
+  public: std::string out;
+
+  /// \brief Text intended for stderr
+  public: std::string err;
+
+  /// \brief Protects out and err, which may be read from another thread
+  public: mutable std::mutex mutex;
+
+  /// \brief Capture callback installed before this one, if any
+  public: Console::CaptureCallback previous;
+
+  /// \brief Thread on which the capture was installed
+  public: std::thread::id owner;
+
+  /// \brief True while the capture is installed
+  public: bool active {false};
+};
+
+//////////////////////////////////////////////////
+void ConsoleCapture::Implementation::Append(Logger::LogType _type,
+    const std::string &_text)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (_type == Logger::STDOUT)
+    this->out += _text;
+  else
+    this->err += _text;
+}
+
+//////////////////////////////////////////////////
+ConsoleCapture::ConsoleCapture():
+  dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
+{
+  auto *impl = this->dataPtr.get();
+  impl->owner = std::this_thread::get_id();
+  impl->previous = Console::SetThreadCapture(
+      [impl](Logger::LogType _type, const std::string &_text)
+      {
+        impl->Append(_type, _text);
+      });
+  impl->active = true;
+}
+
+//////////////////////////////////////////////////
+ConsoleCapture::~ConsoleCapture()
+{
+  this->Stop();
+}
+
+//////////////////////////////////////////////////
+void ConsoleCapture::Stop()
+{
+  if (!this->dataPtr->active)
+    return;
+
+  if (this->dataPtr->owner != std::this_thread::get_id())
+  {
+    gzerr << "ConsoleCapture must be stopped on the thread that created it"
+      << std::endl;
+    return;
+  }
+
+  Console::SetThreadCapture(this->dataPtr->previous);
+  this->dataPtr->previous = nullptr;
+  this->dataPtr->active = false;
+}
+
+//////////////////////////////////////////////////
+std::string ConsoleCapture::Stdout() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->out;
+}
+
+//////////////////////////////////////////////////
+std::string ConsoleCapture::Stderr() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->err;
+}
+
+//////////////////////////////////////////////////
+void ConsoleCapture::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->out.clear();
+  this->dataPtr->err.clear();
+}
+
+//////////////////////////////////////////////////
+bool ConsoleCapture::Active() const
+{
+  return this->dataPtr->active;
+}
+
+}  // namespace gz::common::testing
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gz/common/Console.hh"
+#include "gz/common/testing/ConsoleCapture.hh"
+
+using namespace gz::common;
+using namespace gz::common::testing;
+
+/////////////////////////////////////////////////
+TEST(ConsoleCapture, Console)
+{
+  Console::SetVerbosity(4);
+
+  ConsoleCapture capture;
+  EXPECT_TRUE(capture.Active());
+
+  gzerr << "error" << std::endl;
+  gzwarn << "warning" << std::endl;
+  gzmsg << "message" << std::endl;
+  gzdbg << "debug" << std::endl;
+
+  auto out = capture.Stdout();
+  auto err = capture.Stderr();
+
+  EXPECT_EQ(out.find("error"), std::string::npos);
+  EXPECT_EQ(out.find("warning"), std::string::npos);
+  EXPECT_NE(out.find("message"), std::string::npos);
+  EXPECT_NE(out.find("debug"), std::string::npos);
+
+  EXPECT_NE(err.find("error"), std::string::npos);
+  EXPECT_NE(err.find("warning"), std::string::npos);
+  EXPECT_EQ(err.find("message"), std::string::npos);
+  EXPECT_EQ(err.find("debug"), std::string::npos);
+
+  capture.Clear();
+  EXPECT_TRUE(capture.Stdout().empty());
+  EXPECT_TRUE(capture.Stderr().empty());
+
+  capture.Stop();
+  EXPECT_FALSE(capture.Active());
+  EXPECT_FALSE(Console::HasThreadCapture());
+}
+
+/////////////////////////////////////////////////
+TEST(ConsoleCapture, Nested)
+{
+  Console::SetVerbosity(4);
+
+  ConsoleCapture outer;
+  gzmsg << "outer" << std::endl;
+  {
+    ConsoleCapture inner;
+    gzmsg << "inner" << std::endl;
+    EXPECT_NE(inner.Stdout().find("inner"), std::string::npos);
+    EXPECT_EQ(inner.Stdout().find("outer"), std::string::npos);
+  }
+  gzmsg << "restored" << std::endl;
+
+  auto out = outer.Stdout();
+  EXPECT_NE(out.find("outer"), std::string::npos);
+  EXPECT_EQ(out.find("inner"), std::string::npos);
+  EXPECT_NE(out.find("restored"), std::string::npos);
+}
+
+/////////////////////////////////////////////////
+TEST(ConsoleCapture, Threads)
+{
+  Console::SetVerbosity(4);
+
+  constexpr int kThreads = 8;
+  std::vector<std::string> outputs(kThreads);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i)
+  {
+    threads.emplace_back([i, &outputs]
+        {
+          ConsoleCapture capture;
+          gzmsg << "thread_" << i << "_end" << std::endl;
+          outputs[i] = capture.Stdout();
+        });
+  }
+
+  for (auto &t : threads)
+    t.join();
+
+  for (int i = 0; i < kThreads; ++i)
+  {
+    for (int j = 0; j < kThreads; ++j)
+    {
+      auto found = outputs[i].find("thread_" + std::to_string(j) + "_end");
+      if (i == j)
+        EXPECT_NE(found, std::string::npos) << outputs[i];
+      else
+        EXPECT_EQ(found, std::string::npos) << outputs[i];
+    }
+  }
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <gz/common/Console.hh>
+#include <gz/common/testing/ParallelTestFixture.hh>
+#include <gz/common/testing/Utils.hh>
+
+using namespace gz::common;
+using namespace gz::common::testing;
+
+/////////////////////////////////////////////////
+TEST_F(ParallelTestFixture, TempRoot)
+{
+  auto cwd = gz::common::cwd();
+
+  ASSERT_FALSE(this->TempRoot().empty());
+  EXPECT_TRUE(isDirectory(this->TempRoot()));
+  EXPECT_NE(std::string::npos,
+      this->TempRoot().find("ParallelTestFixture_TempRoot_"));
+  EXPECT_NE(std::string::npos, this->TempRoot().find(
+      "shard_" + std::to_string(this->Shard().index)));
+
+  // The working directory is shared by all threads and must not change
+  EXPECT_EQ(cwd, gz::common::cwd());
+
+  auto path = this->TestTempPath("foo.txt");
+  EXPECT_TRUE(createNewEmptyFile(path));
+  EXPECT_TRUE(exists(path));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ParallelTestFixture, Console)
+{
+  Console::SetVerbosity(4);
+  gzmsg << "message" << std::endl;
+  gzerr << "error" << std::endl;
+
+  EXPECT_NE(std::string::npos, this->Stdout().find("message"));
+  EXPECT_NE(std::string::npos, this->Stderr().find("error"));
+  EXPECT_EQ(std::string::npos, this->Stdout().find("error"));
+}
@@ -17,6 +17,10 @@
 #include "gz/common/testing/TestPaths.hh"
 #include "gz/common/testing/BazelTestPaths.hh"
 #include "gz/common/testing/CMakeTestPaths.hh"
+#include "gz/common/testing/Utils.hh"
+
+#include <cctype>
+#include <string>
 
 #include <gz/common/Console.hh>
 #include <gz/common/Util.hh>
@@ -98,4 +102,36 @@ MakeTestTempDirectoryImpl(const std::string &_projectSourcePath,
       dataDir, _prefix, _subDir, _cleanup);
 }
 
+//////////////////////////////////////////////////
+std::string MakeUniqueTestTempPathImpl(const std::string &_projectSourcePath,
+                                       const std::string &_testName,
+                                       const std::string &_subDir)
+{
+  std::string root;
+  auto testPaths = TestPathFactory(_projectSourcePath);
+  if (testPaths)
+    testPaths->TestTmpPath(root);
+
+  if (root.empty())
+    root = common::tempDirectoryPath();
+
+  if (root.empty())
+    return "";
+
+  // Keep the name usable as a single path component on every platform
+  std::string prefix = _testName.empty() ? "test" : _testName;
+  for (auto &c : prefix)
+  {
+    if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-')
+      c = '_';
+  }
+  prefix += "_";
+
+  auto shard = currentTestShard();
+  auto parent = common::joinPaths(root, _subDir,
+      "shard_" + std::to_string(shard.index));
+
+  return common::createTempDirectory(prefix, parent);
+}
+
 }  // namespace gz::common::testing
@@ -19,6 +19,38 @@
 
 #include <fstream>
 #include <random>
+#include <string>
+
+#include <gz/common/Util.hh>
+
+namespace
+{
+/////////////////////////////////////////////////
+/// \brief Read an unsigned integer from an environment variable
+/// \param[in] _name Name of the environment variable
+/// \param[out] _value Parsed value
+/// \return True if the variable was set and is a valid unsigned integer
+bool envUnsigned(const char *_name, unsigned int &_value)
+{
+  std::string str;
+  if (!gz::common::env(_name, str) || str.empty())
+    return false;
+
+  try
+  {
+    size_t pos {0};
+    auto value = std::stoul(str, &pos);
+    if (pos != str.size())
+      return false;
+    _value = static_cast<unsigned int>(value);
+  }
+  catch(...)
+  {
+    return false;
+  }
+  return true;
+}
+}  // namespace
 
 namespace gz::common::testing
 {
@@ -50,4 +82,20 @@ bool createNewEmptyFile(const std::string &_filename)
   return true;
 }
 
+/////////////////////////////////////////////////
+TestShard currentTestShard()
+{
+  TestShard shard;
+  unsigned int index {0};
+  unsigned int total {0};
+  if (envUnsigned("GTEST_SHARD_INDEX", index) &&
+      envUnsigned("GTEST_TOTAL_SHARDS", total) &&
+      total > 0 && index < total)
+  {
+    shard.index = index;
+    shard.total = total;
+  }
+  return shard;
+}
+
 }  // namespace gz::common::testing
@@ -16,12 +16,49 @@
 */
 #include <gtest/gtest.h>
 
+#include <string>
+
+#include <gz/common/Util.hh>
 #include <gz/common/testing/TestPaths.hh>
 #include <gz/common/testing/Utils.hh>
 
 using namespace gz::common;
 using namespace gz::common::testing;
 
+namespace
+{
+/////////////////////////////////////////////////
+/// \brief Restores an environment variable when going out of scope.
+class ScopedEnv
+{
+  /// \brief Constructor, saves the current value.
+  /// \param[in] _name Name of the environment variable.
+  public: explicit ScopedEnv(const std::string &_name)
+    : name(_name)
+  {
+    this->wasSet = env(this->name, this->value);
+  }
+
+  /// \brief Destructor, restores the saved value.
+  public: ~ScopedEnv()
+  {
+    if (this->wasSet)
+      EXPECT_TRUE(gz::common::setenv(this->name, this->value));
+    else
+      EXPECT_TRUE(gz::common::unsetenv(this->name));
+  }
+
+  /// \brief Name of the variable.
+  private: std::string name;
+
+  /// \brief Saved value.
+  private: std::string value;
+
+  /// \brief Whether the variable was set.
+  private: bool wasSet{false};
+};
+}  // namespace
+
 /////////////////////////////////////////////////
 TEST(Utils, CreateNewEmptyFile)
 {
@@ -36,3 +73,45 @@ TEST(Utils, CreateNewEmptyFile)
   EXPECT_TRUE(removeFile(path));
 }
 
+/////////////////////////////////////////////////
+TEST(Utils, CurrentTestShard)
+{
+  // Restore the environment of the test runner, even if an assertion fails
+  ScopedEnv index("GTEST_SHARD_INDEX");
+  ScopedEnv total("GTEST_TOTAL_SHARDS");
+
+  ASSERT_TRUE(gz::common::setenv("GTEST_SHARD_INDEX", "2"));
+  ASSERT_TRUE(gz::common::setenv("GTEST_TOTAL_SHARDS", "4"));
+  auto shard = currentTestShard();
+  EXPECT_EQ(2u, shard.index);
+  EXPECT_EQ(4u, shard.total);
+
+  // Out of range and malformed values fall back to a single shard
+  ASSERT_TRUE(gz::common::setenv("GTEST_SHARD_INDEX", "4"));
+  shard = currentTestShard();
+  EXPECT_EQ(0u, shard.index);
+  EXPECT_EQ(1u, shard.total);
+
+  ASSERT_TRUE(gz::common::setenv("GTEST_SHARD_INDEX", "1x"));
+  shard = currentTestShard();
+  EXPECT_EQ(0u, shard.index);
+  EXPECT_EQ(1u, shard.total);
+}
+
+/////////////////////////////////////////////////
+TEST(Utils, MakeUniqueTestTempPath)
+{
+  auto first = MakeUniqueTestTempPath("Suite/Name");
+  auto second = MakeUniqueTestTempPath("Suite/Name");
+  ASSERT_FALSE(first.empty());
+  ASSERT_FALSE(second.empty());
+  EXPECT_NE(first, second);
+  EXPECT_TRUE(isDirectory(first));
+  EXPECT_TRUE(isDirectory(second));
+
+  // Invalid filename characters are replaced
+  EXPECT_EQ(0u, basename(first).find("Suite_Name_"));
+
+  EXPECT_TRUE(removeAll(first));
+  EXPECT_TRUE(removeAll(second));
+}